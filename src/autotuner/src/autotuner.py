@@ -3,7 +3,12 @@
 import os
 import sys
 import json
+import threading
 import traceback
+try:
+  import queue
+except ImportError:
+  import Queue as queue
 
 import opentuner
 from opentuner import ConfigurationManipulator
@@ -27,6 +32,30 @@ class autotuneProgram(MeasurementInterface):
   confFile = None
   executionTimeFile = None
   exploredConfs = {}
+  exploredConfsLock = threading.Lock()
+  workerSlots = None
+  cacheDir = None
+  inputsHash = None
+  costModel = None
+  minPredictedSpeedup = 1.0
+
+  def __init__(self, args, *pargs, **kwargs):
+    super(autotuneProgram, self).__init__(args, *pargs, **kwargs)
+
+    # Evaluate configurations concurrently through the parallel compilation of OpenTuner
+    numberOfWorkers = int(os.environ.get('autotunerWORKERS', '1'))
+    coresPerWorker = int(os.environ.get('autotunerCORES_PER_WORKER', '0'))
+    coreSets = utils.getCoreSets(max(1, numberOfWorkers), coresPerWorker)
+    self.workerSlots = queue.Queue()
+    for workerID in range(0, len(coreSets)):
+      self.workerSlots.put((workerID, coreSets[workerID]))
+      sys.stderr.write("AUTOTUNER: worker " + str(workerID) + " uses cores " + str(coreSets[workerID]) + "\n")
+    self.parallel_compile = (len(coreSets) > 1)
+    if (self.parallel_compile and hasattr(args, 'parallelism')):
+      args.parallelism = max(args.parallelism, len(coreSets))
+
+    return
+
 
   def getArgs(self):
     # Read the range of each dimension of the design space
@@ -42,9 +71,90 @@ class autotuneProgram(MeasurementInterface):
     self.baselineTimeFile = os.environ['autotunerBASELINE_TIME']
     self.baselineTime = utils.readExecutionTimeFile(self.baselineTimeFile)
 
+    # Get the predictions of the loop cost model (noelle-loop-cost-model), if any
+    if ('autotunerCOST_MODEL' in os.environ):
+      self.costModel = utils.readCostModelFile(os.environ['autotunerCOST_MODEL'])
+      self.minPredictedSpeedup = float(os.environ.get('autotunerCOST_MODEL_MIN_SPEEDUP', '1.0'))
+      self.pruneSpace()
+
+    # Binaries are cached by the hash of the configuration and of the inputs of
+    # the compilation (options, content of the bitcode and libraries, toolchain)
+    self.cacheDir = os.path.abspath(os.environ.get('autotunerCACHE_DIR', 'autotunerCache'))
+    if (not os.path.isdir(self.cacheDir)):
+      os.makedirs(self.cacheDir)
+    self.inputsHash = utils.getInputsHash(os.environ['autotunerARGS'], os.environ['autotunerLIBS'], [os.environ['autotunerOUTPUTBC']])
+    self.embedBaselinePDG()
+
+    return
+
+
+  def embedBaselinePDG(self):
+    """
+    Compute the PDG of the baseline bitcode once and embed it, so compilations
+    of configurations load it rather than recomputing it.
+    The embedded PDG is rebuilt when the inputs of the compilation change.
+    """
+    args = os.environ['autotunerARGS'].split()
+    if ((len(args) == 0) or (not args[0].endswith('.bc'))):
+      return
+    inputBitcode = args[0]
+    baselineName = 'baseline_with_pdg_' + self.inputsHash + '.bc'
+    baselineWithPDG = os.path.join(self.cacheDir, baselineName)
+    if (not os.path.isfile(baselineWithPDG)):
+      for fileName in os.listdir(self.cacheDir):
+        if (fileName.startswith('baseline_with_pdg') and (fileName != baselineName)):
+          os.remove(os.path.join(self.cacheDir, fileName))
+      sys.stderr.write("AUTOTUNER: embed the PDG of " + inputBitcode + "\n")
+      if (utils.embedPDG(inputBitcode, baselineWithPDG) != 0):
+        sys.stderr.write("AUTOTUNER: PDG embedding failed; the PDG will be computed at every compilation\n")
+        return
+    args[0] = baselineWithPDG
+    os.environ['autotunerARGS'] = ' '.join(args)
+
     return
 
 
+  def pruneSpace(self):
+    """
+    Shrink the design space of the loops using the cost model
+    """
+    for message in utils.pruneSpaceWithCostModel(self.ranges, self.loopIDs, self.costModel, self.minPredictedSpeedup):
+      sys.stderr.write("AUTOTUNER: cost model: " + message + "\n")
+
+    return
+
+
+  def isDominated(self, confWithLoopIDs):
+    """
+    A configuration is dominated if the cost model predicts that a parallelized
+    loop slows down, or that it would run as fast with fewer cores
+    """
+    if (self.costModel is None):
+      return False
+
+    return utils.isConfDominatedByCostModel(confWithLoopIDs, self.costModel, self.minPredictedSpeedup)
+
+
+  def getWorkerEnvironment(self, workerID):
+    """
+    Each worker compiles and runs in its own directory
+    """
+    workerDir = os.path.join(self.cacheDir, 'worker' + str(workerID))
+    if (not os.path.isdir(workerDir)):
+      os.makedirs(workerDir)
+
+    env = os.environ.copy()
+    outputBitcode = env['autotunerOUTPUTBC']
+    workerOutputBitcode = os.path.join(workerDir, os.path.basename(outputBitcode))
+    env['autotunerARGS'] = env['autotunerARGS'].replace(outputBitcode, workerOutputBitcode)
+    env['autotunerOUTPUTBC'] = workerOutputBitcode
+    env['autotunerPARALLELIZED_BINARY'] = os.path.join(workerDir, 'binary')
+    env['autotunerEXECUTION_TIME'] = os.path.join(workerDir, 'executionTime.txt')
+    env['INDEX_FILE'] = os.path.join(workerDir, os.path.basename(self.confFile))
+
+    return env
+
+
   def manipulator(self):
     """
     Define the search space by creating a
@@ -208,14 +318,13 @@ class autotuneProgram(MeasurementInterface):
     return confAsStr
 
 
-  def run(self, desired_result, input, limit):
+  def evaluate(self, conf):
     """
-    Compile and run a given configuration then
-    return performance
+    Compile (unless cached) and run a given configuration on the cores of a
+    free worker then return performance
     """
 
     # Read the configuration to run
-    conf = desired_result.configuration.data
     sys.stderr.write("AUTOTUNER: conf " + str(conf) + "\n")
     confNormalized = self.getNormalizedConf(conf)
     sys.stderr.write("AUTOTUNER: confNormalized " + str(confNormalized) + "\n")
@@ -226,39 +335,76 @@ class autotuneProgram(MeasurementInterface):
     sys.stderr.write("AUTOTUNER: confExpandedAsStr " + str(confExpandedAsStr) + "\n")
     time = None
     # Check if configuration has already been run
-    if (confExpandedAsStr in self.exploredConfs):
-      time = self.exploredConfs[confExpandedAsStr]
-      return Result(time = time)
-   
+    with self.exploredConfsLock:
+      if (confExpandedAsStr in self.exploredConfs):
+        time = self.exploredConfs[confExpandedAsStr]
+        return Result(time = time)
+
+    # Skip configurations dominated according to the cost model
+    confWithLoopIDs = self.getConfWithLoopIDs(confExpanded)
+    if (self.isDominated(confWithLoopIDs)):
+      sys.stderr.write("AUTOTUNER: conf dominated according to the cost model\n")
+      with self.exploredConfsLock:
+        self.exploredConfs[confExpandedAsStr] = float('inf')
+      return Result(time = float('inf'))
+
+    workerID, cores = self.workerSlots.get()
     try:
+      env = self.getWorkerEnvironment(workerID)
+
       # Compile
-      confWithLoopIDs = self.getConfWithLoopIDs(confExpanded)
-      sys.stderr.write("AUTOTUNER: confWithLoopIDs " + str(confWithLoopIDs) + "\n")
-      compileRetCode = utils.myCompile(self.confFile, confWithLoopIDs)
-      if (compileRetCode != 0):
-        time = float('inf')
-        return Result(time = time)
+      cachedBinary = os.path.join(self.cacheDir, utils.getConfHash(confExpandedAsStr, self.inputsHash))
+      if (os.path.isfile(cachedBinary)):
+        sys.stderr.write("AUTOTUNER: reuse binary " + cachedBinary + "\n")
+      else:
+        sys.stderr.write("AUTOTUNER: confWithLoopIDs " + str(confWithLoopIDs) + "\n")
+        compileRetCode = utils.myCompile(env['INDEX_FILE'], confWithLoopIDs, env, cores)
+        if (compileRetCode != 0):
+          time = float('inf')
+          return Result(time = time)
+        utils.cacheFile(env['autotunerPARALLELIZED_BINARY'], cachedBinary)
 
       # Run parallel optimized binary
+      env['autotunerPARALLELIZED_BINARY'] = cachedBinary
       maxExecutionTime = 2*self.baselineTime
-      runRetCode = utils.myRun(maxExecutionTime)
+      runRetCode = utils.myRun(maxExecutionTime, env, cores)
       if (runRetCode != 0):
         time = float('inf')
         return Result(time = time)
 
+      # Get execution time
+      time = utils.readExecutionTimeFile(env['autotunerEXECUTION_TIME'])
+
     except KeyboardInterrupt:
       sys.stderr.write("AUTOTUNER: KeyboardInterrupt. Abort.\n")
       sys.exit(1)
 
-    # Get execution time
-    time = utils.readExecutionTimeFile(self.executionTimeFile)
+    finally:
+      self.workerSlots.put((workerID, cores))
 
     # Save conf in our list of explored configurations
-    self.exploredConfs[confExpandedAsStr] = time
+    with self.exploredConfsLock:
+      self.exploredConfs[confExpandedAsStr] = time
 
     return Result(time=time)
 
 
+  def run(self, desired_result, input, limit):
+    return self.evaluate(desired_result.configuration.data)
+
+
+  def compile(self, config_data, id):
+    """
+    With more than one worker, OpenTuner invokes this method from concurrent
+    threads: each one evaluates a configuration on its own cores
+    """
+    return self.evaluate(config_data)
+
+
+  def run_precompiled(self, desired_result, input, limit, compile_result, id):
+    return compile_result
+
+
   def writeJson(self, pathToFile, jsonData):
     with open(pathToFile, 'w') as f:
       json.dump(jsonData, f)
@@ -280,7 +426,8 @@ class autotuneProgram(MeasurementInterface):
       sys.exit(1)
     
     # Dump explored configurations as json
-    self.writeJson("exploredConfs.json", self.exploredConfs)
+    with self.exploredConfsLock:
+      self.writeJson("exploredConfs.json", self.exploredConfs)
 
     return
 
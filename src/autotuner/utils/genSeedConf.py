@@ -73,8 +73,39 @@ def genSeedConf(pathToSeedConf):
 
   return pathToFile
 
+def readSeedConfFromCostModel(pathToSpaceFile, pathToCostModel):
+  # Start from the configuration the cost model predicts to be the fastest:
+  # every loop uses its best technique and number of cores
+  techniqueIndex = 3
+  coresIndex = 4
+  ranges, loopIDs = utils.readSpaceFile(pathToSpaceFile)
+  model = utils.readCostModelFile(pathToCostModel)
+  seedConf = {}
+  i = 0
+  for loopID in loopIDs:
+    if (loopID in model):
+      speedup, technique, cores = utils.getBestPrediction(model[loopID])
+      cardinalityOfCores = ranges[loopID][coresIndex]
+      if ((technique is not None) and (speedup > 1.0) and ((not cardinalityOfCores.isdigit()) or (cores < int(cardinalityOfCores)))):
+        seedConf[i] = 1
+        seedConf[i + techniqueIndex] = technique
+        seedConf[i + coresIndex] = cores
+    i += len(ranges[loopID])
+
+  sys.stderr.write(str(seedConf) + "\n")
+  return seedConf
+
+def genSeedConfFromCostModel(pathToSpaceFile, pathToCostModel):
+  seedConfJson = readSeedConfFromCostModel(pathToSpaceFile, pathToCostModel)
+  pathToFile = genSeedConfFile(seedConfJson)
+
+  return pathToFile
+
 
 if __name__ == '__main__':
-  pathToSeedConf = genSeedConf(sys.argv[1])
+  if ((len(sys.argv) == 4) and (sys.argv[1] == "--cost-model")):
+    pathToSeedConf = genSeedConfFromCostModel(sys.argv[2], sys.argv[3])
+  else:
+    pathToSeedConf = genSeedConf(sys.argv[1])
   print(pathToSeedConf)
 
@@ -2,7 +2,10 @@
 
 import os
 import sys
+import shutil
+import hashlib
 import subprocess
+import multiprocessing
 from enum import Enum
 
 # Risky. It works because autotuner.py and filter.py are at the same level in the directoy tree.
@@ -40,6 +43,126 @@ def readSpaceFile(pathToFile):
   return ranges, loopIDs
 
 
+def readCostModelFile(pathToFile):
+  # Predictions of noelle-loop-cost-model:
+  # model[loopID][techniqueIndex][cores] = (coverage, loopSpeedup, overhead)
+  model = {}
+  with open(str(pathToFile), 'r') as f:
+    for line in f.readlines():
+      elems = line.split()
+      if (len(elems) != 6):
+        continue
+      loopID = int(elems[0])
+      technique = int(elems[1])
+      cores = int(elems[2])
+      model.setdefault(loopID, {}).setdefault(technique, {})[cores] = (float(elems[3]), float(elems[4]), float(elems[5]))
+    f.close()
+
+  return model
+
+
+def getBestPrediction(modelOfLoop):
+  # Return (speedup, techniqueIndex, cores) of the best prediction for a loop
+  best = (0.0, None, 0)
+  for technique in sorted(modelOfLoop):
+    for cores in sorted(modelOfLoop[technique]):
+      speedup = modelOfLoop[technique][cores][1]
+      if (speedup > best[0]):
+        best = (speedup, technique, cores)
+
+  return best
+
+
+# Techniques in the order of their indexes in the cost model
+costModelTechniques = [Technique.DOALL, Technique.HELIX, Technique.DSWP]
+
+
+def getCostModelTechniqueIndex(technique):
+  # Return the index used by the cost model for a technique, or None if unknown.
+  # A technique is either a raw index of the search space or a Technique
+  # (as an enum member or as its value).
+  if (isinstance(technique, Technique)):
+    return costModelTechniques.index(technique)
+  try:
+    technique = int(technique)
+  except (TypeError, ValueError):
+    return None
+  if (technique in range(len(costModelTechniques))):
+    return technique
+  for index, knownTechnique in enumerate(costModelTechniques):
+    if (technique == knownTechnique.value):
+      return index
+
+  return None
+
+
+def pruneSpaceWithCostModel(ranges, loopIDs, costModel, minPredictedSpeedup):
+  # Shrink the ranges of the design space (see readSpaceFile) of the loops
+  # using the predictions of the cost model (see readCostModelFile).
+  # Return the messages that describe what has been pruned.
+  techniqueIndex = 3
+  coresIndex = 4
+  messages = []
+  for loopID in loopIDs:
+    if (loopID not in costModel):
+      continue
+    modelOfLoop = costModel[loopID]
+    loopRanges = ranges[loopID]
+
+    # Disable loops that are not predicted to speed up
+    bestSpeedup, bestTechnique, _ = getBestPrediction(modelOfLoop)
+    if ((bestTechnique is None) or (bestSpeedup < minPredictedSpeedup)):
+      messages.append("disable loop " + str(loopID))
+      loopRanges[0] = "2_0"
+      continue
+
+    # Force the technique if it is the only one predicted to speed up the loop
+    goodTechniques = [technique for technique in modelOfLoop if (getBestPrediction({technique: modelOfLoop[technique]})[0] >= minPredictedSpeedup)]
+    if ((len(goodTechniques) == 1) and loopRanges[techniqueIndex].isdigit()):
+      messages.append("loop " + str(loopID) + " uses technique " + str(goodTechniques[0]))
+      loopRanges[techniqueIndex] = loopRanges[techniqueIndex] + "_" + str(goodTechniques[0])
+
+    # Do not consider more cores than those predicted to be useful
+    if (not loopRanges[coresIndex].isdigit()):
+      continue
+    usefulCores = 0
+    for technique in goodTechniques:
+      predictions = modelOfLoop[technique]
+      bestOfTechnique = max([predictions[cores][1] for cores in predictions])
+      usefulCores = max(usefulCores, min([cores for cores in predictions if (predictions[cores][1] >= (0.99 * bestOfTechnique))]))
+    if ((usefulCores + 1) < int(loopRanges[coresIndex])):
+      messages.append("loop " + str(loopID) + " uses at most " + str(usefulCores) + " cores")
+      loopRanges[coresIndex] = str(usefulCores + 1)
+
+  return messages
+
+
+def isConfDominatedByCostModel(confWithLoopIDs, costModel, minPredictedSpeedup):
+  # A configuration is dominated if the cost model predicts that a parallelized
+  # loop slows down, or that it would run as fast with fewer cores
+  for loopID in confWithLoopIDs:
+    conf = confWithLoopIDs[loopID]
+    if ((loopID not in costModel) or (conf[0] == 0)):
+      continue
+    cores = int(conf[4])
+    if (cores < 2):
+      continue
+    technique = getCostModelTechniqueIndex(conf[3])
+    if ((technique is None) or (technique not in costModel[loopID])):
+      continue
+    predictions = costModel[loopID][technique]
+    if (cores not in predictions):
+      continue
+    speedup = predictions[cores][1]
+    if (speedup < minPredictedSpeedup):
+      return True
+    for fewerCores in predictions:
+      if ((fewerCores < cores) and (predictions[fewerCores][1] >= speedup)):
+        return True
+
+  return False
+
+
 def writeConfFile(pathToFile, conf):
   strToWrite = ""
   for loopID in conf:
@@ -55,25 +178,112 @@ def writeConfFile(pathToFile, conf):
   return
 
 
-def myCompile(confFile, conf):
+def getAvailableCores():
+  if (hasattr(os, 'sched_getaffinity')):
+    return sorted(os.sched_getaffinity(0))
+
+  return list(range(0, multiprocessing.cpu_count()))
+
+
+def getCoreSets(numberOfWorkers, coresPerWorker = 0):
+  # Split the available cores in disjoint sets, one per worker
+  cores = getAvailableCores()
+  if (coresPerWorker <= 0):
+    coresPerWorker = max(1, len(cores) // numberOfWorkers)
+  numberOfWorkers = min(numberOfWorkers, max(1, len(cores) // coresPerWorker))
+
+  coreSets = []
+  for worker in range(0, numberOfWorkers):
+    coreSets.append(cores[worker * coresPerWorker : (worker + 1) * coresPerWorker])
+
+  return coreSets
+
+
+def getConfHash(confAsStr, salt = ""):
+  return hashlib.sha1((salt + "#" + confAsStr).encode('utf-8')).hexdigest()
+
+
+def getToolchainVersion():
+  # Identify the versions of NOELLE and clang used to compile configurations
+  version = ""
+  for command in ["noelle-config --version --git-commit", "clang --version"]:
+    try:
+      version += subprocess.check_output(command, shell = True, stderr = subprocess.DEVNULL).decode('utf-8', 'replace')
+    except (subprocess.CalledProcessError, OSError):
+      version += command + ": unavailable\n"
+
+  return version
+
+
+def getInputsHash(args, libs, excludedFiles = []):
+  # Hash the compilation options, the content of the files they refer to (e.g.,
+  # the input bitcode and the libraries), and the toolchain
+  hash = hashlib.sha1()
+  hash.update(getToolchainVersion().encode('utf-8'))
+  excludedPaths = [os.path.abspath(pathToFile) for pathToFile in excludedFiles]
+  for option in (args.split() + ["#"] + libs.split()):
+    hash.update((option + "\n").encode('utf-8'))
+    if ((not os.path.isfile(option)) or (os.path.abspath(option) in excludedPaths)):
+      continue
+    with open(option, 'rb') as f:
+      for chunk in iter(lambda: f.read(1 << 20), b''):
+        hash.update(chunk)
+      f.close()
+
+  return hash.hexdigest()
+
+
+def getPinningPrefix(cores):
+  if ((cores is None) or (len(cores) == 0)):
+    return ""
+
+  return "taskset -c " + ",".join([str(core) for core in cores]) + " "
+
+
+def embedPDG(inputBitcode, outputBitcode):
+  # Compute the PDG once and embed it, so every compilation can load it
+  tmpBitcode = outputBitcode + ".tmp"
+  command = "noelle-meta-pdg-embed " + inputBitcode + " -o " + tmpBitcode
+  retcode = subprocess.call(command, shell = True)
+  if (retcode != 0):
+    return retcode
+  os.rename(tmpBitcode, outputBitcode)
+
+  return 0
+
+
+def cacheFile(pathToFile, pathToCachedFile):
+  # Atomically add a file to the cache
+  tmpFile = pathToCachedFile + "." + str(os.getpid()) + ".tmp"
+  shutil.copy2(pathToFile, tmpFile)
+  os.rename(tmpFile, pathToCachedFile)
+
+  return
+
+
+def myCompile(confFile, conf, env = None, cores = None):
   # Write autotuner_conf.info file
   writeConfFile(confFile, conf)
 
-  return os.system(thisPath + "/../scripts/compile")
+  command = getPinningPrefix(cores) + thisPath + "/../scripts/compile"
+  if (env is None):
+    return os.system(command)
+
+  return subprocess.call(command, shell = True, env = env)
 
 
-def myRun(maxExecutionTime = 0):
+def myRun(maxExecutionTime = 0, env = None, cores = None):
   command = None
   if (maxExecutionTime == 0):
     command = "bash " + thisPath + "/../scripts/run"
   else:
-    command = "bash " + "timeout " + str(maxExecutionTime) + "s " + thisPath + "/../scripts/run"
+    command = "timeout " + str(maxExecutionTime) + "s bash " + thisPath + "/../scripts/run"
+  command = getPinningPrefix(cores) + command
 
   retcode = 0
   try:
-    retcode = subprocess.call(command, shell = True)
+    retcode = subprocess.call(command, shell = True, env = env)
   except subprocess.CalledProcessError as e:
     retcode = e.returncode
 
   return retcode
-
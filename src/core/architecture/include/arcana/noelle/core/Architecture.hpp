@@ -30,13 +30,104 @@ class Architecture {
 public:
   Architecture();
 
+  /*
+   * The topology of the machine is read from the Linux sysfs (falling back to
+   * cpuid and to conservative defaults for what is not exposed there).
+   *
+   * When compiling for a different machine, the topology can be described in
+   * a file passed with -noelle-arch-file. Each line of such file is
+   * "KEY VALUES", lines starting with '#' are ignored, and keys that are not
+   * specified get conservative defaults. The keys are:
+   *
+   *   logical_cores N
+   *   physical_cores N
+   *   cache LEVEL SIZE_IN_BYTES LINE_SIZE_IN_BYTES
+   *   numa_node NODE_ID LOGICAL_CORE [LOGICAL_CORE]*
+   *   numa_distances NODE_ID DISTANCE_TO_NODE_0 [DISTANCE_TO_NODE_i]*
+   *   smt_siblings LOGICAL_CORE [LOGICAL_CORE]*
+   */
+
+  /*
+   * =========================== Cores =======================================
+   */
   static uint32_t getNumberOfLogicalCores(void);
 
   static uint32_t getNumberOfPhysicalCores(void);
 
+  /*
+   * Return true if the logical cores @core1 and @core2 belong to the same
+   * physical core.
+   */
+  static bool areSMTSiblings(uint32_t core1, uint32_t core2);
+
+  /*
+   * Return the distance between the logical cores @core1 and @core2.
+   * Logical cores of the same physical core have distance 0.
+   * Otherwise, the distance is the one between their NUMA nodes (e.g., 10
+   * within the same node and 20 or more across nodes).
+   */
+  static uint32_t getCoreDistance(uint32_t core1, uint32_t core2);
+
+  /*
+   * =========================== NUMA ========================================
+   */
+  static uint32_t getNumberOfNUMANodes(void);
+
+  static uint32_t getNUMANodeOfCore(uint32_t core);
+
+  static std::vector<uint32_t> getCoresOfNUMANode(uint32_t node);
+
+  static uint32_t getNUMANodeDistance(uint32_t node1, uint32_t node2);
+
+  /*
+   * =========================== Caches ======================================
+   */
+
+  /*
+   * Return the line size of the L1 data cache.
+   */
   static int32_t getCacheLineBytes(void);
 
+  /*
+   * Return the line size of the cache at level @level.
+   */
+  static uint32_t getCacheLineBytes(uint32_t level);
+
+  /*
+   * Return the size of the cache (data or unified) at level @level.
+   * Level 1 is the L1 data cache.
+   */
+  static uint64_t getCacheBytes(uint32_t level);
+
+  static uint32_t getNumberOfCacheLevels(void);
+
+  static uint64_t getLastLevelCacheBytes(void);
+
 private:
+  struct Cache {
+    uint64_t bytes;
+    uint32_t lineBytes;
+  };
+
+  struct Topology {
+    uint32_t logicalCores;
+    uint32_t physicalCores;
+    std::map<uint32_t, Cache> caches;
+    std::map<uint32_t, uint32_t> physicalCoreOfCore;
+    std::map<uint32_t, uint32_t> numaNodeOfCore;
+    std::map<uint32_t, std::vector<uint32_t>> numaDistances;
+  };
+
+  static const Topology &getTopology(void);
+
+  static void readTopologyFromSysfs(Topology &topology);
+
+  static void readTopologyFromCPUID(Topology &topology);
+
+  static bool readTopologyFromFile(Topology &topology,
+                                   const std::string &fileName);
+
+  static void setDefaults(Topology &topology);
 };
 
 } // namespace arcana::noelle
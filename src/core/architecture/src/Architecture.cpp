@@ -23,20 +23,154 @@
 
 namespace arcana::noelle {
 
+static cl::opt<std::string> ArchitectureFile(
+    "noelle-arch-file",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("File that describes the topology of the target machine"));
+
 Architecture::Architecture() {
   return;
 }
 
+const Architecture::Topology &Architecture::getTopology(void) {
+
+  /*
+   * The topology is discovered only once.
+   */
+  static Topology topology = []() {
+    Topology t{};
+
+    /*
+     * Check if the topology of the target machine has been provided.
+     */
+    if (ArchitectureFile.getNumOccurrences() > 0) {
+      auto fileName = ArchitectureFile.getValue();
+      if (!Architecture::readTopologyFromFile(t, fileName)) {
+        errs() << "Architecture: ERROR = the file \"" << fileName
+               << "\" cannot be read\n";
+        abort();
+      }
+
+    } else {
+
+      /*
+       * Read the topology of the current machine.
+       */
+      Architecture::readTopologyFromSysfs(t);
+      Architecture::readTopologyFromCPUID(t);
+    }
+
+    /*
+     * Fill what has not been discovered.
+     */
+    Architecture::setDefaults(t);
+
+    return t;
+  }();
+
+  return topology;
+}
+
 uint32_t Architecture::getNumberOfLogicalCores(void) {
-  return std::thread::hardware_concurrency();
+  return getTopology().logicalCores;
 }
 
 uint32_t Architecture::getNumberOfPhysicalCores(void) {
-  return getNumberOfLogicalCores() / 2;
+  return getTopology().physicalCores;
+}
+
+bool Architecture::areSMTSiblings(uint32_t core1, uint32_t core2) {
+  if (core1 == core2) {
+    return true;
+  }
+  auto &physicalCoreOfCore = getTopology().physicalCoreOfCore;
+  auto it1 = physicalCoreOfCore.find(core1);
+  auto it2 = physicalCoreOfCore.find(core2);
+  if ((it1 == physicalCoreOfCore.end()) || (it2 == physicalCoreOfCore.end())) {
+    return false;
+  }
+
+  return it1->second == it2->second;
+}
+
+uint32_t Architecture::getCoreDistance(uint32_t core1, uint32_t core2) {
+  if (areSMTSiblings(core1, core2)) {
+    return 0;
+  }
+  auto node1 = getNUMANodeOfCore(core1);
+  auto node2 = getNUMANodeOfCore(core2);
+
+  return getNUMANodeDistance(node1, node2);
+}
+
+uint32_t Architecture::getNumberOfNUMANodes(void) {
+  return getTopology().numaDistances.size();
+}
+
+uint32_t Architecture::getNUMANodeOfCore(uint32_t core) {
+  auto &numaNodeOfCore = getTopology().numaNodeOfCore;
+  auto it = numaNodeOfCore.find(core);
+  if (it == numaNodeOfCore.end()) {
+    return 0;
+  }
+
+  return it->second;
+}
+
+std::vector<uint32_t> Architecture::getCoresOfNUMANode(uint32_t node) {
+  std::vector<uint32_t> cores{};
+  for (auto pair : getTopology().numaNodeOfCore) {
+    if (pair.second == node) {
+      cores.push_back(pair.first);
+    }
+  }
+
+  return cores;
+}
+
+uint32_t Architecture::getNUMANodeDistance(uint32_t node1, uint32_t node2) {
+  auto &numaDistances = getTopology().numaDistances;
+  auto it = numaDistances.find(node1);
+  if ((it == numaDistances.end()) || (node2 >= it->second.size())) {
+    errs() << "Architecture: ERROR = the NUMA nodes " << node1 << " and "
+           << node2 << " do not exist\n";
+    abort();
+  }
+
+  return it->second[node2];
 }
 
 int32_t Architecture::getCacheLineBytes(void) {
-  return 64;
+  return getCacheLineBytes(1);
+}
+
+uint32_t Architecture::getCacheLineBytes(uint32_t level) {
+  auto &caches = getTopology().caches;
+  auto it = caches.find(level);
+  if (it == caches.end()) {
+    return 0;
+  }
+
+  return it->second.lineBytes;
+}
+
+uint64_t Architecture::getCacheBytes(uint32_t level) {
+  auto &caches = getTopology().caches;
+  auto it = caches.find(level);
+  if (it == caches.end()) {
+    return 0;
+  }
+
+  return it->second.bytes;
+}
+
+uint32_t Architecture::getNumberOfCacheLevels(void) {
+  return getTopology().caches.rbegin()->first;
+}
+
+uint64_t Architecture::getLastLevelCacheBytes(void) {
+  return getTopology().caches.rbegin()->second.bytes;
 }
 
 } // namespace arcana::noelle
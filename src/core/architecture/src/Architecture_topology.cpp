@@ -0,0 +1,474 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include "arcana/noelle/core/Architecture.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <cpuid.h>
+#endif
+
+namespace arcana::noelle {
+
+static bool readFirstLine(const std::string &fileName, std::string &line) {
+  std::ifstream file(fileName);
+  if (!file.is_open()) {
+    return false;
+  }
+  if (!std::getline(file, line)) {
+    return false;
+  }
+
+  return true;
+}
+
+/*
+ * Parse the unsigned number at the beginning of @text.
+ * The position after the number is stored in @end if given; otherwise, the
+ * whole text must be the number.
+ */
+static bool parseUnsigned(const std::string &text,
+                          uint64_t &value,
+                          std::size_t *end = nullptr) {
+  if (text.empty() || !std::isdigit(static_cast<unsigned char>(text[0]))) {
+    return false;
+  }
+  errno = 0;
+  char *textEnd = nullptr;
+  value = std::strtoull(text.c_str(), &textEnd, 10);
+  if (errno == ERANGE) {
+    return false;
+  }
+  auto position = static_cast<std::size_t>(textEnd - text.c_str());
+  if (end != nullptr) {
+    *end = position;
+    return true;
+  }
+
+  return position == text.size();
+}
+
+/*
+ * Parse a list of CPUs like "0-3,8,10-11".
+ * A malformed list is returned empty.
+ */
+static std::vector<uint32_t> parseCPUList(const std::string &list) {
+  std::vector<uint32_t> cpus{};
+  std::istringstream stream{ list };
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    if (range.empty()) {
+      continue;
+    }
+    auto dash = range.find('-');
+    uint64_t first = 0;
+    if (!parseUnsigned(range.substr(0, dash), first)) {
+      return {};
+    }
+    auto last = first;
+    if ((dash != std::string::npos)
+        && !parseUnsigned(range.substr(dash + 1), last)) {
+      return {};
+    }
+    if ((last < first) || (last > std::numeric_limits<uint32_t>::max())) {
+      return {};
+    }
+    for (auto cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+
+  return cpus;
+}
+
+/*
+ * Parse a size like "32K".
+ */
+static bool parseSize(const std::string &size, uint64_t &bytes) {
+  std::size_t suffix = 0;
+  if (!parseUnsigned(size, bytes, &suffix)) {
+    return false;
+  }
+  if (suffix < size.size()) {
+    switch (size[suffix]) {
+      case 'K':
+        bytes *= 1024;
+        break;
+      case 'M':
+        bytes *= 1024 * 1024;
+        break;
+      case 'G':
+        bytes *= 1024 * 1024 * 1024;
+        break;
+      default:
+        return false;
+    }
+  }
+
+  return true;
+}
+
+void Architecture::readTopologyFromSysfs(Topology &topology) {
+  std::string cpuDir = "/sys/devices/system/cpu/";
+  std::string nodeDir = "/sys/devices/system/node/";
+  std::string line;
+
+  /*
+   * Fetch the logical cores.
+   */
+  if (!readFirstLine(cpuDir + "online", line)) {
+    return;
+  }
+  auto cores = parseCPUList(line);
+  if (cores.empty()) {
+    return;
+  }
+  topology.logicalCores = cores.size();
+
+  /*
+   * Fetch the physical cores.
+   * Each physical core is identified by the smallest logical core among its
+   * SMT siblings.
+   */
+  std::set<uint32_t> physicalCores{};
+  for (auto core : cores) {
+    auto siblingsFile = cpuDir + "cpu" + std::to_string(core)
+                        + "/topology/thread_siblings_list";
+    if (!readFirstLine(siblingsFile, line)) {
+      continue;
+    }
+    auto siblings = parseCPUList(line);
+    if (siblings.empty()) {
+      continue;
+    }
+    auto physicalCore = *std::min_element(siblings.begin(), siblings.end());
+    topology.physicalCoreOfCore[core] = physicalCore;
+    physicalCores.insert(physicalCore);
+  }
+  topology.physicalCores = physicalCores.size();
+
+  /*
+   * Fetch the caches of the first logical core.
+   */
+  auto cacheDir = cpuDir + "cpu" + std::to_string(cores.front()) + "/cache/";
+  for (auto index = 0;; index++) {
+    auto indexDir = cacheDir + "index" + std::to_string(index) + "/";
+    if (!readFirstLine(indexDir + "level", line)) {
+      break;
+    }
+    uint64_t level = 0;
+    if (!parseUnsigned(line, level)) {
+      continue;
+    }
+
+    /*
+     * Instruction caches are not relevant to data layout.
+     */
+    if (!readFirstLine(indexDir + "type", line) || (line == "Instruction")) {
+      continue;
+    }
+
+    /*
+     * Fetch the size and the line size.
+     * A cache whose size is unknown is left to the defaults.
+     */
+    Cache cache{ 0, 0 };
+    if (!readFirstLine(indexDir + "size", line)
+        || !parseSize(line, cache.bytes)) {
+      continue;
+    }
+    uint64_t lineBytes = 0;
+    if (readFirstLine(indexDir + "coherency_line_size", line)
+        && parseUnsigned(line, lineBytes)
+        && (lineBytes <= std::numeric_limits<uint32_t>::max())) {
+      cache.lineBytes = lineBytes;
+    }
+    topology.caches[level] = cache;
+  }
+
+  /*
+   * Fetch the NUMA nodes.
+   */
+  if (!readFirstLine(nodeDir + "online", line)) {
+    return;
+  }
+  for (auto node : parseCPUList(line)) {
+    auto thisNodeDir = nodeDir + "node" + std::to_string(node) + "/";
+
+    /*
+     * Fetch the logical cores of the node.
+     */
+    if (readFirstLine(thisNodeDir + "cpulist", line)) {
+      for (auto core : parseCPUList(line)) {
+        topology.numaNodeOfCore[core] = node;
+      }
+    }
+
+    /*
+     * Fetch the distances from the other nodes.
+     */
+    if (readFirstLine(thisNodeDir + "distance", line)) {
+      std::istringstream stream{ line };
+      uint32_t distance;
+      auto &distances = topology.numaDistances[node];
+      while (stream >> distance) {
+        distances.push_back(distance);
+      }
+    }
+  }
+
+  return;
+}
+
+void Architecture::readTopologyFromCPUID(Topology &topology) {
+#if defined(__x86_64__) || defined(__i386__)
+  uint32_t eax, ebx, ecx, edx;
+
+  /*
+   * Check if the deterministic cache parameters are available.
+   */
+  if (!topology.caches.empty()) {
+    return;
+  }
+  if (__get_cpuid_max(0, nullptr) < 4) {
+    return;
+  }
+
+  /*
+   * Fetch the caches.
+   */
+  for (uint32_t index = 0;; index++) {
+    __cpuid_count(4, index, eax, ebx, ecx, edx);
+    auto type = eax & 0x1F;
+    if (type == 0) {
+      break;
+    }
+
+    /*
+     * Instruction caches are not relevant to data layout.
+     */
+    if (type == 2) {
+      continue;
+    }
+    auto level = (eax >> 5) & 0x7;
+    uint64_t lineBytes = (ebx & 0xFFF) + 1;
+    uint64_t partitions = ((ebx >> 12) & 0x3FF) + 1;
+    uint64_t ways = ((ebx >> 22) & 0x3FF) + 1;
+    uint64_t sets = uint64_t(ecx) + 1;
+    Cache cache{ ways * partitions * lineBytes * sets, uint32_t(lineBytes) };
+    topology.caches[level] = cache;
+  }
+#endif
+
+  return;
+}
+
+bool Architecture::readTopologyFromFile(Topology &topology,
+                                        const std::string &fileName) {
+  std::ifstream file(fileName);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  /*
+   * Lines that cannot be parsed are ignored, so what they describe is left
+   * to the defaults.
+   */
+  std::string line;
+  uint64_t lineNumber = 0;
+  while (std::getline(file, line)) {
+    lineNumber++;
+    std::istringstream stream{ line };
+    std::string key;
+    if (!(stream >> key) || (key[0] == '#')) {
+      continue;
+    }
+
+    /*
+     * A list of values is well formed if it has been read up to the end of
+     * the line.
+     */
+    auto isWellFormed = true;
+    if (key == "logical_cores") {
+      uint32_t cores = 0;
+      isWellFormed = (stream >> cores) && (stream >> std::ws).eof();
+      if (isWellFormed) {
+        topology.logicalCores = cores;
+      }
+
+    } else if (key == "physical_cores") {
+      uint32_t cores = 0;
+      isWellFormed = (stream >> cores) && (stream >> std::ws).eof();
+      if (isWellFormed) {
+        topology.physicalCores = cores;
+      }
+
+    } else if (key == "cache") {
+      uint32_t level = 0;
+      Cache cache{ 0, 0 };
+      isWellFormed = (stream >> level >> cache.bytes >> cache.lineBytes)
+                     && (stream >> std::ws).eof();
+      if (isWellFormed) {
+        topology.caches[level] = cache;
+      }
+
+    } else if (key == "numa_node") {
+      uint32_t node, core;
+      std::vector<uint32_t> cores{};
+      isWellFormed = static_cast<bool>(stream >> node);
+      while (isWellFormed && (stream >> core)) {
+        cores.push_back(core);
+      }
+      isWellFormed &= stream.eof();
+      if (isWellFormed) {
+        for (auto core : cores) {
+          topology.numaNodeOfCore[core] = node;
+        }
+      }
+
+    } else if (key == "numa_distances") {
+      uint32_t node, distance;
+      std::vector<uint32_t> distances{};
+      isWellFormed = static_cast<bool>(stream >> node);
+      while (isWellFormed && (stream >> distance)) {
+        distances.push_back(distance);
+      }
+      isWellFormed &= stream.eof();
+      if (isWellFormed) {
+        topology.numaDistances[node] = distances;
+      }
+
+    } else if (key == "smt_siblings") {
+      std::vector<uint32_t> siblings{};
+      uint32_t core;
+      while (stream >> core) {
+        siblings.push_back(core);
+      }
+      isWellFormed = stream.eof() && !siblings.empty();
+      if (isWellFormed) {
+        auto physicalCore =
+            *std::min_element(siblings.begin(), siblings.end());
+        for (auto sibling : siblings) {
+          topology.physicalCoreOfCore[sibling] = physicalCore;
+        }
+      }
+
+    } else {
+      errs() << "Architecture: WARNING = the key \"" << key
+             << "\" of the file " << fileName << " is unknown\n";
+      continue;
+    }
+
+    if (!isWellFormed) {
+      errs() << "Architecture: WARNING = the line " << lineNumber
+             << " of the file " << fileName
+             << " is malformed and it is ignored\n";
+    }
+  }
+
+  /*
+   * Check that the file has been read until its end.
+   */
+  if (file.bad()) {
+    return false;
+  }
+
+  return true;
+}
+
+void Architecture::setDefaults(Topology &topology) {
+
+  /*
+   * Cores.
+   */
+  if (topology.logicalCores == 0) {
+    topology.logicalCores = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  if ((topology.physicalCores == 0) && topology.physicalCoreOfCore.empty()) {
+
+    /*
+     * Assume 2-way SMT.
+     */
+    topology.physicalCores = std::max(topology.logicalCores / 2, 1u);
+  }
+  if (topology.physicalCores == 0) {
+
+    /*
+     * Logical cores without SMT siblings are physical cores.
+     */
+    std::set<uint32_t> physicalCores{};
+    for (auto core = 0u; core < topology.logicalCores; core++) {
+      auto it = topology.physicalCoreOfCore.find(core);
+      if (it == topology.physicalCoreOfCore.end()) {
+        topology.physicalCoreOfCore[core] = core;
+      }
+      physicalCores.insert(topology.physicalCoreOfCore[core]);
+    }
+    topology.physicalCores = physicalCores.size();
+  }
+
+  /*
+   * Caches.
+   */
+  if (topology.caches.count(1) == 0) {
+    topology.caches[1] = Cache{ 32 * 1024, 64 };
+  }
+  for (auto &pair : topology.caches) {
+    if (pair.second.lineBytes == 0) {
+      pair.second.lineBytes = 64;
+    }
+  }
+
+  /*
+   * NUMA nodes.
+   */
+  if (topology.numaNodeOfCore.empty()) {
+    for (auto core = 0u; core < topology.logicalCores; core++) {
+      topology.numaNodeOfCore[core] = 0;
+    }
+  }
+  std::set<uint32_t> nodes{};
+  for (auto pair : topology.numaNodeOfCore) {
+    nodes.insert(pair.second);
+  }
+  auto numberOfNodes = *nodes.rbegin() + 1;
+  for (auto node = 0u; node < numberOfNodes; node++) {
+    auto &distances = topology.numaDistances[node];
+    if (distances.size() >= numberOfNodes) {
+      continue;
+    }
+
+    /*
+     * Use the ACPI SLIT convention: 10 for the local node, 20 otherwise.
+     */
+    distances.clear();
+    for (auto otherNode = 0u; otherNode < numberOfNodes; otherNode++) {
+      distances.push_back(otherNode == node ? 10 : 20);
+    }
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_BASIC_UTILITIES_INSTRUMENTATION_H_
+#define NOELLE_SRC_CORE_BASIC_UTILITIES_INSTRUMENTATION_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/MemoryFootprint.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Timers and counters of the phases of NOELLE.
+ *
+ * They are enabled by -noelle-instrumentation. At exit, the wall time and the
+ * number of invocations of each phase (nested within the phases that invoked
+ * it), the functions that took the most time, the memory used by the data
+ * structures of NOELLE, and the counters are printed to the standard error.
+ * -noelle-instrumentation-trace=FILE also writes the phases as a Chrome trace
+ * (chrome://tracing or https://ui.perfetto.dev).
+ */
+class Instrumentation {
+public:
+  static bool isEnabled(void);
+
+  /*
+   * Add @value to the counter @name.
+   */
+  static void count(const std::string &name, uint64_t value = 1);
+
+  static void printReport(raw_ostream &stream);
+
+  /*
+   * Print the memory that is alive and its peak for each kind of data
+   * structure (e.g., PDG, SCCDAG).
+   */
+  static void printMemoryReport(raw_ostream &stream);
+
+  static uint64_t getPeakMemoryBytes(void);
+
+  static void writeChromeTrace(const std::string &fileName);
+};
+
+/*
+ * Time the scope where the object lives as the phase @name.
+ * If @function is given, the time is also attributed to it.
+ * Phases that are invoked very often (e.g., a single alias query) should
+ * not emit an event in the trace.
+ */
+class ScopedTimer {
+public:
+  ScopedTimer(const char *name,
+              const Function *function = nullptr,
+              bool emitTraceEvent = true);
+
+  ScopedTimer(const ScopedTimer &) = delete;
+
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+  ~ScopedTimer();
+
+private:
+  bool active;
+  const char *name;
+  const Function *function;
+  bool emitTraceEvent;
+  uint64_t startNanoseconds;
+};
+
+/*
+ * Memory used by a data structure, accounted while the structure is alive.
+ * The memory added by an update is also attributed to the phases that are
+ * running.
+ */
+class MemoryAccount {
+public:
+  MemoryAccount();
+
+  /*
+   * A copy of a data structure is accounted on its own.
+   */
+  MemoryAccount(const MemoryAccount &other);
+
+  MemoryAccount &operator=(const MemoryAccount &other);
+
+  /*
+   * Replace what was accounted with @footprint of a structure of kind
+   * @category.
+   */
+  void update(const char *category, const MemoryFootprint &footprint);
+
+  ~MemoryAccount();
+
+private:
+  const char *category;
+  MemoryFootprint accounted;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_BASIC_UTILITIES_INSTRUMENTATION_H_
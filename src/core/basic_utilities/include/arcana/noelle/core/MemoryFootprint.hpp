@@ -0,0 +1,72 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_BASIC_UTILITIES_MEMORYFOOTPRINT_H_
+#define NOELLE_SRC_CORE_BASIC_UTILITIES_MEMORYFOOTPRINT_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Number of objects and estimated bytes used by a data structure of NOELLE.
+ *
+ * Bytes include the objects and the entries of the standard containers that
+ * store them (the allocator overhead is not included).
+ */
+class MemoryFootprint {
+public:
+  uint64_t nodes = 0;
+  uint64_t edges = 0;
+  uint64_t subEdges = 0;
+  uint64_t setElements = 0;
+  uint64_t bytes = 0;
+
+  MemoryFootprint &operator+=(const MemoryFootprint &other) {
+    this->nodes += other.nodes;
+    this->edges += other.edges;
+    this->subEdges += other.subEdges;
+    this->setElements += other.setElements;
+    this->bytes += other.bytes;
+    return *this;
+  }
+
+  /*
+   * Bytes of @n entries of a std::set or std::map whose elements take
+   * @elementBytes bytes (red-black tree node: three pointers and the color).
+   */
+  static uint64_t treeEntriesBytes(uint64_t n, uint64_t elementBytes) {
+    return n * (4 * sizeof(void *) + elementBytes);
+  }
+
+  /*
+   * Bytes of @n entries of a std::unordered_set or std::unordered_map whose
+   * elements take @elementBytes bytes (node with the next pointer and a
+   * bucket).
+   */
+  static uint64_t hashEntriesBytes(uint64_t n, uint64_t elementBytes) {
+    return n * (2 * sizeof(void *) + elementBytes);
+  }
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_BASIC_UTILITIES_MEMORYFOOTPRINT_H_
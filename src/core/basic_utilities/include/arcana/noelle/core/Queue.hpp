@@ -33,6 +33,17 @@ public:
   std::vector<Function *> queuePushes;
   std::vector<Function *> queuePops;
   std::vector<Type *> queueTypes;
+
+  /*
+   * APIs to create and destroy a queue, and to push and pop several elements
+   * at once.
+   * They are set only by runtimes that provide them (e.g., the one declared
+   * by Noelle::declareQueueRuntime).
+   */
+  Function *queueCreate = nullptr;
+  Function *queueDestroy = nullptr;
+  Function *queuePushBatch = nullptr;
+  Function *queuePopBatch = nullptr;
 };
 
 } // namespace llvm
@@ -0,0 +1,492 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <unistd.h>
+
+#include "arcana/noelle/core/Instrumentation.hpp"
+
+namespace arcana::noelle {
+
+static cl::opt<bool> EnableInstrumentation(
+    "noelle-instrumentation",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Print the time of the phases of NOELLE and its counters"));
+
+static cl::opt<std::string> InstrumentationTraceFile(
+    "noelle-instrumentation-trace",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Write the phases of NOELLE to a file as a Chrome trace"));
+
+static cl::opt<uint32_t> InstrumentationOutliers(
+    "noelle-instrumentation-outliers",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::init(5),
+    cl::desc("Number of functions to report as outliers for each phase"));
+
+namespace {
+
+const uint64_t maximumNumberOfTraceEvents = 1000000;
+
+struct PhaseStatistics {
+  uint64_t invocations = 0;
+  uint64_t totalNanoseconds = 0;
+  uint64_t selfNanoseconds = 0;
+  uint64_t accountedBytes = 0;
+  std::map<std::string, uint64_t> nanosecondsPerFunction;
+};
+
+struct TraceEvent {
+  const char *name;
+  std::string function;
+  uint64_t startNanoseconds;
+  uint64_t durationNanoseconds;
+  uint32_t threadID;
+};
+
+struct MemoryStatistics {
+  MemoryFootprint live;
+  uint64_t liveStructures = 0;
+  uint64_t peakBytes = 0;
+};
+
+/*
+ * Timers that are currently running in the thread (innermost last) with the
+ * time spent by their nested timers and the memory accounted while they run.
+ */
+struct ActiveTimer {
+  std::string name;
+  uint64_t nestedNanoseconds;
+  uint64_t accountedBytes;
+};
+thread_local std::vector<ActiveTimer> activeTimers;
+
+uint64_t now(void) {
+  auto t = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+}
+
+bool registryIsDestroyed = false;
+
+class Registry {
+public:
+  std::mutex lock;
+  uint64_t epoch;
+  std::map<std::vector<std::string>, PhaseStatistics> phases;
+  std::map<std::string, uint64_t> counters;
+  std::map<std::string, MemoryStatistics> memory;
+  uint64_t liveBytes;
+  uint64_t peakBytes;
+  std::vector<TraceEvent> events;
+  uint64_t droppedEvents;
+  std::map<std::thread::id, uint32_t> threadIDs;
+
+  Registry()
+    : epoch{ now() },
+      liveBytes{ 0 },
+      peakBytes{ 0 },
+      droppedEvents{ 0 } {
+    return;
+  }
+
+  uint32_t getThreadID(void) {
+    auto id = std::this_thread::get_id();
+    auto it = this->threadIDs.find(id);
+    if (it != this->threadIDs.end()) {
+      return it->second;
+    }
+    auto newID = static_cast<uint32_t>(this->threadIDs.size());
+    this->threadIDs[id] = newID;
+    return newID;
+  }
+
+  /*
+   * The report is generated when the compiler exits.
+   */
+  ~Registry() {
+    registryIsDestroyed = true;
+    if (!Instrumentation::isEnabled()) {
+      return;
+    }
+    if (EnableInstrumentation) {
+      raw_fd_ostream stream(STDERR_FILENO, false);
+      Instrumentation::printReport(stream);
+    }
+    if (InstrumentationTraceFile.getNumOccurrences() > 0) {
+      Instrumentation::writeChromeTrace(InstrumentationTraceFile);
+    }
+    return;
+  }
+};
+
+Registry &getRegistry(void) {
+  static Registry registry;
+  return registry;
+}
+
+void printMemory(Registry &registry, raw_ostream &stream) {
+  stream << "NOELLE: Instrumentation:   Memory (peak KB, live KB, live "
+            "structures, nodes, edges, sub-edges, set elements)\n";
+  for (auto &pair : registry.memory) {
+    auto &stats = pair.second;
+    stream << "NOELLE: Instrumentation:     " << pair.first << ": ";
+    stream << format("%.1f", stats.peakBytes / 1024.0) << ", ";
+    stream << format("%.1f", stats.live.bytes / 1024.0) << ", ";
+    stream << stats.liveStructures << ", " << stats.live.nodes << ", "
+           << stats.live.edges << ", " << stats.live.subEdges << ", "
+           << stats.live.setElements << "\n";
+  }
+  stream << "NOELLE: Instrumentation:     Peak of all structures: ";
+  stream << format("%.1f", registry.peakBytes / 1024.0) << " KB\n";
+
+  return;
+}
+
+void subtract(MemoryFootprint &footprint, const MemoryFootprint &other) {
+  footprint.nodes -= other.nodes;
+  footprint.edges -= other.edges;
+  footprint.subEdges -= other.subEdges;
+  footprint.setElements -= other.setElements;
+  footprint.bytes -= other.bytes;
+
+  return;
+}
+
+std::string escapeJSON(const std::string &s) {
+  std::string escaped;
+  for (auto c : s) {
+    switch (c) {
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\\':
+        escaped += "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          escaped += ' ';
+        } else {
+          escaped += c;
+        }
+    }
+  }
+  return escaped;
+}
+
+} // namespace
+
+bool Instrumentation::isEnabled(void) {
+  return EnableInstrumentation
+         || (InstrumentationTraceFile.getNumOccurrences() > 0);
+}
+
+void Instrumentation::count(const std::string &name, uint64_t value) {
+  if (!Instrumentation::isEnabled()) {
+    return;
+  }
+  auto &registry = getRegistry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+  registry.counters[name] += value;
+
+  return;
+}
+
+void Instrumentation::printReport(raw_ostream &stream) {
+  auto &registry = getRegistry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+
+  stream << "NOELLE: Instrumentation\n";
+
+  /*
+   * Print the phases.
+   * Sorting the paths of the phases lists every phase right after the one
+   * that invoked it.
+   */
+  stream << "NOELLE: Instrumentation:   Phases (calls, total ms, self ms, "
+            "accounted KB)\n";
+  for (auto &pair : registry.phases) {
+    auto &path = pair.first;
+    auto &stats = pair.second;
+    stream << "NOELLE: Instrumentation:     ";
+    stream.indent(2 * (path.size() - 1));
+    stream << path.back() << ": " << stats.invocations << ", ";
+    stream << format("%.3f", stats.totalNanoseconds / 1e6) << ", ";
+    stream << format("%.3f", stats.selfNanoseconds / 1e6) << ", ";
+    stream << format("%.1f", stats.accountedBytes / 1024.0) << "\n";
+  }
+
+  /*
+   * Print the functions that took the most time for each phase.
+   */
+  if (InstrumentationOutliers > 0) {
+    stream << "NOELLE: Instrumentation:   Outliers (ms)\n";
+    std::map<std::string, std::map<std::string, uint64_t>> timePerPhase;
+    for (auto &pair : registry.phases) {
+      auto &times = timePerPhase[pair.first.back()];
+      for (auto &functionTime : pair.second.nanosecondsPerFunction) {
+        times[functionTime.first] += functionTime.second;
+      }
+    }
+    for (auto &pair : timePerPhase) {
+      if (pair.second.empty()) {
+        continue;
+      }
+      std::vector<std::pair<std::string, uint64_t>> sorted(pair.second.begin(),
+                                                           pair.second.end());
+      std::sort(sorted.begin(), sorted.end(), [](auto &a, auto &b) {
+        return a.second > b.second;
+      });
+      stream << "NOELLE: Instrumentation:     " << pair.first << "\n";
+      auto n = std::min<size_t>(sorted.size(), InstrumentationOutliers);
+      for (auto i = 0u; i < n; i++) {
+        stream << "NOELLE: Instrumentation:       " << sorted[i].first << ": ";
+        stream << format("%.3f", sorted[i].second / 1e6) << "\n";
+      }
+    }
+  }
+
+  /*
+   * Print the memory.
+   */
+  printMemory(registry, stream);
+
+  /*
+   * Print the counters.
+   */
+  stream << "NOELLE: Instrumentation:   Counters\n";
+  for (auto &pair : registry.counters) {
+    stream << "NOELLE: Instrumentation:     " << pair.first << ": "
+           << pair.second << "\n";
+  }
+
+  return;
+}
+
+void Instrumentation::printMemoryReport(raw_ostream &stream) {
+  auto &registry = getRegistry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+  printMemory(registry, stream);
+
+  return;
+}
+
+uint64_t Instrumentation::getPeakMemoryBytes(void) {
+  auto &registry = getRegistry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+
+  return registry.peakBytes;
+}
+
+void Instrumentation::writeChromeTrace(const std::string &fileName) {
+  auto &registry = getRegistry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+
+  std::ofstream file(fileName);
+  if (!file.good()) {
+    errs() << "Instrumentation: ERROR = cannot write " << fileName << "\n";
+    return;
+  }
+
+  /*
+   * Phases are complete events ("X") whose timestamps are in microseconds.
+   */
+  file << "{\"traceEvents\":[";
+  auto first = true;
+  for (auto &event : registry.events) {
+    if (!first) {
+      file << ",";
+    }
+    first = false;
+    file << "\n{\"name\":\"" << escapeJSON(event.name)
+         << "\",\"cat\":\"noelle\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+         << event.threadID << ",\"ts\":" << (event.startNanoseconds / 1000.0)
+         << ",\"dur\":" << (event.durationNanoseconds / 1000.0);
+    if (!event.function.empty()) {
+      file << ",\"args\":{\"function\":\"" << escapeJSON(event.function)
+           << "\"}";
+    }
+    file << "}";
+  }
+  file << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{";
+
+  /*
+   * Counters are attached to the trace as metadata.
+   */
+  file << "\"droppedEvents\":\"" << registry.droppedEvents << "\"";
+  file << ",\"peakBytes\":\"" << registry.peakBytes << "\"";
+  for (auto &pair : registry.counters) {
+    file << ",\"" << escapeJSON(pair.first) << "\":\"" << pair.second << "\"";
+  }
+  file << "}}\n";
+
+  return;
+}
+
+ScopedTimer::ScopedTimer(const char *name,
+                         const Function *function,
+                         bool emitTraceEvent)
+  : active{ Instrumentation::isEnabled() },
+    name{ name },
+    function{ function },
+    emitTraceEvent{ emitTraceEvent },
+    startNanoseconds{ 0 } {
+  if (!this->active) {
+    return;
+  }
+
+  /*
+   * Make sure the registry is created before the first timer starts.
+   */
+  getRegistry();
+
+  activeTimers.push_back({ name, 0, 0 });
+  this->startNanoseconds = now();
+
+  return;
+}
+
+ScopedTimer::~ScopedTimer() {
+  if (!this->active) {
+    return;
+  }
+  auto elapsed = now() - this->startNanoseconds;
+
+  /*
+   * Compute the path of the phase and remove the timer from the stack.
+   */
+  std::vector<std::string> path;
+  for (auto &timer : activeTimers) {
+    path.push_back(timer.name);
+  }
+  auto nested = activeTimers.back().nestedNanoseconds;
+  auto accountedBytes = activeTimers.back().accountedBytes;
+  activeTimers.pop_back();
+  if (!activeTimers.empty()) {
+    activeTimers.back().nestedNanoseconds += elapsed;
+    activeTimers.back().accountedBytes += accountedBytes;
+  }
+
+  /*
+   * Record the phase.
+   */
+  auto &registry = getRegistry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+  auto &stats = registry.phases[path];
+  stats.invocations++;
+  stats.totalNanoseconds += elapsed;
+  stats.selfNanoseconds += (nested < elapsed) ? (elapsed - nested) : 0;
+  stats.accountedBytes += accountedBytes;
+  std::string functionName;
+  if (this->function != nullptr) {
+    functionName = this->function->getName().str();
+    stats.nanosecondsPerFunction[functionName] += elapsed;
+  }
+  if (!this->emitTraceEvent) {
+    return;
+  }
+  if (registry.events.size() >= maximumNumberOfTraceEvents) {
+    registry.droppedEvents++;
+    return;
+  }
+  registry.events.push_back({ this->name,
+                              functionName,
+                              this->startNanoseconds - registry.epoch,
+                              elapsed,
+                              registry.getThreadID() });
+
+  return;
+}
+
+MemoryAccount::MemoryAccount() : category{ nullptr } {
+  return;
+}
+
+MemoryAccount::MemoryAccount(const MemoryAccount &other)
+  : category{ nullptr } {
+  return;
+}
+
+MemoryAccount &MemoryAccount::operator=(const MemoryAccount &other) {
+  return *this;
+}
+
+void MemoryAccount::update(const char *category,
+                           const MemoryFootprint &footprint) {
+  if (!Instrumentation::isEnabled()) {
+    return;
+  }
+  auto &registry = getRegistry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+
+  /*
+   * Remove what was accounted before.
+   */
+  if (this->category != nullptr) {
+    auto &old = registry.memory[this->category];
+    subtract(old.live, this->accounted);
+    old.liveStructures--;
+    registry.liveBytes -= this->accounted.bytes;
+  }
+
+  /*
+   * Account the new footprint.
+   */
+  auto &stats = registry.memory[category];
+  stats.live += footprint;
+  stats.liveStructures++;
+  stats.peakBytes = std::max(stats.peakBytes, stats.live.bytes);
+  registry.liveBytes += footprint.bytes;
+  registry.peakBytes = std::max(registry.peakBytes, registry.liveBytes);
+
+  /*
+   * Attribute the new memory to the innermost phase that is running.
+   */
+  if ((!activeTimers.empty()) && (footprint.bytes > this->accounted.bytes)) {
+    activeTimers.back().accountedBytes +=
+        footprint.bytes - this->accounted.bytes;
+  }
+
+  this->category = category;
+  this->accounted = footprint;
+
+  return;
+}
+
+MemoryAccount::~MemoryAccount() {
+  if ((this->category == nullptr) || registryIsDestroyed) {
+    return;
+  }
+  auto &registry = getRegistry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+  auto &stats = registry.memory[this->category];
+  subtract(stats.live, this->accounted);
+  stats.liveStructures--;
+  registry.liveBytes -= this->accounted.bytes;
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -32,7 +32,9 @@ public:
                             uint32_t maxCores,
                             bool arePRVGsNonDeterministic,
                             bool areFloatRealNumbers,
-                            bool hoistLoopsToMain);
+                            bool hoistLoopsToMain,
+                            uint32_t analysisThreads = 1,
+                            uint64_t queueCost = 60);
 
   uint32_t getMaximumNumberOfCores(void) const;
 
@@ -42,12 +44,26 @@ public:
 
   bool shouldLoopsBeHoistToMain(void) const;
 
+  /*
+   * Number of threads that analyses can use to compute their results
+   * concurrently (e.g., the classification of the SCCs of a loop).
+   */
+  uint32_t getNumberOfAnalysisThreads(void) const;
+
+  /*
+   * Number of dynamic instructions that a core spends to send a value to
+   * another core through a queue (e.g., between two stages of a pipeline).
+   */
+  uint64_t getQueueCost(void) const;
+
 private:
   Module &program;
   uint32_t _maxCores;
   bool _arePRVGsNonDeterministic;
   bool _areFloatRealNumbers;
   bool _hoistLoopsToMain;
+  uint32_t _analysisThreads;
+  uint64_t _queueCost;
 };
 
 } // namespace arcana::noelle
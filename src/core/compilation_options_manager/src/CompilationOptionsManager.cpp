@@ -28,12 +28,16 @@ CompilationOptionsManager::CompilationOptionsManager(
     uint32_t maxCores,
     bool arePRVGsNonDeterministic,
     bool areFloatRealNumbers,
-    bool hoistLoopsToMain)
+    bool hoistLoopsToMain,
+    uint32_t analysisThreads,
+    uint64_t queueCost)
   : program{ m },
     _maxCores{ maxCores },
     _arePRVGsNonDeterministic{ arePRVGsNonDeterministic },
     _areFloatRealNumbers{ areFloatRealNumbers },
-    _hoistLoopsToMain{ hoistLoopsToMain } {
+    _hoistLoopsToMain{ hoistLoopsToMain },
+    _analysisThreads{ analysisThreads },
+    _queueCost{ queueCost } {
   return;
 }
 
@@ -53,4 +57,12 @@ bool CompilationOptionsManager::shouldLoopsBeHoistToMain(void) const {
   return this->_hoistLoopsToMain;
 }
 
+uint32_t CompilationOptionsManager::getNumberOfAnalysisThreads(void) const {
+  return this->_analysisThreads;
+}
+
+uint64_t CompilationOptionsManager::getQueueCost(void) const {
+  return this->_queueCost;
+}
+
 } // namespace arcana::noelle
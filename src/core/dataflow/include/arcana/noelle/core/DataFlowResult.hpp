@@ -23,6 +23,7 @@
 #define NOELLE_SRC_CORE_DATAFLOW_DATAFLOWRESULT_H_
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
 
 namespace arcana::noelle {
 
@@ -38,11 +39,22 @@ public:
   std::set<Value *> &IN(Instruction *inst);
   std::set<Value *> &OUT(Instruction *inst);
 
+  /*
+   * Memory used by the GEN, KILL, IN, and OUT sets.
+   */
+  MemoryFootprint getMemoryFootprint(void) const;
+
+  /*
+   * Account the current footprint of the sets (see Instrumentation).
+   */
+  void updateMemoryAccount(void);
+
 private:
   std::map<Instruction *, std::set<Value *>> gens;
   std::map<Instruction *, std::set<Value *>> kills;
   std::map<Instruction *, std::set<Value *>> ins;
   std::map<Instruction *, std::set<Value *>> outs;
+  MemoryAccount memoryAccount;
 };
 
 } // namespace arcana::noelle
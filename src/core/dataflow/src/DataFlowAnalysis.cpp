@@ -38,6 +38,7 @@ DataFlowResult *DataFlowAnalysis::getFullSets(Function *f) {
       outSetOfInst.insert(&inst2);
     }
   }
+  df->updateMemoryAccount();
 
   return df;
 }
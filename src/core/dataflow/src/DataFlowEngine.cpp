@@ -20,6 +20,7 @@
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "arcana/noelle/core/DataFlowEngine.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
 
 namespace arcana::noelle {
 
@@ -301,6 +302,7 @@ DataFlowResult *DataFlowEngine::applyGeneralizedForwardAnalysis(
         getOutSetOfInst,
     std::function<BasicBlock::iterator(BasicBlock *)> getEndIterator,
     std::function<void(BasicBlock::iterator &)> incrementIterator) {
+  ScopedTimer timer("DataFlowEngine::applyGeneralizedForwardAnalysis", f);
 
   /*
    * Initialize IN and OUT sets.
@@ -334,8 +336,10 @@ DataFlowResult *DataFlowEngine::applyGeneralizedForwardAnalysis(
    * Compute the INs and OUTs iteratively until the working list is empty.
    */
   std::unordered_set<BasicBlock *> computedOnce;
+  uint64_t visitedBasicBlocks = 0;
 
   while (!workingList.empty()) {
+    visitedBasicBlocks++;
 
     /*
      * Fetch a basic block that needs to be processed.
@@ -432,6 +436,9 @@ DataFlowResult *DataFlowEngine::applyGeneralizedForwardAnalysis(
       }
     }
   }
+  Instrumentation::count("DataFlowEngine: basic blocks visited",
+                         visitedBasicBlocks);
+  df->updateMemoryAccount();
 
   return df;
 }
@@ -51,4 +51,32 @@ std::set<Value *> &DataFlowResult::OUT(Instruction *inst) {
   return s;
 }
 
+MemoryFootprint DataFlowResult::getMemoryFootprint(void) const {
+  MemoryFootprint footprint;
+  auto pointerBytes = sizeof(void *);
+
+  for (auto sets : { &this->gens, &this->kills, &this->ins, &this->outs }) {
+    footprint.bytes += MemoryFootprint::treeEntriesBytes(
+        sets->size(),
+        pointerBytes + sizeof(std::set<Value *>));
+    for (auto &pair : *sets) {
+      auto elements = pair.second.size();
+      footprint.setElements += elements;
+      footprint.bytes +=
+          MemoryFootprint::treeEntriesBytes(elements, pointerBytes);
+    }
+  }
+
+  return footprint;
+}
+
+void DataFlowResult::updateMemoryAccount(void) {
+  if (!Instrumentation::isEnabled()) {
+    return;
+  }
+  this->memoryAccount.update("DataFlowResult", this->getMemoryFootprint());
+
+  return;
+}
+
 } // namespace arcana::noelle
@@ -23,6 +23,7 @@
 #define NOELLE_SRC_CORE_DG_DGBASE_H_
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
 #include "arcana/noelle/core/DGNode.hpp"
 #include "arcana/noelle/core/DGEdge.hpp"
 #include "arcana/noelle/core/DataDependence.hpp"
@@ -126,6 +127,17 @@ public:
   uint64_t numExternalNodes(void) const;
   uint64_t numEdges(void) const;
 
+  /*
+   * Memory used by the nodes and the edges of the graph.
+   */
+  MemoryFootprint getMemoryFootprint(void) const;
+
+  /*
+   * Account the current footprint of the graph as a structure of kind
+   * @category (see Instrumentation).
+   */
+  void updateMemoryAccount(const char *category);
+
   /*
    * Iterator ranges
    */
@@ -205,6 +217,7 @@ protected:
   std::map<T *, DGNode<T> *> internalNodeMap;
   std::map<T *, DGNode<T> *> externalNodeMap;
   std::shared_ptr<DepIdReverseMap_t> depLookupMap;
+  MemoryAccount memoryAccount;
 };
 
 /*
@@ -700,6 +713,57 @@ uint64_t DG<T>::numEdges(void) const {
   return allEdges.size();
 }
 
+template <class T>
+MemoryFootprint DG<T>::getMemoryFootprint(void) const {
+  MemoryFootprint footprint;
+  auto pointerBytes = sizeof(void *);
+
+  /*
+   * Nodes: the objects, the sets of their edges, and the maps of the graph.
+   */
+  footprint.nodes = this->allNodes.size();
+  for (auto node : this->allNodes) {
+    footprint.bytes += sizeof(DGNode<T>);
+    footprint.bytes +=
+        MemoryFootprint::hashEntriesBytes(node->degree(), pointerBytes);
+  }
+  footprint.bytes +=
+      MemoryFootprint::treeEntriesBytes(this->allNodes.size(), pointerBytes);
+  footprint.bytes += MemoryFootprint::treeEntriesBytes(
+      this->internalNodeMap.size() + this->externalNodeMap.size(),
+      2 * pointerBytes);
+
+  /*
+   * Edges: the objects, their sub-edges, and the set of the graph.
+   */
+  footprint.edges = this->allEdges.size();
+  for (auto edge : this->allEdges) {
+    footprint.bytes += sizeof(DataDependence<T, T>);
+    auto subEdges = edge->getNumberOfSubEdges();
+    if (subEdges == 0) {
+      continue;
+    }
+    footprint.subEdges += subEdges;
+    footprint.bytes += sizeof(std::unordered_set<void *>);
+    footprint.bytes +=
+        MemoryFootprint::hashEntriesBytes(subEdges, pointerBytes);
+  }
+  footprint.bytes +=
+      MemoryFootprint::treeEntriesBytes(this->allEdges.size(), pointerBytes);
+
+  return footprint;
+}
+
+template <class T>
+void DG<T>::updateMemoryAccount(const char *category) {
+  if (!Instrumentation::isEnabled()) {
+    return;
+  }
+  this->memoryAccount.update(category, this->getMemoryFootprint());
+
+  return;
+}
+
 } // namespace arcana::noelle
 
 #endif // NOELLE_SRC_CORE_DG_DGBASE_H_
@@ -24,7 +24,9 @@
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/LoopStructure.hpp"
+#include "arcana/noelle/core/LoopForest.hpp"
 #include "arcana/noelle/core/SCC.hpp"
+#include "arcana/noelle/core/LoopProfile.hpp"
 
 namespace arcana::noelle {
 
@@ -125,6 +127,55 @@ public:
 
   double getAverageTotalInstructionsPerIteration(LoopStructure *loop) const;
 
+  /*
+   * Compute the static and total instructions of all loops of @forest
+   * bottom-up (i.e., the counters of a loop are computed from the ones of its
+   * sub-loops).
+   * Loop counters are memoized, so this makes the loop queries above (and
+   * sorting or filtering loops by hotness) constant time.
+   */
+  void computeLoopAggregates(LoopForest *forest);
+
+  /*
+   * =========================== Loops (runtime loop profiler) ===============
+   *
+   * The next APIs rely on the profile generated by noelle-prof-loops and
+   * embedded by noelle-meta-loop-prof-embed.
+   */
+
+  /*
+   * Return true if the runtime profile of @loop is available.
+   */
+  bool isLoopProfileAvailable(LoopStructure *loop) const;
+
+  /*
+   * Return the runtime profile of @loop.
+   * Return nullptr if the profile is not available.
+   */
+  const LoopProfile *getLoopProfile(LoopStructure *loop) const;
+
+  /*
+   * Return the number of invocations of @loop grouped by trip count.
+   * Each key is the smallest trip count of a power-of-two bucket.
+   */
+  std::map<uint64_t, uint64_t> getTripCountHistogram(LoopStructure *loop) const;
+
+  uint64_t getMinimumIterationsPerInvocation(LoopStructure *loop) const;
+
+  uint64_t getMaximumIterationsPerInvocation(LoopStructure *loop) const;
+
+  double getIterationsPerInvocationVariance(LoopStructure *loop) const;
+
+  /*
+   * Return the total number of cycles spent in @loop among all its
+   * invocations.
+   */
+  uint64_t getCycles(LoopStructure *loop) const;
+
+  double getAverageCyclesPerInvocation(LoopStructure *loop) const;
+
+  double getCyclesPerInvocationVariance(LoopStructure *loop) const;
+
   /*
    * =========================== Functions ==================================
    */
@@ -145,6 +196,64 @@ public:
 
   double getDynamicTotalInstructionCoverage(Function *f) const;
 
+  /*
+   * =========================== Inputs ======================================
+   *
+   * The next APIs rely on the profiles of multiple runs embedded by
+   * noelle-meta-prof-embed-multi.
+   * When these profiles are available, the dynamic coverage of loops and
+   * functions is the weighted average of their coverage on each input. Hence,
+   * every input contributes to the hotness of the code according to its
+   * weight rather than to the length of its run.
+   */
+
+  /*
+   * Return the number of inputs the profile has been generated with.
+   * Return 0 if the profiles of the single inputs are not available.
+   */
+  uint32_t getNumberOfInputs(void) const;
+
+  const std::string &getInputName(uint32_t inputID) const;
+
+  /*
+   * Return the weight of the input @inputID normalized over all inputs.
+   *
+   * @return Between 0 and 1
+   */
+  double getInputWeight(uint32_t inputID) const;
+
+  /*
+   * Return the profile of the run that used the input @inputID.
+   */
+  const Hot *getInputProfile(uint32_t inputID) const;
+
+  double getDynamicTotalInstructionCoverage(LoopStructure *loop,
+                                            uint32_t inputID) const;
+
+  double getDynamicTotalInstructionCoverage(Function *f,
+                                            uint32_t inputID) const;
+
+  /*
+   * Return the weighted variance of the coverage of @loop across inputs.
+   * Inputs whose profile is not available are ignored, and the weights of
+   * the others are normalized, as for the weighted average.
+   */
+  double getDynamicTotalInstructionCoverageVariance(LoopStructure *loop) const;
+
+  double getDynamicTotalInstructionCoverageVariance(Function *f) const;
+
+  /*
+   * Return the inputs where the coverage of @loop is at least
+   * @minimumHotness.
+   * For example, a loop that is hot on only one input can be identified by
+   * checking whether the returned set includes a single input.
+   */
+  std::set<uint32_t> getInputsWhereHot(LoopStructure *loop,
+                                       double minimumHotness) const;
+
+  std::set<uint32_t> getInputsWhereHot(Function *f,
+                                       double minimumHotness) const;
+
   /*
    * =========================== Module ======================================
    */
@@ -162,7 +271,26 @@ public:
    */
   double getBranchFrequency(BasicBlock *sourceBB, BasicBlock *targetBB) const;
 
+  /*
+   * Forget the memoized counters of basic blocks, loops, SCCs, and functions.
+   * This must be invoked after modifying the code these counters have been
+   * computed for. LoopTransformer does it after its transformations; any
+   * other code that modifies the IR while holding these profiles must do it
+   * too.
+   */
+  void invalidateAggregates(void);
+
 private:
+  struct LoopAggregates {
+    uint64_t staticInstructions;
+    uint64_t totalInstructions;
+  };
+
+  struct SCCAggregates {
+    uint64_t selfInstructions;
+    uint64_t totalInstructions;
+  };
+
   std::unordered_map<BasicBlock *, std::unordered_map<BasicBlock *, double>>
       branchProbability;
   std::unordered_map<BasicBlock *, uint64_t> bbInvocations;
@@ -170,7 +298,15 @@ private:
   std::unordered_map<Function *, uint64_t> functionSelfInstructions;
   std::unordered_map<Function *, uint64_t> functionTotalInstructions;
   std::unordered_map<Instruction *, uint64_t> instructionTotalInstructions;
+  std::unordered_map<BasicBlock *, LoopProfile> loopProfiles;
+  std::unordered_map<BasicBlock *, uint64_t> bbTotalInstructions;
+  mutable std::unordered_map<BasicBlock *, LoopAggregates> loopAggregates;
+  mutable std::unordered_map<uint64_t, SCCAggregates> sccAggregates;
+  mutable std::unordered_map<Function *, uint64_t> functionStaticInstructions;
   uint64_t moduleNumberOfInstructionsExecuted;
+  std::vector<std::string> inputNames;
+  std::vector<double> inputWeights;
+  std::vector<std::unique_ptr<Hot>> inputProfiles;
 
   void computeTotalInstructions(Module &M);
 
@@ -188,8 +324,22 @@ private:
                           BasicBlock *dst,
                           double branchFrequency);
 
+  void setLoopProfile(BasicBlock *header, const LoopProfile &profile);
+
+  const LoopAggregates &getLoopAggregates(LoopStructure *loop) const;
+
+  void addToLoopAggregates(BasicBlock *bb, LoopAggregates &aggregates) const;
+
+  const SCCAggregates &getSCCAggregates(SCC *scc) const;
+
   void computeProgramInvocations(Module &M);
 
+  double getWeightedAverageOverInputs(
+      std::function<double(const Hot *inputProfile)> getMetric) const;
+
+  double getWeightedVarianceOverInputs(
+      std::function<double(const Hot *inputProfile)> getMetric) const;
+
   friend class HotProfiler;
 };
 
@@ -43,10 +43,31 @@ public:
 
   Hot &getHot(void);
 
+  /*
+   * Key of the metadata that stores the runtime profile of a loop.
+   */
+  static const std::string loopProfileMetadataKey;
+
+  /*
+   * Key of the module metadata that lists the inputs (weight and name) whose
+   * profiles have been recorded by InputProfileRecorder.
+   */
+  static const std::string inputsMetadataKey;
+
+  /*
+   * Key of the metadata that stores the counters of a basic block for each
+   * input recorded (in the same order of the inputs).
+   */
+  static const std::string inputCountersMetadataKey;
+
 private:
   Hot hot;
 
   void analyzeProfiles(Module &M);
+
+  void analyzeLoopProfiles(Module &M);
+
+  void analyzeInputProfiles(Module &M);
 };
 
 } // namespace arcana::noelle
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_HOTPROFILER_LOOPPROFILE_H_
+#define NOELLE_SRC_CORE_HOTPROFILER_LOOPPROFILE_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Per-loop runtime profile collected by the NOELLE loop profiler
+ * (noelle-prof-loops) and embedded as metadata by noelle-meta-loop-prof-embed.
+ *
+ * Iterations are the number of executions of the loop header.
+ * Cycles are the time-stamp-counter ticks spent within an invocation of the
+ * loop (including its sub-loops and callees).
+ */
+class LoopProfile {
+public:
+  LoopProfile();
+
+  /*
+   * Parse a profile from its textual representation.
+   * Return an empty optional if @profileAsString is malformed.
+   */
+  static std::optional<LoopProfile> fromString(
+      const std::string &profileAsString);
+
+  std::string toString(void) const;
+
+  uint64_t getLoopID(void) const;
+
+  uint64_t getInvocations(void) const;
+
+  uint64_t getIterations(void) const;
+
+  uint64_t getMinimumIterationsPerInvocation(void) const;
+
+  uint64_t getMaximumIterationsPerInvocation(void) const;
+
+  double getAverageIterationsPerInvocation(void) const;
+
+  double getIterationsPerInvocationVariance(void) const;
+
+  uint64_t getCycles(void) const;
+
+  double getAverageCyclesPerInvocation(void) const;
+
+  double getCyclesPerInvocationVariance(void) const;
+
+  /*
+   * Return the trip-count histogram.
+   * Each key is the smallest trip count of a power-of-two bucket (0, 1, 2, 4,
+   * 8, ...) and each value is the number of invocations that fall within it.
+   */
+  std::map<uint64_t, uint64_t> getTripCountHistogram(void) const;
+
+  static uint32_t getBucketOfTripCount(uint64_t tripCount);
+
+  static uint64_t getSmallestTripCountOfBucket(uint32_t bucket);
+
+private:
+  uint64_t loopID;
+  uint64_t invocations;
+  uint64_t iterations;
+  uint64_t minIterations;
+  uint64_t maxIterations;
+  double iterationsSquaredSum;
+  uint64_t cycles;
+  double cyclesSquaredSum;
+  std::map<uint32_t, uint64_t> buckets;
+
+  static double computeVariance(double sum, double squaredSum, uint64_t n);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_HOTPROFILER_LOOPPROFILE_H_
@@ -85,6 +85,36 @@ void Hot::computeProgramInvocations(Module &M) {
    */
   this->computeTotalInstructions(M);
 
+  /*
+   * Compute the total instructions of each basic block once.
+   * This is what loop and function counters are aggregated from.
+   */
+  for (auto pairs : this->bbInvocations) {
+    auto bb = pairs.first;
+    uint64_t t = 0;
+    for (auto &inst : *bb) {
+      t += this->getTotalInstructions(&inst);
+    }
+    this->bbTotalInstructions[bb] = t;
+  }
+
+  return;
+}
+
+void Hot::invalidateAggregates(void) {
+
+  /*
+   * The basic blocks these counters refer to might have been modified or
+   * deleted: their counters are recomputed from their instructions on demand.
+   */
+  this->bbTotalInstructions.clear();
+  this->loopAggregates.clear();
+  this->sccAggregates.clear();
+  this->functionStaticInstructions.clear();
+  for (auto &inputProfile : this->inputProfiles) {
+    inputProfile->invalidateAggregates();
+  }
+
   return;
 }
 
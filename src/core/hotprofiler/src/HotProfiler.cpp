@@ -83,11 +83,144 @@ void HotProfiler::analyzeProfiles(Module &M) {
     }
   }
 
+  /*
+   * Fetch the loop profiles embedded by noelle-meta-loop-prof-embed.
+   */
+  this->analyzeLoopProfiles(M);
+
   /*
    * Compute the global counters.
    */
   this->hot.computeProgramInvocations(M);
 
+  /*
+   * Fetch the profiles of the single inputs recorded by InputProfileRecorder.
+   */
+  this->analyzeInputProfiles(M);
+
+  return;
+}
+
+void HotProfiler::analyzeLoopProfiles(Module &M) {
+
+  /*
+   * Loop profiles are attached to the terminator of the loop headers.
+   */
+  for (auto &F : M) {
+    for (auto &bb : F) {
+      auto term = bb.getTerminator();
+      if (term == nullptr) {
+        continue;
+      }
+      auto metaNode = term->getMetadata(HotProfiler::loopProfileMetadataKey);
+      if (metaNode == nullptr) {
+        continue;
+      }
+
+      /*
+       * Parse the profile.
+       */
+      auto metaString = cast<MDString>(metaNode->getOperand(0))->getString();
+      auto profile = LoopProfile::fromString(metaString.str());
+      if (!profile) {
+        errs() << "HotProfiler: the loop profile \"" << metaString
+               << "\" is malformed\n";
+        continue;
+      }
+
+      /*
+       * Set the profile.
+       */
+      this->hot.setLoopProfile(&bb, *profile);
+    }
+  }
+
+  return;
+}
+
+void HotProfiler::analyzeInputProfiles(Module &M) {
+
+  /*
+   * Fetch the inputs.
+   */
+  auto inputsNode = M.getNamedMetadata(HotProfiler::inputsMetadataKey);
+  if (inputsNode == nullptr) {
+    return;
+  }
+  auto numberOfInputs = inputsNode->getNumOperands();
+  for (auto i = 0u; i < numberOfInputs; i++) {
+    auto inputNode = inputsNode->getOperand(i);
+    auto inputString = cast<MDString>(inputNode->getOperand(0))->getString();
+
+    /*
+     * Parse the weight and the name of the input.
+     */
+    std::istringstream stream{ inputString.str() };
+    double weight = 0;
+    std::string name{};
+    stream >> weight;
+    std::getline(stream >> std::ws, name);
+    if (weight <= 0) {
+      errs() << "HotProfiler: the input \"" << inputString
+             << "\" is malformed\n";
+      this->hot.inputNames.clear();
+      this->hot.inputWeights.clear();
+      this->hot.inputProfiles.clear();
+      return;
+    }
+
+    /*
+     * Create the profile of the input.
+     */
+    this->hot.inputNames.push_back(name);
+    this->hot.inputWeights.push_back(weight);
+    this->hot.inputProfiles.push_back(std::make_unique<Hot>());
+  }
+
+  /*
+   * Set the invocations of basic blocks for each input.
+   * Basic blocks without counters have not been executed by any input.
+   */
+  auto &countersKey = HotProfiler::inputCountersMetadataKey;
+  for (auto &F : M) {
+    for (auto &bb : F) {
+      auto term = bb.getTerminator();
+      if (term == nullptr) {
+        continue;
+      }
+      std::istringstream stream{};
+      if (auto metaNode = term->getMetadata(countersKey)) {
+        auto metaString = cast<MDString>(metaNode->getOperand(0))->getString();
+        stream.str(metaString.str());
+      }
+      for (auto &inputProfile : this->hot.inputProfiles) {
+        uint64_t counter = 0;
+        if (!(stream >> counter)) {
+          counter = 0;
+        }
+        inputProfile->setBasicBlockInvocations(&bb, counter);
+      }
+    }
+  }
+
+  /*
+   * Compute the global counters of each input.
+   */
+  for (auto &inputProfile : this->hot.inputProfiles) {
+    inputProfile->computeProgramInvocations(M);
+  }
+
+  /*
+   * Normalize the weights.
+   */
+  double totalWeight = 0;
+  for (auto weight : this->hot.inputWeights) {
+    totalWeight += weight;
+  }
+  for (auto &weight : this->hot.inputWeights) {
+    weight /= totalWeight;
+  }
+
   return;
 }
 
@@ -70,6 +70,15 @@ uint64_t Hot::getSelfInstructions(BasicBlock *bb) const {
 }
 
 uint64_t Hot::getTotalInstructions(BasicBlock *bb) const {
+
+  /*
+   * Check if the counter has been computed together with the profiles.
+   */
+  auto it = this->bbTotalInstructions.find(bb);
+  if (it != this->bbTotalInstructions.end()) {
+    return it->second;
+  }
+
   uint64_t t = 0;
 
   for (auto &inst : *bb) {
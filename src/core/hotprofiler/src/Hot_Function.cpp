@@ -25,10 +25,23 @@
 namespace arcana::noelle {
 
 uint64_t Hot::getStaticInstructions(Function *f) const {
+
+  /*
+   * Check if we have already computed the counter.
+   */
+  auto it = this->functionStaticInstructions.find(f);
+  if (it != this->functionStaticInstructions.end()) {
+    return it->second;
+  }
+
+  /*
+   * Compute the counter.
+   */
   uint64_t t = 0;
   for (auto &bb : *f) {
     t += this->getStaticInstructions(&bb);
   }
+  this->functionStaticInstructions[f] = t;
 
   return t;
 }
@@ -90,6 +103,16 @@ bool Hot::hasBeenExecuted(Function *f) const {
 }
 
 double Hot::getDynamicTotalInstructionCoverage(Function *f) const {
+
+  /*
+   * Check if the profile has been generated with multiple inputs.
+   */
+  if (this->getNumberOfInputs() > 0) {
+    return this->getWeightedAverageOverInputs([f](const Hot *inputProfile) {
+      return inputProfile->getDynamicTotalInstructionCoverage(f);
+    });
+  }
+
   auto mInsts = this->getTotalInstructions();
   auto lInsts = this->getTotalInstructions(f);
   auto hotness = ((double)lInsts) / ((double)mInsts);
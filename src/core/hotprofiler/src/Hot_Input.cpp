@@ -0,0 +1,154 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/Hot.hpp"
+
+namespace arcana::noelle {
+
+uint32_t Hot::getNumberOfInputs(void) const {
+  return this->inputProfiles.size();
+}
+
+const std::string &Hot::getInputName(uint32_t inputID) const {
+  return this->inputNames.at(inputID);
+}
+
+double Hot::getInputWeight(uint32_t inputID) const {
+  return this->inputWeights.at(inputID);
+}
+
+const Hot *Hot::getInputProfile(uint32_t inputID) const {
+  return this->inputProfiles.at(inputID).get();
+}
+
+double Hot::getDynamicTotalInstructionCoverage(LoopStructure *loop,
+                                               uint32_t inputID) const {
+  auto inputProfile = this->getInputProfile(inputID);
+  if (!inputProfile->isAvailable()) {
+    return 0;
+  }
+
+  return inputProfile->getDynamicTotalInstructionCoverage(loop);
+}
+
+double Hot::getDynamicTotalInstructionCoverage(Function *f,
+                                               uint32_t inputID) const {
+  auto inputProfile = this->getInputProfile(inputID);
+  if (!inputProfile->isAvailable()) {
+    return 0;
+  }
+
+  return inputProfile->getDynamicTotalInstructionCoverage(f);
+}
+
+double Hot::getDynamicTotalInstructionCoverageVariance(
+    LoopStructure *loop) const {
+  return this->getWeightedVarianceOverInputs([loop](const Hot *inputProfile) {
+    return inputProfile->getDynamicTotalInstructionCoverage(loop);
+  });
+}
+
+double Hot::getDynamicTotalInstructionCoverageVariance(Function *f) const {
+  return this->getWeightedVarianceOverInputs([f](const Hot *inputProfile) {
+    return inputProfile->getDynamicTotalInstructionCoverage(f);
+  });
+}
+
+std::set<uint32_t> Hot::getInputsWhereHot(LoopStructure *loop,
+                                          double minimumHotness) const {
+  std::set<uint32_t> inputs{};
+  for (auto i = 0u; i < this->getNumberOfInputs(); i++) {
+    if (this->getDynamicTotalInstructionCoverage(loop, i) >= minimumHotness) {
+      inputs.insert(i);
+    }
+  }
+
+  return inputs;
+}
+
+std::set<uint32_t> Hot::getInputsWhereHot(Function *f,
+                                          double minimumHotness) const {
+  std::set<uint32_t> inputs{};
+  for (auto i = 0u; i < this->getNumberOfInputs(); i++) {
+    if (this->getDynamicTotalInstructionCoverage(f, i) >= minimumHotness) {
+      inputs.insert(i);
+    }
+  }
+
+  return inputs;
+}
+
+double Hot::getWeightedAverageOverInputs(
+    std::function<double(const Hot *inputProfile)> getMetric) const {
+
+  /*
+   * Inputs that did not execute any instruction do not contribute, so the
+   * weights are normalized over the available inputs.
+   */
+  double average = 0;
+  double availableWeight = 0;
+  for (auto i = 0u; i < this->getNumberOfInputs(); i++) {
+    auto inputProfile = this->getInputProfile(i);
+    if (!inputProfile->isAvailable()) {
+      continue;
+    }
+    average += this->getInputWeight(i) * getMetric(inputProfile);
+    availableWeight += this->getInputWeight(i);
+  }
+  if (availableWeight == 0) {
+    return 0;
+  }
+
+  return average / availableWeight;
+}
+
+double Hot::getWeightedVarianceOverInputs(
+    std::function<double(const Hot *inputProfile)> getMetric) const {
+
+  /*
+   * Compute the weighted average.
+   */
+  auto average = this->getWeightedAverageOverInputs(getMetric);
+
+  /*
+   * Compute the weighted average of the squared deviations over the same
+   * inputs as the average.
+   */
+  double variance = 0;
+  double availableWeight = 0;
+  for (auto i = 0u; i < this->getNumberOfInputs(); i++) {
+    auto inputProfile = this->getInputProfile(i);
+    if (!inputProfile->isAvailable()) {
+      continue;
+    }
+    auto deviation = getMetric(inputProfile) - average;
+    variance += this->getInputWeight(i) * deviation * deviation;
+    availableWeight += this->getInputWeight(i);
+  }
+  if (availableWeight == 0) {
+    return 0;
+  }
+
+  return variance / availableWeight;
+}
+
+} // namespace arcana::noelle
@@ -25,12 +25,7 @@
 namespace arcana::noelle {
 
 uint64_t Hot::getStaticInstructions(LoopStructure *l) const {
-  uint64_t t = 0;
-  for (auto bb : l->getBasicBlocks()) {
-    t += this->getStaticInstructions(bb);
-  }
-
-  return t;
+  return this->getLoopAggregates(l).staticInstructions;
 }
 
 uint64_t Hot::getStaticInstructions(
@@ -68,26 +63,118 @@ uint64_t Hot::getInvocations(LoopStructure *l) const {
 }
 
 uint64_t Hot::getSelfInstructions(LoopStructure *loop) const {
-  uint64_t insts = 0;
+  return this->getLoopAggregates(loop).staticInstructions;
+}
+
+uint64_t Hot::getTotalInstructions(LoopStructure *loop) const {
+  return this->getLoopAggregates(loop).totalInstructions;
+}
+
+const Hot::LoopAggregates &Hot::getLoopAggregates(LoopStructure *loop) const {
+
+  /*
+   * Check if we have already computed the counters of the loop.
+   */
+  auto header = loop->getHeader();
+  auto it = this->loopAggregates.find(header);
+  if (it != this->loopAggregates.end()) {
+    return it->second;
+  }
 
+  /*
+   * Compute the counters of the loop.
+   */
+  LoopAggregates aggregates{ 0, 0 };
   for (auto bb : loop->getBasicBlocks()) {
-    insts += this->getStaticInstructions(bb);
+    this->addToLoopAggregates(bb, aggregates);
   }
 
-  return insts;
+  /*
+   * Memoize the counters.
+   */
+  this->loopAggregates[header] = aggregates;
+
+  return this->loopAggregates.at(header);
 }
 
-uint64_t Hot::getTotalInstructions(LoopStructure *loop) const {
-  uint64_t insts = 0;
+void Hot::addToLoopAggregates(BasicBlock *bb,
+                              LoopAggregates &aggregates) const {
+  aggregates.staticInstructions += this->getStaticInstructions(bb);
 
-  for (auto bb : loop->getBasicBlocks()) {
-    insts += this->getTotalInstructions(bb);
+  /*
+   * Dynamic counters exist only if the profiles are available.
+   */
+  if (!this->isAvailable()) {
+    return;
   }
+  aggregates.totalInstructions += this->getTotalInstructions(bb);
 
-  return insts;
+  return;
+}
+
+void Hot::computeLoopAggregates(LoopForest *forest) {
+
+  /*
+   * Compute the counters of the loops bottom-up.
+   */
+  auto computeLoop = [this](LoopTree *n, uint32_t treeLevel) -> bool {
+    auto loop = n->getLoop();
+    LoopAggregates aggregates{ 0, 0 };
+
+    /*
+     * Add the counters of the sub-loops, which have been already visited.
+     */
+    for (auto child : n->getChildren()) {
+      auto childHeader = child->getLoop()->getHeader();
+      auto &childAggregates = this->loopAggregates.at(childHeader);
+      aggregates.staticInstructions += childAggregates.staticInstructions;
+      aggregates.totalInstructions += childAggregates.totalInstructions;
+    }
+
+    /*
+     * Add the counters of the basic blocks that do not belong to sub-loops.
+     */
+    for (auto bb : loop->getBasicBlocks()) {
+      if (n->isIncludedInItsSubLoops(bb->getTerminator())) {
+        continue;
+      }
+      this->addToLoopAggregates(bb, aggregates);
+    }
+
+    /*
+     * Memoize the counters.
+     * Counters computed before are overwritten as the code might have changed
+     * since then.
+     */
+    this->loopAggregates[loop->getHeader()] = aggregates;
+
+    return false;
+  };
+  for (auto tree : forest->getTrees()) {
+    tree->visitPostOrder(computeLoop);
+  }
+
+  /*
+   * Compute the counters of the loops for each input.
+   */
+  for (auto &inputProfile : this->inputProfiles) {
+    inputProfile->computeLoopAggregates(forest);
+  }
+
+  return;
 }
 
 double Hot::getDynamicTotalInstructionCoverage(LoopStructure *loop) const {
+
+  /*
+   * Check if the profile has been generated with multiple inputs.
+   */
+  if (this->getNumberOfInputs() > 0) {
+    return this->getWeightedAverageOverInputs([loop](const Hot *inputProfile) {
+      return inputProfile->getDynamicTotalInstructionCoverage(loop);
+    });
+  }
+
   auto mInsts = this->getTotalInstructions();
   auto lInsts = this->getTotalInstructions(loop);
   auto hotness = ((double)lInsts) / ((double)mInsts);
@@ -168,6 +255,14 @@ double Hot::getAverageTotalInstructionsPerIteration(LoopStructure *loop) const {
 
 uint64_t Hot::getIterations(LoopStructure *l) const {
 
+  /*
+   * Check if the loop has been profiled by the loop profiler.
+   * In this case, the number of iterations has been measured.
+   */
+  if (auto profile = this->getLoopProfile(l)) {
+    return profile->getIterations();
+  }
+
   /*
    * Fetch the header.
    */
@@ -199,4 +294,87 @@ uint64_t Hot::getIterations(LoopStructure *l) const {
   return loopIterations;
 }
 
+void Hot::setLoopProfile(BasicBlock *header, const LoopProfile &profile) {
+  this->loopProfiles[header] = profile;
+
+  return;
+}
+
+bool Hot::isLoopProfileAvailable(LoopStructure *loop) const {
+  return (this->getLoopProfile(loop) != nullptr);
+}
+
+const LoopProfile *Hot::getLoopProfile(LoopStructure *loop) const {
+  auto it = this->loopProfiles.find(loop->getHeader());
+  if (it == this->loopProfiles.end()) {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+std::map<uint64_t, uint64_t> Hot::getTripCountHistogram(
+    LoopStructure *loop) const {
+  auto profile = this->getLoopProfile(loop);
+  if (profile == nullptr) {
+    return {};
+  }
+
+  return profile->getTripCountHistogram();
+}
+
+uint64_t Hot::getMinimumIterationsPerInvocation(LoopStructure *loop) const {
+  auto profile = this->getLoopProfile(loop);
+  if (profile == nullptr) {
+    return 0;
+  }
+
+  return profile->getMinimumIterationsPerInvocation();
+}
+
+uint64_t Hot::getMaximumIterationsPerInvocation(LoopStructure *loop) const {
+  auto profile = this->getLoopProfile(loop);
+  if (profile == nullptr) {
+    return 0;
+  }
+
+  return profile->getMaximumIterationsPerInvocation();
+}
+
+double Hot::getIterationsPerInvocationVariance(LoopStructure *loop) const {
+  auto profile = this->getLoopProfile(loop);
+  if (profile == nullptr) {
+    return 0;
+  }
+
+  return profile->getIterationsPerInvocationVariance();
+}
+
+uint64_t Hot::getCycles(LoopStructure *loop) const {
+  auto profile = this->getLoopProfile(loop);
+  if (profile == nullptr) {
+    return 0;
+  }
+
+  return profile->getCycles();
+}
+
+double Hot::getAverageCyclesPerInvocation(LoopStructure *loop) const {
+  auto profile = this->getLoopProfile(loop);
+  if (profile == nullptr) {
+    return 0;
+  }
+
+  return profile->getAverageCyclesPerInvocation();
+}
+
+double Hot::getCyclesPerInvocationVariance(LoopStructure *loop) const {
+  auto profile = this->getLoopProfile(loop);
+  if (profile == nullptr) {
+    return 0;
+  }
+
+  return profile->getCyclesPerInvocationVariance();
+}
+
 } // namespace arcana::noelle
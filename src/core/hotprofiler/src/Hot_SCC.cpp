@@ -38,27 +38,43 @@ uint64_t Hot::getStaticInstructions(SCC *scc) const {
 }
 
 uint64_t Hot::getSelfInstructions(SCC *scc) const {
-  uint64_t t = 0;
-
-  auto accumulateF = [this, &t](Instruction *i) -> bool {
-    t += this->getSelfInstructions(i);
-    return false;
-  };
-  scc->iterateOverInstructions(accumulateF);
-
-  return t;
+  return this->getSCCAggregates(scc).selfInstructions;
 }
 
 uint64_t Hot::getTotalInstructions(SCC *scc) const {
-  uint64_t t = 0;
+  return this->getSCCAggregates(scc).totalInstructions;
+}
+
+const Hot::SCCAggregates &Hot::getSCCAggregates(SCC *scc) const {
 
-  auto accumulateF = [this, &t](Instruction *i) -> bool {
-    t += this->getTotalInstructions(i);
+  /*
+   * Check if we have already computed the counters of the SCC.
+   * SCCs are identified by their ID rather than their address, because the
+   * memory of a deallocated SCC can be reused by a new one.
+   */
+  auto id = scc->getID();
+  auto it = this->sccAggregates.find(id);
+  if (it != this->sccAggregates.end()) {
+    return it->second;
+  }
+
+  /*
+   * Compute the counters of the SCC.
+   */
+  SCCAggregates aggregates{ 0, 0 };
+  auto accumulateF = [this, &aggregates](Instruction *i) -> bool {
+    aggregates.selfInstructions += this->getSelfInstructions(i);
+    aggregates.totalInstructions += this->getTotalInstructions(i);
     return false;
   };
   scc->iterateOverInstructions(accumulateF);
 
-  return t;
+  /*
+   * Memoize the counters.
+   */
+  this->sccAggregates[id] = aggregates;
+
+  return this->sccAggregates.at(id);
 }
 
 } // namespace arcana::noelle
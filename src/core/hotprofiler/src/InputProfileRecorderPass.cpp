@@ -0,0 +1,188 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/MetadataManager.hpp"
+#include "arcana/noelle/core/HotProfiler.hpp"
+#include "InputProfileRecorderPass.hpp"
+
+namespace arcana::noelle {
+
+static cl::opt<std::string> InputName(
+    "noelle-prof-input-name",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Name of the input the embedded profile has been generated with"));
+
+static cl::opt<double> InputWeight(
+    "noelle-prof-input-weight",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Weight of the input the embedded profile has been generated "
+             "with"));
+
+InputProfileRecorderPass::InputProfileRecorderPass() : ModulePass(ID) {
+
+  return;
+}
+
+bool InputProfileRecorderPass::doInitialization(Module &M) {
+  return false;
+}
+
+bool InputProfileRecorderPass::runOnModule(Module &M) {
+
+  /*
+   * Fetch the weight of the input.
+   */
+  double weight = 1;
+  if (InputWeight.getNumOccurrences() > 0) {
+    weight = InputWeight.getValue();
+  }
+  if (weight <= 0) {
+    errs() << "InputProfileRecorder: ERROR = the weight of an input must be "
+              "positive\n";
+    abort();
+  }
+
+  /*
+   * Fetch the ID of the input.
+   * Inputs are numbered in the order they have been recorded.
+   */
+  uint32_t inputID = 0;
+  auto &inputsKey = HotProfiler::inputsMetadataKey;
+  if (auto inputsNode = M.getNamedMetadata(inputsKey)) {
+    inputID = inputsNode->getNumOperands();
+  }
+
+  /*
+   * Record the counters of the basic blocks.
+   */
+  this->recordCounters(M, inputID);
+
+  /*
+   * Record the input.
+   */
+  std::string name = "input" + std::to_string(inputID);
+  if (InputName.getNumOccurrences() > 0) {
+    name = InputName.getValue();
+  }
+  MetadataManager mm{ M };
+  mm.addMetadata(inputsKey, std::to_string(weight) + " " + name);
+
+  /*
+   * Remove the profile so the one of the next input can be embedded.
+   */
+  this->removeProfile(M);
+
+  return true;
+}
+
+void InputProfileRecorderPass::recordCounters(Module &M, uint32_t inputID) {
+  auto &countersKey = HotProfiler::inputCountersMetadataKey;
+  MetadataManager mm{ M };
+
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    auto &bfi = getAnalysis<BlockFrequencyInfoWrapperPass>(F).getBFI();
+
+    for (auto &bb : F) {
+
+      /*
+       * Fetch the counter of the basic block.
+       */
+      uint64_t counter = 0;
+      auto profileCount = bfi.getBlockProfileCount(&bb);
+      if (profileCount.hasValue()) {
+        counter = profileCount.getValue();
+      }
+
+      /*
+       * Fetch the counters recorded for the previous inputs.
+       */
+      auto term = bb.getTerminator();
+      std::string counters{};
+      uint32_t previousInputs = 0;
+      if (auto metaNode = term->getMetadata(countersKey)) {
+        auto metaString = cast<MDString>(metaNode->getOperand(0))->getString();
+        counters = metaString.str();
+        std::istringstream stream{ counters };
+        uint64_t previousCounter;
+        while (stream >> previousCounter) {
+          previousInputs++;
+        }
+      }
+
+      /*
+       * Basic blocks that did not exist when the previous inputs have been
+       * recorded have never been executed by them.
+       */
+      for (; previousInputs < inputID; previousInputs++) {
+        counters.append(counters.empty() ? "0" : " 0");
+      }
+
+      /*
+       * Append the counter of the current input.
+       */
+      if (!counters.empty()) {
+        counters.append(" ");
+      }
+      counters.append(std::to_string(counter));
+      if (mm.doesHaveMetadata(term, countersKey)) {
+        mm.setMetadata(term, countersKey, counters);
+      } else {
+        mm.addMetadata(term, countersKey, counters);
+      }
+    }
+  }
+
+  return;
+}
+
+void InputProfileRecorderPass::removeProfile(Module &M) {
+  for (auto &F : M) {
+    if (F.hasMetadata("prof")) {
+      F.setMetadata("prof", nullptr);
+    }
+    for (auto &inst : instructions(F)) {
+      if (inst.getMetadata("prof")) {
+        inst.setMetadata("prof", nullptr);
+      }
+    }
+  }
+
+  return;
+}
+
+void InputProfileRecorderPass::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<BlockFrequencyInfoWrapperPass>();
+
+  return;
+}
+
+// Next there is code to register your pass to "opt"
+char InputProfileRecorderPass::ID = 0;
+static RegisterPass<InputProfileRecorderPass> X(
+    "InputProfileRecorder",
+    "Record the profile of a single input as metadata");
+
+} // namespace arcana::noelle
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_HOTPROFILER_INPUTPROFILERECORDERPASS_H_
+#define NOELLE_SRC_CORE_HOTPROFILER_INPUTPROFILERECORDERPASS_H_
+
+#include "llvm/Analysis/BlockFrequencyInfo.h"
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Record the basic block counters of the profile of a single run (embedded by
+ * -pgo-instr-use) as metadata, and then remove such profile from the IR.
+ * Running this pass once per input accumulates the counters of all inputs in
+ * the IR. These counters are later read by HotProfiler and exposed through
+ * Hot.
+ */
+class InputProfileRecorderPass : public ModulePass {
+public:
+  static char ID;
+
+  InputProfileRecorderPass();
+
+  bool doInitialization(Module &M) override;
+
+  bool runOnModule(Module &M) override;
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  void recordCounters(Module &M, uint32_t inputID);
+
+  void removeProfile(Module &M);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_HOTPROFILER_INPUTPROFILERECORDERPASS_H_
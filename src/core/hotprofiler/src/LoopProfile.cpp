@@ -0,0 +1,190 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/LoopProfile.hpp"
+
+namespace arcana::noelle {
+
+LoopProfile::LoopProfile()
+  : loopID{ 0 },
+    invocations{ 0 },
+    iterations{ 0 },
+    minIterations{ 0 },
+    maxIterations{ 0 },
+    iterationsSquaredSum{ 0 },
+    cycles{ 0 },
+    cyclesSquaredSum{ 0 } {
+  return;
+}
+
+std::optional<LoopProfile> LoopProfile::fromString(
+    const std::string &profileAsString) {
+
+  /*
+   * The format of a profile is:
+   * ID INVOCATIONS ITERATIONS MIN_ITERATIONS MAX_ITERATIONS
+   * ITERATIONS_SQUARED_SUM CYCLES CYCLES_SQUARED_SUM BUCKETS [BUCKET:COUNT]*
+   */
+  std::stringstream s{ profileAsString };
+  LoopProfile p;
+  uint32_t numberOfBuckets = 0;
+  s >> p.loopID >> p.invocations >> p.iterations >> p.minIterations
+      >> p.maxIterations >> p.iterationsSquaredSum >> p.cycles
+      >> p.cyclesSquaredSum >> numberOfBuckets;
+  if (s.fail()) {
+    return std::nullopt;
+  }
+
+  /*
+   * Parse the trip-count histogram.
+   */
+  for (auto i = 0u; i < numberOfBuckets; i++) {
+    uint32_t bucket;
+    uint64_t count;
+    char separator;
+    s >> bucket >> separator >> count;
+    if (s.fail() || (separator != ':')) {
+      return std::nullopt;
+    }
+    p.buckets[bucket] = count;
+  }
+
+  return p;
+}
+
+std::string LoopProfile::toString(void) const {
+  std::stringstream s;
+  s.precision(17);
+  s << this->loopID << " " << this->invocations << " " << this->iterations
+    << " " << this->minIterations << " " << this->maxIterations << " "
+    << this->iterationsSquaredSum << " " << this->cycles << " "
+    << this->cyclesSquaredSum << " " << this->buckets.size();
+  for (auto &pair : this->buckets) {
+    s << " " << pair.first << ":" << pair.second;
+  }
+
+  return s.str();
+}
+
+uint64_t LoopProfile::getLoopID(void) const {
+  return this->loopID;
+}
+
+uint64_t LoopProfile::getInvocations(void) const {
+  return this->invocations;
+}
+
+uint64_t LoopProfile::getIterations(void) const {
+  return this->iterations;
+}
+
+uint64_t LoopProfile::getMinimumIterationsPerInvocation(void) const {
+  return this->minIterations;
+}
+
+uint64_t LoopProfile::getMaximumIterationsPerInvocation(void) const {
+  return this->maxIterations;
+}
+
+double LoopProfile::getAverageIterationsPerInvocation(void) const {
+  if (this->invocations == 0) {
+    return 0;
+  }
+
+  return ((double)this->iterations) / ((double)this->invocations);
+}
+
+double LoopProfile::getIterationsPerInvocationVariance(void) const {
+  return LoopProfile::computeVariance((double)this->iterations,
+                                      this->iterationsSquaredSum,
+                                      this->invocations);
+}
+
+uint64_t LoopProfile::getCycles(void) const {
+  return this->cycles;
+}
+
+double LoopProfile::getAverageCyclesPerInvocation(void) const {
+  if (this->invocations == 0) {
+    return 0;
+  }
+
+  return ((double)this->cycles) / ((double)this->invocations);
+}
+
+double LoopProfile::getCyclesPerInvocationVariance(void) const {
+  return LoopProfile::computeVariance((double)this->cycles,
+                                      this->cyclesSquaredSum,
+                                      this->invocations);
+}
+
+std::map<uint64_t, uint64_t> LoopProfile::getTripCountHistogram(void) const {
+  std::map<uint64_t, uint64_t> h;
+  for (auto &pair : this->buckets) {
+    auto smallestTripCount =
+        LoopProfile::getSmallestTripCountOfBucket(pair.first);
+    h[smallestTripCount] = pair.second;
+  }
+
+  return h;
+}
+
+uint32_t LoopProfile::getBucketOfTripCount(uint64_t tripCount) {
+
+  /*
+   * Bucket 0 is for invocations that did not execute the header at all.
+   * Bucket b > 0 includes trip counts within [2^(b-1), 2^b - 1].
+   */
+  uint32_t b = 0;
+  while (tripCount > 0) {
+    tripCount >>= 1;
+    b++;
+  }
+
+  return b;
+}
+
+uint64_t LoopProfile::getSmallestTripCountOfBucket(uint32_t bucket) {
+  if (bucket == 0) {
+    return 0;
+  }
+
+  return ((uint64_t)1) << (bucket - 1);
+}
+
+double LoopProfile::computeVariance(double sum, double squaredSum, uint64_t n) {
+  if (n == 0) {
+    return 0;
+  }
+
+  /*
+   * Var(X) = E[X^2] - E[X]^2
+   */
+  auto mean = sum / ((double)n);
+  auto variance = (squaredSum / ((double)n)) - (mean * mean);
+  if (variance < 0) {
+    variance = 0;
+  }
+
+  return variance;
+}
+
+} // namespace arcana::noelle
@@ -51,6 +51,13 @@ void HotProfiler::getAnalysisUsage(AnalysisUsage &AU) const {
   return;
 }
 
+const std::string HotProfiler::loopProfileMetadataKey = "noelle.loop.prof";
+
+const std::string HotProfiler::inputsMetadataKey = "noelle.prof.inputs";
+
+const std::string HotProfiler::inputCountersMetadataKey =
+    "noelle.prof.input.counters";
+
 // Next there is code to register your pass to "opt"
 char HotProfiler::ID = 0;
 static RegisterPass<HotProfiler> X("HotProfiler",
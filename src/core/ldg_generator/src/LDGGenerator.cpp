@@ -23,10 +23,17 @@
 #include "arcana/noelle/core/LoopIterationSpaceAnalysis.hpp"
 #include "arcana/noelle/core/LoopCarriedDependencies.hpp"
 #include "arcana/noelle/core/DataFlow.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
 #include "LoopAwareMemDepAnalysis.hpp"
 
 namespace arcana::noelle {
 
+/*
+ * Maximum number of iteration tuples the exhaustive dependence test can
+ * enumerate for all the memory dependences of a loop.
+ */
+static const uint64_t affineAnalysisTuplesPerLoop = 1 << 24;
+
 // TODO: Refactor along with HELIX's exact same implementation of this method
 DataFlowResult *computeReachabilityFromInstructions(
     LoopStructure *loopStructure) {
@@ -202,6 +209,8 @@ PDG *LDGGenerator::generateLoopDependenceGraph(PDG *functionDG,
                                                CompilationOptionsManager *com,
                                                Loop *l,
                                                LoopTree &loopNode) {
+  ScopedTimer timer("LDGGenerator::generateLoopDependenceGraph",
+                    l->getHeader()->getParent());
 
   /*
    * Create the loop dependence graph.
@@ -320,18 +329,28 @@ PDG *LDGGenerator::generateLoopDependenceGraph(PDG *functionDG,
     /*
      * Run SCAF.
      */
-    refinePDGWithSCAF(loopDG, loopNode);
+    {
+      ScopedTimer scafTimer("LDGGenerator::refinePDGWithSCAF");
+      refinePDGWithSCAF(loopDG, loopNode);
+    }
 
     /*
      * Run the iteration space analysis.
      */
-    this->runAffineAnalysis(*loopDG, scalarEvolution, ivManager, loopNode);
+    {
+      ScopedTimer affineTimer("LDGGenerator::runAffineAnalysis");
+      this->runAffineAnalysis(*loopDG, scalarEvolution, ivManager, loopNode);
+    }
 
     /*
      * Run the loop-centric dependence analyses.
      */
-    this->improveDependenceGraph(loopDG, loopStructure);
+    {
+      ScopedTimer improveTimer("LDGGenerator::improveDependenceGraph");
+      this->improveDependenceGraph(loopDG, loopStructure);
+    }
   }
+  loopDG->updateMemoryAccount("Loop DG");
 
   return loopDG;
 }
@@ -357,7 +376,11 @@ void LDGGenerator::runAffineAnalysis(PDG &loopDG,
    */
   auto dfr = computeReachabilityFromInstructions(loopStructure);
 
-  std::unordered_set<DGEdge<Value, Value> *> edgesToRemove;
+  /*
+   * Fetch the memory dependences to test.
+   */
+  std::vector<std::tuple<DGEdge<Value, Value> *, Instruction *, Instruction *>>
+      memoryDependences;
   for (auto dependency :
        LoopCarriedDependencies::getLoopCarriedDependenciesForLoop(
            *loopStructure,
@@ -375,6 +398,38 @@ void LDGGenerator::runAffineAnalysis(PDG &loopDG,
     auto toInst = dyn_cast<Instruction>(dependency->getDst());
     if (!fromInst || !toInst)
       continue;
+    memoryDependences.push_back(std::make_tuple(dependency, fromInst, toInst));
+  }
+
+  /*
+   * Bound the time spent by the exhaustive dependence test on large loop
+   * dependence graphs: the tuples it can enumerate are shared by all edges.
+   */
+  if (!memoryDependences.empty()) {
+    auto budgetPerEdge =
+        affineAnalysisTuplesPerLoop / memoryDependences.size();
+    domainSpace.setExhaustiveTestBudget(
+        std::min(domainSpace.getExhaustiveTestBudget(), budgetPerEdge));
+  }
+
+  std::unordered_set<DGEdge<Value, Value> *> edgesToRemove;
+  std::unordered_set<DGEdge<Value, Value> *> edgesWithinIterations;
+  uint64_t edgesRemovedByTheDependenceTests = 0;
+  for (auto &memoryDependence : memoryDependences) {
+    auto dependency = std::get<0>(memoryDependence);
+    auto fromInst = std::get<1>(memoryDependence);
+    auto toInst = std::get<2>(memoryDependence);
+
+    /*
+     * The dependence tests on the subscripts of the two accesses can prove
+     * that the dependence does not exist at all.
+     */
+    auto classification = domainSpace.classifyDependence(fromInst, toInst);
+    if (classification == LoopIterationSpaceAnalysis::DEPENDENCE_DISPROVED) {
+      edgesToRemove.insert(dependency);
+      edgesRemovedByTheDependenceTests++;
+      continue;
+    }
 
     /*
      * Loop carried dependencies are conservatively marked as such; we can only
@@ -382,7 +437,26 @@ void LDGGenerator::runAffineAnalysis(PDG &loopDG,
      * producer can NEVER reach the consumer during the same iteration
      */
     auto &afterInstructions = dfr->OUT(fromInst);
-    if (afterInstructions.find(toInst) != afterInstructions.end()) {
+    auto isReachableWithinIteration =
+        afterInstructions.find(toInst) != afterInstructions.end();
+
+    /*
+     * The dependence tests can also prove that the dependence never crosses
+     * iterations.
+     * In this case, the dependence exists only if the consumer can run after
+     * the producer within the same iteration.
+     */
+    if (classification
+        == LoopIterationSpaceAnalysis::DEPENDENCE_WITHIN_ITERATIONS) {
+      if (isReachableWithinIteration) {
+        edgesWithinIterations.insert(dependency);
+      } else {
+        edgesToRemove.insert(dependency);
+        edgesRemovedByTheDependenceTests++;
+      }
+      continue;
+    }
+    if (isReachableWithinIteration) {
       continue;
     }
 
@@ -398,6 +472,17 @@ void LDGGenerator::runAffineAnalysis(PDG &loopDG,
     edge->setLoopCarried(false);
     loopDG.removeEdge(edge);
   }
+  for (auto edge : edgesWithinIterations) {
+    edge->setLoopCarried(false);
+  }
+  Instrumentation::count("LDGGenerator: edges removed by the affine analysis",
+                         edgesToRemove.size());
+  Instrumentation::count(
+      "LDGGenerator: loop-carried dependences removed by the dependence tests",
+      edgesRemovedByTheDependenceTests);
+  Instrumentation::count(
+      "LDGGenerator: loop-carried dependences proven within iterations",
+      edgesWithinIterations.size());
 
   /*
    * Free the memory
@@ -127,6 +127,11 @@ public:
    */
   PDG *getLoopDG(void) const;
 
+  /*
+   * Memory used by the dependence graph of the loop and its SCCDAG.
+   */
+  MemoryFootprint getMemoryFootprint(void) const;
+
   /*
    * Copy all options from otherLDI to "this".
    */
@@ -25,6 +25,7 @@
 #include "arcana/noelle/core/SCCDAG.hpp"
 #include "arcana/noelle/core/LoopContent.hpp"
 #include "arcana/noelle/core/LoopCarriedDependencies.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
 
 namespace arcana::noelle {
 
@@ -143,6 +144,7 @@ LoopContent::LoopContent(
     memoryCloningAnalysis{ nullptr },
     com{ compilationOptionsManager } {
   assert(this->loop != nullptr);
+  ScopedTimer timer("LoopContent", l->getHeader()->getParent());
 
   /*
    * Assertions.
@@ -231,28 +233,40 @@ LoopContent::LoopContent(
    * Then, we compute the SCCDAG of this sub-LDG.
    * And then, we can identify IVs from this new SCCDAG.
    */
-  auto loopSCCDAGWithoutMemoryDeps =
-      ldgAnalysis.computeSCCDAGWithOnlyVariableAndControlDependences(loopDG);
-  this->inductionVariables =
-      new InductionVariableManager(this->loop,
-                                   *invariantManager,
-                                   SE,
-                                   *loopSCCDAGWithoutMemoryDeps,
-                                   *environment,
-                                   *l);
+  {
+    ScopedTimer ivTimer("LoopContent::InductionVariableManager");
+    auto loopSCCDAGWithoutMemoryDeps =
+        ldgAnalysis.computeSCCDAGWithOnlyVariableAndControlDependences(loopDG);
+    this->inductionVariables =
+        new InductionVariableManager(this->loop,
+                                     *invariantManager,
+                                     SE,
+                                     *loopSCCDAGWithoutMemoryDeps,
+                                     *environment,
+                                     *l);
+  }
 
   /*
    * Calculate various attributes on SCCs
    */
-  this->sccdagAttrs = new SCCDAGAttrs(
-      compilationOptionsManager->canFloatsBeConsideredRealNumbers(),
-      loopDG,
-      loopSCCDAG,
-      this->loop,
-      *inductionVariables,
-      DS);
-  this->domainSpaceAnalysis =
-      new LoopIterationSpaceAnalysis(this->loop, *this->inductionVariables, SE);
+  {
+    ScopedTimer attrsTimer("LoopContent::SCCDAGAttrs");
+    this->sccdagAttrs = new SCCDAGAttrs(
+        compilationOptionsManager->canFloatsBeConsideredRealNumbers(),
+        loopDG,
+        loopSCCDAG,
+        this->loop,
+        *inductionVariables,
+        DS,
+        compilationOptionsManager->getNumberOfAnalysisThreads());
+  }
+  {
+    ScopedTimer spaceTimer("LoopContent::LoopIterationSpaceAnalysis");
+    this->domainSpaceAnalysis =
+        new LoopIterationSpaceAnalysis(this->loop,
+                                       *this->inductionVariables,
+                                       SE);
+  }
 
   /*
    * Collect induction variable information
@@ -315,6 +329,7 @@ std::pair<PDG *, SCCDAG *> LoopContent::createDGsForLoop(
     PDG *functionDG,
     DominatorSummary &DS,
     ScalarEvolution &SE) {
+  ScopedTimer timer("LoopContent::createDGsForLoop");
 
   /*
    * Perform loop-aware memory dependence analysis to refine the loop dependence
@@ -592,6 +607,13 @@ MemoryCloningAnalysis *LoopContent::getMemoryCloningAnalysis(void) const {
   return this->memoryCloningAnalysis;
 }
 
+MemoryFootprint LoopContent::getMemoryFootprint(void) const {
+  auto footprint = this->loopDG->getMemoryFootprint();
+  footprint += this->sccdagAttrs->getSCCDAG()->getMemoryFootprint();
+
+  return footprint;
+}
+
 bool LoopContent::doesHaveCompileTimeKnownTripCount(void) const {
   return this->compileTimeKnownTripCount;
 }
@@ -26,6 +26,7 @@
 #include "arcana/noelle/core/LoopStructure.hpp"
 #include "arcana/noelle/core/LoopContent.hpp"
 #include "arcana/noelle/core/SCC.hpp"
+#include "arcana/noelle/core/DependenceReachability.hpp"
 
 namespace arcana::noelle {
 
@@ -59,9 +60,10 @@ private:
                  std::set<Instruction *> &instructionsRemoved,
                  std::set<Instruction *> &instructionsAdded);
 
-  void recursivelyCollectDependencies(Instruction *inst,
-                                      std::set<Instruction *> &toPopulate,
-                                      LoopContent const &LDI);
+  void recursivelyCollectDependencies(
+      Instruction *inst,
+      std::set<Instruction *> &toPopulate,
+      DependenceReachability const &reachability);
 
   bool splitWouldBeTrivial(LoopStructure *const loopStructure,
                            std::set<Instruction *> const &instsToPullOut,
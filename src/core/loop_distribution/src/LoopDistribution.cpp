@@ -75,6 +75,16 @@ bool LoopDistribution::splitLoop(LoopContent const &LDI,
   }
   std::set<Instruction *> instsToClone{};
 
+  /*
+   * Index the memory and register dependences between the instructions of the
+   * loop once, so the dependences of all instructions to clone can be
+   * collected without traversing the loop dependence graph again.
+   */
+  DependenceReachability reachability(LDI.getLoopDG(),
+                                      false, // Control
+                                      true,  // Memory
+                                      true); // Register
+
   /*
    * Require that all terminators in the loop are branches and collect
    * instructions that are dependencies of conditional branches
@@ -84,7 +94,9 @@ bool LoopDistribution::splitLoop(LoopContent const &LDI,
       // errs () << "LoopDistribution: Branch instruction: " <<  *branch <<
       // "\n";
       instsToClone.insert(branch);
-      this->recursivelyCollectDependencies(branch, instsToClone, LDI);
+      this->recursivelyCollectDependencies(branch,
+                                           instsToClone,
+                                           reachability);
 
     } else {
       // errs() << "LoopDistribution: Abort: Non-branch terminator " <<
@@ -108,7 +120,9 @@ bool LoopDistribution::splitLoop(LoopContent const &LDI,
         // errs() << "LoopDistribution: Sub loop instruction: " << childI <<
         // "\n";
         instsToClone.insert(&childI);
-        this->recursivelyCollectDependencies(&childI, instsToClone, LDI);
+        this->recursivelyCollectDependencies(&childI,
+                                             instsToClone,
+                                             reachability);
       }
     }
   }
@@ -227,44 +241,18 @@ bool LoopDistribution::splitLoop(LoopContent const &LDI,
 void LoopDistribution::recursivelyCollectDependencies(
     Instruction *inst,
     std::set<Instruction *> &toPopulate,
-    LoopContent const &LDI) {
-  std::vector<Instruction *> queue = { inst };
-  auto BBs = LDI.getLoopStructure()->getBasicBlocks();
-  auto pdg = LDI.getLoopDG();
-  auto fn = [&BBs, &queue, &toPopulate](Value *from,
-                                        DGEdge<Value, Value> *dep) -> bool {
-    if (!isa<Instruction>(from)) {
-      return false;
-    }
-    auto i = cast<Instruction>(from);
+    DependenceReachability const &reachability) {
 
-    /*
-     * Ignore dependencies that are outside of the loop
-     */
-    auto parent = i->getParent();
-    if (BBs.find(parent) == BBs.end()) {
-      return false;
-    }
-
-    /*
-     * Ignore duplicates
-     */
-    if (toPopulate.find(i) == toPopulate.end()) {
-      // errs() << "LoopDistribution: Found dependency: " << *i << "\n";
+  /*
+   * The index only includes the instructions of the loop, so dependences
+   * that are outside of the loop are ignored.
+   */
+  for (auto v : reachability.getBackwardSlice(inst)) {
+    if (auto i = dyn_cast<Instruction>(v)) {
       toPopulate.insert(i);
-      queue.push_back(i);
     }
-    return false;
-  };
-  while (queue.size() != 0) {
-    auto i = queue.back();
-    queue.pop_back();
-    pdg->iterateOverDependencesTo(i,
-                                  false, // Control
-                                  true,  // Memory
-                                  true,  // Register
-                                  fn);
   }
+
   return;
 }
 
@@ -72,7 +72,13 @@ public:
 
   /*
    * Reduce live out variables given binary operators to reduce
-   * with and initial values to start at
+   * with and initial values to start at.
+   *
+   * Reductions whose operator is associative and commutative combine the
+   * private copies of the threads with a tree of depth log2(reducers).
+   * The other reductions (and all of them with
+   * -noelle-disable-reduction-tree) are computed by a loop that walks the
+   * private copies one after the other.
    */
   virtual BasicBlock *reduceLiveOutVariables(
       BasicBlock *bb,
@@ -100,6 +106,29 @@ public:
                                                uint32_t reducerInd) const;
   virtual bool hasVariableBeenReduced(uint32_t id) const;
 
+  /*
+   * Return the offset (in 64-bit slots) of the variable @id within the
+   * environment array.
+   */
+  virtual uint64_t getOffsetOfEnvironmentVariable(uint32_t id) const;
+
+  /*
+   * Return the size of the environment array in bytes.
+   */
+  virtual uint64_t getEnvironmentBytes(void) const;
+
+  /*
+   * Return the size that the environment array would have if every variable
+   * had its own cache line.
+   */
+  virtual uint64_t getPaddedEnvironmentBytes(void) const;
+
+  /*
+   * Print where each variable is stored in the environment array.
+   */
+  raw_ostream &printLayout(raw_ostream &stream,
+                           std::string prefixToUse = "") const;
+
   virtual ~LoopEnvironmentBuilder();
 
 protected:
@@ -128,6 +157,22 @@ protected:
   std::unordered_map<uint32_t, AllocaInst *> envIndexToVectorOfReducableVar;
   uint64_t numReducers;
 
+  /*
+   * The layout of the environment array.
+   *
+   * By default, every variable has its own cache line.
+   * With -noelle-compact-environment, only variables that are written while
+   * the tasks run (e.g., live-outs) have their own cache line. Variables that
+   * are only read by the tasks (i.e., read-only live-ins and the pointers to
+   * the per-reducer copies of reducable variables) are packed together.
+   * The packed variables then follow the ones with their own cache line,
+   * which keep their offset of index times the slots in a cache line.
+   * Without compaction, variables keep the order of their IDs.
+   */
+  std::unordered_map<uint32_t, uint64_t> envIndexToOffset;
+  std::set<uint32_t> envIndexOfPackedVars;
+  uint64_t envSlots;
+
   /*
    * Information on a specific user (a function, stage, chunk, etc...)
    */
@@ -139,7 +184,32 @@ protected:
                                  uint64_t reducerCount,
                                  uint64_t numberOfUsers);
 
+  virtual void initializeBuilder(const std::vector<Type *> &varTypes,
+                                 const std::set<uint32_t> &singleVarIDs,
+                                 const std::set<uint32_t> &readOnlyVarIDs,
+                                 const std::set<uint32_t> &reducableVarIDs,
+                                 uint64_t reducerCount,
+                                 uint64_t numberOfUsers);
+
   virtual void createUsers(uint32_t numUsers);
+
+  virtual BasicBlock *reduceLiveOutVariablesSequentially(
+      BasicBlock *bb,
+      IRBuilder<> &builder,
+      const std::unordered_map<uint32_t, BinaryReductionSCC *> &reductions,
+      Value *numberOfThreadsExecuted,
+      std::function<Value *(ReductionSCC *scc)> castingInitialValue);
+
+  virtual Value *reduceLiveOutVariableWithTree(IRBuilder<> &builder,
+                                               uint32_t envIndex,
+                                               BinaryReductionSCC *reduction,
+                                               Value *initialValue,
+                                               Value *numberOfThreadsExecuted);
+
+  virtual bool canBeReducedWithTree(uint32_t envIndex,
+                                    BinaryReductionSCC *reduction) const;
+
+  virtual bool canBePacked(Type *varType) const;
 };
 
 } // namespace arcana::noelle
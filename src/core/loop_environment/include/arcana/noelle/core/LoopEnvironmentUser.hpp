@@ -30,6 +30,14 @@ class LoopEnvironmentUser {
 public:
   LoopEnvironmentUser(std::unordered_map<uint32_t, uint32_t> &envIDToIndex);
 
+  /*
+   * @envIndexToOffset maps the index of each variable to its offset (in 64-bit
+   * slots) within the environment array.
+   */
+  LoopEnvironmentUser(
+      std::unordered_map<uint32_t, uint32_t> &envIDToIndex,
+      std::unordered_map<uint32_t, uint64_t> &envIndexToOffset);
+
   LoopEnvironmentUser() = delete;
 
   virtual void setEnvironmentArray(Value *envArr);
@@ -68,6 +76,9 @@ protected:
   std::set<uint32_t> liveInIDs;
   std::set<uint32_t> liveOutIDs;
   std::unordered_map<uint32_t, uint32_t> &envIDToIndex;
+  std::unordered_map<uint32_t, uint64_t> *envIndexToOffset;
+
+  uint64_t getOffsetOfEnvIndex(uint32_t envIndex) const;
 };
 
 } // namespace arcana::noelle
@@ -25,6 +25,19 @@
 
 namespace arcana::noelle {
 
+static cl::opt<bool> CompactEnvironment(
+    "noelle-compact-environment",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Pack the environment variables that are only read by the "
+             "tasks"));
+
+static cl::opt<bool> DisableReductionTree(
+    "noelle-disable-reduction-tree",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Reduce live-out variables one private copy at a time"));
+
 LoopEnvironmentBuilder::LoopEnvironmentBuilder(LLVMContext &cxt,
                                                LoopEnvironment *environment,
                                                uint64_t numberOfUsers)
@@ -70,8 +83,10 @@ LoopEnvironmentBuilder::LoopEnvironmentBuilder(
 
   /*
    * Group environment variables into reducable and not.
+   * Non-reducable live-ins are only read by the tasks.
    */
   std::set<uint32_t> nonReducableVars;
+  std::set<uint32_t> readOnlyVars;
   std::set<uint32_t> reducableVars;
   for (auto liveInVariableID : environment->getEnvIDsOfLiveInVars()) {
     if (shouldThisVariableBeSkipped(liveInVariableID, false)) {
@@ -81,6 +96,7 @@ LoopEnvironmentBuilder::LoopEnvironmentBuilder(
       reducableVars.insert(liveInVariableID);
     } else {
       nonReducableVars.insert(liveInVariableID);
+      readOnlyVars.insert(liveInVariableID);
     }
   }
   for (auto liveOutVariableID : environment->getEnvIDsOfLiveOutVars()) {
@@ -106,6 +122,7 @@ LoopEnvironmentBuilder::LoopEnvironmentBuilder(
    */
   this->initializeBuilder(environment->getTypesOfEnvironmentLocations(),
                           nonReducableVars,
+                          readOnlyVars,
                           reducableVars,
                           reducerCount,
                           numberOfUsers);
@@ -140,16 +157,48 @@ void LoopEnvironmentBuilder::initializeBuilder(
     const std::set<uint32_t> &reducableVarIDs,
     uint64_t reducerCount,
     uint64_t numberOfUsers) {
+  this->initializeBuilder(varTypes,
+                          singleVarIDs,
+                          {},
+                          reducableVarIDs,
+                          reducerCount,
+                          numberOfUsers);
+
+  return;
+}
+
+void LoopEnvironmentBuilder::initializeBuilder(
+    const std::vector<Type *> &varTypes,
+    const std::set<uint32_t> &singleVarIDs,
+    const std::set<uint32_t> &readOnlyVarIDs,
+    const std::set<uint32_t> &reducableVarIDs,
+    uint64_t reducerCount,
+    uint64_t numberOfUsers) {
 
   /*
-   * Build up envID to index map and reverse map
+   * Build up envID to index map and reverse map.
+   * When the environment is compacted, variables written by the tasks come
+   * first. Otherwise, variables keep the order of their IDs.
    */
   uint32_t index = 0;
   for (auto singleVarID : singleVarIDs) {
+    if (CompactEnvironment && (readOnlyVarIDs.count(singleVarID) > 0)) {
+      continue;
+    }
     this->envIDToIndex[singleVarID] = index;
     this->indexToEnvID[index] = singleVarID;
     index++;
   }
+  if (CompactEnvironment) {
+    for (auto singleVarID : singleVarIDs) {
+      if (readOnlyVarIDs.count(singleVarID) == 0) {
+        continue;
+      }
+      this->envIDToIndex[singleVarID] = index;
+      this->indexToEnvID[index] = singleVarID;
+      index++;
+    }
+  }
   for (auto reducableVarID : reducableVarIDs) {
     this->envIDToIndex[reducableVarID] = index;
     this->indexToEnvID[index] = reducableVarID;
@@ -164,6 +213,7 @@ void LoopEnvironmentBuilder::initializeBuilder(
   this->envSize = singleVarIDs.size() + reducableVarIDs.size();
   this->envArrayType = nullptr;
   this->numReducers = reducerCount;
+  this->envSlots = 0;
 
   /*
    * Build up partial/all environment types array based on envSize
@@ -180,11 +230,41 @@ void LoopEnvironmentBuilder::initializeBuilder(
    */
   auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
 
+  /*
+   * Compute the layout of the environment.
+   */
+  for (uint32_t i = 0; i < this->envSize; i++) {
+    auto varID = this->indexToEnvID[i];
+
+    /*
+     * Check if the variable is only read by the tasks.
+     * The slot of a reducable variable stores the pointer to its per-reducer
+     * copies, which is only read by the tasks.
+     */
+    auto isReadOnly = (readOnlyVarIDs.count(varID) > 0)
+                      && this->canBePacked(this->envTypes[i]);
+    auto isReducable = reducableVarIDs.count(varID) > 0;
+    if (CompactEnvironment && (isReadOnly || isReducable)) {
+      this->envIndexToOffset[i] = this->envSlots;
+      this->envIndexOfPackedVars.insert(i);
+      this->envSlots++;
+      continue;
+    }
+
+    /*
+     * The variable has its own cache line.
+     */
+    this->envSlots = alignTo(this->envSlots, valuesInCacheLine);
+    this->envIndexToOffset[i] = this->envSlots;
+    this->envSlots += valuesInCacheLine;
+  }
+  this->envSlots = alignTo(this->envSlots, valuesInCacheLine);
+
   /*
    * Define the LLVM type for the array of environment values.
    */
   auto int64 = IntegerType::get(this->CXT, 64);
-  this->envArrayType = ArrayType::get(int64, this->envSize * valuesInCacheLine);
+  this->envArrayType = ArrayType::get(int64, this->envSlots);
 
   /*
    * Initialize the index-to-variable map.
@@ -206,9 +286,26 @@ void LoopEnvironmentBuilder::initializeBuilder(
   return;
 }
 
+bool LoopEnvironmentBuilder::canBePacked(Type *varType) const {
+
+  /*
+   * Only variables that fit in a 64-bit slot can be packed.
+   */
+  if (varType->isPointerTy()) {
+    return true;
+  }
+  auto bits = varType->getPrimitiveSizeInBits();
+  if ((bits == 0) || (bits > 64)) {
+    return false;
+  }
+
+  return true;
+}
+
 void LoopEnvironmentBuilder::createUsers(uint32_t numUsers) {
   for (auto i = 0u; i < numUsers; ++i) {
-    this->envUsers.push_back(new LoopEnvironmentUser(this->envIDToIndex));
+    this->envUsers.push_back(
+        new LoopEnvironmentUser(this->envIDToIndex, this->envIndexToOffset));
   }
 
   return;
@@ -235,15 +332,17 @@ void LoopEnvironmentBuilder::addVariableToEnvironment(uint64_t varID,
   this->envTypes.push_back(varType);
 
   /*
-   * Compute how many values can fit in a cache line.
+   * The new variable has its own cache line.
    */
   auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+  this->envIndexToOffset[this->envIDToIndex[varID]] = this->envSlots;
+  this->envSlots += valuesInCacheLine;
 
   /*
    * Define the LLVM type for the array of environment values.
    */
   auto int64 = IntegerType::get(this->CXT, 64);
-  this->envArrayType = ArrayType::get(int64, this->envSize * valuesInCacheLine);
+  this->envArrayType = ArrayType::get(int64, this->envSlots);
 
   /*
    * Set the index-to-var map for the new variable.
@@ -288,22 +387,13 @@ void LoopEnvironmentBuilder::generateEnvVariables(IRBuilder<> &builder) {
 
   auto int64 = IntegerType::get(builder.getContext(), 64);
   auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
+  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
   auto fetchCastedEnvPtr =
-      [&](Value *arr, uint32_t envIndex, Type *ptrType) -> Value * {
-    /*
-     * Compute the offset of the variable with index "envIndex" that is stored
-     * inside the environment.
-     *
-     * Compute how many values can fit in a cache line.
-     */
-    auto valuesInCacheLine =
-        Architecture::getCacheLineBytes() / sizeof(int64_t);
-    auto indValue =
-        cast<Value>(ConstantInt::get(int64, envIndex * valuesInCacheLine));
-
+      [&](Value *arr, uint64_t offset, Type *ptrType) -> Value * {
     /*
-     * Compute the address of the variable with index "envIndex".
+     * Compute the address of the variable stored at the 64-bit slot "offset".
      */
+    auto indValue = cast<Value>(ConstantInt::get(int64, offset));
     auto envPtr =
         builder.CreateInBoundsGEP(arr, ArrayRef<Value *>({ zeroV, indValue }));
 
@@ -327,8 +417,9 @@ void LoopEnvironmentBuilder::generateEnvVariables(IRBuilder<> &builder) {
   }
   for (auto envIndex : singleIndices) {
     auto ptrType = PointerType::getUnqual(this->envTypes[envIndex]);
+    auto envOffset = this->envIndexToOffset.at(envIndex);
     this->envIndexToVar[envIndex] =
-        fetchCastedEnvPtr(this->envArray, envIndex, ptrType);
+        fetchCastedEnvPtr(this->envArray, envOffset, ptrType);
   }
 
   /*
@@ -352,9 +443,9 @@ void LoopEnvironmentBuilder::generateEnvVariables(IRBuilder<> &builder) {
 
     /*
      * Define the type of the vectorized form of the reducable variable.
+     * Each reducer writes its own copy, so copies are in different cache
+     * lines.
      */
-    auto valuesInCacheLine =
-        Architecture::getCacheLineBytes() / sizeof(int64_t);
     auto reduceArrType =
         ArrayType::get(int64, this->numReducers * valuesInCacheLine);
 
@@ -373,14 +464,17 @@ void LoopEnvironmentBuilder::generateEnvVariables(IRBuilder<> &builder) {
      * environment.
      */
     auto reduceArrPtrType = PointerType::getUnqual(reduceArrAlloca->getType());
-    auto envPtr = fetchCastedEnvPtr(this->envArray, envIndex, reduceArrPtrType);
+    auto envOffset = this->envIndexToOffset.at(envIndex);
+    auto envPtr =
+        fetchCastedEnvPtr(this->envArray, envOffset, reduceArrPtrType);
     builder.CreateStore(reduceArrAlloca, envPtr);
 
     /*
      * Compute and cache the pointer of each element of the vectorized variable.
      */
     for (auto i = 0u; i < this->numReducers; ++i) {
-      auto reducePtr = fetchCastedEnvPtr(reduceArrAlloca, i, ptrType);
+      auto reducePtr =
+          fetchCastedEnvPtr(reduceArrAlloca, i * valuesInCacheLine, ptrType);
       this->envIndexToReducableVar[envIndex].push_back(reducePtr);
     }
   }
@@ -403,6 +497,175 @@ BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariables(
     return bb;
   }
 
+  /*
+   * Split the reductions between the ones that can be computed by a tree and
+   * the ones that need to be computed sequentially.
+   */
+  std::unordered_map<uint32_t, BinaryReductionSCC *> treeReductions;
+  std::unordered_map<uint32_t, BinaryReductionSCC *> sequentialReductions;
+  for (auto envIDReduction : reductions) {
+    auto envID = envIDReduction.first;
+    auto red = envIDReduction.second;
+    auto envIndex = this->envIDToIndex.at(envID);
+    if (!DisableReductionTree && this->canBeReducedWithTree(envIndex, red)) {
+      treeReductions[envID] = red;
+    } else {
+      sequentialReductions[envID] = red;
+    }
+  }
+
+  /*
+   * Compute the tree reductions at the end of "bb".
+   */
+  if (treeReductions.size() > 0) {
+    auto bbTerminator = bb->getTerminator();
+    if (bbTerminator != nullptr) {
+      bbTerminator->eraseFromParent();
+    }
+    IRBuilder<> bbBuilder{ bb };
+    for (auto envIDReduction : treeReductions) {
+      auto envIndex = this->envIDToIndex.at(envIDReduction.first);
+      auto red = envIDReduction.second;
+      auto initialValue = castingInitialValue(red);
+      auto reducedValue =
+          this->reduceLiveOutVariableWithTree(bbBuilder,
+                                              envIndex,
+                                              red,
+                                              initialValue,
+                                              numberOfThreadsExecuted);
+      this->envIndexToAccumulatedReducableVar[envIndex] = reducedValue;
+    }
+  }
+
+  /*
+   * Compute the other reductions.
+   */
+  return this->reduceLiveOutVariablesSequentially(bb,
+                                                  builder,
+                                                  sequentialReductions,
+                                                  numberOfThreadsExecuted,
+                                                  castingInitialValue);
+}
+
+bool LoopEnvironmentBuilder::canBeReducedWithTree(
+    uint32_t envIndex,
+    BinaryReductionSCC *reduction) const {
+
+  /*
+   * The private copies of the threads are combined in a different order than
+   * the sequential one, so the identity is needed for the threads that did
+   * not run.
+   */
+  auto varType = this->envTypes.at(envIndex);
+  auto identity = reduction->getIdentityValue();
+  if ((identity == nullptr) || (identity->getType() != varType)) {
+    return false;
+  }
+
+  /*
+   * Integer operators that are associative and commutative can always be
+   * reordered.
+   */
+  auto binOp = reduction->getReductionOperation();
+  if (Instruction::isAssociative(binOp) && Instruction::isCommutative(binOp)) {
+    return true;
+  }
+
+  /*
+   * Floating point operators can be reordered only if all accumulations allow
+   * reassociation.
+   */
+  if ((binOp != Instruction::FAdd) && (binOp != Instruction::FMul)) {
+    return false;
+  }
+  auto phi = reduction->getPhiThatAccumulatesValuesBetweenLoopIterations();
+  if (phi == nullptr) {
+    return false;
+  }
+  auto accumulations = 0;
+  for (auto user : phi->users()) {
+    auto accumulation = dyn_cast<BinaryOperator>(user);
+    if (accumulation == nullptr) {
+      continue;
+    }
+    if (accumulation->getOpcode() != binOp) {
+      continue;
+    }
+    if (!accumulation->hasAllowReassoc()) {
+      return false;
+    }
+    accumulations++;
+  }
+
+  return accumulations > 0;
+}
+
+Value *LoopEnvironmentBuilder::reduceLiveOutVariableWithTree(
+    IRBuilder<> &builder,
+    uint32_t envIndex,
+    BinaryReductionSCC *reduction,
+    Value *initialValue,
+    Value *numberOfThreadsExecuted) {
+  auto binOp = reduction->getReductionOperation();
+  auto identity = reduction->getIdentityValue();
+  auto &privateCopies = this->envIndexToReducableVar.at(envIndex);
+
+  /*
+   * Load the private copies of the threads.
+   * The copies of the threads that did not run are replaced by the identity.
+   * The first thread always runs.
+   */
+  std::vector<Value *> values;
+  auto threadsType = numberOfThreadsExecuted->getType();
+  for (auto i = 0u; i < this->numReducers; i++) {
+    auto privateCopy = builder.CreateLoad(privateCopies.at(i));
+    if (i == 0) {
+      values.push_back(privateCopy);
+      continue;
+    }
+    auto threadID = ConstantInt::get(threadsType, i);
+    auto hasRun = builder.CreateICmpSLT(threadID, numberOfThreadsExecuted);
+    values.push_back(builder.CreateSelect(hasRun, privateCopy, identity));
+  }
+
+  /*
+   * Combine the private copies pairwise until only one value is left.
+   */
+  while (values.size() > 1) {
+    std::vector<Value *> nextLevel;
+    for (auto i = 0u; (i + 1) < values.size(); i += 2) {
+      auto combined = builder.CreateBinOp(binOp, values[i], values[i + 1]);
+      nextLevel.push_back(combined);
+    }
+    if ((values.size() % 2) == 1) {
+      nextLevel.push_back(values.back());
+    }
+    values = nextLevel;
+  }
+
+  /*
+   * Accumulate the result to the initial value.
+   */
+  auto reducedValue = builder.CreateBinOp(binOp, initialValue, values[0]);
+
+  return reducedValue;
+}
+
+BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariablesSequentially(
+    BasicBlock *bb,
+    IRBuilder<> &builder,
+    const std::unordered_map<uint32_t, BinaryReductionSCC *> &reductions,
+    Value *numberOfThreadsExecuted,
+    std::function<Value *(ReductionSCC *scc)> castingInitialValue) {
+  assert(bb != nullptr);
+
+  /*
+   * Check if there are any live-out variable that needs to be reduced.
+   */
+  if (reductions.size() == 0) {
+    return bb;
+  }
+
   /*
    * Fetch the function that "bb" belongs to.
    */
@@ -695,6 +958,55 @@ bool LoopEnvironmentBuilder::hasVariableBeenReduced(uint32_t id) const {
   return isReduce;
 }
 
+uint64_t LoopEnvironmentBuilder::getOffsetOfEnvironmentVariable(
+    uint32_t id) const {
+  /*
+   * Mapping from envID to index
+   */
+  assert(this->envIDToIndex.find(id) != this->envIDToIndex.end()
+         && "The environment variable is not included in the builder\n");
+  auto ind = this->envIDToIndex.at(id);
+
+  return this->envIndexToOffset.at(ind);
+}
+
+uint64_t LoopEnvironmentBuilder::getEnvironmentBytes(void) const {
+  return this->envSlots * sizeof(int64_t);
+}
+
+uint64_t LoopEnvironmentBuilder::getPaddedEnvironmentBytes(void) const {
+  return this->envSize * Architecture::getCacheLineBytes();
+}
+
+raw_ostream &LoopEnvironmentBuilder::printLayout(
+    raw_ostream &stream,
+    std::string prefixToUse) const {
+  stream << prefixToUse << "Environment layout\n";
+  stream << prefixToUse << "  Bytes = " << this->getEnvironmentBytes()
+         << " (" << this->getPaddedEnvironmentBytes()
+         << " with a cache line per variable)\n";
+  stream << prefixToUse << "  Cache line bytes = "
+         << Architecture::getCacheLineBytes() << "\n";
+  stream << prefixToUse << "  Packed variables = "
+         << this->envIndexOfPackedVars.size() << "\n";
+  for (uint32_t i = 0; i < this->envSize; i++) {
+    auto offsetInBytes = this->envIndexToOffset.at(i) * sizeof(int64_t);
+    stream << prefixToUse << "  Variable " << this->indexToEnvID.at(i)
+           << ": byte " << offsetInBytes;
+    if (this->envIndexOfPackedVars.count(i) > 0) {
+      stream << ", packed";
+    } else {
+      stream << ", own cache line";
+    }
+    if (this->envIndexToReducableVar.count(i) > 0) {
+      stream << ", reducable";
+    }
+    stream << ", type " << *this->envTypes.at(i) << "\n";
+  }
+
+  return stream;
+}
+
 LoopEnvironmentUser *LoopEnvironmentBuilder::getUser(uint32_t user) const {
   if (user >= this->getNumberOfUsers()) {
     abort();
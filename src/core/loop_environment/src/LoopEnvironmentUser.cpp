@@ -29,7 +29,8 @@ LoopEnvironmentUser::LoopEnvironmentUser(
   : envIndexToPtr{},
     liveInIDs{},
     liveOutIDs{},
-    envIDToIndex{ envIDToIndex } {
+    envIDToIndex{ envIDToIndex },
+    envIndexToOffset{ nullptr } {
   envIndexToPtr.clear();
   liveInIDs.clear();
   liveOutIDs.clear();
@@ -37,6 +38,32 @@ LoopEnvironmentUser::LoopEnvironmentUser(
   return;
 }
 
+LoopEnvironmentUser::LoopEnvironmentUser(
+    std::unordered_map<uint32_t, uint32_t> &envIDToIndex,
+    std::unordered_map<uint32_t, uint64_t> &envIndexToOffset)
+  : LoopEnvironmentUser(envIDToIndex) {
+  this->envIndexToOffset = &envIndexToOffset;
+
+  return;
+}
+
+uint64_t LoopEnvironmentUser::getOffsetOfEnvIndex(uint32_t envIndex) const {
+
+  /*
+   * Check if the layout of the environment is known.
+   */
+  if (this->envIndexToOffset != nullptr) {
+    return this->envIndexToOffset->at(envIndex);
+  }
+
+  /*
+   * Every variable has its own cache line.
+   */
+  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+
+  return envIndex * valuesInCacheLine;
+}
+
 void LoopEnvironmentUser::setEnvironmentArray(Value *envArr) {
   this->envArray = envArr;
 
@@ -70,16 +97,11 @@ Instruction *LoopEnvironmentUser::createEnvironmentVariablePointer(
   auto int64 = IntegerType::get(builder.getContext(), 64);
   auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
 
-  /*
-   * Compute how many values can fit in a cache line.
-   */
-  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
-
   /*
    * Compute the offset of the environment variable.
    */
-  auto envIndV =
-      cast<Value>(ConstantInt::get(int64, envIndex * valuesInCacheLine));
+  auto envOffset = this->getOffsetOfEnvIndex(envIndex);
+  auto envIndV = cast<Value>(ConstantInt::get(int64, envOffset));
 
   /*
    * Compute the address of the environment variable
@@ -123,8 +145,8 @@ void LoopEnvironmentUser::createReducableEnvPtr(IRBuilder<> &builder,
 
   auto int64 = IntegerType::get(builder.getContext(), 64);
   auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
-  auto envIndV =
-      cast<Value>(ConstantInt::get(int64, envIndex * valuesInCacheLine));
+  auto envOffset = this->getOffsetOfEnvIndex(envIndex);
+  auto envIndV = cast<Value>(ConstantInt::get(int64, envOffset));
 
   auto envReduceGEP =
       builder.CreateInBoundsGEP(this->envArray,
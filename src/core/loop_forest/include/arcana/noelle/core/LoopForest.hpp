@@ -52,6 +52,8 @@ public:
 
   LoopTree *getParent(void) const;
 
+  LoopForest *getForest(void) const;
+
   std::unordered_set<LoopTree *> getChildren(void) const;
 
   std::unordered_set<LoopTree *> getDescendants(void);
@@ -100,6 +102,22 @@ public:
 
   void addTree(LoopTree *tree);
 
+  /*
+   * Add @loop to the forest as the parent of @tree (e.g., after a
+   * transformation wrapped the loop of @tree into @loop).
+   * The previous parent of @tree becomes the parent of @loop.
+   * Return the node of @loop.
+   */
+  LoopTree *addParent(LoopTree *tree, LoopStructure *loop);
+
+  /*
+   * Remove the loop of @tree from the forest and move its sub-loops to @into
+   * (e.g., after a transformation fused the loop of @tree into the loop of
+   * @into).
+   * @tree is deallocated.
+   */
+  void mergeTree(LoopTree *tree, LoopTree *into);
+
   LoopTree *getNode(LoopStructure *loop) const;
 
   LoopTree *getInnermostLoopThatContains(Instruction *i) const;
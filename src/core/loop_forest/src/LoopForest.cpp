@@ -238,6 +238,71 @@ void LoopForest::addTree(LoopTree *tree) {
   return;
 }
 
+LoopTree *LoopForest::addParent(LoopTree *tree, LoopStructure *loop) {
+  assert(tree != nullptr);
+  assert(loop != nullptr);
+  assert(this->nodes.find(loop) == this->nodes.end());
+  assert(loop->isIncluded(tree->getLoop()->getHeader()));
+
+  /*
+   * Allocate the node.
+   */
+  auto oldParent = tree->parent;
+  auto n = new LoopTree(this, loop, oldParent);
+  this->nodes[loop] = n;
+  this->functionLoops[loop->getFunction()].insert(loop);
+  this->headerLoops[loop->getHeader()] = n;
+
+  /*
+   * Place the new node between @tree and its parent.
+   */
+  if (oldParent == nullptr) {
+    this->trees.erase(tree);
+    this->trees.insert(n);
+  } else {
+    oldParent->children.erase(tree);
+    oldParent->children.insert(n);
+  }
+  n->children.insert(tree);
+  tree->parent = n;
+
+  return n;
+}
+
+void LoopForest::mergeTree(LoopTree *tree, LoopTree *into) {
+  assert(tree != nullptr);
+  assert(into != nullptr);
+  assert(tree != into);
+  assert(tree->parent == into->parent);
+
+  /*
+   * Move the sub-loops.
+   */
+  for (auto child : tree->children) {
+    child->parent = into;
+    into->children.insert(child);
+  }
+  tree->children.clear();
+
+  /*
+   * Unregister the loop.
+   */
+  auto loop = tree->loop;
+  this->nodes.erase(loop);
+  this->functionLoops[loop->getFunction()].erase(loop);
+  auto headerIt = this->headerLoops.find(loop->getHeader());
+  if ((headerIt != this->headerLoops.end()) && (headerIt->second == tree)) {
+    this->headerLoops.erase(headerIt);
+  }
+
+  /*
+   * Remove the node from its tree (or from the trees of the forest).
+   */
+  delete tree;
+
+  return;
+}
+
 LoopForest::~LoopForest() {
   for (auto pair : this->nodes) {
     delete pair.second;
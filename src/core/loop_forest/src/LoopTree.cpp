@@ -186,6 +186,10 @@ LoopTree *LoopTree::getParent(void) const {
   return this->parent;
 }
 
+LoopForest *LoopTree::getForest(void) const {
+  return this->forest;
+}
+
 std::unordered_set<LoopTree *> LoopTree::getDescendants(void) {
   std::unordered_set<LoopTree *> s;
 
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_LOOP_FUSION_LOOPFUSION_H_
+#define NOELLE_SRC_CORE_LOOP_FUSION_LOOPFUSION_H_
+
+#include "llvm/Analysis/ValueTracking.h"
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/LoopContent.hpp"
+#include "arcana/noelle/core/PDG.hpp"
+#include "arcana/noelle/core/Dominators.hpp"
+
+namespace arcana::noelle {
+
+class LoopFusion {
+public:
+  /*
+   * Methods
+   */
+  LoopFusion();
+
+  /*
+   * Fuse the loop of @second into the loop of @first, which must immediately
+   * precede it: the fused loop runs the body of @first and then the body of
+   * @second at every iteration.
+   *
+   * The loops must be in while form (see LoopWhilifier), their loop-governing
+   * induction variables must run over the same values, they must run the same
+   * number of times (i.e., be control equivalent), and @FDG must not have
+   * memory dependences from an iteration of @first to an earlier iteration of
+   * @second.
+   *
+   * On success, the loop of @first is the fused loop (its LoopStructure is
+   * updated and the loop of @second is removed from the loop forest), so a
+   * LoopContent can be computed for it; @second must not be used anymore.
+   *
+   * Return true if the loops have been fused.
+   */
+  bool fuseLoops(LoopContent &first,
+                 LoopContent &second,
+                 PDG *FDG,
+                 DominatorSummary *DS,
+                 LoopInfo &LI,
+                 ScalarEvolution &SE);
+
+private:
+  /*
+   * Fields
+   */
+  struct LoopControl {
+    PHINode *inductionVariable;
+    Value *startValue;
+    Value *exitValue;
+    ConstantInt *step;
+    CmpInst *compare;
+    CmpInst::Predicate continuePredicate;
+    BasicBlock *bodyEntry;
+    BasicBlock *latch;
+    BasicBlock *exitBlock;
+  };
+
+  /*
+   * Methods
+   */
+  bool describeLoopControl(LoopContent &LDI, LoopControl &control);
+
+  bool haveSameIterations(const LoopControl &firstControl,
+                          const LoopControl &secondControl,
+                          ScalarEvolution &SE);
+
+  bool canRunInterleaved(LoopStructure *firstLoop,
+                         LoopStructure *secondLoop,
+                         PDG *FDG,
+                         ScalarEvolution &SE);
+
+  void updateLoopForest(LoopContent &first, LoopContent &second);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_LOOP_FUSION_LOOPFUSION_H_
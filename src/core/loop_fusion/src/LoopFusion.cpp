@@ -0,0 +1,491 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/LoopFusion.hpp"
+#include "arcana/noelle/core/ControlFlowEquivalence.hpp"
+
+namespace arcana::noelle {
+
+static bool overlapOnlyAtLaterIterationsOfTheSecondLoop(
+    Instruction *firstAccess,
+    LoopStructure *firstLoop,
+    Instruction *secondAccess,
+    LoopStructure *secondLoop,
+    ScalarEvolution &SE);
+
+LoopFusion::LoopFusion() {
+
+  return;
+}
+
+bool LoopFusion::fuseLoops(LoopContent &first,
+                           LoopContent &second,
+                           PDG *FDG,
+                           DominatorSummary *DS,
+                           LoopInfo &LI,
+                           ScalarEvolution &SE) {
+  auto firstLoop = first.getLoopStructure();
+  auto secondLoop = second.getLoopStructure();
+  if ((firstLoop == secondLoop)
+      || (firstLoop->getFunction() != secondLoop->getFunction())) {
+    return false;
+  }
+  auto F = firstLoop->getFunction();
+  auto firstHeader = firstLoop->getHeader();
+  auto secondHeader = secondLoop->getHeader();
+
+  /*
+   * Check that the loops run over the same values of their loop-governing
+   * induction variables.
+   */
+  LoopControl firstControl;
+  LoopControl secondControl;
+  if (!this->describeLoopControl(first, firstControl)
+      || !this->describeLoopControl(second, secondControl)) {
+    return false;
+  }
+  if (!this->haveSameIterations(firstControl, secondControl, SE)) {
+    return false;
+  }
+
+  /*
+   * Check that the second loop starts right after the first one.
+   */
+  auto between = firstControl.exitBlock;
+  if ((between != secondLoop->getPreHeader())
+      || (between->getSinglePredecessor() != firstHeader)) {
+    return false;
+  }
+
+  /*
+   * Check that the loops are control equivalent.
+   */
+  auto root = first.getLoopHierarchyStructures();
+  while (root->getParent() != nullptr) {
+    root = root->getParent();
+  }
+  ControlFlowEquivalence cfe(DS, root, *F);
+  auto equivalences = cfe.getEquivalences(firstLoop->getPreHeader());
+  if (equivalences.find(secondLoop->getPreHeader()) == equivalences.end()) {
+    return false;
+  }
+
+  /*
+   * The header of the second loop will only jump to its exit block, so it
+   * must contain only the control of the loop.
+   * Its body will be reached from the latch of the first loop.
+   */
+  if ((secondHeader->size() != 3)
+      || (secondControl.compare->getParent() != secondHeader)
+      || !secondControl.compare->hasOneUse()
+      || (secondControl.bodyEntry->getSinglePredecessor() != secondHeader)
+      || isa<PHINode>(secondControl.bodyEntry->begin())) {
+    return false;
+  }
+
+  /*
+   * The fused loop must not leave any of the bodies early.
+   */
+  for (auto pred : predecessors(secondControl.exitBlock)) {
+    if (secondLoop->isIncluded(pred) && (pred != secondHeader)) {
+      return false;
+    }
+  }
+  for (auto loop : { firstLoop, secondLoop }) {
+    for (auto bb : loop->getBasicBlocks()) {
+      if (succ_empty(bb)) {
+        return false;
+      }
+    }
+  }
+
+  /*
+   * Values computed by the first loop cannot be used by the second one, as
+   * they will be computed by the same iteration of the fused loop.
+   */
+  auto isComputedByTheFirstLoop = [firstLoop, between](Value *v) -> bool {
+    auto inst = dyn_cast<Instruction>(v);
+    if (inst == nullptr) {
+      return false;
+    }
+    return firstLoop->isIncluded(inst)
+           || ((inst->getParent() == between) && isa<PHINode>(inst));
+  };
+  for (auto bb : secondLoop->getBasicBlocks()) {
+    for (auto &inst : *bb) {
+      for (auto &op : inst.operands()) {
+        if (isComputedByTheFirstLoop(op.get())) {
+          return false;
+        }
+      }
+    }
+  }
+
+  /*
+   * The code between the loops will run before the fused loop, so it must be
+   * safe to run before the first loop.
+   */
+  std::vector<Instruction *> instructionsToHoist;
+  for (auto &inst : *between) {
+    if (isa<PHINode>(&inst) || inst.isTerminator()) {
+      continue;
+    }
+    if (!isSafeToSpeculativelyExecute(&inst) || inst.mayReadFromMemory()) {
+      return false;
+    }
+    for (auto &op : inst.operands()) {
+      if (isComputedByTheFirstLoop(op.get())) {
+        return false;
+      }
+    }
+    instructionsToHoist.push_back(&inst);
+  }
+
+  /*
+   * Check that no memory dependence prevents running an iteration of the
+   * second loop before the later iterations of the first one.
+   */
+  if (!this->canRunInterleaved(firstLoop, secondLoop, FDG, SE)) {
+    return false;
+  }
+
+  /*
+   * Invalidate the scalar evolutions of the loops.
+   */
+  for (auto header : { firstHeader, secondHeader }) {
+    if (auto llvmLoop = LI.getLoopFor(header)) {
+      SE.forgetLoop(llvmLoop);
+    }
+  }
+
+  /*
+   * Hoist the code between the loops.
+   */
+  auto firstPreheaderTerminator = firstLoop->getPreHeader()->getTerminator();
+  for (auto inst : instructionsToHoist) {
+    inst->moveBefore(firstPreheaderTerminator);
+  }
+
+  /*
+   * Run the body of the second loop after the body of the first one.
+   */
+  firstControl.latch->getTerminator()->replaceUsesOfWith(
+      firstHeader,
+      secondControl.bodyEntry);
+  secondControl.latch->getTerminator()->replaceUsesOfWith(secondHeader,
+                                                          firstHeader);
+  for (auto &phi : firstHeader->phis()) {
+    for (auto i = 0u; i < phi.getNumIncomingValues(); i++) {
+      if (phi.getIncomingBlock(i) == firstControl.latch) {
+        phi.setIncomingBlock(i, secondControl.latch);
+      }
+    }
+  }
+
+  /*
+   * The induction variable of the first loop takes the values of the one of
+   * the second loop, whose header now jumps to its exit block.
+   */
+  auto secondIV = secondControl.inductionVariable;
+  auto secondStepValue =
+      secondIV->getIncomingValueForBlock(secondControl.latch);
+  secondIV->replaceAllUsesWith(firstControl.inductionVariable);
+  auto secondBranch = secondHeader->getTerminator();
+  BranchInst::Create(secondControl.exitBlock, secondBranch);
+  secondBranch->eraseFromParent();
+  secondControl.compare->eraseFromParent();
+  secondIV->eraseFromParent();
+  auto secondStepInst = dyn_cast<Instruction>(secondStepValue);
+  if ((secondStepInst != nullptr) && secondStepInst->use_empty()) {
+    secondStepInst->eraseFromParent();
+  }
+
+  /*
+   * Update the loop forest.
+   */
+  this->updateLoopForest(first, second);
+
+  return true;
+}
+
+bool LoopFusion::describeLoopControl(LoopContent &LDI, LoopControl &control) {
+  auto loop = LDI.getLoopStructure();
+  auto header = loop->getHeader();
+
+  /*
+   * Fetch the loop-governing induction variable.
+   * Its step must be a non-zero constant.
+   */
+  auto ivManager = LDI.getInductionVariableManager();
+  auto GIV = ivManager->getLoopGoverningInductionVariable(*loop);
+  if (GIV == nullptr) {
+    return false;
+  }
+  auto IV = GIV->getInductionVariable();
+  control.step =
+      dyn_cast_or_null<ConstantInt>(IV->getSingleComputedStepValue());
+  if ((control.step == nullptr) || control.step->isZero()) {
+    return false;
+  }
+  control.inductionVariable = IV->getLoopEntryPHI();
+
+  /*
+   * The loop must be entered from its preheader only and it must have a
+   * single latch.
+   */
+  auto preheader = loop->getPreHeader();
+  auto latches = loop->getLatches();
+  if ((preheader == nullptr) || (latches.size() != 1)
+      || (control.inductionVariable->getNumIncomingValues() != 2)
+      || (control.inductionVariable->getBasicBlockIndex(preheader) < 0)) {
+    return false;
+  }
+  control.latch = *latches.begin();
+  if (control.latch == header) {
+    return false;
+  }
+  control.startValue =
+      control.inductionVariable->getIncomingValueForBlock(preheader);
+
+  /*
+   * The loop must exit only from its header, by comparing the induction
+   * variable against an exit value.
+   */
+  auto exitBlocks = loop->getLoopExitBasicBlocks();
+  if ((exitBlocks.size() != 1)
+      || (exitBlocks[0] != GIV->getExitBlockFromHeader())) {
+    return false;
+  }
+  control.exitBlock = exitBlocks[0];
+  control.compare = dyn_cast_or_null<ICmpInst>(
+      GIV->getHeaderCompareInstructionToComputeExitCondition());
+  if ((control.compare == nullptr)
+      || (GIV->getValueToCompareAgainstExitConditionValue()
+          != control.inductionVariable)
+      || (GIV->getConditionValueDerivation().size() > 0)) {
+    return false;
+  }
+  control.exitValue = GIV->getExitConditionValue();
+  auto branch = dyn_cast<BranchInst>(header->getTerminator());
+  if ((branch == nullptr) || !branch->isConditional()) {
+    return false;
+  }
+  control.bodyEntry = loop->isIncluded(branch->getSuccessor(0))
+                          ? branch->getSuccessor(0)
+                          : branch->getSuccessor(1);
+
+  /*
+   * Compute the predicate that keeps the loop running when the induction
+   * variable is the first operand of the compare.
+   */
+  auto predicate = control.compare->getPredicate();
+  if (control.compare->getOperand(1) == control.inductionVariable) {
+    predicate = CmpInst::getSwappedPredicate(predicate);
+  }
+  if (!GIV->valueOfExitConditionToJumpToTheLoopBody()) {
+    predicate = CmpInst::getInversePredicate(predicate);
+  }
+  control.continuePredicate = predicate;
+
+  return true;
+}
+
+bool LoopFusion::haveSameIterations(const LoopControl &firstControl,
+                                    const LoopControl &secondControl,
+                                    ScalarEvolution &SE) {
+
+  /*
+   * The induction variables must be updated and compared the same way.
+   */
+  if ((firstControl.inductionVariable->getType()
+       != secondControl.inductionVariable->getType())
+      || (firstControl.step->getValue() != secondControl.step->getValue())
+      || (firstControl.continuePredicate != secondControl.continuePredicate)) {
+    return false;
+  }
+
+  /*
+   * The induction variables must start from, and be compared against, the
+   * same values.
+   */
+  auto isSameValue = [&SE](Value *a, Value *b) -> bool {
+    if (a == b) {
+      return true;
+    }
+    if (!SE.isSCEVable(a->getType())) {
+      return false;
+    }
+    return SE.getSCEV(a) == SE.getSCEV(b);
+  };
+  return isSameValue(firstControl.startValue, secondControl.startValue)
+         && isSameValue(firstControl.exitValue, secondControl.exitValue);
+}
+
+bool LoopFusion::canRunInterleaved(LoopStructure *firstLoop,
+                                   LoopStructure *secondLoop,
+                                   PDG *FDG,
+                                   ScalarEvolution &SE) {
+
+  /*
+   * Every memory dependence between the two loops must connect an iteration
+   * of the first loop to the same or a later iteration of the second one.
+   */
+  for (auto edge : FDG->getEdges()) {
+    if (!isa<MemoryDependence<Value, Value>>(edge)) {
+      continue;
+    }
+    auto src = dyn_cast<Instruction>(edge->getSrc());
+    auto dst = dyn_cast<Instruction>(edge->getDst());
+    if ((src == nullptr) || (dst == nullptr)) {
+      continue;
+    }
+    Instruction *firstAccess = nullptr;
+    Instruction *secondAccess = nullptr;
+    if (firstLoop->isIncluded(src) && secondLoop->isIncluded(dst)) {
+      firstAccess = src;
+      secondAccess = dst;
+    } else if (firstLoop->isIncluded(dst) && secondLoop->isIncluded(src)) {
+      firstAccess = dst;
+      secondAccess = src;
+    } else {
+      continue;
+    }
+    if (!overlapOnlyAtLaterIterationsOfTheSecondLoop(firstAccess,
+                                                     firstLoop,
+                                                     secondAccess,
+                                                     secondLoop,
+                                                     SE)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void LoopFusion::updateLoopForest(LoopContent &first, LoopContent &second) {
+
+  /*
+   * The first loop now includes the blocks of the second one.
+   */
+  auto firstTree = first.getLoopHierarchyStructures();
+  auto firstLoop = firstTree->getLoop();
+  auto F = firstLoop->getFunction();
+  DominatorTree DT(*F);
+  LoopInfo LI(DT);
+  firstLoop->updateStructure(LI.getLoopFor(firstLoop->getHeader()));
+
+  /*
+   * The sub-loops of the second loop are now sub-loops of the first one.
+   */
+  auto secondTree = second.getLoopHierarchyStructures();
+  auto forest = firstTree->getForest();
+  if ((secondTree->getForest() == forest)
+      && (secondTree->getParent() == firstTree->getParent())) {
+    forest->mergeTree(secondTree, firstTree);
+  }
+
+  return;
+}
+
+static bool overlapOnlyAtLaterIterationsOfTheSecondLoop(
+    Instruction *firstAccess,
+    LoopStructure *firstLoop,
+    Instruction *secondAccess,
+    LoopStructure *secondLoop,
+    ScalarEvolution &SE) {
+
+  /*
+   * Fetch the address and the number of bytes of the accesses.
+   */
+  auto &DL = firstLoop->getFunction()->getParent()->getDataLayout();
+  auto describeAccess = [&DL](Instruction *inst,
+                              Value *&pointer,
+                              uint64_t &bytes) -> bool {
+    if (auto load = dyn_cast<LoadInst>(inst)) {
+      pointer = load->getPointerOperand();
+      bytes = DL.getTypeStoreSize(load->getType());
+      return load->isSimple();
+    }
+    if (auto store = dyn_cast<StoreInst>(inst)) {
+      pointer = store->getPointerOperand();
+      bytes = DL.getTypeStoreSize(store->getValueOperand()->getType());
+      return store->isSimple();
+    }
+    return false;
+  };
+  Value *firstPointer = nullptr;
+  Value *secondPointer = nullptr;
+  uint64_t firstBytes = 0;
+  uint64_t secondBytes = 0;
+  if (!describeAccess(firstAccess, firstPointer, firstBytes)
+      || !describeAccess(secondAccess, secondPointer, secondBytes)
+      || (firstBytes != secondBytes)) {
+    return false;
+  }
+
+  /*
+   * The addresses must be affine in the iterations of their loop, with the
+   * same constant stride, and at a constant distance from each other.
+   */
+  auto fetchAddRec = [&SE](Value *pointer,
+                           LoopStructure *loop) -> const SCEVAddRecExpr * {
+    auto addRec = dyn_cast<SCEVAddRecExpr>(SE.getSCEV(pointer));
+    if ((addRec == nullptr) || !addRec->isAffine()
+        || (addRec->getLoop()->getHeader() != loop->getHeader())) {
+      return nullptr;
+    }
+    return addRec;
+  };
+  auto firstAddRec = fetchAddRec(firstPointer, firstLoop);
+  auto secondAddRec = fetchAddRec(secondPointer, secondLoop);
+  if ((firstAddRec == nullptr) || (secondAddRec == nullptr)) {
+    return false;
+  }
+  auto firstStride =
+      dyn_cast<SCEVConstant>(firstAddRec->getStepRecurrence(SE));
+  auto secondStride =
+      dyn_cast<SCEVConstant>(secondAddRec->getStepRecurrence(SE));
+  auto distance = dyn_cast<SCEVConstant>(
+      SE.getMinusSCEV(firstAddRec->getStart(), secondAddRec->getStart()));
+  if ((firstStride == nullptr) || (secondStride == nullptr)
+      || (distance == nullptr)
+      || (firstStride->getAPInt() != secondStride->getAPInt())
+      || (firstStride->getAPInt().getMinSignedBits() > 62)
+      || (distance->getAPInt().getMinSignedBits() > 62)) {
+    return false;
+  }
+  auto stride = firstStride->getAPInt().getSExtValue();
+  auto delta = distance->getAPInt().getSExtValue();
+  if (stride < 0) {
+    stride = -stride;
+    delta = -delta;
+  }
+
+  /*
+   * The first access at iteration x and the second one at iteration y
+   * overlap when |delta + stride * (x - y)| < bytes.
+   * No overlap exists with y < x if delta + stride >= bytes.
+   */
+  auto bytes = static_cast<int64_t>(firstBytes);
+  return (delta + stride) >= bytes;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_LOOP_INTERCHANGE_LOOPINTERCHANGE_H_
+#define NOELLE_SRC_CORE_LOOP_INTERCHANGE_LOOPINTERCHANGE_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/LoopContent.hpp"
+#include "arcana/noelle/core/PerfectLoopNest.hpp"
+
+namespace arcana::noelle {
+
+class LoopInterchange {
+public:
+  /*
+   * Methods
+   */
+  LoopInterchange();
+
+  /*
+   * Reorder the loops of the perfect loop nest rooted at the loop of @LDI
+   * (see PerfectLoopNest; loops can be brought in while form with
+   * LoopWhilifier first).
+   *
+   * @permutation[i] is the depth, from 0, of the loop of the nest that becomes
+   * the i-th one. If @permutation is empty, the most profitable legal order is
+   * computed (see computeProfitablePermutation).
+   *
+   * The basic blocks of the nest are preserved: the loops exchange their
+   * induction variables and bounds. Hence, the loop forest of @LDI is still
+   * valid, while its other abstractions (e.g., induction variables) describe
+   * the nest before the interchange and they need to be recomputed.
+   * The SCEVs of the nest cached by @SE are invalidated.
+   *
+   * Return true if the loops have been reordered.
+   */
+  bool interchangeLoops(LoopContent &LDI,
+                        const std::vector<uint32_t> &permutation,
+                        LoopInfo &LI,
+                        ScalarEvolution &SE);
+
+  /*
+   * Compute the order of the loops of @nest that minimizes the number of
+   * cache lines its memory accesses touch per iteration of the innermost
+   * loop, among the orders that preserve the memory dependences.
+   * The returned order is the identity if no better one exists.
+   */
+  std::vector<uint32_t> computeProfitablePermutation(
+      const PerfectLoopNest &nest,
+      ScalarEvolution &SE);
+
+private:
+  /*
+   * Methods
+   */
+  uint64_t computeCacheCostOfInnermostLoop(const PerfectLoopNest &nest,
+                                           uint32_t depth,
+                                           ScalarEvolution &SE);
+
+  bool canExchangeInductionVariables(const PerfectLoopNest &nest,
+                                     const std::vector<uint32_t> &permutation);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_LOOP_INTERCHANGE_LOOPINTERCHANGE_H_
@@ -0,0 +1,386 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/LoopInterchange.hpp"
+#include "arcana/noelle/core/Architecture.hpp"
+
+namespace arcana::noelle {
+
+static BinaryOperator *getStepInstruction(
+    const PerfectLoopNest::CountedLoop &countedLoop);
+
+LoopInterchange::LoopInterchange() {
+
+  return;
+}
+
+bool LoopInterchange::interchangeLoops(
+    LoopContent &LDI,
+    const std::vector<uint32_t> &permutation,
+    LoopInfo &LI,
+    ScalarEvolution &SE) {
+
+  /*
+   * Check that the loop is the root of a perfect nest of counted loops.
+   */
+  PerfectLoopNest nest(LDI, SE);
+  if (!nest.isValid() || (nest.getDepth() < 2)) {
+    return false;
+  }
+  auto depth = nest.getDepth();
+  auto &loops = nest.getLoops();
+
+  /*
+   * Choose the new order of the loops.
+   */
+  auto order = permutation;
+  if (order.empty()) {
+    order = this->computeProfitablePermutation(nest, SE);
+  }
+  if (order.size() != depth) {
+    return false;
+  }
+  std::vector<bool> isPlaced(depth, false);
+  std::vector<uint32_t> positionOf(depth);
+  auto isIdentity = true;
+  for (auto position = 0u; position < depth; position++) {
+    auto loopDepth = order[position];
+    if ((loopDepth >= depth) || isPlaced[loopDepth]) {
+      return false;
+    }
+    isPlaced[loopDepth] = true;
+    positionOf[loopDepth] = position;
+    if (loopDepth != position) {
+      isIdentity = false;
+    }
+  }
+  if (isIdentity) {
+    return false;
+  }
+
+  /*
+   * Check the legality of the new order.
+   * The profitable order has been checked while computing it.
+   */
+  if (!permutation.empty()) {
+    if (!nest.isPermutationLegal(order)
+        || !this->canExchangeInductionVariables(nest, order)) {
+      return false;
+    }
+  }
+
+  /*
+   * Fetch the LLVM loop of the nest, whose SCEVs become stale.
+   */
+  auto llvmTopLoop = LI.getLoopFor(loops[0].loop->getHeader());
+
+  /*
+   * Collect the uses of the induction variables that are not part of the
+   * control of their loop.
+   * The induction variable of the loop at depth @k will be computed by the
+   * header of the loop at depth positionOf[k].
+   */
+  std::vector<std::pair<Use *, PHINode *>> usesToRedirect;
+  for (auto k = 0u; k < depth; k++) {
+    auto &countedLoop = loops[k];
+    auto IV = countedLoop.inductionVariable;
+    if (positionOf[k] == k) {
+      continue;
+    }
+    auto stepInst = getStepInstruction(countedLoop);
+    auto newIV = loops[positionOf[k]].inductionVariable;
+    for (auto &use : IV->uses()) {
+      auto user = use.getUser();
+      if ((user == stepInst) || (user == countedLoop.compare)) {
+        continue;
+      }
+      usesToRedirect.push_back(std::make_pair(&use, newIV));
+    }
+  }
+
+  /*
+   * Make the header of each loop iterate over the iteration space of the loop
+   * that takes its position.
+   */
+  for (auto position = 0u; position < depth; position++) {
+    if (order[position] == position) {
+      continue;
+    }
+    auto &target = loops[position];
+    auto &source = loops[order[position]];
+    auto IV = target.inductionVariable;
+
+    /*
+     * Set the start value and the step.
+     */
+    IV->setIncomingValue(IV->getBasicBlockIndex(target.loop->getPreHeader()),
+                         source.startValue);
+    auto stepInst = getStepInstruction(target);
+    auto stepOperand = isa<ConstantInt>(stepInst->getOperand(1)) ? 1 : 0;
+    stepInst->setOperand(stepOperand,
+                         ConstantInt::get(IV->getType(), source.step));
+    stepInst->setHasNoSignedWrap(false);
+    stepInst->setHasNoUnsignedWrap(false);
+
+    /*
+     * Set the exit condition.
+     */
+    auto branch = cast<BranchInst>(target.loop->getHeader()->getTerminator());
+    auto predicate = source.continuePredicate;
+    if (!target.loop->isIncluded(branch->getSuccessor(0))) {
+      predicate = CmpInst::getInversePredicate(predicate);
+    }
+    IRBuilder<> builder(target.compare);
+    auto compare = builder.CreateICmp(predicate, IV, source.exitValue);
+    target.compare->replaceAllUsesWith(compare);
+    target.compare->eraseFromParent();
+  }
+
+  /*
+   * Redirect the uses of the induction variables.
+   */
+  for (auto &pair : usesToRedirect) {
+    pair.first->set(pair.second);
+  }
+
+  /*
+   * Update the analyses.
+   * The SCEVs of the whole nest (not only the ones of the induction
+   * variables) depend on the order of its loops.
+   */
+  if (llvmTopLoop != nullptr) {
+    SE.forgetLoop(llvmTopLoop);
+  }
+
+  return true;
+}
+
+std::vector<uint32_t> LoopInterchange::computeProfitablePermutation(
+    const PerfectLoopNest &nest,
+    ScalarEvolution &SE) {
+  auto depth = nest.getDepth();
+  std::vector<uint32_t> identity(depth);
+  for (auto i = 0u; i < depth; i++) {
+    identity[i] = i;
+  }
+  if (!nest.isValid() || (depth < 2)) {
+    return identity;
+  }
+
+  /*
+   * Compute the cost of running each loop innermost.
+   */
+  std::vector<uint64_t> costs(depth);
+  std::vector<uint32_t> candidates(depth);
+  for (auto k = 0u; k < depth; k++) {
+    costs[k] = this->computeCacheCostOfInnermostLoop(nest, k, SE);
+    candidates[k] = k;
+  }
+  std::stable_sort(candidates.begin(),
+                   candidates.end(),
+                   [&costs](uint32_t a, uint32_t b) -> bool {
+                     return costs[a] < costs[b];
+                   });
+
+  /*
+   * Move the cheapest loop that can legally run innermost to the innermost
+   * position, keeping the relative order of the other loops.
+   */
+  for (auto k : candidates) {
+    if (costs[k] >= costs[depth - 1]) {
+      break;
+    }
+    std::vector<uint32_t> permutation;
+    for (auto l = 0u; l < depth; l++) {
+      if (l != k) {
+        permutation.push_back(l);
+      }
+    }
+    permutation.push_back(k);
+    if (nest.isPermutationLegal(permutation)
+        && this->canExchangeInductionVariables(nest, permutation)) {
+      return permutation;
+    }
+  }
+
+  return identity;
+}
+
+uint64_t LoopInterchange::computeCacheCostOfInnermostLoop(
+    const PerfectLoopNest &nest,
+    uint32_t depth,
+    ScalarEvolution &SE) {
+  uint64_t lineBytes = Architecture::getCacheLineBytes(1);
+  auto header = nest.getLoops()[depth].loop->getHeader();
+
+  /*
+   * Every access touches a new cache line at each iteration of the loop,
+   * unless its stride along the loop is smaller than a cache line.
+   */
+  uint64_t cost = 0;
+  for (auto access : nest.getMemoryAccesses()) {
+    auto pointer = isa<LoadInst>(access)
+                       ? cast<LoadInst>(access)->getPointerOperand()
+                       : cast<StoreInst>(access)->getPointerOperand();
+
+    /*
+     * Fetch the stride of the access along the loop.
+     * The address of an access of the nest is a chain of add recurrences,
+     * from the innermost loop that changes it.
+     */
+    auto addressSCEV = SE.getSCEV(pointer);
+    const SCEV *stride = nullptr;
+    while (auto addRec = dyn_cast<SCEVAddRecExpr>(addressSCEV)) {
+      if (addRec->getLoop()->getHeader() == header) {
+        stride = addRec->getStepRecurrence(SE);
+        break;
+      }
+      addressSCEV = addRec->getStart();
+    }
+    if (stride == nullptr) {
+      if (!SE.containsAddRecurrence(addressSCEV)) {
+
+        /*
+         * The address does not change along the loop.
+         */
+        continue;
+      }
+      cost += lineBytes;
+      continue;
+    }
+
+    /*
+     * Accumulate the bytes of new cache lines the access touches per
+     * iteration.
+     */
+    auto constantStride = dyn_cast<SCEVConstant>(stride);
+    if (constantStride == nullptr) {
+      cost += lineBytes;
+      continue;
+    }
+    auto strideBytes = constantStride->getAPInt().abs().getLimitedValue();
+    cost += std::min(strideBytes, lineBytes);
+  }
+
+  return cost;
+}
+
+bool LoopInterchange::canExchangeInductionVariables(
+    const PerfectLoopNest &nest,
+    const std::vector<uint32_t> &permutation) {
+  auto depth = nest.getDepth();
+  auto &loops = nest.getLoops();
+  std::vector<uint32_t> positionOf(depth);
+  for (auto position = 0u; position < depth; position++) {
+    positionOf[permutation[position]] = position;
+  }
+
+  /*
+   * Return the depth of the innermost loop of the nest that includes @bb.
+   */
+  auto depthOf = [&loops](BasicBlock *bb) -> uint32_t {
+    for (auto d = loops.size(); d > 1; d--) {
+      if (loops[d - 1].loop->isIncluded(bb)) {
+        return d - 1;
+      }
+    }
+    return 0;
+  };
+
+  auto type = loops.front().inductionVariable->getType();
+  for (auto k = 0u; k < depth; k++) {
+    auto &countedLoop = loops[k];
+    auto IV = countedLoop.inductionVariable;
+    if (positionOf[k] == k) {
+      continue;
+    }
+
+    /*
+     * Loops exchange their induction variables, so they must have the same
+     * type.
+     */
+    if (IV->getType() != type) {
+      return false;
+    }
+
+    /*
+     * The control of the loop must be made only of the induction variable,
+     * its update, and the compare that feeds the branch of the header.
+     */
+    auto stepInst = getStepInstruction(countedLoop);
+    if ((stepInst == nullptr) || !stepInst->hasOneUse()) {
+      return false;
+    }
+    auto branch = countedLoop.loop->getHeader()->getTerminator();
+    if (!countedLoop.compare->hasOneUse()
+        || (*countedLoop.compare->user_begin() != branch)) {
+      return false;
+    }
+
+    /*
+     * The induction variable will be computed by the header at depth
+     * positionOf[k], so it can only be used by code within that loop.
+     */
+    for (auto user : IV->users()) {
+      if ((user == stepInst) || (user == countedLoop.compare)) {
+        continue;
+      }
+      auto userInst = cast<Instruction>(user);
+      if (isa<PHINode>(userInst)
+          || (depthOf(userInst->getParent()) < positionOf[k])) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+static BinaryOperator *getStepInstruction(
+    const PerfectLoopNest::CountedLoop &countedLoop) {
+  auto IV = countedLoop.inductionVariable;
+  auto preheader = countedLoop.loop->getPreHeader();
+  for (auto i = 0u; i < IV->getNumIncomingValues(); i++) {
+    if (IV->getIncomingBlock(i) == preheader) {
+      continue;
+    }
+
+    /*
+     * The value that comes from the latch must be iv + step.
+     */
+    auto stepInst = dyn_cast<BinaryOperator>(IV->getIncomingValue(i));
+    if ((stepInst == nullptr) || (stepInst->getOpcode() != Instruction::Add)) {
+      return nullptr;
+    }
+    auto isIVPlusConstant = (stepInst->getOperand(0) == IV)
+                            && isa<ConstantInt>(stepInst->getOperand(1));
+    auto isConstantPlusIV = (stepInst->getOperand(1) == IV)
+                            && isa<ConstantInt>(stepInst->getOperand(0));
+    if (!isIVPlusConstant && !isConstantPlusIV) {
+      return nullptr;
+    }
+    return stepInst;
+  }
+
+  return nullptr;
+}
+
+} // namespace arcana::noelle
@@ -34,6 +34,45 @@ namespace arcana::noelle {
 
 class LoopIterationSpaceAnalysis {
 public:
+  /*
+   * Directions of a dependence with respect to the iterations of a loop.
+   * DIRECTION_BEFORE: the source accesses memory at an earlier iteration than
+   * the destination.
+   * DIRECTION_AFTER: the source accesses memory at a later iteration than the
+   * destination.
+   */
+  enum DependenceDirection : uint8_t {
+    DIRECTION_NONE = 0,
+    DIRECTION_BEFORE = 1,
+    DIRECTION_SAME = 2,
+    DIRECTION_AFTER = 4,
+    DIRECTION_ANY = 7
+  };
+
+  /*
+   * Dependence between two memory accesses of the loop nest.
+   * Loops are the ones that include both accesses, from the outermost to the
+   * innermost.
+   * For each of them, we store the set of possible directions (a bitmask of
+   * DependenceDirection) and the distance in iterations when it is constant.
+   */
+  struct DependenceVector {
+    std::vector<LoopStructure *> loops;
+    std::vector<uint8_t> directions;
+    std::vector<std::optional<int64_t>> distances;
+  };
+
+  /*
+   * Outcome of the dependence tests on a pair of accesses.
+   * DEPENDENCE_WITHIN_ITERATIONS: the accesses may overlap only within the
+   * same iteration of all common loops.
+   */
+  enum DependenceClassification : uint8_t {
+    DEPENDENCE_DISPROVED,
+    DEPENDENCE_WITHIN_ITERATIONS,
+    DEPENDENCE_MAY_BE_LOOP_CARRIED
+  };
+
   LoopIterationSpaceAnalysis(LoopTree *loops,
                              InductionVariableManager &ivManager,
                              ScalarEvolution &SE);
@@ -44,6 +83,58 @@ public:
       Instruction *from,
       Instruction *to) const;
 
+  /*
+   * Compute the dependence vector from @from to @to by running the GCD, the
+   * Banerjee, and (for small iteration spaces) the exhaustive dependence tests
+   * on the affine subscripts of the two accesses.
+   * Return std::nullopt if the accesses cannot be analyzed.
+   */
+  std::optional<DependenceVector> computeDependenceVector(
+      Instruction *from,
+      Instruction *to) const;
+
+  /*
+   * Return true if the dependence tests prove that @to never accesses the
+   * memory location accessed by @from at an earlier iteration of any loop of
+   * the nest.
+   */
+  bool isLoopCarriedDependenceDisproved(Instruction *from,
+                                        Instruction *to) const;
+
+  /*
+   * Return true if the dependence tests prove that @from and @to never access
+   * the same memory location.
+   */
+  bool isDependenceDisproved(Instruction *from, Instruction *to) const;
+
+  /*
+   * Combine isDependenceDisproved and isLoopCarriedDependenceDisproved while
+   * building the dependence equations of the two accesses only once.
+   * Return DEPENDENCE_MAY_BE_LOOP_CARRIED when the accesses cannot be
+   * analyzed.
+   */
+  DependenceClassification classifyDependence(Instruction *from,
+                                              Instruction *to) const;
+
+  /*
+   * Maximum number of iteration tuples the exhaustive test can enumerate per
+   * query (0 disables it; the default is 2^16). Above the bound, only the GCD
+   * and the Banerjee tests run.
+   */
+  uint64_t getExhaustiveTestBudget(void) const;
+  void setExhaustiveTestBudget(uint64_t tuples);
+
+  /*
+   * Return true if @to may access the memory location accessed by @from when
+   * the iterations of the common loops (from the outermost) satisfy
+   * @directions (a bitmask of DependenceDirection per loop; missing loops
+   * have DIRECTION_ANY).
+   * Return true also when the accesses cannot be analyzed.
+   */
+  bool mayDependWithDirections(Instruction *from,
+                               Instruction *to,
+                               const std::vector<uint8_t> &directions) const;
+
   ~LoopIterationSpaceAnalysis();
 
 private:
@@ -75,11 +166,56 @@ private:
     SmallVector<std::pair<Instruction *, InductionVariable *>, 4> subscriptIVs;
   };
 
+  /*
+   * Affine function of the iterations of the loops of the nest:
+   * constant + symbol + sum(coefficients[loop] * iteration of loop).
+   * The symbol is a loop-nest invariant SCEV (nullptr if there is none).
+   */
+  struct AffineExpression {
+    int64_t constant = 0;
+    const SCEV *symbol = nullptr;
+    std::map<LoopStructure *, int64_t> coefficients;
+  };
+
+  /*
+   * Load or store whose address is an affine function of the iterations of
+   * the loops of the nest.
+   */
+  struct AffineAccess {
+    const SCEV *basePointer = nullptr;
+    uint64_t accessSize = 0;
+
+    /*
+     * Loops of the nest that include the access, from the outermost.
+     */
+    std::vector<LoopStructure *> loops;
+
+    /*
+     * Offset in bytes from the base pointer.
+     */
+    bool isOffsetAffine = false;
+    AffineExpression offset;
+
+    /*
+     * Subscripts of the delinearized access, in elements.
+     * They are set only if all the inner dimensions are proven to stay within
+     * their sizes.
+     */
+    std::vector<AffineExpression> subscripts;
+    std::vector<const SCEV *> sizes;
+  };
+
+  /*
+   * Dependence equations between two affine accesses.
+   */
+  struct DependenceSystem;
+
   /*
    * Long-lived references
    */
   LoopTree *loops;
   InductionVariableManager &ivManager;
+  uint64_t exhaustiveTestBudget;
 
   /*
    * Associate SCEVs with all IV instructions matching that evolution
@@ -104,6 +240,13 @@ private:
   std::unordered_set<MemoryAccessSpace *>
       nonOverlappingAccessesBetweenIterations;
 
+  /*
+   * Affine accesses and the maximum iteration index of the loops of the nest
+   * (when known) used by the dependence tests
+   */
+  std::unordered_map<Instruction *, AffineAccess> affineAccesses;
+  std::unordered_map<LoopStructure *, uint64_t> maximumIterationOfLoop;
+
   /*
    * Methods
    */
@@ -126,6 +269,32 @@ private:
 
   bool isInnerDimensionSubscriptsBounded(ScalarEvolution &SE,
                                          MemoryAccessSpace *space);
+
+  void computeAffineAccesses(ScalarEvolution &SE);
+
+  bool decomposeAffineExpression(
+      ScalarEvolution &SE,
+      const SCEV *expression,
+      Instruction *access,
+      int64_t factor,
+      std::unordered_map<BasicBlock *, LoopStructure *> &nestLoops,
+      AffineExpression &affineExpression);
+
+  bool isInvariantInTheLoopNest(const SCEV *expression) const;
+
+  bool isSubscriptWithinSize(ScalarEvolution &SE,
+                             const SCEV *subscript,
+                             const AffineExpression &affineSubscript,
+                             const SCEV *size) const;
+
+  bool buildDependenceSystem(Instruction *from,
+                             Instruction *to,
+                             DependenceSystem &system) const;
+
+  bool mayDepend(const DependenceSystem &system,
+                 const std::vector<uint8_t> &directions) const;
+
+  bool mayBeLoopCarried(const DependenceSystem &system) const;
 };
 
 } // namespace arcana::noelle
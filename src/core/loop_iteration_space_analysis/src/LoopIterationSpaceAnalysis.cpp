@@ -28,7 +28,14 @@ LoopIterationSpaceAnalysis::LoopIterationSpaceAnalysis(
     InductionVariableManager &ivManager,
     ScalarEvolution &SE)
   : loops{ loops },
-    ivManager{ ivManager } {
+    ivManager{ ivManager },
+    exhaustiveTestBudget{ 1 << 16 } {
+
+  /*
+   * Describe the loads and stores whose addresses are affine functions of the
+   * iterations of the loop nest for the dependence tests
+   */
+  computeAffineAccesses(SE);
 
   /*
    * Map IV instructions to SCEVs for quick lookup
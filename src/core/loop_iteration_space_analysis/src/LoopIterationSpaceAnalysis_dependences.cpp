@@ -0,0 +1,1129 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/LoopIterationSpaceAnalysis.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Value larger than any bound of a dependence equation.
+ * It represents unbounded ranges.
+ */
+static const __int128 unbounded = ((__int128)1) << 120;
+
+/*
+ * Equation between the subscripts of two accesses:
+ * sum(fromCoefficients[l] * x_l) - sum(toCoefficients[l] * y_l)
+ *   + sum(otherCoefficients[v] * z_v) + constant
+ * must be within [lowest, highest] for the two accesses to overlap.
+ * x_l and y_l are the iterations of the common loop l of the source and the
+ * destination respectively; z_v are the iterations of the loops that include
+ * only one of the two accesses.
+ */
+struct DependenceEquation {
+  std::vector<int64_t> fromCoefficients;
+  std::vector<int64_t> toCoefficients;
+  std::vector<int64_t> otherCoefficients;
+  __int128 constant = 0;
+  __int128 lowest = 0;
+  __int128 highest = 0;
+};
+
+struct LoopIterationSpaceAnalysis::DependenceSystem {
+  std::vector<LoopStructure *> commonLoops;
+  std::vector<std::optional<uint64_t>> commonLoopBounds;
+  std::vector<std::optional<uint64_t>> otherLoopBounds;
+  std::vector<DependenceEquation> equations;
+};
+
+static void addRange(__int128 &minimum,
+                     __int128 &maximum,
+                     __int128 termMinimum,
+                     __int128 termMaximum) {
+  minimum = ((minimum <= -unbounded) || (termMinimum <= -unbounded))
+                ? -unbounded
+                : minimum + termMinimum;
+  maximum = ((maximum >= unbounded) || (termMaximum >= unbounded))
+                ? unbounded
+                : maximum + termMaximum;
+
+  return;
+}
+
+/*
+ * Range of coefficient * t for 0 <= t <= bound.
+ */
+static void rangeOfTerm(__int128 coefficient,
+                        std::optional<uint64_t> bound,
+                        __int128 &minimum,
+                        __int128 &maximum) {
+  if (coefficient == 0) {
+    minimum = 0;
+    maximum = 0;
+    return;
+  }
+  if (!bound) {
+    minimum = (coefficient > 0) ? 0 : -unbounded;
+    maximum = (coefficient > 0) ? unbounded : 0;
+    return;
+  }
+  auto extreme = coefficient * (__int128)*bound;
+  minimum = std::min<__int128>(0, extreme);
+  maximum = std::max<__int128>(0, extreme);
+
+  return;
+}
+
+/*
+ * Range of a * x - b * y for the iterations x and y of a loop that satisfy
+ * @direction (Banerjee bounds).
+ * Return false if no pair of iterations satisfies @direction.
+ */
+static bool rangeOfCommonLoopTerm(__int128 a,
+                                  __int128 b,
+                                  std::optional<uint64_t> bound,
+                                  uint8_t direction,
+                                  __int128 &minimum,
+                                  __int128 &maximum) {
+  switch (direction) {
+    case LoopIterationSpaceAnalysis::DIRECTION_SAME:
+      rangeOfTerm(a - b, bound, minimum, maximum);
+      return true;
+
+    case LoopIterationSpaceAnalysis::DIRECTION_ANY: {
+      __int128 minimumY, maximumY;
+      rangeOfTerm(a, bound, minimum, maximum);
+      rangeOfTerm(-b, bound, minimumY, maximumY);
+      addRange(minimum, maximum, minimumY, maximumY);
+      return true;
+    }
+
+    case LoopIterationSpaceAnalysis::DIRECTION_BEFORE:
+    case LoopIterationSpaceAnalysis::DIRECTION_AFTER:
+      break;
+
+    default:
+      abort();
+  }
+
+  /*
+   * The iterations must differ, so the loop must have at least two.
+   */
+  if (bound && (*bound < 1)) {
+    return false;
+  }
+
+  /*
+   * The value at the corner of the iteration space (x = 0, y = 1 for BEFORE;
+   * x = 1, y = 0 for AFTER) and the value of a step along the two edges of
+   * the space that start there.
+   */
+  auto isBefore = (direction == LoopIterationSpaceAnalysis::DIRECTION_BEFORE);
+  auto corner = isBefore ? -b : a;
+  auto alongSingleLoop = isBefore ? -b : a;
+  auto alongBothLoops = a - b;
+  if (!bound) {
+
+    /*
+     * The iteration space is an unbounded cone.
+     */
+    minimum = ((alongSingleLoop < 0) || (alongBothLoops < 0)) ? -unbounded
+                                                                : corner;
+    maximum = ((alongSingleLoop > 0) || (alongBothLoops > 0)) ? unbounded
+                                                                : corner;
+    return true;
+  }
+
+  /*
+   * The iteration space is a triangle; the extremes are at its vertices.
+   */
+  __int128 u = *bound;
+  std::vector<__int128> vertices;
+  if (isBefore) {
+    vertices = { -b, -b * u, a * (u - 1) - b * u };
+  } else {
+    vertices = { a, a * u, a * u - b * (u - 1) };
+  }
+  minimum = *std::min_element(vertices.begin(), vertices.end());
+  maximum = *std::max_element(vertices.begin(), vertices.end());
+
+  return true;
+}
+
+/*
+ * Banerjee test: check whether the range of the left-hand side of @equation
+ * intersects its window.
+ */
+static bool isFeasibleByBanerjee(
+    const DependenceEquation &equation,
+    const std::vector<std::optional<uint64_t>> &commonLoopBounds,
+    const std::vector<std::optional<uint64_t>> &otherLoopBounds,
+    const std::vector<uint8_t> &directions) {
+  __int128 minimum = equation.constant;
+  __int128 maximum = equation.constant;
+  for (auto l = 0u; l < directions.size(); l++) {
+    __int128 termMinimum, termMaximum;
+    if (!rangeOfCommonLoopTerm(equation.fromCoefficients[l],
+                               equation.toCoefficients[l],
+                               commonLoopBounds[l],
+                               directions[l],
+                               termMinimum,
+                               termMaximum)) {
+      return false;
+    }
+    addRange(minimum, maximum, termMinimum, termMaximum);
+  }
+  for (auto v = 0u; v < otherLoopBounds.size(); v++) {
+    __int128 termMinimum, termMaximum;
+    rangeOfTerm(equation.otherCoefficients[v],
+                otherLoopBounds[v],
+                termMinimum,
+                termMaximum);
+    addRange(minimum, maximum, termMinimum, termMaximum);
+  }
+
+  return (maximum >= equation.lowest) && (minimum <= equation.highest);
+}
+
+/*
+ * GCD test: check whether the left-hand side of @equation can be equal to a
+ * value of its window with integer iterations.
+ */
+static bool isFeasibleByGCD(const DependenceEquation &equation,
+                            const std::vector<uint8_t> &directions) {
+
+  /*
+   * Rewrite the directions as equalities.
+   * BEFORE: y = x + 1 + e, which adds (a - b) * x - b * e - b.
+   * AFTER: x = y + 1 + e, which adds (a - b) * y + a * e + a.
+   */
+  __int128 constant = equation.constant;
+  std::vector<__int128> coefficients;
+  for (auto l = 0u; l < directions.size(); l++) {
+    __int128 a = equation.fromCoefficients[l];
+    __int128 b = equation.toCoefficients[l];
+    switch (directions[l]) {
+      case LoopIterationSpaceAnalysis::DIRECTION_SAME:
+        coefficients.push_back(a - b);
+        break;
+      case LoopIterationSpaceAnalysis::DIRECTION_BEFORE:
+        coefficients.push_back(a - b);
+        coefficients.push_back(b);
+        constant -= b;
+        break;
+      case LoopIterationSpaceAnalysis::DIRECTION_AFTER:
+        coefficients.push_back(a - b);
+        coefficients.push_back(a);
+        constant += a;
+        break;
+      default:
+        coefficients.push_back(a);
+        coefficients.push_back(b);
+        break;
+    }
+  }
+  for (auto coefficient : equation.otherCoefficients) {
+    coefficients.push_back(coefficient);
+  }
+
+  /*
+   * Compute the GCD of the coefficients.
+   */
+  __int128 gcd = 0;
+  for (auto coefficient : coefficients) {
+    auto value = (coefficient < 0) ? -coefficient : coefficient;
+    while (value != 0) {
+      auto remainder = gcd % value;
+      gcd = value;
+      value = remainder;
+    }
+  }
+  if (gcd == 0) {
+    return (constant >= equation.lowest) && (constant <= equation.highest);
+  }
+
+  /*
+   * Check whether the window includes a value w such that the GCD divides
+   * w - constant.
+   */
+  auto offset = (constant - equation.lowest) % gcd;
+  if (offset < 0) {
+    offset += gcd;
+  }
+
+  return (equation.lowest + offset) <= equation.highest;
+}
+
+/*
+ * Exhaustive test: enumerate all iterations that satisfy @directions and check
+ * whether one of them satisfies all equations.
+ * Return true if a solution exists or the iteration space has more than
+ * @budget tuples.
+ */
+static bool isFeasibleByEnumeration(
+    const std::vector<DependenceEquation> &equations,
+    const std::vector<std::optional<uint64_t>> &commonLoopBounds,
+    const std::vector<std::optional<uint64_t>> &otherLoopBounds,
+    const std::vector<uint8_t> &directions,
+    uint64_t budget) {
+  if (budget == 0) {
+    return true;
+  }
+
+  /*
+   * Loops whose iterations do not appear in any equation do not need to be
+   * enumerated (the Banerjee test already checked that they have iterations
+   * that satisfy their direction).
+   */
+  auto isRelevant = [&equations](uint32_t level, bool isCommon) -> bool {
+    for (auto &equation : equations) {
+      if (isCommon
+              ? ((equation.fromCoefficients[level] != 0)
+                 || (equation.toCoefficients[level] != 0))
+              : (equation.otherCoefficients[level] != 0)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  /*
+   * Compute the size of the iteration space.
+   */
+  uint64_t tuples = 1;
+  auto multiply = [&tuples, budget](std::optional<uint64_t> bound,
+                                    uint8_t direction) -> bool {
+    if (!bound || (*bound >= budget)) {
+      return false;
+    }
+    uint64_t iterations = *bound + 1;
+    uint64_t pairs;
+    switch (direction) {
+      case LoopIterationSpaceAnalysis::DIRECTION_SAME:
+        pairs = iterations;
+        break;
+      case LoopIterationSpaceAnalysis::DIRECTION_BEFORE:
+      case LoopIterationSpaceAnalysis::DIRECTION_AFTER:
+        pairs = iterations * (iterations - 1) / 2;
+        break;
+      default:
+        pairs = iterations * iterations;
+        break;
+    }
+    tuples *= std::max<uint64_t>(pairs, 1);
+    return tuples <= budget;
+  };
+  for (auto l = 0u; l < directions.size(); l++) {
+    if (isRelevant(l, true) && !multiply(commonLoopBounds[l], directions[l])) {
+      return true;
+    }
+  }
+  for (auto v = 0u; v < otherLoopBounds.size(); v++) {
+    if (isRelevant(v, false)
+        && !multiply(otherLoopBounds[v],
+                     LoopIterationSpaceAnalysis::DIRECTION_SAME)) {
+      return true;
+    }
+  }
+
+  /*
+   * Enumerate the iterations loop by loop while accumulating the value of the
+   * left-hand side of each equation.
+   */
+  std::vector<__int128> values;
+  for (auto &equation : equations) {
+    values.push_back(equation.constant);
+  }
+  std::function<bool(uint32_t)> enumerate;
+  enumerate = [&](uint32_t level) -> bool {
+    if (level == directions.size() + otherLoopBounds.size()) {
+      for (auto e = 0u; e < equations.size(); e++) {
+        if ((values[e] < equations[e].lowest)
+            || (values[e] > equations[e].highest)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /*
+     * Try the iterations of a loop that includes only one access.
+     */
+    if (level >= directions.size()) {
+      auto v = level - directions.size();
+      if (!isRelevant(v, false)) {
+        return enumerate(level + 1);
+      }
+      for (uint64_t z = 0; z <= *otherLoopBounds[v]; z++) {
+        for (auto e = 0u; e < equations.size(); e++) {
+          values[e] += (__int128)equations[e].otherCoefficients[v] * z;
+        }
+        auto found = enumerate(level + 1);
+        for (auto e = 0u; e < equations.size(); e++) {
+          values[e] -= (__int128)equations[e].otherCoefficients[v] * z;
+        }
+        if (found) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /*
+     * Try the pairs of iterations of a common loop that satisfy its
+     * direction.
+     */
+    if (!isRelevant(level, true)) {
+      return enumerate(level + 1);
+    }
+    auto bound = *commonLoopBounds[level];
+    for (uint64_t x = 0; x <= bound; x++) {
+      uint64_t firstY = 0;
+      uint64_t lastY = bound;
+      switch (directions[level]) {
+        case LoopIterationSpaceAnalysis::DIRECTION_SAME:
+          firstY = x;
+          lastY = x;
+          break;
+        case LoopIterationSpaceAnalysis::DIRECTION_BEFORE:
+          firstY = x + 1;
+          break;
+        case LoopIterationSpaceAnalysis::DIRECTION_AFTER:
+          if (x == 0) {
+            continue;
+          }
+          lastY = x - 1;
+          break;
+      }
+      for (auto y = firstY; y <= lastY; y++) {
+        for (auto e = 0u; e < equations.size(); e++) {
+          values[e] += (__int128)equations[e].fromCoefficients[level] * x
+                       - (__int128)equations[e].toCoefficients[level] * y;
+        }
+        auto found = enumerate(level + 1);
+        for (auto e = 0u; e < equations.size(); e++) {
+          values[e] -= (__int128)equations[e].fromCoefficients[level] * x
+                       - (__int128)equations[e].toCoefficients[level] * y;
+        }
+        if (found) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  return enumerate(0);
+}
+
+/*
+ * Check whether the dependence equations of a system may have a solution
+ * where the iterations of the common loops satisfy @directions.
+ */
+static bool areEquationsFeasible(
+    const std::vector<DependenceEquation> &equations,
+    const std::vector<std::optional<uint64_t>> &commonLoopBounds,
+    const std::vector<std::optional<uint64_t>> &otherLoopBounds,
+    const std::vector<uint8_t> &directions,
+    uint64_t exhaustiveTestBudget) {
+  for (auto &equation : equations) {
+    if (!isFeasibleByGCD(equation, directions)) {
+      return false;
+    }
+    if (!isFeasibleByBanerjee(equation,
+                              commonLoopBounds,
+                              otherLoopBounds,
+                              directions)) {
+      return false;
+    }
+  }
+
+  return isFeasibleByEnumeration(equations,
+                                 commonLoopBounds,
+                                 otherLoopBounds,
+                                 directions,
+                                 exhaustiveTestBudget);
+}
+
+void LoopIterationSpaceAnalysis::computeAffineAccesses(ScalarEvolution &SE) {
+
+  /*
+   * Index the loops of the nest by header.
+   */
+  std::unordered_map<BasicBlock *, LoopStructure *> nestLoops;
+  for (auto loop : this->loops->getLoops()) {
+    nestLoops[loop->getHeader()] = loop;
+  }
+
+  /*
+   * Describe the address of every load and store of the loop nest.
+   */
+  auto topLoop = this->loops->getLoop();
+  auto &DL = topLoop->getFunction()->getParent()->getDataLayout();
+  for (auto inst : topLoop->getInstructions()) {
+    Value *pointer = nullptr;
+    Type *accessedType = nullptr;
+    if (auto load = dyn_cast<LoadInst>(inst)) {
+      pointer = load->getPointerOperand();
+      accessedType = load->getType();
+    } else if (auto store = dyn_cast<StoreInst>(inst)) {
+      pointer = store->getPointerOperand();
+      accessedType = store->getValueOperand()->getType();
+    } else {
+      continue;
+    }
+    if (!SE.isSCEVable(pointer->getType())) {
+      continue;
+    }
+    auto pointerSCEV = SE.getSCEV(pointer);
+    auto basePointer = dyn_cast<SCEVUnknown>(SE.getPointerBase(pointerSCEV));
+    if (!basePointer) {
+      continue;
+    }
+    AffineAccess access;
+    access.basePointer = basePointer;
+    access.accessSize = DL.getTypeStoreSize(accessedType);
+
+    /*
+     * Fetch the loops that include the access, from the outermost.
+     */
+    for (auto loop : this->loops->getLoops()) {
+      if (loop->isIncluded(inst)) {
+        access.loops.push_back(loop);
+      }
+    }
+    std::sort(access.loops.begin(),
+              access.loops.end(),
+              [](LoopStructure *l1, LoopStructure *l2) -> bool {
+                return l1->getNestingLevel() < l2->getNestingLevel();
+              });
+
+    /*
+     * Decompose the offset in bytes.
+     */
+    auto offset = SE.getMinusSCEV(pointerSCEV, basePointer);
+    access.isOffsetAffine = this->decomposeAffineExpression(SE,
+                                                            offset,
+                                                            inst,
+                                                            1,
+                                                            nestLoops,
+                                                            access.offset);
+
+    /*
+     * Decompose the subscripts of the delinearized access.
+     * They can be compared dimension by dimension only if the element size is
+     * the size of the access and if the inner subscripts never exceed their
+     * dimension.
+     */
+    SmallVector<const SCEV *, 4> subscripts;
+    SmallVector<const SCEV *, 4> sizes;
+    auto elementSize = SE.getElementSize(inst);
+    auto constantElementSize = dyn_cast_or_null<SCEVConstant>(elementSize);
+    if ((constantElementSize != nullptr)
+        && (constantElementSize->getAPInt() == access.accessSize)) {
+      ScalarEvolutionDelinearization::delinearize(SE,
+                                                  offset,
+                                                  subscripts,
+                                                  sizes,
+                                                  elementSize);
+    }
+    if ((subscripts.size() > 1) && (subscripts.size() == sizes.size())) {
+      std::vector<AffineExpression> affineSubscripts(subscripts.size());
+      auto isDelinearized = true;
+      for (auto i = 0u; isDelinearized && (i < subscripts.size()); i++) {
+        isDelinearized = this->decomposeAffineExpression(SE,
+                                                         subscripts[i],
+                                                         inst,
+                                                         1,
+                                                         nestLoops,
+                                                         affineSubscripts[i]);
+        if (isDelinearized && (i > 0)) {
+          isDelinearized = this->isSubscriptWithinSize(SE,
+                                                       subscripts[i],
+                                                       affineSubscripts[i],
+                                                       sizes[i - 1]);
+        }
+      }
+      if (isDelinearized) {
+        access.subscripts = std::move(affineSubscripts);
+        access.sizes.assign(sizes.begin(), sizes.end());
+      }
+    }
+
+    if (!access.isOffsetAffine && access.subscripts.empty()) {
+      continue;
+    }
+    this->affineAccesses.insert(std::make_pair(inst, std::move(access)));
+  }
+  Instrumentation::count("LoopIterationSpaceAnalysis: affine accesses",
+                         this->affineAccesses.size());
+
+  return;
+}
+
+bool LoopIterationSpaceAnalysis::decomposeAffineExpression(
+    ScalarEvolution &SE,
+    const SCEV *expression,
+    Instruction *access,
+    int64_t factor,
+    std::unordered_map<BasicBlock *, LoopStructure *> &nestLoops,
+    AffineExpression &affineExpression) {
+
+  /*
+   * Loop-nest invariant terms are part of the symbol.
+   */
+  auto addToSymbol = [&](const SCEV *term) -> bool {
+    if (!this->isInvariantInTheLoopNest(term)) {
+      return false;
+    }
+    if (factor != 1) {
+      term = SE.getMulExpr(SE.getConstant(term->getType(), factor, true), term);
+    }
+    affineExpression.symbol =
+        (affineExpression.symbol == nullptr)
+            ? term
+            : SE.getAddExpr(affineExpression.symbol, term);
+    return true;
+  };
+
+  /*
+   * Constants.
+   */
+  if (auto constant = dyn_cast<SCEVConstant>(expression)) {
+    auto &value = constant->getAPInt();
+    int64_t term;
+    if ((value.getMinSignedBits() > 64)
+        || __builtin_mul_overflow(value.getSExtValue(), factor, &term)
+        || __builtin_add_overflow(affineExpression.constant,
+                                  term,
+                                  &affineExpression.constant)) {
+      return false;
+    }
+    return true;
+  }
+
+  /*
+   * Induction variables of the loops of the nest with a constant step.
+   * Their evolution must not wrap, otherwise the equations on the integers do
+   * not describe the accessed addresses.
+   */
+  if (auto addRec = dyn_cast<SCEVAddRecExpr>(expression)) {
+    auto nestLoopIt = nestLoops.find(addRec->getLoop()->getHeader());
+    if (nestLoopIt == nestLoops.end()) {
+      return addToSymbol(expression);
+    }
+    auto loop = nestLoopIt->second;
+    if (!loop->isIncluded(access) || !addRec->isAffine()
+        || (addRec->getNoWrapFlags(SCEV::NoWrapMask) == SCEV::FlagAnyWrap)) {
+      return false;
+    }
+    auto step = dyn_cast<SCEVConstant>(addRec->getStepRecurrence(SE));
+    if ((step == nullptr) || (step->getAPInt().getMinSignedBits() > 64)) {
+      return false;
+    }
+    int64_t coefficient;
+    if (__builtin_mul_overflow(step->getAPInt().getSExtValue(),
+                               factor,
+                               &coefficient)
+        || __builtin_add_overflow(affineExpression.coefficients[loop],
+                                  coefficient,
+                                  &affineExpression.coefficients[loop])) {
+      return false;
+    }
+
+    /*
+     * Remember the number of iterations of the loop.
+     */
+    auto tripCount = SE.getSmallConstantMaxTripCount(addRec->getLoop());
+    if (tripCount > 0) {
+      this->maximumIterationOfLoop[loop] = tripCount - 1;
+    }
+
+    return this->decomposeAffineExpression(SE,
+                                           addRec->getStart(),
+                                           access,
+                                           factor,
+                                           nestLoops,
+                                           affineExpression);
+  }
+
+  /*
+   * Sums and products by constants.
+   */
+  if (auto add = dyn_cast<SCEVAddExpr>(expression)) {
+    for (auto operand : add->operands()) {
+      if (!this->decomposeAffineExpression(SE,
+                                           operand,
+                                           access,
+                                           factor,
+                                           nestLoops,
+                                           affineExpression)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (auto mul = dyn_cast<SCEVMulExpr>(expression)) {
+    auto constant = dyn_cast<SCEVConstant>(mul->getOperand(0));
+    if ((mul->getNumOperands() != 2) || (constant == nullptr)) {
+      return addToSymbol(expression);
+    }
+    int64_t newFactor;
+    if ((constant->getAPInt().getMinSignedBits() > 64)
+        || __builtin_mul_overflow(constant->getAPInt().getSExtValue(),
+                                  factor,
+                                  &newFactor)) {
+      return false;
+    }
+    return this->decomposeAffineExpression(SE,
+                                           mul->getOperand(1),
+                                           access,
+                                           newFactor,
+                                           nestLoops,
+                                           affineExpression);
+  }
+
+  /*
+   * Extensions of induction variables that do not wrap.
+   */
+  if (auto sext = dyn_cast<SCEVSignExtendExpr>(expression)) {
+    auto addRec = dyn_cast<SCEVAddRecExpr>(sext->getOperand());
+    if ((addRec != nullptr) && addRec->isAffine()
+        && addRec->hasNoSignedWrap()) {
+      auto type = sext->getType();
+      auto extendedAddRec = SE.getAddRecExpr(
+          SE.getSignExtendExpr(addRec->getStart(), type),
+          SE.getSignExtendExpr(addRec->getStepRecurrence(SE), type),
+          addRec->getLoop(),
+          SCEV::FlagNSW);
+      return this->decomposeAffineExpression(SE,
+                                             extendedAddRec,
+                                             access,
+                                             factor,
+                                             nestLoops,
+                                             affineExpression);
+    }
+  }
+  if (auto zext = dyn_cast<SCEVZeroExtendExpr>(expression)) {
+    auto addRec = dyn_cast<SCEVAddRecExpr>(zext->getOperand());
+    if ((addRec != nullptr) && addRec->isAffine()
+        && addRec->hasNoUnsignedWrap()) {
+      auto type = zext->getType();
+      auto extendedAddRec = SE.getAddRecExpr(
+          SE.getZeroExtendExpr(addRec->getStart(), type),
+          SE.getZeroExtendExpr(addRec->getStepRecurrence(SE), type),
+          addRec->getLoop(),
+          SCEV::FlagNUW);
+      return this->decomposeAffineExpression(SE,
+                                             extendedAddRec,
+                                             access,
+                                             factor,
+                                             nestLoops,
+                                             affineExpression);
+    }
+  }
+
+  return addToSymbol(expression);
+}
+
+bool LoopIterationSpaceAnalysis::isInvariantInTheLoopNest(
+    const SCEV *expression) const {
+  auto topLoop = this->loops->getLoop();
+  auto topHeader = topLoop->getHeader();
+
+  /*
+   * Only induction variables of loops that include the nest and values
+   * defined outside the nest do not change while the nest runs.
+   */
+  auto isVariant = [topLoop, topHeader](const SCEV *s) -> bool {
+    if (auto addRec = dyn_cast<SCEVAddRecExpr>(s)) {
+      return !addRec->getLoop()->contains(topHeader);
+    }
+    if (auto unknown = dyn_cast<SCEVUnknown>(s)) {
+      auto inst = dyn_cast<Instruction>(unknown->getValue());
+      return (inst != nullptr) && topLoop->isIncluded(inst);
+    }
+    return false;
+  };
+
+  return !SCEVExprContains(expression, isVariant);
+}
+
+bool LoopIterationSpaceAnalysis::isSubscriptWithinSize(
+    ScalarEvolution &SE,
+    const SCEV *subscript,
+    const AffineExpression &affineSubscript,
+    const SCEV *size) const {
+
+  /*
+   * Check the range of the subscript over the iterations of its loops.
+   */
+  auto constantSize = dyn_cast<SCEVConstant>(size);
+  if ((constantSize != nullptr) && (affineSubscript.symbol == nullptr)
+      && (constantSize->getAPInt().getMinSignedBits() <= 64)) {
+    __int128 minimum = affineSubscript.constant;
+    __int128 maximum = affineSubscript.constant;
+    for (auto &pair : affineSubscript.coefficients) {
+      std::optional<uint64_t> bound;
+      auto boundIt = this->maximumIterationOfLoop.find(pair.first);
+      if (boundIt != this->maximumIterationOfLoop.end()) {
+        bound = boundIt->second;
+      }
+      __int128 termMinimum, termMaximum;
+      rangeOfTerm(pair.second, bound, termMinimum, termMaximum);
+      addRange(minimum, maximum, termMinimum, termMaximum);
+    }
+    if ((minimum >= 0)
+        && (maximum < constantSize->getAPInt().getSExtValue())) {
+      return true;
+    }
+  }
+
+  /*
+   * Fall back to the facts known by scalar evolution.
+   */
+  if (subscript->getType() != size->getType()) {
+    return false;
+  }
+
+  return SE.isKnownNonNegative(subscript)
+         && SE.isKnownPredicate(ICmpInst::Predicate::ICMP_SLT,
+                                subscript,
+                                size);
+}
+
+bool LoopIterationSpaceAnalysis::buildDependenceSystem(
+    Instruction *from,
+    Instruction *to,
+    DependenceSystem &system) const {
+
+  /*
+   * Both accesses must be affine functions of the same base pointer.
+   */
+  auto fromIt = this->affineAccesses.find(from);
+  auto toIt = this->affineAccesses.find(to);
+  if ((fromIt == this->affineAccesses.end())
+      || (toIt == this->affineAccesses.end())) {
+    return false;
+  }
+  auto &fromAccess = fromIt->second;
+  auto &toAccess = toIt->second;
+  if (fromAccess.basePointer != toAccess.basePointer) {
+    return false;
+  }
+
+  /*
+   * Identify the common loops and the ones that include only one access.
+   */
+  auto fetchBound = [this](LoopStructure *loop) -> std::optional<uint64_t> {
+    auto boundIt = this->maximumIterationOfLoop.find(loop);
+    if (boundIt == this->maximumIterationOfLoop.end()) {
+      return std::nullopt;
+    }
+    return boundIt->second;
+  };
+  std::vector<LoopStructure *> fromOnlyLoops;
+  std::vector<LoopStructure *> toOnlyLoops;
+  for (auto loop : fromAccess.loops) {
+    if (std::find(toAccess.loops.begin(), toAccess.loops.end(), loop)
+        != toAccess.loops.end()) {
+      system.commonLoops.push_back(loop);
+      system.commonLoopBounds.push_back(fetchBound(loop));
+    } else {
+      fromOnlyLoops.push_back(loop);
+      system.otherLoopBounds.push_back(fetchBound(loop));
+    }
+  }
+  for (auto loop : toAccess.loops) {
+    if (std::find(fromAccess.loops.begin(), fromAccess.loops.end(), loop)
+        == fromAccess.loops.end()) {
+      toOnlyLoops.push_back(loop);
+      system.otherLoopBounds.push_back(fetchBound(loop));
+    }
+  }
+
+  /*
+   * Generate the equation of a pair of subscripts.
+   * Subscripts with different symbols do not constrain the dependence.
+   */
+  auto addEquation = [&](const AffineExpression &fromExpression,
+                         const AffineExpression &toExpression,
+                         __int128 lowest,
+                         __int128 highest) {
+    if (fromExpression.symbol != toExpression.symbol) {
+      return;
+    }
+    auto coefficientOf = [](const AffineExpression &expression,
+                            LoopStructure *loop) -> int64_t {
+      auto it = expression.coefficients.find(loop);
+      return (it == expression.coefficients.end()) ? 0 : it->second;
+    };
+    DependenceEquation equation;
+    for (auto loop : system.commonLoops) {
+      equation.fromCoefficients.push_back(coefficientOf(fromExpression, loop));
+      equation.toCoefficients.push_back(coefficientOf(toExpression, loop));
+    }
+    for (auto loop : fromOnlyLoops) {
+      equation.otherCoefficients.push_back(
+          coefficientOf(fromExpression, loop));
+    }
+    for (auto loop : toOnlyLoops) {
+      equation.otherCoefficients.push_back(-coefficientOf(toExpression, loop));
+    }
+    equation.constant =
+        (__int128)fromExpression.constant - (__int128)toExpression.constant;
+    equation.lowest = lowest;
+    equation.highest = highest;
+    system.equations.push_back(std::move(equation));
+  };
+
+  /*
+   * Compare the accesses dimension by dimension when they are delinearized
+   * the same way.
+   * Otherwise, compare their offsets in bytes: they overlap if
+   * -(fromSize - 1) <= fromOffset - toOffset <= toSize - 1.
+   */
+  if ((!fromAccess.subscripts.empty())
+      && (fromAccess.sizes == toAccess.sizes)
+      && (fromAccess.subscripts.size() == toAccess.subscripts.size())) {
+    for (auto i = 0u; i < fromAccess.subscripts.size(); i++) {
+      addEquation(fromAccess.subscripts[i], toAccess.subscripts[i], 0, 0);
+    }
+  } else if (fromAccess.isOffsetAffine && toAccess.isOffsetAffine) {
+    addEquation(fromAccess.offset,
+                toAccess.offset,
+                -((__int128)fromAccess.accessSize - 1),
+                (__int128)toAccess.accessSize - 1);
+  }
+
+  return !system.equations.empty();
+}
+
+std::optional<LoopIterationSpaceAnalysis::DependenceVector>
+LoopIterationSpaceAnalysis::computeDependenceVector(Instruction *from,
+                                                    Instruction *to) const {
+  DependenceSystem system;
+  if (!this->buildDependenceSystem(from, to, system)) {
+    return std::nullopt;
+  }
+  auto levels = system.commonLoops.size();
+  DependenceVector vector;
+  vector.loops = system.commonLoops;
+  vector.directions.assign(levels, DIRECTION_NONE);
+  vector.distances.assign(levels, std::nullopt);
+
+  /*
+   * Check whether there is a dependence at all.
+   */
+  std::vector<uint8_t> directions(levels, DIRECTION_ANY);
+  if (!this->mayDepend(system, directions)) {
+    return vector;
+  }
+
+  /*
+   * Test each direction of each common loop.
+   */
+  for (auto l = 0u; l < levels; l++) {
+    for (auto direction :
+         { DIRECTION_BEFORE, DIRECTION_SAME, DIRECTION_AFTER }) {
+      directions[l] = direction;
+      if (this->mayDepend(system, directions)) {
+        vector.directions[l] |= direction;
+      }
+    }
+    directions[l] = DIRECTION_ANY;
+  }
+
+  /*
+   * Compute the constant distances: an equation that depends only on the
+   * iterations of a common loop with the same coefficient k for both
+   * accesses fixes the distance to (constant - lowest) / k.
+   */
+  for (auto &equation : system.equations) {
+    if ((equation.lowest != equation.highest)
+        || std::any_of(equation.otherCoefficients.begin(),
+                       equation.otherCoefficients.end(),
+                       [](int64_t c) { return c != 0; })) {
+      continue;
+    }
+    std::optional<uint32_t> level;
+    auto isStrong = true;
+    for (auto l = 0u; l < levels; l++) {
+      auto a = equation.fromCoefficients[l];
+      auto b = equation.toCoefficients[l];
+      if ((a == 0) && (b == 0)) {
+        continue;
+      }
+      if ((a != b) || level) {
+        isStrong = false;
+        break;
+      }
+      level = l;
+    }
+    if (!isStrong || !level) {
+      continue;
+    }
+    auto k = (__int128)equation.fromCoefficients[*level];
+    auto numerator = equation.constant - equation.lowest;
+    if ((numerator % k) != 0) {
+      continue;
+    }
+    auto distance = (int64_t)(numerator / k);
+    vector.distances[*level] = distance;
+    auto direction = (distance > 0)   ? DIRECTION_BEFORE
+                     : (distance < 0) ? DIRECTION_AFTER
+                                      : DIRECTION_SAME;
+    vector.directions[*level] &= direction;
+  }
+
+  return vector;
+}
+
+bool LoopIterationSpaceAnalysis::isLoopCarriedDependenceDisproved(
+    Instruction *from,
+    Instruction *to) const {
+  DependenceSystem system;
+  if (!this->buildDependenceSystem(from, to, system)) {
+    return false;
+  }
+
+  return !this->mayBeLoopCarried(system);
+}
+
+bool LoopIterationSpaceAnalysis::isDependenceDisproved(Instruction *from,
+                                                       Instruction *to) const {
+  DependenceSystem system;
+  if (!this->buildDependenceSystem(from, to, system)) {
+    return false;
+  }
+  std::vector<uint8_t> directions(system.commonLoops.size(), DIRECTION_ANY);
+
+  return !this->mayDepend(system, directions);
+}
+
+LoopIterationSpaceAnalysis::DependenceClassification
+LoopIterationSpaceAnalysis::classifyDependence(Instruction *from,
+                                               Instruction *to) const {
+
+  /*
+   * The dependence system is built once and shared by all tests.
+   */
+  DependenceSystem system;
+  if (!this->buildDependenceSystem(from, to, system)) {
+    return DEPENDENCE_MAY_BE_LOOP_CARRIED;
+  }
+  std::vector<uint8_t> directions(system.commonLoops.size(), DIRECTION_ANY);
+  if (!this->mayDepend(system, directions)) {
+    return DEPENDENCE_DISPROVED;
+  }
+  if (!this->mayBeLoopCarried(system)) {
+    return DEPENDENCE_WITHIN_ITERATIONS;
+  }
+
+  return DEPENDENCE_MAY_BE_LOOP_CARRIED;
+}
+
+uint64_t LoopIterationSpaceAnalysis::getExhaustiveTestBudget(void) const {
+  return this->exhaustiveTestBudget;
+}
+
+void LoopIterationSpaceAnalysis::setExhaustiveTestBudget(uint64_t tuples) {
+  this->exhaustiveTestBudget = tuples;
+
+  return;
+}
+
+bool LoopIterationSpaceAnalysis::mayDepend(
+    const DependenceSystem &system,
+    const std::vector<uint8_t> &directions) const {
+  return areEquationsFeasible(system.equations,
+                              system.commonLoopBounds,
+                              system.otherLoopBounds,
+                              directions,
+                              this->exhaustiveTestBudget);
+}
+
+bool LoopIterationSpaceAnalysis::mayBeLoopCarried(
+    const DependenceSystem &system) const {
+
+  /*
+   * A dependence is carried by the common loop at level l if the iterations
+   * of the outer common loops are the same and @to runs at a later iteration
+   * of the loop at level l.
+   */
+  auto levels = system.commonLoops.size();
+  std::vector<uint8_t> directions(levels, DIRECTION_ANY);
+  for (auto l = 0u; l < levels; l++) {
+    for (auto outer = 0u; outer < l; outer++) {
+      directions[outer] = DIRECTION_SAME;
+    }
+    directions[l] = DIRECTION_BEFORE;
+    if (this->mayDepend(system, directions)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool LoopIterationSpaceAnalysis::mayDependWithDirections(
+    Instruction *from,
+    Instruction *to,
+    const std::vector<uint8_t> &directions) const {
+  DependenceSystem system;
+  if (!this->buildDependenceSystem(from, to, system)) {
+    return true;
+  }
+
+  /*
+   * Test every combination of the single directions included in the
+   * bitmasks, as the tests handle one direction per loop.
+   */
+  auto levels = system.commonLoops.size();
+  std::vector<uint8_t> constraints(levels, DIRECTION_ANY);
+  std::function<bool(uint32_t)> mayDependFromLevel;
+  mayDependFromLevel = [&](uint32_t level) -> bool {
+    if (level == levels) {
+      return this->mayDepend(system, constraints);
+    }
+    auto mask = (level < directions.size()) ? directions[level]
+                                            : (uint8_t)DIRECTION_ANY;
+    if (mask == DIRECTION_ANY) {
+      constraints[level] = DIRECTION_ANY;
+      return mayDependFromLevel(level + 1);
+    }
+    for (auto direction :
+         { DIRECTION_BEFORE, DIRECTION_SAME, DIRECTION_AFTER }) {
+      if ((mask & direction) == 0) {
+        continue;
+      }
+      constraints[level] = direction;
+      if (mayDependFromLevel(level + 1)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  return mayDependFromLevel(0);
+}
+
+} // namespace arcana::noelle
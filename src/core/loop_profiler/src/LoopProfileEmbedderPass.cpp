@@ -0,0 +1,146 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/LoopStructure.hpp"
+#include "arcana/noelle/core/MetadataManager.hpp"
+#include "arcana/noelle/core/HotProfiler.hpp"
+#include "LoopProfileEmbedderPass.hpp"
+
+namespace arcana::noelle {
+
+static cl::opt<std::string> LoopProfileFile(
+    "noelle-loop-prof-file",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("File generated by a binary instrumented by noelle-prof-loops"));
+
+LoopProfileEmbedderPass::LoopProfileEmbedderPass() : ModulePass(ID) {
+
+  return;
+}
+
+bool LoopProfileEmbedderPass::doInitialization(Module &M) {
+  return false;
+}
+
+bool LoopProfileEmbedderPass::runOnModule(Module &M) {
+
+  /*
+   * Read the profiles.
+   */
+  if (LoopProfileFile.getNumOccurrences() == 0) {
+    errs() << "LoopProfileEmbed: ERROR = the option -noelle-loop-prof-file "
+              "is required\n";
+    abort();
+  }
+  if (!this->readProfiles(LoopProfileFile.getValue())) {
+    return false;
+  }
+
+  /*
+   * Attach the profiles to the loops.
+   */
+  auto modified = false;
+  MetadataManager mm{ M };
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    auto &LI = getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
+    for (auto loop : LI.getLoopsInPreorder()) {
+      LoopStructure ls{ loop };
+
+      /*
+       * Fetch the profile of the loop.
+       */
+      auto loopID = ls.getID();
+      if (!loopID) {
+        continue;
+      }
+      auto profileIt = this->profiles.find(loopID.value());
+      if (profileIt == this->profiles.end()) {
+        continue;
+      }
+      auto profileAsString = profileIt->second.toString();
+
+      /*
+       * Embed the profile.
+       */
+      auto &key = HotProfiler::loopProfileMetadataKey;
+      if (mm.doesHaveMetadata(&ls, key)) {
+        mm.setMetadata(&ls, key, profileAsString);
+      } else {
+        mm.addMetadata(&ls, key, profileAsString);
+      }
+      modified = true;
+    }
+  }
+
+  return modified;
+}
+
+bool LoopProfileEmbedderPass::readProfiles(const std::string &fileName) {
+
+  /*
+   * Open the file.
+   */
+  auto fileBuf = MemoryBuffer::getFileAsStream(fileName);
+  if (auto ec = fileBuf.getError()) {
+    errs() << "LoopProfileEmbed: Failed to read \"" << fileName
+           << "\":" << ec.message() << "\n";
+    abort();
+  }
+
+  /*
+   * Parse the file: one loop per line.
+   * Lines that start with '#' are comments.
+   */
+  std::stringstream fileStream{ fileBuf.get()->getBuffer().str() };
+  std::string line;
+  while (std::getline(fileStream, line)) {
+    if (line.empty() || (line[0] == '#')) {
+      continue;
+    }
+    auto profile = LoopProfile::fromString(line);
+    if (!profile) {
+      errs() << "LoopProfileEmbed: the line \"" << line
+             << "\" is malformed and it will be skipped\n";
+      continue;
+    }
+    this->profiles[profile->getLoopID()] = *profile;
+  }
+
+  return !this->profiles.empty();
+}
+
+void LoopProfileEmbedderPass::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<LoopInfoWrapperPass>();
+
+  return;
+}
+
+// Next there is code to register your pass to "opt"
+char LoopProfileEmbedderPass::ID = 0;
+static RegisterPass<LoopProfileEmbedderPass> X(
+    "LoopProfileEmbed",
+    "Embed the runtime profile of loops as metadata");
+
+} // namespace arcana::noelle
@@ -0,0 +1,240 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "LoopProfilerPass.hpp"
+
+namespace arcana::noelle {
+
+void LoopProfilerPass::declareRuntimeAPIs(Module &M) {
+
+  /*
+   * All the APIs have the same signature: void (uint64_t loopID, void *frame)
+   */
+  auto &cxt = M.getContext();
+  auto voidType = Type::getVoidTy(cxt);
+  auto int64Type = Type::getInt64Ty(cxt);
+  auto framePtrType = Type::getInt8PtrTy(cxt);
+  auto signature =
+      FunctionType::get(voidType,
+                        ArrayRef<Type *>({ int64Type, framePtrType }),
+                        false);
+
+  /*
+   * Declare the APIs.
+   */
+  this->invocationBegin = cast<Function>(
+      M.getOrInsertFunction("NOELLE_loopInvocationBegin", signature)
+          .getCallee());
+  this->iterationBegin = cast<Function>(
+      M.getOrInsertFunction("NOELLE_loopIterationBegin", signature)
+          .getCallee());
+  this->invocationEnd = cast<Function>(
+      M.getOrInsertFunction("NOELLE_loopInvocationEnd", signature)
+          .getCallee());
+
+  return;
+}
+
+bool LoopProfilerPass::instrumentLoops(Function &F,
+                                       std::vector<LoopStructure *> &loops) {
+
+  /*
+   * Only loops with an ID and a pre-header can be profiled.
+   */
+  std::vector<LoopStructure *> profiledLoops;
+  for (auto loop : loops) {
+    auto loopID = loop->getID();
+    if (!loopID) {
+      errs() << "LoopProfiler:   Skip a loop of " << F.getName()
+             << " because it has no ID (run noelle-meta-loop-embed first)\n";
+      continue;
+    }
+    if (loop->getPreHeader() == nullptr) {
+      errs() << "LoopProfiler:   Skip loop " << loopID.value()
+             << " because it has no pre-header\n";
+      continue;
+    }
+    profiledLoops.push_back(loop);
+  }
+  if (profiledLoops.empty()) {
+    return false;
+  }
+
+  /*
+   * Allocate a stack slot that identifies the frame of the current
+   * invocation of @F.
+   * The runtime uses it to tell apart recursive invocations of the same loop
+   * and to discard the invocations of frames that have been unwound without
+   * reaching an end of their loops.
+   */
+  IRBuilder<> entryBuilder(&*F.getEntryBlock().getFirstInsertionPt());
+  auto frame = entryBuilder.CreateAlloca(entryBuilder.getInt8Ty(),
+                                         nullptr,
+                                         "noelle.loop.frame");
+
+  /*
+   * Instrument the start of invocations and iterations.
+   *
+   * The ends of invocations are only collected here because splitting exit
+   * edges changes the CFG the loop structures have been computed on.
+   * Loops are in pre-order, so outer loops come before their sub-loops.
+   */
+  std::vector<std::pair<BasicBlock *, BasicBlock *>> exitEdges;
+  std::map<std::pair<BasicBlock *, BasicBlock *>, std::vector<uint64_t>>
+      loopsExitedByEdge;
+  std::vector<BasicBlock *> landingPads;
+  std::map<BasicBlock *, std::vector<uint64_t>> loopsExitedByLandingPad;
+  for (auto loop : profiledLoops) {
+    auto loopID = loop->getID().value();
+    auto header = loop->getHeader();
+
+    /*
+     * A new invocation starts when the pre-header jumps to the header.
+     */
+    this->addCall(this->invocationBegin,
+                  loopID,
+                  frame,
+                  loop->getPreHeader()->getTerminator());
+
+    /*
+     * A new iteration starts every time the header is executed.
+     */
+    this->addCall(this->iterationBegin,
+                  loopID,
+                  frame,
+                  &*header->getFirstInsertionPt());
+
+    /*
+     * Collect the exit edges.
+     *
+     * Edges to exception handling pads cannot be split. When the pad is a
+     * landing pad, the invocation ends within the pad; the runtime ignores the
+     * end if the pad has been reached from outside the loop. Invocations
+     * exited through other pads, or whose frame has been unwound by an
+     * exception, are discarded by the runtime the next time an older frame
+     * uses the loop or the same frame starts it again.
+     */
+    for (auto exitEdge : loop->getLoopExitEdges()) {
+      auto dst = exitEdge.second;
+      if (dst->isEHPad()) {
+        if (!dst->isLandingPad()) {
+          continue;
+        }
+        auto &exitedLoops = loopsExitedByLandingPad[dst];
+        if (exitedLoops.empty()) {
+          landingPads.push_back(dst);
+        }
+        if (std::find(exitedLoops.begin(), exitedLoops.end(), loopID)
+            == exitedLoops.end()) {
+          exitedLoops.push_back(loopID);
+        }
+        continue;
+      }
+      if (loopsExitedByEdge.find(exitEdge) == loopsExitedByEdge.end()) {
+        exitEdges.push_back(exitEdge);
+      }
+      loopsExitedByEdge[exitEdge].push_back(loopID);
+    }
+  }
+
+  /*
+   * Instrument the end of invocations.
+   *
+   * An edge or a landing pad can exit more than one loop (e.g., a break out
+   * of a loop nest).
+   * In this case, sub-loops end before their parents.
+   */
+  for (auto exitEdge : exitEdges) {
+
+    /*
+     * Add a basic block that is executed only when the edge is taken.
+     */
+    auto edgeBB = this->splitEdge(exitEdge.first, exitEdge.second);
+
+    /*
+     * Notify the runtime.
+     */
+    auto &exitedLoops = loopsExitedByEdge[exitEdge];
+    for (auto it = exitedLoops.rbegin(); it != exitedLoops.rend(); it++) {
+      this->addCall(this->invocationEnd, *it, frame, edgeBB->getTerminator());
+    }
+  }
+  for (auto landingPad : landingPads) {
+    auto &exitedLoops = loopsExitedByLandingPad[landingPad];
+    auto insertPoint = &*landingPad->getFirstInsertionPt();
+    for (auto it = exitedLoops.rbegin(); it != exitedLoops.rend(); it++) {
+      this->addCall(this->invocationEnd, *it, frame, insertPoint);
+    }
+  }
+
+  return true;
+}
+
+BasicBlock *LoopProfilerPass::splitEdge(BasicBlock *src, BasicBlock *dst) {
+
+  /*
+   * Create the new basic block.
+   */
+  auto &cxt = src->getContext();
+  auto edgeBB = BasicBlock::Create(cxt, "", src->getParent(), dst);
+  IRBuilder<> builder(edgeBB);
+  builder.CreateBr(dst);
+
+  /*
+   * Redirect the edge.
+   */
+  auto srcTerm = src->getTerminator();
+  for (auto i = 0u; i < srcTerm->getNumSuccessors(); i++) {
+    if (srcTerm->getSuccessor(i) == dst) {
+      srcTerm->setSuccessor(i, edgeBB);
+    }
+  }
+
+  /*
+   * Fix the PHIs of the destination.
+   * If @src had more than one edge to @dst, all of them now target the new
+   * basic block, which has a single edge to @dst.
+   */
+  for (auto &phi : dst->phis()) {
+    auto incomingValue = phi.getIncomingValueForBlock(src);
+    while (phi.getBasicBlockIndex(src) != -1) {
+      phi.removeIncomingValue(src, false);
+    }
+    phi.addIncoming(incomingValue, edgeBB);
+  }
+
+  return edgeBB;
+}
+
+void LoopProfilerPass::addCall(Function *api,
+                               uint64_t loopID,
+                               Value *frame,
+                               Instruction *insertPoint) {
+  IRBuilder<> builder(insertPoint);
+  auto loopIDValue = builder.getInt64(loopID);
+  builder.CreateCall(api->getFunctionType(),
+                     api,
+                     ArrayRef<Value *>({ loopIDValue, frame }));
+
+  return;
+}
+
+} // namespace arcana::noelle
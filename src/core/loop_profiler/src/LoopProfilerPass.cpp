@@ -0,0 +1,94 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "LoopProfilerPass.hpp"
+
+namespace arcana::noelle {
+
+LoopProfilerPass::LoopProfilerPass()
+  : ModulePass(ID),
+    invocationBegin{ nullptr },
+    iterationBegin{ nullptr },
+    invocationEnd{ nullptr } {
+
+  return;
+}
+
+bool LoopProfilerPass::doInitialization(Module &M) {
+  return false;
+}
+
+bool LoopProfilerPass::runOnModule(Module &M) {
+  auto modified = false;
+  errs() << "LoopProfiler: Start\n";
+
+  /*
+   * Declare the APIs of the runtime.
+   */
+  this->declareRuntimeAPIs(M);
+
+  /*
+   * Instrument the loops of every function.
+   */
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+
+    /*
+     * Fetch the loops of the function.
+     */
+    auto &LI = getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
+    std::vector<LoopStructure *> loops;
+    for (auto loop : LI.getLoopsInPreorder()) {
+      loops.push_back(new LoopStructure{ loop });
+    }
+
+    /*
+     * Instrument the loops.
+     */
+    modified |= this->instrumentLoops(F, loops);
+
+    /*
+     * Free the memory.
+     */
+    for (auto loop : loops) {
+      delete loop;
+    }
+  }
+
+  errs() << "LoopProfiler: Exit\n";
+  return modified;
+}
+
+void LoopProfilerPass::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<LoopInfoWrapperPass>();
+
+  return;
+}
+
+// Next there is code to register your pass to "opt"
+char LoopProfilerPass::ID = 0;
+static RegisterPass<LoopProfilerPass> X(
+    "LoopProfiler",
+    "Instrument loops to collect their runtime profile");
+
+} // namespace arcana::noelle
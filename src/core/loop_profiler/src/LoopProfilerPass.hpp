@@ -0,0 +1,71 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_LOOP_PROFILER_LOOPPROFILERPASS_H_
+#define NOELLE_SRC_CORE_LOOP_PROFILER_LOOPPROFILERPASS_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/LoopStructure.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Instrument every loop that has an ID (see noelle-meta-loop-embed) with calls
+ * to the NOELLE loop profiler runtime.
+ *
+ * The runtime is notified when an invocation of a loop starts (at the end of
+ * its pre-header), when a new iteration starts (at the beginning of its
+ * header), and when an invocation ends (on every loop exit edge, and in the
+ * landing pads the loop unwinds to). Every call also passes the address of a
+ * stack slot of the function, which identifies the frame the loop runs in.
+ */
+class LoopProfilerPass : public ModulePass {
+public:
+  static char ID;
+
+  LoopProfilerPass();
+
+  bool doInitialization(Module &M) override;
+
+  bool runOnModule(Module &M) override;
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  Function *invocationBegin;
+  Function *iterationBegin;
+  Function *invocationEnd;
+
+  void declareRuntimeAPIs(Module &M);
+
+  bool instrumentLoops(Function &F, std::vector<LoopStructure *> &loops);
+
+  BasicBlock *splitEdge(BasicBlock *src, BasicBlock *dst);
+
+  void addCall(Function *api,
+               uint64_t loopID,
+               Value *frame,
+               Instruction *insertPoint);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_LOOP_PROFILER_LOOPPROFILERPASS_H_
@@ -38,12 +38,17 @@ namespace arcana::noelle {
 
 class SCCDAGAttrs {
 public:
+  /*
+   * The SCCs of @loopSCCDAG are classified by using up to @numberOfThreads
+   * threads.
+   */
   SCCDAGAttrs(bool enableFloatAsReal,
               PDG *loopDG,
               SCCDAG *loopSCCDAG,
               LoopTree *loopNode,
               InductionVariableManager &IV,
-              DominatorSummary &DS);
+              DominatorSummary &DS,
+              uint32_t numberOfThreads = 1);
 
   SCCDAGAttrs() = delete;
 
@@ -82,6 +87,22 @@ public:
   ~SCCDAGAttrs();
 
 private:
+  /*
+   * Characteristics of an SCC that are computed without modifying the IR nor
+   * the state of @this.
+   * Hence, they can be computed for different SCCs concurrently.
+   */
+  struct SCCCharacteristics {
+    std::set<InductionVariable *> inductionVariables;
+    LoopCarriedVariable *reducibleVariable;
+    std::set<ClonableMemoryObject *> clonableMemoryObjects;
+    std::set<Instruction *> valuesToPropagateAcrossIterations;
+  };
+
+  /*
+   * The map is computed before the SCCs are classified and it is only read
+   * afterwards.
+   */
   std::map<SCC *, std::set<DGEdge<Value, Value> *>>
       sccToLoopCarriedDependencies;
   bool enableFloatAsReal;
@@ -98,7 +119,13 @@ private:
   /*
    * Helper methods on single SCC
    */
-  LoopCarriedVariable *checkIfReducible(SCC *scc, LoopTree *loop);
+  SCCCharacteristics computeSCCCharacteristics(
+      SCC *scc,
+      LoopTree *loop,
+      std::set<InductionVariable *> &IVs,
+      std::set<InductionVariable *> &loopGoverningIVs) const;
+
+  LoopCarriedVariable *checkIfReducible(SCC *scc, LoopTree *loop) const;
 
   std::tuple<bool, Value *, Value *, Value *> checkIfPeriodic(
       SCC *scc,
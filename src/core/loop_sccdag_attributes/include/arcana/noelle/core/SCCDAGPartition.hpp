@@ -27,6 +27,8 @@
 #include "arcana/noelle/core/SCCDAG.hpp"
 #include "arcana/noelle/core/DGGraphTraits.hpp"
 #include "arcana/noelle/core/LoopForest.hpp"
+#include "arcana/noelle/core/Hot.hpp"
+#include "arcana/noelle/core/CompilationOptionsManager.hpp"
 
 namespace arcana::noelle {
 
@@ -58,15 +60,38 @@ public:
 
   SCCSet *setOfSCC(SCC *scc);
 
-  void mergeSetsAndCollapseResultingCycles(std::unordered_set<SCCSet *> sets);
+  /*
+   * Merge @sets and all the sets that would form a cycle with them.
+   * Return the merged set.
+   */
+  SCCSet *mergeSetsAndCollapseResultingCycles(
+      std::unordered_set<SCCSet *> sets);
+
+  /*
+   * Reachability queries answered by the reachability matrix (no traversals).
+   */
+  bool isReachable(SCCSet *fromSet, SCCSet *toSet);
+  std::unordered_set<SCCSet *> getDescendants(SCCSet *set);
+  std::unordered_set<SCCSet *> getAncestors(SCCSet *set);
+
+  /*
+   * Return the sets, not included in @sets, that are reachable from a set of
+   * @sets and that reach a set of @sets.
+   * These are the sets that would form a cycle if @sets were merged.
+   */
+  std::unordered_set<SCCSet *> getSetsOnPathsBetween(
+      std::unordered_set<SCCSet *> const &sets);
 
   std::vector<SCCSet *> getDepthOrderedSets(void);
 
   SCCDAG *getSCCDAG(void) const;
 
 private:
-  void mergeSets(std::unordered_set<SCCSet *> sets);
-  void collapseCycles(void);
+  SCCSet *mergeSets(std::unordered_set<SCCSet *> const &sets);
+
+  uint32_t findSlot(uint32_t slot);
+
+  std::unordered_set<SCCSet *> setsOfSlots(BitVector const &slots);
 
   /*
    * The SCCDAG being partitioned
@@ -74,9 +99,23 @@ private:
   SCCDAG *sccdag;
 
   /*
-   * A mapping from SCC to its set in the partitioning
+   * Every initial set has a slot. When sets are merged, their slots are
+   * joined in a union-find and the merged set takes the slot of the root.
+   * An SCC is mapped to the slot of its initial set, so merges do not
+   * need to re-map SCCs.
    */
-  std::unordered_map<SCC *, SCCSet *> sccToSetMap;
+  std::unordered_map<SCC *, uint32_t> sccToSlot;
+  std::vector<uint32_t> slotParent;
+  std::vector<SCCSet *> slotToSet;
+  std::unordered_map<SCCSet *, uint32_t> setToSlot;
+
+  /*
+   * Reachability matrix of the partition graph, indexed by the slots of the
+   * current sets: descendants[i] has bit j set if the set of slot i reaches
+   * the set of slot j, and ancestors is its transpose.
+   */
+  std::vector<BitVector> descendants;
+  std::vector<BitVector> ancestors;
 };
 
 class SCCDAGPartitioner {
@@ -122,6 +161,29 @@ public:
 
   void mergeAlongMemoryEdges(void);
 
+  /*
+   * Merge the sets into pipeline stages, one per core at most (see
+   * CompilationOptionsManager::getMaximumNumberOfCores), so that the time of
+   * the slowest stage is minimized.
+   *
+   * The time of a stage is the number of dynamic instructions executed by its
+   * SCCs (see Hot::getTotalInstructions; static instructions are used when
+   * the profile is not available) plus the cost of a queue (see
+   * CompilationOptionsManager::getQueueCost) per loop iteration for every
+   * edge of the partition graph that enters or leaves the stage.
+   * Stages are contiguous ranges of the depth-ordered sets, so merging them
+   * never introduces cycles.
+   */
+  void mergeToBalancePipelineStages(Hot *profiles,
+                                    CompilationOptionsManager *options);
+
+  /*
+   * Print the stages predicted by the last call of
+   * mergeToBalancePipelineStages and their balance.
+   */
+  raw_ostream &printPredictedStageBalance(raw_ostream &stream,
+                                          std::string prefix);
+
   raw_ostream &printSet(raw_ostream &stream, SCCSet *set);
 
   // raw_ostream &print (raw_ostream &stream, std::string prefix) ;
@@ -136,6 +198,16 @@ private:
 
   void mergeAllPairs(std::set<std::pair<SCC *, SCC *>> pairs);
 
+  /*
+   * Stages predicted by mergeToBalancePipelineStages
+   */
+  struct StagePrediction {
+    uint64_t sets;
+    uint64_t work;
+    uint64_t communication;
+  };
+  std::vector<StagePrediction> predictedStages;
+
   /*
    * Debug information at the SCC level
    */
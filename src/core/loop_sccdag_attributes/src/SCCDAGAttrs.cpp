@@ -29,6 +29,8 @@
 #include "arcana/noelle/core/LoopCarriedUnknownSCC.hpp"
 #include "arcana/noelle/core/LoopCarriedDependencies.hpp"
 #include "arcana/noelle/core/UnknownClosedFormSCC.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
+#include <atomic>
 
 namespace arcana::noelle {
 
@@ -37,7 +39,8 @@ SCCDAGAttrs::SCCDAGAttrs(bool enableFloatAsReal,
                          SCCDAG *loopSCCDAG,
                          LoopTree *loopNode,
                          InductionVariableManager &IV,
-                         DominatorSummary &DS)
+                         DominatorSummary &DS,
+                         uint32_t numberOfThreads)
   : enableFloatAsReal{ enableFloatAsReal },
     loopDG{ loopDG },
     sccdag{ loopSCCDAG },
@@ -79,30 +82,84 @@ SCCDAGAttrs::SCCDAGAttrs(bool enableFloatAsReal,
   auto rootLoop = loopNode->getLoop();
   this->memoryCloningAnalysis = new MemoryCloningAnalysis(rootLoop, DS, loopDG);
 
+  /*
+   * Fetch the SCCs to tag.
+   */
+  std::vector<SCC *> sccs;
+  loopSCCDAG->iterateOverSCCs([&sccs](SCC *scc) -> bool {
+    sccs.push_back(scc);
+    return false;
+  });
+
+  /*
+   * Compute the characteristics of the SCCs.
+   *
+   * This only reads the IR, the loop dependence graph, the loop-carried
+   * dependences collected above, and the memory cloning analysis (which
+   * memoizes its answers in a thread-safe way).
+   * Hence, SCCs are analyzed concurrently when multiple threads are available.
+   * Threads pick the next SCC to analyze from a shared counter to balance the
+   * work as SCCs can be very different in size.
+   */
+  std::vector<SCCCharacteristics> characteristics(sccs.size());
+  auto analyzeSCC = [this,
+                     loopNode,
+                     &ivs,
+                     &loopGoverningIVs,
+                     &sccs,
+                     &characteristics](uint64_t sccIndex) -> void {
+    characteristics[sccIndex] =
+        this->computeSCCCharacteristics(sccs[sccIndex],
+                                        loopNode,
+                                        ivs,
+                                        loopGoverningIVs);
+  };
+  auto workers = std::min<uint64_t>(numberOfThreads, sccs.size());
+  if (workers <= 1) {
+    for (uint64_t sccIndex = 0; sccIndex < sccs.size(); sccIndex++) {
+      analyzeSCC(sccIndex);
+    }
+
+  } else {
+    ScopedTimer timer("SCCDAGAttrs::concurrentClassification");
+    std::atomic<uint64_t> nextSCC{ 0 };
+    auto worker = [&nextSCC, &sccs, &analyzeSCC](void) -> void {
+      while (true) {
+        auto sccIndex = nextSCC.fetch_add(1);
+        if (sccIndex >= sccs.size()) {
+          break;
+        }
+        analyzeSCC(sccIndex);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (uint64_t i = 1; i < workers; i++) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    Instrumentation::count("SCCDAGAttrs: SCCs classified concurrently",
+                           sccs.size());
+  }
+
   /*
    * Tag SCCs depending on their characteristics.
+   *
+   * This is done sequentially and in the order of the SCCDAG because checking
+   * periodic variables creates constants and the tags are allocated here.
    */
-  loopSCCDAG->iterateOverSCCs([this,
-                               loopNode,
-                               rootLoop,
-                               &ivs,
-                               &loopGoverningIVs,
-                               &DS](SCC *scc) -> bool {
-    /*
-     * Collect information about the current SCC.
-     */
-    auto doesSCCOnlyContainIV =
-        this->checkIfSCCOnlyContainsInductionVariables(scc,
-                                                       loopNode,
-                                                       ivs,
-                                                       loopGoverningIVs);
-    auto lcVar = this->checkIfReducible(scc, loopNode);
+  for (uint64_t sccIndex = 0; sccIndex < sccs.size(); sccIndex++) {
+    auto scc = sccs[sccIndex];
+    auto &sccCharacteristics = characteristics[sccIndex];
+    auto &doesSCCOnlyContainIV = sccCharacteristics.inductionVariables;
+    auto lcVar = sccCharacteristics.reducibleVariable;
     auto isReducable = lcVar != nullptr;
-    auto stackObjectsThatAreClonable =
-        this->checkIfClonableByUsingLocalMemory(scc, loopNode);
-    auto valuesToPropagateAcrossIterations =
-        this->checkIfRecomputable(scc, loopNode);
-
+    auto &stackObjectsThatAreClonable =
+        sccCharacteristics.clonableMemoryObjects;
+    auto &valuesToPropagateAcrossIterations =
+        sccCharacteristics.valuesToPropagateAcrossIterations;
     auto isPeriodic = this->checkIfPeriodic(scc, loopNode);
 
     /*
@@ -190,13 +247,32 @@ SCCDAGAttrs::SCCDAGAttrs(bool enableFloatAsReal,
     }
     assert(sccInfo != nullptr);
     this->sccToInfo[scc] = sccInfo;
-
-    return false;
-  });
+  }
 
   return;
 }
 
+SCCDAGAttrs::SCCCharacteristics SCCDAGAttrs::computeSCCCharacteristics(
+    SCC *scc,
+    LoopTree *loopNode,
+    std::set<InductionVariable *> &IVs,
+    std::set<InductionVariable *> &loopGoverningIVs) const {
+  SCCCharacteristics c;
+
+  c.inductionVariables =
+      this->checkIfSCCOnlyContainsInductionVariables(scc,
+                                                     loopNode,
+                                                     IVs,
+                                                     loopGoverningIVs);
+  c.reducibleVariable = this->checkIfReducible(scc, loopNode);
+  c.clonableMemoryObjects =
+      this->checkIfClonableByUsingLocalMemory(scc, loopNode);
+  c.valuesToPropagateAcrossIterations =
+      this->checkIfRecomputable(scc, loopNode);
+
+  return c;
+}
+
 std::set<LoopCarriedSCC *> SCCDAGAttrs::getSCCsWithLoopCarriedDependencies(
     void) const {
   std::set<LoopCarriedSCC *> sccs;
@@ -654,7 +730,7 @@ std::tuple<bool, Value *, Value *, Value *> SCCDAGAttrs::checkIfPeriodic(
 }
 
 LoopCarriedVariable *SCCDAGAttrs::checkIfReducible(SCC *scc,
-                                                   LoopTree *loopNode) {
+                                                   LoopTree *loopNode) const {
 
   /*
    * Check if the SCC has loop-carried dependences.
@@ -27,19 +27,25 @@ SCCDAGPartition::SCCDAGPartition(
     SCCDAG *sccdag,
     std::unordered_set<SCCSet *> initialSets,
     std::unordered_map<SCC *, std::unordered_set<SCC *>> sccToParentsMap)
-  : sccdag{ sccdag },
-    sccToSetMap{} {
+  : sccdag{ sccdag } {
 
   /*
    * Create nodes for each set and relate their member SCCs to that set
+   * Every set gets a slot, which identifies the set in the union-find and in
+   * the reachability matrix
    */
+  auto numberOfSlots = initialSets.size();
   for (auto initialSet : initialSets) {
     auto set = new SCCSet();
     set->sccs = initialSet->sccs;
     this->addNode(set, /*inclusion=*/true);
 
+    auto slot = static_cast<uint32_t>(this->slotToSet.size());
+    this->slotToSet.push_back(set);
+    this->slotParent.push_back(slot);
+    this->setToSlot[set] = slot;
     for (auto scc : set->sccs) {
-      this->sccToSetMap.insert(std::make_pair(scc, set));
+      this->sccToSlot.insert(std::make_pair(scc, slot));
     }
   }
 
@@ -53,17 +59,17 @@ SCCDAGPartition::SCCDAGPartition(
    */
   for (auto sccAndParents : sccToParentsMap) {
     auto scc = sccAndParents.first;
-    if (sccToSetMap.find(scc) == sccToSetMap.end())
+    if (!this->isIncludedInPartitioning(scc))
       continue;
 
-    auto selfSet = sccToSetMap.at(scc);
+    auto selfSet = this->setOfSCC(scc);
     auto selfNode = this->fetchNode(selfSet);
     auto &parents = sccAndParents.second;
 
     for (auto parent : parents) {
-      if (sccToSetMap.find(parent) == sccToSetMap.end())
+      if (!this->isIncludedInPartitioning(parent))
         continue;
-      auto parentSet = sccToSetMap.at(parent);
+      auto parentSet = this->setOfSCC(parent);
       auto parentNode = this->fetchNode(parentSet);
 
       if (this->fetchEdges(parentNode, selfNode).size() != 0)
@@ -71,6 +77,32 @@ SCCDAGPartition::SCCDAGPartition(
       this->addUndefinedDependenceEdge(parentSet, selfSet);
     }
   }
+
+  /*
+   * Compute the reachability matrix of the partition graph
+   * From now on, merges keep it up to date without traversing the graph
+   */
+  this->descendants.assign(numberOfSlots, BitVector(numberOfSlots));
+  this->ancestors.assign(numberOfSlots, BitVector(numberOfSlots));
+  for (auto slot = 0u; slot < numberOfSlots; slot++) {
+    auto &reached = this->descendants[slot];
+    std::vector<SCCSet *> setsToCheck{ this->slotToSet[slot] };
+    while (!setsToCheck.empty()) {
+      auto set = setsToCheck.back();
+      setsToCheck.pop_back();
+      for (auto edge : this->fetchNode(set)->getOutgoingEdges()) {
+        auto childSet = edge->getDst();
+        auto childSlot = this->setToSlot.at(childSet);
+        if (reached.test(childSlot))
+          continue;
+        reached.set(childSlot);
+        setsToCheck.push_back(childSet);
+      }
+    }
+    for (auto reachedSlot : reached.set_bits()) {
+      this->ancestors[reachedSlot].set(slot);
+    }
+  }
 }
 
 SCCDAGPartition::~SCCDAGPartition() {
@@ -92,35 +124,79 @@ SCC *SCCDAGPartition::sccOfValue(Value *V) {
 SCCSet *SCCDAGPartition::setOfSCC(SCC *scc) {
   assert(isIncludedInPartitioning(scc)
          && "SCCDAGPartition: SCC not in any partition");
-  return this->sccToSetMap.at(scc);
+  auto slot = this->findSlot(this->sccToSlot.at(scc));
+  return this->slotToSet[slot];
 }
 
 bool SCCDAGPartition::isIncludedInPartitioning(SCC *scc) {
-  return this->sccToSetMap.find(scc) != this->sccToSetMap.end();
+  return this->sccToSlot.find(scc) != this->sccToSlot.end();
+}
+
+bool SCCDAGPartition::isReachable(SCCSet *fromSet, SCCSet *toSet) {
+  auto fromSlot = this->setToSlot.at(fromSet);
+  auto toSlot = this->setToSlot.at(toSet);
+  return this->descendants[fromSlot].test(toSlot);
+}
+
+std::unordered_set<SCCSet *> SCCDAGPartition::getDescendants(SCCSet *set) {
+  return this->setsOfSlots(this->descendants[this->setToSlot.at(set)]);
+}
+
+std::unordered_set<SCCSet *> SCCDAGPartition::getAncestors(SCCSet *set) {
+  return this->setsOfSlots(this->ancestors[this->setToSlot.at(set)]);
+}
+
+std::unordered_set<SCCSet *> SCCDAGPartition::getSetsOnPathsBetween(
+    std::unordered_set<SCCSet *> const &sets) {
+
+  /*
+   * A set lies on a path between two sets of @sets if it is reachable from
+   * one of them and it reaches one of them
+   */
+  BitVector reachedFromSets(this->slotToSet.size());
+  BitVector reachingSets(this->slotToSet.size());
+  for (auto set : sets) {
+    auto slot = this->setToSlot.at(set);
+    reachedFromSets |= this->descendants[slot];
+    reachingSets |= this->ancestors[slot];
+  }
+  reachedFromSets &= reachingSets;
+
+  return this->setsOfSlots(reachedFromSets);
 }
 
-void SCCDAGPartition::mergeSetsAndCollapseResultingCycles(
+SCCSet *SCCDAGPartition::mergeSetsAndCollapseResultingCycles(
     std::unordered_set<SCCSet *> sets) {
-  mergeSets(sets);
-  collapseCycles();
+
+  /*
+   * The graph is acyclic before the merge, so the only cycles the merge can
+   * introduce go through the merged set. They are made of the sets that lie
+   * on a path between two of the sets to merge, so these sets are merged as
+   * well.
+   */
+  auto setsInCycles = this->getSetsOnPathsBetween(sets);
+  sets.insert(setsInCycles.begin(), setsInCycles.end());
+
+  return this->mergeSets(sets);
 }
 
-void SCCDAGPartition::mergeSets(std::unordered_set<SCCSet *> sets) {
+SCCSet *SCCDAGPartition::mergeSets(std::unordered_set<SCCSet *> const &sets) {
 
   /*
    * Merge sets into a single new set
-   * Re-map member SCCs to point to this new set
+   * The merged set takes the smallest slot among the ones of the sets merged
    * Add this set to a new node in the graph
    */
   auto mergedSet = new SCCSet();
+  BitVector mergedSlots(this->slotToSet.size());
+  auto mergedSlot = std::numeric_limits<uint32_t>::max();
   // errs() << "Merging:\n";
   for (auto set : sets) {
     mergedSet->sccs.insert(set->sccs.begin(), set->sccs.end());
 
-    for (auto scc : set->sccs) {
-      // scc->printMinimal(errs() << "SCC:\n"); errs() << "\n";
-      this->sccToSetMap[scc] = mergedSet;
-    }
+    auto slot = this->setToSlot.at(set);
+    mergedSlots.set(slot);
+    mergedSlot = std::min(mergedSlot, slot);
   }
   auto mergedSetNode = this->addNode(mergedSet, /*inclusion=*/true);
 
@@ -140,8 +216,7 @@ void SCCDAGPartition::mergeSets(std::unordered_set<SCCSet *> sets) {
       auto parentSet = edge->getSrc();
       auto parentNode = this->fetchNode(parentSet);
 
-      auto anySCCInParentSet = *parentSet->sccs.begin();
-      if (this->sccToSetMap.at(anySCCInParentSet) == mergedSet)
+      if (sets.find(parentSet) != sets.end())
         continue;
 
       if (this->fetchEdges(parentNode, mergedSetNode).size() != 0)
@@ -153,8 +228,7 @@ void SCCDAGPartition::mergeSets(std::unordered_set<SCCSet *> sets) {
       auto childSet = edge->getDst();
       auto childNode = this->fetchNode(childSet);
 
-      auto anySCCInChildSet = *childSet->sccs.begin();
-      if (this->sccToSetMap.at(anySCCInChildSet) == mergedSet)
+      if (sets.find(childSet) != sets.end())
         continue;
 
       if (this->fetchEdges(mergedSetNode, childNode).size() != 0)
@@ -169,70 +243,82 @@ void SCCDAGPartition::mergeSets(std::unordered_set<SCCSet *> sets) {
   for (auto set : sets) {
     auto node = this->fetchNode(set);
     this->removeNode(node);
+    this->setToSlot.erase(set);
     delete set;
   }
-}
-
-void SCCDAGPartition::collapseCycles(void) {
 
   /*
-   * Use Tarjan's algorithm to collapse all cycles
+   * Union the slots of the merged sets
+   * SCCs are re-mapped to the merged set lazily through the union-find
    */
-  std::set<std::unordered_set<SCCSet *> *> collapsedSets;
-  std::unordered_set<SCCSet *> visited;
-  for (auto nodeToVisit : getNodes()) {
-    auto setToVisit = nodeToVisit->getT();
-    if (visited.find(setToVisit) != visited.end())
-      continue;
+  for (auto slot : mergedSlots.set_bits()) {
+    this->slotParent[slot] = mergedSlot;
+  }
+  this->slotToSet[mergedSlot] = mergedSet;
+  this->setToSlot[mergedSet] = mergedSlot;
 
-    /*
-     * To use the DGGraphWrapper, the entry node must be set to the node
-     * where the traversal starts from
-     */
-    setEntryNode(nodeToVisit);
-    DGGraphWrapper<SCCDAGPartition, SCCSet> wrapper(this);
-    // nodeToVisit->print(errs() << "Visiting node using scc_iterator\n");
+  /*
+   * Update the reachability matrix
+   * The ancestors of any merged set now reach all the descendants of any
+   * merged set, and only through the merged set
+   */
+  BitVector mergedDescendants(this->slotToSet.size());
+  BitVector mergedAncestors(this->slotToSet.size());
+  for (auto slot : mergedSlots.set_bits()) {
+    mergedDescendants |= this->descendants[slot];
+    mergedAncestors |= this->ancestors[slot];
+    this->descendants[slot].reset();
+    this->ancestors[slot].reset();
+  }
+  mergedDescendants.reset(mergedSlots);
+  mergedAncestors.reset(mergedSlots);
+  for (auto slot : mergedAncestors.set_bits()) {
+    auto &reached = this->descendants[slot];
+    reached.reset(mergedSlots);
+    reached |= mergedDescendants;
+    reached.set(mergedSlot);
+  }
+  for (auto slot : mergedDescendants.set_bits()) {
+    auto &reaching = this->ancestors[slot];
+    reaching.reset(mergedSlots);
+    reaching |= mergedAncestors;
+    reaching.set(mergedSlot);
+  }
+  this->descendants[mergedSlot] = mergedDescendants;
+  this->ancestors[mergedSlot] = mergedAncestors;
 
-    /*
-     * scc_iterator collects all cycles found from the entry node to leaves of
-     * the graph reachable by that node
-     */
-    for (auto dgI = scc_begin(&wrapper); dgI != scc_end(&wrapper); ++dgI) {
+  return mergedSet;
+}
 
-      /*
-       * Fetch a newly identified cycle of SCC sets.
-       */
-      const std::vector<DGNodeWrapper<SCCSet> *> &setNodes = *dgI;
-      auto firstNodeWrapper = *setNodes.begin();
-      auto firstSet = firstNodeWrapper->wrappedNode->getT();
-      if (visited.find(firstSet) != visited.end()) {
-        continue;
-      }
+uint32_t SCCDAGPartition::findSlot(uint32_t slot) {
 
-      auto unwrappedSets = new std::unordered_set<SCCSet *>();
-      for (auto setWrapper : setNodes) {
-        auto unwrappedNode = setWrapper->wrappedNode;
-        auto unwrappedSet = unwrappedNode->getT();
-        unwrappedSets->insert(unwrappedSet);
-        // for (auto scc : unwrappedSet->sccs) {
-        //   scc->printMinimal(errs() << "Contained SCC:\n");
-        // }
-      }
+  /*
+   * Find the root of the union-find
+   */
+  auto root = slot;
+  while (this->slotParent[root] != root) {
+    root = this->slotParent[root];
+  }
 
-      /*
-       * Collapse sets that form a cycle into one set
-       */
-      visited.insert(unwrappedSets->begin(), unwrappedSets->end());
-      collapsedSets.insert(unwrappedSets);
-    }
+  /*
+   * Compress the path
+   */
+  while (this->slotParent[slot] != root) {
+    auto next = this->slotParent[slot];
+    this->slotParent[slot] = root;
+    slot = next;
   }
 
-  for (auto setsToMerge : collapsedSets) {
-    if (setsToMerge->size() > 1) {
-      this->mergeSets(*setsToMerge);
-    }
-    delete setsToMerge;
+  return root;
+}
+
+std::unordered_set<SCCSet *> SCCDAGPartition::setsOfSlots(
+    BitVector const &slots) {
+  std::unordered_set<SCCSet *> sets;
+  for (auto slot : slots.set_bits()) {
+    sets.insert(this->slotToSet[slot]);
   }
+  return sets;
 }
 
 std::vector<SCCSet *> SCCDAGPartition::getDepthOrderedSets(void) {
@@ -436,26 +522,7 @@ void SCCDAGPartitioner::resetPartitioner(void) {
 }
 
 bool SCCDAGPartitioner::isAncestor(SCCSet *parentTarget, SCCSet *target) {
-  std::queue<SCCSet *> setToCheck;
-  setToCheck.push(target);
-
-  while (!setToCheck.empty()) {
-    auto set = setToCheck.front();
-    setToCheck.pop();
-
-    auto node = partition->fetchNode(set);
-    if (node->inDegree() == 0)
-      continue;
-
-    for (auto edge : node->getIncomingEdges()) {
-      auto parentSet = edge->getSrc();
-      if (parentSet == parentTarget)
-        return true;
-      setToCheck.push(parentSet);
-    }
-  }
-
-  return false;
+  return this->partition->isReachable(parentTarget, target);
 }
 
 std::pair<SCCSet *, SCCSet *> SCCDAGPartitioner::getParentChildPair(
@@ -482,86 +549,32 @@ std::unordered_set<SCCSet *> SCCDAGPartitioner::getOverlap(
 }
 
 bool SCCDAGPartitioner::isMergeIntroducingCycle(SCCSet *setA, SCCSet *setB) {
-  auto parentChild = getParentChildPair(setA, setB);
-  if (parentChild.first == nullptr)
-    return false;
 
   /*
-   * If one set is the ancestor of another, no cycle is created ONLY if
-   * no set can be reached by the parent that can reach the child
+   * If one set is the ancestor of another, a cycle is created if
+   * any set can be reached by the parent that can reach the child
    */
-  auto parentDescendants = getDescendants(parentChild.first);
-  auto childAncestors = getAncestors(parentChild.second);
-  auto overlap = getOverlap(parentDescendants, childAncestors);
-  return overlap.size() > 0;
+  auto setsInCycle = this->partition->getSetsOnPathsBetween({ setA, setB });
+  return setsInCycle.size() > 0;
 }
 
 std::unordered_set<SCCSet *> SCCDAGPartitioner::getCycleIntroducedByMerging(
     SCCSet *setA,
     SCCSet *setB) {
-  auto parentChild = getParentChildPair(setA, setB);
-  if (parentChild.first == nullptr) {
-    return { setA, setB };
-  }
-
-  auto parentDescendants = getDescendants(parentChild.first);
-  auto childAncestors = getAncestors(parentChild.second);
-  auto overlap = getOverlap(parentDescendants, childAncestors);
-  overlap.insert(parentChild.first);
-  overlap.insert(parentChild.second);
-  return overlap;
+  auto setsInCycle = this->partition->getSetsOnPathsBetween({ setA, setB });
+  setsInCycle.insert(setA);
+  setsInCycle.insert(setB);
+  return setsInCycle;
 }
 
 std::unordered_set<SCCSet *> SCCDAGPartitioner::getDescendants(
     SCCSet *startingSet) {
-  std::unordered_set<SCCSet *> descendants;
-  std::queue<SCCSet *> setToCheck;
-  setToCheck.push(startingSet);
-
-  while (!setToCheck.empty()) {
-    auto set = setToCheck.front();
-    setToCheck.pop();
-
-    auto node = partition->fetchNode(set);
-    if (node->outDegree() == 0)
-      continue;
-
-    for (auto edge : node->getOutgoingEdges()) {
-      auto childSet = edge->getDst();
-      if (descendants.find(childSet) != descendants.end())
-        continue;
-      setToCheck.push(childSet);
-      descendants.insert(childSet);
-    }
-  }
-
-  return descendants;
+  return this->partition->getDescendants(startingSet);
 }
 
 std::unordered_set<SCCSet *> SCCDAGPartitioner::getAncestors(
     SCCSet *startingSet) {
-  std::unordered_set<SCCSet *> ancestors;
-  std::queue<SCCSet *> setToCheck;
-  setToCheck.push(startingSet);
-
-  while (!setToCheck.empty()) {
-    auto set = setToCheck.front();
-    setToCheck.pop();
-
-    auto node = partition->fetchNode(set);
-    if (node->inDegree() == 0)
-      continue;
-
-    for (auto edge : node->getIncomingEdges()) {
-      auto parentSet = edge->getSrc();
-      if (ancestors.find(parentSet) != ancestors.end())
-        continue;
-      setToCheck.push(parentSet);
-      ancestors.insert(parentSet);
-    }
-  }
-
-  return ancestors;
+  return this->partition->getAncestors(startingSet);
 }
 
 SCCDAGPartition *SCCDAGPartitioner::getPartitionGraph(void) {
@@ -611,9 +624,8 @@ std::vector<SCCSet *> SCCDAGPartitioner::getDepthOrderedSets(void) {
 }
 
 SCCSet *SCCDAGPartitioner::mergePair(SCCSet *setA, SCCSet *setB) {
-  this->partition->mergeSetsAndCollapseResultingCycles({ setA, setB });
-  auto anySCCInMergedSet = *setA->sccs.begin();
-  auto mergedSet = this->partition->setOfSCC(anySCCInMergedSet);
+  auto mergedSet =
+      this->partition->mergeSetsAndCollapseResultingCycles({ setA, setB });
   return mergedSet;
 }
 
@@ -711,6 +723,214 @@ void SCCDAGPartitioner::mergeAlongMemoryEdges(void) {
   mergeAllPairs(memoryPairs);
 }
 
+void SCCDAGPartitioner::mergeToBalancePipelineStages(
+    Hot *profiles,
+    CompilationOptionsManager *options) {
+  this->predictedStages.clear();
+
+  /*
+   * Fetch the sets in a topological order
+   */
+  auto orderedSets = this->getDepthOrderedSets();
+  auto numberOfSets = orderedSets.size();
+  if (numberOfSets == 0) {
+    return;
+  }
+  std::unordered_map<SCCSet *, uint32_t> setToPosition;
+  for (auto i = 0u; i < numberOfSets; i++) {
+    setToPosition[orderedSets[i]] = i;
+  }
+
+  /*
+   * Compute the work of every set and the edges between sets
+   * All edges go from a set to a later one in the order
+   */
+  auto isProfileAvailable = profiles->isAvailable();
+  std::vector<uint64_t> work(numberOfSets, 0);
+  std::vector<uint32_t> numberOfChildren(numberOfSets, 0);
+  std::vector<std::vector<uint32_t>> parents(numberOfSets);
+  for (auto i = 0u; i < numberOfSets; i++) {
+    auto set = orderedSets[i];
+    for (auto scc : set->sccs) {
+      work[i] += isProfileAvailable ? profiles->getTotalInstructions(scc)
+                                    : profiles->getStaticInstructions(scc);
+    }
+    auto node = this->partition->fetchNode(set);
+    numberOfChildren[i] = node->outDegree();
+    for (auto edge : node->getIncomingEdges()) {
+      parents[i].push_back(setToPosition.at(edge->getSrc()));
+    }
+  }
+
+  /*
+   * Compute the cost of sending a value between two stages
+   */
+  uint64_t iterations = 1;
+  if (isProfileAvailable) {
+    iterations = std::max<uint64_t>(
+        profiles->getIterations(this->rootLoop->getLoop()),
+        1);
+  }
+  auto communicationCost = options->getQueueCost() * iterations;
+
+  /*
+   * Compute the time of the stage made of the sets [first, last]
+   */
+  auto computeStage = [&](uint32_t first, uint32_t last) -> StagePrediction {
+    StagePrediction stage{ last - first + 1, 0, 0 };
+    uint64_t edges = 0;
+    for (auto j = first; j <= last; j++) {
+      stage.work += work[j];
+      edges += numberOfChildren[j];
+      for (auto parent : parents[j]) {
+        if (parent < first) {
+          edges++;
+        } else {
+          edges--;
+        }
+      }
+    }
+    stage.communication = edges * communicationCost;
+    return stage;
+  };
+
+  /*
+   * Split the ordered sets into at most as many stages as the cores
+   * available minimizing the time of the slowest stage.
+   *
+   * slowest[k][j] is the time of the slowest stage when the first j sets
+   * are split into k stages, and firstOfLast[k][j] is the first set of the
+   * last of these stages.
+   * The time of the stages starting at i is computed incrementally while
+   * extending them one set at a time.
+   */
+  auto maximumStages = std::max<uint32_t>(options->getMaximumNumberOfCores(),
+                                          1);
+  maximumStages = std::min<uint64_t>(maximumStages, numberOfSets);
+  auto unreachable = std::numeric_limits<uint64_t>::max();
+  std::vector<std::vector<uint64_t>> slowest(
+      maximumStages + 1,
+      std::vector<uint64_t>(numberOfSets + 1, unreachable));
+  std::vector<std::vector<uint32_t>> firstOfLast(
+      maximumStages + 1,
+      std::vector<uint32_t>(numberOfSets + 1, 0));
+  slowest[0][0] = 0;
+  for (auto i = 0u; i < numberOfSets; i++) {
+    uint64_t stageWork = 0;
+    uint64_t stageEdges = 0;
+    for (auto j = i; j < numberOfSets; j++) {
+
+      /*
+       * Add the set j to the stage starting at i
+       * Its edges with previous sets of the stage become internal
+       */
+      stageWork += work[j];
+      stageEdges += numberOfChildren[j];
+      for (auto parent : parents[j]) {
+        if (parent < i) {
+          stageEdges++;
+        } else {
+          stageEdges--;
+        }
+      }
+      auto stageTime = stageWork + stageEdges * communicationCost;
+
+      for (auto k = 1u; k <= maximumStages; k++) {
+        if (slowest[k - 1][i] == unreachable) {
+          continue;
+        }
+        auto time = std::max(slowest[k - 1][i], stageTime);
+        if (time < slowest[k][j + 1]) {
+          slowest[k][j + 1] = time;
+          firstOfLast[k][j + 1] = i;
+        }
+      }
+    }
+  }
+
+  /*
+   * Pick the number of stages with the fastest slowest stage (the smallest
+   * number of stages on ties)
+   */
+  auto numberOfStages = 1u;
+  for (auto k = 2u; k <= maximumStages; k++) {
+    if (slowest[k][numberOfSets] < slowest[numberOfStages][numberOfSets]) {
+      numberOfStages = k;
+    }
+  }
+
+  /*
+   * Collect the stages
+   */
+  std::vector<std::pair<uint32_t, uint32_t>> stages;
+  auto last = numberOfSets;
+  for (auto k = numberOfStages; k > 0; k--) {
+    auto first = firstOfLast[k][last];
+    stages.push_back({ first, last - 1 });
+    last = first;
+  }
+  std::reverse(stages.begin(), stages.end());
+
+  /*
+   * Merge the sets of every stage
+   */
+  for (auto &[first, last] : stages) {
+    this->predictedStages.push_back(computeStage(first, last));
+    if (first == last) {
+      continue;
+    }
+    std::unordered_set<SCCSet *> setsOfStage(orderedSets.begin() + first,
+                                             orderedSets.begin() + last + 1);
+    this->partition->mergeSetsAndCollapseResultingCycles(setsOfStage);
+  }
+
+  return;
+}
+
+raw_ostream &SCCDAGPartitioner::printPredictedStageBalance(
+    raw_ostream &stream,
+    std::string prefix) {
+
+  /*
+   * Find the slowest stage
+   */
+  uint64_t slowestTime = 0;
+  uint64_t totalTime = 0;
+  for (auto &stage : this->predictedStages) {
+    auto time = stage.work + stage.communication;
+    slowestTime = std::max(slowestTime, time);
+    totalTime += time;
+  }
+
+  stream << prefix << "Predicted pipeline stages: "
+         << this->predictedStages.size() << "\n";
+  auto stageID = 0u;
+  for (auto &stage : this->predictedStages) {
+    auto time = stage.work + stage.communication;
+    stream << prefix << "  Stage " << stageID++ << ": sets = " << stage.sets
+           << ", work = " << stage.work
+           << ", communication = " << stage.communication
+           << ", time = " << time;
+    if (slowestTime > 0) {
+      stream << " (" << ((time * 100) / slowestTime)
+             << "% of the slowest stage)";
+    }
+    stream << "\n";
+  }
+
+  /*
+   * The balance is the average stage time over the slowest one (100% means
+   * perfectly balanced stages)
+   */
+  if (slowestTime > 0) {
+    auto balance =
+        (totalTime * 100) / (slowestTime * this->predictedStages.size());
+    stream << prefix << "  Balance: " << balance << "%\n";
+  }
+
+  return stream;
+}
+
 raw_ostream &SCCDAGPartitioner::printSet(raw_ostream &stream, SCCSet *set) {
   stream << "Set: ";
   for (auto scc : set->sccs) {
@@ -80,6 +80,13 @@ public:
 
   bool isIncluded(Instruction *inst) const;
 
+  /*
+   * Recompute the structure of the loop (e.g., its basic blocks, its exits,
+   * and its nesting level) from @l after a transformation changed it.
+   * The ID of the loop is preserved.
+   */
+  void updateStructure(Loop *l);
+
   void print(raw_ostream &stream);
 
 private:
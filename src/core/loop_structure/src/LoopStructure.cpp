@@ -31,6 +31,15 @@ namespace arcana::noelle {
 const std::string LoopStructure::metadataKeyID = "noelle.loop.id";
 
 LoopStructure::LoopStructure(Loop *l) {
+  this->updateStructure(l);
+
+  return;
+}
+
+void LoopStructure::updateStructure(Loop *l) {
+  this->invariants.clear();
+  this->latchBBs.clear();
+  this->bbs.clear();
 
   /*
    * Set the nesting level
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_LOOP_TILING_LOOPTILING_H_
+#define NOELLE_SRC_CORE_LOOP_TILING_LOOPTILING_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/LoopContent.hpp"
+#include "arcana/noelle/core/PerfectLoopNest.hpp"
+
+namespace arcana::noelle {
+
+class LoopTiling {
+public:
+  /*
+   * Methods
+   */
+  LoopTiling();
+
+  /*
+   * Tile the perfect loop nest rooted at the loop of @LDI (see
+   * PerfectLoopNest) to improve the cache locality of its memory accesses.
+   *
+   * @tileSizes is the number of iterations of a tile for each loop of the
+   * nest, from the outermost; loops with a tile size lower than 2 (or without
+   * one) are not tiled. If @tileSizes is empty, the tile sizes are computed
+   * from the size of the L1 data cache.
+   *
+   * The basic blocks of the loops of the nest are preserved: the new loops
+   * that iterate over the tiles wrap the nest and they are added to the loop
+   * forest of @LDI as the parents of the nest. The other abstractions of @LDI
+   * (e.g., induction variables) describe the nest before tiling and they need
+   * to be recomputed.
+   *
+   * Return true if the nest has been tiled.
+   */
+  bool tileLoopNest(LoopContent &LDI,
+                    const std::vector<uint32_t> &tileSizes,
+                    LoopInfo &LI,
+                    ScalarEvolution &SE);
+
+  /*
+   * Compute the tile sizes for @nest such that the data a tile accesses fits
+   * in half of the L1 data cache.
+   */
+  std::vector<uint32_t> computeTileSizes(const PerfectLoopNest &nest,
+                                         LoopInfo &LI,
+                                         ScalarEvolution &SE);
+
+private:
+  /*
+   * Fields
+   */
+  struct TileLoop {
+    uint32_t depth;
+    uint64_t tileStride;
+    BasicBlock *header;
+    BasicBlock *body;
+    BasicBlock *latch;
+    PHINode *tileStart;
+    Value *tileEnd;
+  };
+
+  /*
+   * Methods
+   */
+  bool canWrapLoopNest(LoopStructure *topLoop);
+
+  void updateLoopForest(LoopContent &LDI,
+                        const std::vector<TileLoop> &tileLoops);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_LOOP_TILING_LOOPTILING_H_
@@ -0,0 +1,381 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/LoopTiling.hpp"
+#include "arcana/noelle/core/Architecture.hpp"
+
+namespace arcana::noelle {
+
+LoopTiling::LoopTiling() {
+
+  return;
+}
+
+bool LoopTiling::tileLoopNest(LoopContent &LDI,
+                              const std::vector<uint32_t> &tileSizes,
+                              LoopInfo &LI,
+                              ScalarEvolution &SE) {
+
+  /*
+   * Check that the loop is the root of a perfect nest of counted loops that
+   * can be wrapped into new loops.
+   */
+  PerfectLoopNest nest(LDI, SE);
+  if (!nest.isValid()) {
+    return false;
+  }
+  auto &countedLoops = nest.getLoops();
+  auto topLoop = countedLoops.front().loop;
+  if (!this->canWrapLoopNest(topLoop)) {
+    return false;
+  }
+
+  /*
+   * Choose the loops to tile.
+   */
+  auto sizes = tileSizes;
+  if (sizes.empty()) {
+    sizes = this->computeTileSizes(nest, LI, SE);
+  }
+  std::vector<uint32_t> tiledDepths;
+  for (auto depth = 0u; depth < nest.getDepth(); depth++) {
+    if ((depth < sizes.size()) && (sizes[depth] > 1)) {
+      tiledDepths.push_back(depth);
+    }
+  }
+  if (tiledDepths.empty()) {
+    return false;
+  }
+
+  /*
+   * The iterations of the tiled loops run in a different order, which is
+   * legal only if no memory dependence has a negative distance.
+   */
+  if (!nest.isFullyPermutable()) {
+    return false;
+  }
+
+  /*
+   * Fetch the blocks around the nest.
+   * The exit block keeps being the exit of the nest, while its code moves to
+   * a new block that runs after all tiles.
+   */
+  auto F = topLoop->getFunction();
+  auto &context = F->getContext();
+  auto preheader = topLoop->getPreHeader();
+  auto exitBlock = topLoop->getLoopExitBasicBlocks()[0];
+  auto llvmTopLoop = LI.getLoopFor(topLoop->getHeader());
+  auto afterNest = SplitBlock(exitBlock, &*exitBlock->begin());
+
+  /*
+   * Redirect the entry of the nest to the loops that iterate over the tiles.
+   */
+  auto tileEntry = BasicBlock::Create(context, "", F, preheader);
+  std::set<BasicBlock *> predecessorsOfTheNest(pred_begin(preheader),
+                                               pred_end(preheader));
+  for (auto pred : predecessorsOfTheNest) {
+    if (pred == tileEntry) {
+      continue;
+    }
+    pred->getTerminator()->replaceUsesOfWith(preheader, tileEntry);
+  }
+
+  /*
+   * Hoist the code of the preheader before the tile loops.
+   * The tile loops use the start and exit values of the nest, which are
+   * either computed by the preheader or they dominate it, so they dominate
+   * the tile loops after hoisting.
+   * This also avoids running the preheader once per tile.
+   */
+  std::vector<Instruction *> preheaderInstructions;
+  for (auto &inst : *preheader) {
+    if (!inst.isTerminator()) {
+      preheaderInstructions.push_back(&inst);
+    }
+  }
+  for (auto inst : preheaderInstructions) {
+    inst->moveBefore(*tileEntry, tileEntry->end());
+  }
+
+  /*
+   * Create a loop that iterates over the tiles of each tiled loop, from the
+   * outermost.
+   * Each one is in while form:
+   *
+   *   header:
+   *     tileStart = phi [start, entry], [tileEnd, latch]
+   *     if (tileStart continuePredicate exitValue) goto body; else goto exit;
+   *   body:
+   *     tileEnd = (exitValue - tileStart) < tileStride
+   *               ? exitValue
+   *               : tileStart + tileStride
+   *     goto next tile loop (or the nest)
+   *   latch:
+   *     goto header
+   */
+  std::vector<TileLoop> tileLoops;
+  auto entry = tileEntry;
+  for (auto depth : tiledDepths) {
+    auto &countedLoop = countedLoops[depth];
+    auto type = countedLoop.inductionVariable->getType();
+    TileLoop tileLoop;
+    tileLoop.depth = depth;
+    tileLoop.tileStride = sizes[depth] * countedLoop.step;
+    tileLoop.header = BasicBlock::Create(context, "", F, preheader);
+    tileLoop.body = BasicBlock::Create(context, "", F, preheader);
+    tileLoop.latch = BasicBlock::Create(context, "", F, afterNest);
+    auto tileStride = ConstantInt::get(type, tileLoop.tileStride);
+
+    /*
+     * Enter the tile loop.
+     */
+    IRBuilder<> entryBuilder(entry);
+    entryBuilder.CreateBr(tileLoop.header);
+
+    /*
+     * Fill the header.
+     * The exit target is set once the body of the tile loop is known.
+     */
+    IRBuilder<> headerBuilder(tileLoop.header);
+    tileLoop.tileStart = headerBuilder.CreatePHI(type, 2);
+    tileLoop.tileStart->addIncoming(countedLoop.startValue, entry);
+    auto isInTheIterationSpace =
+        headerBuilder.CreateICmp(countedLoop.continuePredicate,
+                                 tileLoop.tileStart,
+                                 countedLoop.exitValue);
+    auto exitTarget = tileLoops.empty() ? afterNest : tileLoops.back().latch;
+    headerBuilder.CreateCondBr(isInTheIterationSpace,
+                               tileLoop.body,
+                               exitTarget);
+
+    /*
+     * Fill the body.
+     */
+    IRBuilder<> bodyBuilder(tileLoop.body);
+    auto remaining =
+        bodyBuilder.CreateSub(countedLoop.exitValue, tileLoop.tileStart);
+    auto isLastTile = bodyBuilder.CreateICmpULT(remaining, tileStride);
+    auto nextTileStart = bodyBuilder.CreateAdd(tileLoop.tileStart, tileStride);
+    tileLoop.tileEnd = bodyBuilder.CreateSelect(isLastTile,
+                                                countedLoop.exitValue,
+                                                nextTileStart);
+
+    /*
+     * Fill the latch.
+     */
+    IRBuilder<> latchBuilder(tileLoop.latch);
+    latchBuilder.CreateBr(tileLoop.header);
+    tileLoop.tileStart->addIncoming(tileLoop.tileEnd, tileLoop.latch);
+
+    tileLoops.push_back(tileLoop);
+    entry = tileLoop.body;
+  }
+
+  /*
+   * Run the nest within the innermost tile loop.
+   */
+  IRBuilder<> entryBuilder(entry);
+  entryBuilder.CreateBr(preheader);
+  exitBlock->getTerminator()->replaceUsesOfWith(afterNest,
+                                                tileLoops.back().latch);
+
+  /*
+   * Restrict the tiled loops to their tile.
+   */
+  for (auto &tileLoop : tileLoops) {
+    auto &countedLoop = countedLoops[tileLoop.depth];
+    auto loopPreheader = countedLoop.loop->getPreHeader();
+    auto phi = countedLoop.inductionVariable;
+    phi->setIncomingValue(phi->getBasicBlockIndex(loopPreheader),
+                          tileLoop.tileStart);
+    countedLoop.compare->replaceUsesOfWith(countedLoop.exitValue,
+                                           tileLoop.tileEnd);
+  }
+
+  /*
+   * Update the analyses.
+   */
+  if (llvmTopLoop != nullptr) {
+    SE.forgetLoop(llvmTopLoop);
+  }
+  this->updateLoopForest(LDI, tileLoops);
+
+  return true;
+}
+
+std::vector<uint32_t> LoopTiling::computeTileSizes(const PerfectLoopNest &nest,
+                                                   LoopInfo &LI,
+                                                   ScalarEvolution &SE) {
+  std::vector<uint32_t> sizes(nest.getDepth(), 0);
+
+  /*
+   * Tiling a single loop does not improve locality.
+   */
+  if (nest.getDepth() < 2) {
+    return sizes;
+  }
+
+  /*
+   * Fetch the arrays accessed by the nest and the size of their elements.
+   */
+  auto F = nest.getLoops().front().loop->getFunction();
+  auto &DL = F->getParent()->getDataLayout();
+  std::unordered_set<const SCEV *> arrays;
+  uint64_t elementBytes = 1;
+  for (auto access : nest.getMemoryAccesses()) {
+    Value *pointer = nullptr;
+    Type *accessedType = nullptr;
+    if (auto load = dyn_cast<LoadInst>(access)) {
+      pointer = load->getPointerOperand();
+      accessedType = load->getType();
+    } else {
+      auto store = cast<StoreInst>(access);
+      pointer = store->getPointerOperand();
+      accessedType = store->getValueOperand()->getType();
+    }
+    arrays.insert(SE.getPointerBase(SE.getSCEV(pointer)));
+    elementBytes =
+        std::max<uint64_t>(elementBytes, DL.getTypeStoreSize(accessedType));
+  }
+  if (arrays.empty()) {
+    return sizes;
+  }
+
+  /*
+   * Each array is accessed along (at most) two dimensions of a tile, so a tile
+   * of T iterations per loop accesses about arrays * T^2 elements.
+   * Pick the largest power of two that fits in half of the L1 data cache, but
+   * at least a cache line of elements.
+   */
+  auto budget = Architecture::getCacheBytes(1) / 2;
+  uint64_t tile = 1;
+  while (((tile * 2) * (tile * 2) * arrays.size() * elementBytes) <= budget) {
+    tile *= 2;
+  }
+  auto lineElements = std::max<uint64_t>(
+      Architecture::getCacheLineBytes(1) / elementBytes,
+      2);
+  tile = std::max(tile, lineElements);
+
+  /*
+   * Do not tile loops that run at most one tile.
+   */
+  for (auto depth = 0u; depth < nest.getDepth(); depth++) {
+    auto loop = nest.getLoops()[depth].loop;
+    auto llvmLoop = LI.getLoopFor(loop->getHeader());
+    auto tripCount =
+        (llvmLoop != nullptr) ? SE.getSmallConstantTripCount(llvmLoop) : 0;
+    if ((tripCount > 0) && (tripCount <= tile)) {
+      continue;
+    }
+    sizes[depth] = tile;
+  }
+
+  return sizes;
+}
+
+bool LoopTiling::canWrapLoopNest(LoopStructure *topLoop) {
+
+  /*
+   * The code of the preheader of the nest is hoisted before the tile loops.
+   * Hence, the preheader must not be the entry point of the function, and its
+   * code must be side-effect free, it must not read memory, and it must be
+   * used only within the nest.
+   */
+  auto F = topLoop->getFunction();
+  auto preheader = topLoop->getPreHeader();
+  if ((preheader == nullptr) || (preheader == &F->getEntryBlock())
+      || isa<PHINode>(preheader->begin())) {
+    return false;
+  }
+  for (auto &inst : *preheader) {
+    if (inst.mayHaveSideEffects() || inst.mayReadFromMemory()
+        || isa<AllocaInst>(&inst)) {
+      return false;
+    }
+    for (auto user : inst.users()) {
+      auto userInst = dyn_cast<Instruction>(user);
+      if ((userInst == nullptr)
+          || ((userInst->getParent() != preheader)
+              && !topLoop->isIncluded(userInst))) {
+        return false;
+      }
+    }
+  }
+
+  /*
+   * The nest must have a single exit block that is reached only from the
+   * nest, as it will jump to the next tile.
+   */
+  auto exitBlocks = topLoop->getLoopExitBasicBlocks();
+  if (exitBlocks.size() != 1) {
+    return false;
+  }
+  auto exitBlock = exitBlocks[0];
+  if ((exitBlock->getSinglePredecessor() == nullptr)
+      || isa<PHINode>(exitBlock->begin())) {
+    return false;
+  }
+
+  return true;
+}
+
+void LoopTiling::updateLoopForest(LoopContent &LDI,
+                                  const std::vector<TileLoop> &tileLoops) {
+
+  /*
+   * Compute the loops of the function after tiling.
+   */
+  auto tree = LDI.getLoopHierarchyStructures();
+  auto F = tree->getLoop()->getFunction();
+  DominatorTree DT(*F);
+  LoopInfo LI(DT);
+
+  /*
+   * The loops that include the nest now include the tile loops as well, and
+   * the loops of the nest are now deeper.
+   */
+  for (auto node = tree->getParent(); node != nullptr;
+       node = node->getParent()) {
+    auto loop = node->getLoop();
+    loop->updateStructure(LI.getLoopFor(loop->getHeader()));
+  }
+  for (auto loop : tree->getLoops()) {
+    loop->updateStructure(LI.getLoopFor(loop->getHeader()));
+  }
+
+  /*
+   * Add the tile loops to the forest, from the innermost.
+   */
+  auto forest = tree->getForest();
+  auto node = tree;
+  for (auto it = tileLoops.rbegin(); it != tileLoops.rend(); ++it) {
+    auto llvmLoop = LI.getLoopFor(it->header);
+    assert(llvmLoop != nullptr);
+    assert(llvmLoop->getHeader() == it->header);
+    auto loop = new LoopStructure(llvmLoop);
+    node = forest->addParent(node, loop);
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -27,6 +27,7 @@
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/LoopContent.hpp"
+#include "arcana/noelle/core/Hot.hpp"
 
 namespace arcana::noelle {
 
@@ -38,6 +39,8 @@ public:
 
   void setPDG(PDG *programDependenceGraph);
 
+  void setProfiles(Hot *profiles);
+
   LoopUnrollResult unrollLoop(LoopContent *loop, uint32_t unrollFactor);
 
   bool fullyUnrollLoop(LoopContent *loop);
@@ -49,6 +52,28 @@ public:
                  std::set<Instruction *> &instructionsRemoved,
                  std::set<Instruction *> &instructionsAdded);
 
+  /*
+   * Tile the perfect loop nest rooted at @loop (see LoopTiling).
+   * If @tileSizes is empty, the tile sizes are computed from the L1 cache.
+   */
+  bool tileLoopNest(LoopContent *loop,
+                    const std::vector<uint32_t> &tileSizes = {});
+
+  /*
+   * Reorder the loops of the perfect loop nest rooted at @loop (see
+   * LoopInterchange).
+   * If @permutation is empty, the most profitable legal order is used.
+   */
+  bool interchangeLoops(LoopContent *loop,
+                        const std::vector<uint32_t> &permutation = {});
+
+  /*
+   * Fuse the loop @second into the loop @first, which must immediately
+   * precede it (see LoopFusion).
+   * On success, @first is the fused loop and @second must not be used anymore.
+   */
+  bool fuseLoops(LoopContent *first, LoopContent *second);
+
   virtual ~LoopTransformer();
 
   bool doInitialization(Module &M) override;
@@ -59,6 +84,9 @@ public:
 
 private:
   PDG *pdg;
+  Hot *profiles;
+
+  void invalidateProfileAggregates(void);
 };
 
 } // namespace arcana::noelle
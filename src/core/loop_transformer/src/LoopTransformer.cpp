@@ -24,10 +24,16 @@
 #include "arcana/noelle/core/LoopWhilify.hpp"
 #include "arcana/noelle/core/LoopUnroll.hpp"
 #include "arcana/noelle/core/LoopDistribution.hpp"
+#include "arcana/noelle/core/LoopTiling.hpp"
+#include "arcana/noelle/core/LoopInterchange.hpp"
+#include "arcana/noelle/core/LoopFusion.hpp"
 
 namespace arcana::noelle {
 
-LoopTransformer::LoopTransformer() : ModulePass{ ID } {
+LoopTransformer::LoopTransformer()
+  : ModulePass{ ID },
+    pdg{ nullptr },
+    profiles{ nullptr } {
   return;
 }
 
@@ -38,6 +44,25 @@ void LoopTransformer::setPDG(PDG *programDependenceGraph) {
   return;
 }
 
+void LoopTransformer::setProfiles(Hot *profiles) {
+  this->profiles = profiles;
+
+  return;
+}
+
+void LoopTransformer::invalidateProfileAggregates(void) {
+
+  /*
+   * The counters the profiles memoized for loops and SCCs describe the code
+   * before the transformation.
+   */
+  if (this->profiles != nullptr) {
+    this->profiles->invalidateAggregates();
+  }
+
+  return;
+}
+
 LoopUnrollResult LoopTransformer::unrollLoop(LoopContent *loop,
                                              uint32_t unrollFactor) {
 
@@ -86,6 +111,10 @@ LoopUnrollResult LoopTransformer::unrollLoop(LoopContent *loop,
   auto unrolled =
       UnrollLoop(llvmLoop, opts, &LLVMLoops, &SE, &DT, &AC, &ORE, true);
 
+  if (unrolled != LoopUnrollResult::Unmodified) {
+    this->invalidateProfileAggregates();
+  }
+
   return unrolled;
 }
 
@@ -108,6 +137,10 @@ bool LoopTransformer::fullyUnrollLoop(LoopContent *loop) {
       getAnalysis<AssumptionCacheTracker>().getAssumptionCache(loopFunction);
   auto modified = loopUnroll.fullyUnrollLoop(*loop, LS, DT, SE, AC);
 
+  if (modified) {
+    this->invalidateProfileAggregates();
+  }
+
   return modified;
 }
 
@@ -135,6 +168,10 @@ bool LoopTransformer::whilifyLoop(LoopContent *loop) {
    */
   auto modified = loopWhilify.whilifyLoop(*loop, scheduler, DS, FDG);
 
+  if (modified) {
+    this->invalidateProfileAggregates();
+  }
+
   return modified;
 }
 
@@ -163,6 +200,108 @@ bool LoopTransformer::splitLoop(LoopContent *loop,
                                instructionsRemoved,
                                instructionsAdded);
 
+  if (modified) {
+    this->invalidateProfileAggregates();
+  }
+
+  return modified;
+}
+
+bool LoopTransformer::tileLoopNest(LoopContent *loop,
+                                   const std::vector<uint32_t> &tileSizes) {
+
+  /*
+   * Check trivial cases
+   */
+  if (loop == nullptr) {
+    return false;
+  }
+
+  /*
+   * Fetch the analyses of the function
+   */
+  auto ls = loop->getLoopStructure();
+  auto &loopFunction = *ls->getFunction();
+  auto &LI = getAnalysis<LoopInfoWrapperPass>(loopFunction).getLoopInfo();
+  auto &SE = getAnalysis<ScalarEvolutionWrapperPass>(loopFunction).getSE();
+
+  /*
+   * Tile the loop nest.
+   */
+  LoopTiling lt;
+  auto modified = lt.tileLoopNest(*loop, tileSizes, LI, SE);
+
+  if (modified) {
+    this->invalidateProfileAggregates();
+  }
+
+  return modified;
+}
+
+bool LoopTransformer::interchangeLoops(
+    LoopContent *loop,
+    const std::vector<uint32_t> &permutation) {
+
+  /*
+   * Check trivial cases
+   */
+  if (loop == nullptr) {
+    return false;
+  }
+
+  /*
+   * Fetch the analyses of the function
+   */
+  auto ls = loop->getLoopStructure();
+  auto &loopFunction = *ls->getFunction();
+  auto &LI = getAnalysis<LoopInfoWrapperPass>(loopFunction).getLoopInfo();
+  auto &SE = getAnalysis<ScalarEvolutionWrapperPass>(loopFunction).getSE();
+
+  /*
+   * Interchange the loops.
+   */
+  LoopInterchange interchange;
+  auto modified = interchange.interchangeLoops(*loop, permutation, LI, SE);
+
+  if (modified) {
+    this->invalidateProfileAggregates();
+  }
+
+  return modified;
+}
+
+bool LoopTransformer::fuseLoops(LoopContent *first, LoopContent *second) {
+  assert(this->pdg != nullptr);
+
+  /*
+   * Check trivial cases
+   */
+  if ((first == nullptr) || (second == nullptr)) {
+    return false;
+  }
+
+  /*
+   * Get the necessary information
+   */
+  auto func = first->getLoopStructure()->getFunction();
+  auto &DT = getAnalysis<DominatorTreeWrapperPass>(*func).getDomTree();
+  auto &PDT = getAnalysis<PostDominatorTreeWrapperPass>(*func).getPostDomTree();
+  auto &LI = getAnalysis<LoopInfoWrapperPass>(*func).getLoopInfo();
+  auto &SE = getAnalysis<ScalarEvolutionWrapperPass>(*func).getSE();
+  DominatorSummary DS(DT, PDT);
+  auto FDG = this->pdg->createFunctionSubgraph(*func);
+
+  /*
+   * Fuse the loops.
+   */
+  LoopFusion lf;
+  auto modified = lf.fuseLoops(*first, *second, FDG, &DS, LI, SE);
+  delete FDG;
+
+  if (modified) {
+    this->invalidateProfileAggregates();
+  }
+
   return modified;
 }
 
@@ -29,6 +29,7 @@
 #include "arcana/noelle/core/Invariants.hpp"
 #include "arcana/noelle/core/Dominators.hpp"
 #include "arcana/noelle/core/ClonableMemoryObject.hpp"
+#include <mutex>
 
 namespace arcana::noelle {
 
@@ -36,6 +37,10 @@ class MemoryCloningAnalysis {
 public:
   MemoryCloningAnalysis(LoopStructure *loop, DominatorSummary &DS, PDG *ldg);
 
+  /*
+   * The answers are memoized.
+   * This method can be invoked by multiple threads concurrently.
+   */
   const std::unordered_set<ClonableMemoryObject *> getClonableMemoryObjectsFor(
       Instruction *I) const;
 
@@ -45,6 +50,10 @@ public:
 private:
   std::unordered_set<std::unique_ptr<ClonableMemoryObject>>
       clonableMemoryLocations;
+  mutable std::unordered_map<Instruction *,
+                             std::unordered_set<ClonableMemoryObject *>>
+      clonableMemoryObjectsOfInstruction;
+  mutable std::mutex clonableMemoryObjectsOfInstructionLock;
 };
 
 } // namespace arcana::noelle
@@ -110,11 +110,25 @@ std::unordered_set<ClonableMemoryObject *> MemoryCloningAnalysis::
 
 const std::unordered_set<ClonableMemoryObject *> MemoryCloningAnalysis::
     getClonableMemoryObjectsFor(Instruction *I) const {
-  std::unordered_set<ClonableMemoryObject *> locs = {};
 
   /*
-   * TODO: Determine if it is worth mapping from instructions to locations
+   * Check if we have already answered this query.
+   */
+  {
+    std::lock_guard<std::mutex> guard(
+        this->clonableMemoryObjectsOfInstructionLock);
+    auto cached = this->clonableMemoryObjectsOfInstruction.find(I);
+    if (cached != this->clonableMemoryObjectsOfInstruction.end()) {
+      return cached->second;
+    }
+  }
+
+  /*
+   * Compute the answer.
+   * This only reads the clonable memory objects, so it is done without holding
+   * the lock.
    */
+  std::unordered_set<ClonableMemoryObject *> locs = {};
   for (auto &location : this->clonableMemoryLocations) {
     if (location->getAllocation() == I) {
       locs.insert(location.get());
@@ -139,6 +153,15 @@ const std::unordered_set<ClonableMemoryObject *> MemoryCloningAnalysis::
     }
   }
 
+  /*
+   * Memoize the answer.
+   */
+  {
+    std::lock_guard<std::mutex> guard(
+        this->clonableMemoryObjectsOfInstructionLock);
+    this->clonableMemoryObjectsOfInstruction.emplace(I, locs);
+  }
+
   return locs;
 }
 
@@ -225,6 +225,16 @@ public:
 
   bool verifyCode(void) const;
 
+  /*
+   * Declare the queues of the NOELLE runtime (libNoelleQueues.a) in the
+   * program and register them in "queues".
+   * The queues are lock-free single-producer/single-consumer ring buffers,
+   * or multiple-producers/multiple-consumers queues if
+   * @multipleProducersAndConsumers is true.
+   * Queues of 1-bit values use the 8-bit APIs.
+   */
+  void declareQueueRuntime(bool multipleProducersAndConsumers = false);
+
   ~Noelle();
 
   /*
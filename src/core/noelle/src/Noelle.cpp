@@ -124,7 +124,7 @@ DataFlowEngine Noelle::getDataFlowEngine(void) const {
 }
 
 Scheduler Noelle::getScheduler(void) const {
-  return Scheduler{};
+  return Scheduler{ static_cast<SchedulerVerbosity>(this->verbose) };
 }
 
 MayPointsToAnalysis Noelle::getMayPointsToAnalysis(void) const {
@@ -135,6 +135,7 @@ LoopTransformer &Noelle::getLoopTransformer(void) {
   auto &lt = getAnalysis<LoopTransformer>();
   auto pdg = this->getProgramDependenceGraph();
   lt.setPDG(pdg);
+  lt.setProfiles(this->getProfiles());
   return lt;
 }
 
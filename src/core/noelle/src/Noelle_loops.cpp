@@ -1509,6 +1509,15 @@ LoopForest *Noelle::organizeLoopsInTheirNestingForest(
    */
   auto n = new noelle::LoopForest(loops, doms);
 
+  /*
+   * Compute the counters of the loops bottom-up once, so that later hotness
+   * queries on these loops do not have to walk their basic blocks again.
+   */
+  auto hot = this->getProfiles();
+  if (hot->isAvailable()) {
+    hot->computeLoopAggregates(n);
+  }
+
   /*
    * Free the memory.
    */
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/Noelle.hpp"
+
+namespace arcana::noelle {
+
+void Noelle::declareQueueRuntime(bool multipleProducersAndConsumers) {
+  auto tm = this->getTypesManager();
+  auto fm = this->getFunctionsManager();
+
+  /*
+   * Fetch the function with name @name if it exists (e.g., the runtime has
+   * been linked as bitcode), or declare it.
+   */
+  auto getRuntimeFunction = [this, fm](const std::string &name,
+                                       FunctionType *signature) -> Function * {
+    if (auto f = this->program->getFunction(name)) {
+      return f;
+    }
+    return fm->newFunction(name, *signature);
+  };
+
+  /*
+   * Define the types used by the APIs.
+   */
+  auto queueType = tm->getVoidPointerType();
+  auto voidType = tm->getVoidType();
+  auto int64 = tm->getIntegerType(64);
+  auto prefix = multipleProducersAndConsumers ? std::string("NOELLE_mpmcQueue")
+                                              : std::string("NOELLE_queue");
+
+  /*
+   * Reset the queues previously registered.
+   */
+  this->queues = Queue();
+
+  /*
+   * Declare the APIs to create and destroy queues.
+   */
+  auto createSignature =
+      FunctionType::get(queueType, ArrayRef<Type *>({ int64, int64 }), false);
+  this->queues.queueCreate =
+      getRuntimeFunction(prefix + "Create", createSignature);
+  auto destroySignature =
+      FunctionType::get(voidType, ArrayRef<Type *>({ queueType }), false);
+  this->queues.queueDestroy =
+      getRuntimeFunction(prefix + "Destroy", destroySignature);
+
+  /*
+   * Declare the APIs to push and pop a single element.
+   */
+  std::vector<uint32_t> queueSizes = { 1, 8, 16, 32, 64 };
+  for (auto queueSize : queueSizes) {
+    auto elementBits = std::max(queueSize, 8u);
+    auto elementType = tm->getIntegerType(elementBits);
+    auto elementPtrType = PointerType::getUnqual(elementType);
+    auto signature =
+        FunctionType::get(voidType,
+                          ArrayRef<Type *>({ queueType, elementPtrType }),
+                          false);
+    auto suffix = std::to_string(elementBits);
+    auto push = getRuntimeFunction(prefix + "Push" + suffix, signature);
+    auto pop = getRuntimeFunction(prefix + "Pop" + suffix, signature);
+
+    this->queues.queueSizeToIndex[queueSize] = this->queues.queuePushes.size();
+    this->queues.queueElementTypes.push_back(elementType);
+    this->queues.queuePushes.push_back(push);
+    this->queues.queuePops.push_back(pop);
+    this->queues.queueTypes.push_back(queueType);
+  }
+
+  /*
+   * Declare the APIs to push and pop several elements at once.
+   * Only single-producer/single-consumer queues provide them.
+   */
+  if (!multipleProducersAndConsumers) {
+    auto batchSignature =
+        FunctionType::get(voidType,
+                          ArrayRef<Type *>({ queueType, queueType, int64 }),
+                          false);
+    this->queues.queuePushBatch =
+        getRuntimeFunction(prefix + "PushBatch", batchSignature);
+    this->queues.queuePopBatch =
+        getRuntimeFunction(prefix + "PopBatch", batchSignature);
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
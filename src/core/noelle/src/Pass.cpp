@@ -41,6 +41,16 @@ static cl::opt<int> MaximumCores(
     cl::ZeroOrMore,
     cl::Hidden,
     cl::desc("Maximum number of logical cores that Noelle can use"));
+static cl::opt<int> AnalysisThreads(
+    "noelle-analysis-threads",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Number of threads that analyses can use (0: all logical cores)"));
+static cl::opt<int> QueueCost(
+    "noelle-queue-cost",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Dynamic instructions spent to send a value between cores"));
 static cl::opt<bool> ND_PRVGs("noelle-nondeterministic-prvgs",
                               cl::ZeroOrMore,
                               cl::Hidden,
@@ -119,6 +129,24 @@ bool Noelle::doInitialization(Module &M) {
   if (optMaxCores == 0) {
     optMaxCores = Architecture::getNumberOfPhysicalCores();
   }
+  uint32_t analysisThreads = 1;
+  if (AnalysisThreads.getNumOccurrences() > 0) {
+    auto optAnalysisThreads = AnalysisThreads.getValue();
+    if (optAnalysisThreads <= 0) {
+      analysisThreads = Architecture::getNumberOfLogicalCores();
+    } else {
+      analysisThreads = optAnalysisThreads;
+    }
+  }
+  uint64_t queueCost = 60;
+  if (QueueCost.getNumOccurrences() > 0) {
+    auto optQueueCost = QueueCost.getValue();
+    if (optQueueCost < 0) {
+      errs() << "NOELLE: ERROR = the cost of a queue cannot be negative\n";
+      abort();
+    }
+    queueCost = optQueueCost;
+  }
   if (DisableDOALL.getNumOccurrences() > 0) {
     this->enabledTransformations.erase(DOALL_ID);
   }
@@ -157,7 +185,9 @@ bool Noelle::doInitialization(Module &M) {
       optMaxCores,
       (ND_PRVGs.getNumOccurrences() > 0),
       (DisableFloatAsReal.getNumOccurrences() == 0),
-      (InlinerDisableHoistToMain.getNumOccurrences() > 0));
+      (InlinerDisableHoistToMain.getNumOccurrences() > 0),
+      analysisThreads,
+      queueCost);
 
   /*
    * Store the module.
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_PDG_DEPENDENCEREACHABILITY_H_
+#define NOELLE_SRC_CORE_PDG_DEPENDENCEREACHABILITY_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/PDG.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Index to answer transitive dependence queries on a dependence graph (e.g.,
+ * the PDG or the dependence graph of a loop) without traversing the graph
+ * again for every query.
+ *
+ * The index condenses the strongly connected components of the graph into a
+ * DAG and labels every component with the interval of post-order numbers of
+ * the components it reaches. Most queries are answered by comparing labels;
+ * the remaining ones traverse the condensed DAG pruned by the labels.
+ *
+ * The index is a snapshot of the graph: it must be rebuilt if dependences
+ * are added or removed.
+ *
+ * Queries that traverse the condensed DAG mark the components they visit in
+ * mutable fields of the index. Hence, const queries on the same index are not
+ * thread-safe: threads must synchronize or use an index each.
+ */
+class DependenceReachability {
+public:
+  /*
+   * Build the index for the dependences of @param graph of the kinds
+   * specified by the other parameters.
+   *
+   * Only the internal nodes of @param graph are considered unless
+   * @param includeExternalNodes is true.
+   * Paths that go through values for which @param includeValue returns false,
+   * or through dependences for which @param includeDependence returns false,
+   * are not considered.
+   */
+  DependenceReachability(
+      PDG *graph,
+      bool includeControlDependences,
+      bool includeMemoryDataDependences,
+      bool includeRegisterDataDependences,
+      bool includeExternalNodes = false,
+      std::function<bool(Value *v)> includeValue = nullptr,
+      std::function<bool(Value *from, Value *to)> includeDependence = nullptr);
+
+  DependenceReachability() = delete;
+
+  /*
+   * Return true if @param v has been indexed.
+   */
+  bool isIncluded(Value *v) const;
+
+  /*
+   * Return true if there is a non-empty path of dependences from
+   * @param fromValue to @param toValue (i.e., @param toValue transitively
+   * depends on @param fromValue).
+   */
+  bool doesDependOn(Value *toValue, Value *fromValue) const;
+
+  /*
+   * Return true if @param v1 and @param v2 belong to the same dependence
+   * cycle.
+   */
+  bool areInTheSameCycle(Value *v1, Value *v2) const;
+
+  /*
+   * Return the values @param v transitively depends on.
+   * @param v is included only if it belongs to a dependence cycle.
+   */
+  std::unordered_set<Value *> getBackwardSlice(Value *v) const;
+
+  /*
+   * Return the values that transitively depend on @param v.
+   * @param v is included only if it belongs to a dependence cycle.
+   */
+  std::unordered_set<Value *> getForwardSlice(Value *v) const;
+
+  /*
+   * Return the number of strongly connected components of the indexed graph.
+   */
+  uint64_t getNumberOfComponents(void) const;
+
+private:
+  /*
+   * Fields
+   */
+  std::unordered_map<Value *, uint32_t> valueToComponent;
+  std::vector<std::vector<Value *>> components;
+  std::vector<bool> isCyclic;
+
+  /*
+   * Condensed DAG. Components are numbered in reverse topological order (the
+   * successors of a component have smaller IDs).
+   */
+  std::vector<std::vector<uint32_t>> successors;
+  std::vector<std::vector<uint32_t>> predecessors;
+
+  /*
+   * Labels: pre-order and post-order numbers of a depth-first traversal of
+   * the condensed DAG, and the smallest post-order number reachable from
+   * each component.
+   */
+  std::vector<uint32_t> preOrder;
+  std::vector<uint32_t> postOrder;
+  std::vector<uint32_t> lowestPostOrder;
+
+  /*
+   * Visit marks of the queries (a component is visited by the current query
+   * if its mark is equal to currentMark).
+   */
+  mutable std::vector<uint32_t> marks;
+  mutable uint32_t currentMark;
+
+  /*
+   * Methods
+   */
+  void computeComponents(
+      std::vector<std::vector<uint32_t>> const &nodeSuccessors,
+      std::vector<Value *> const &nodes);
+
+  void computeLabels(void);
+
+  bool isReachable(uint32_t fromComponent, uint32_t toComponent) const;
+
+  std::unordered_set<Value *> collectValues(
+      uint32_t component,
+      std::vector<std::vector<uint32_t>> const &edges) const;
+
+  uint32_t getNewMark(void) const;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_PDG_DEPENDENCEREACHABILITY_H_
@@ -0,0 +1,423 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/DependenceReachability.hpp"
+
+namespace arcana::noelle {
+
+DependenceReachability::DependenceReachability(
+    PDG *graph,
+    bool includeControlDependences,
+    bool includeMemoryDataDependences,
+    bool includeRegisterDataDependences,
+    bool includeExternalNodes,
+    std::function<bool(Value *v)> includeValue,
+    std::function<bool(Value *from, Value *to)> includeDependence)
+  : currentMark{ 0 } {
+
+  /*
+   * Assign a dense ID to every value to index.
+   */
+  std::vector<Value *> nodes;
+  std::unordered_map<Value *, uint32_t> valueToNode;
+  for (auto node : graph->getNodes()) {
+    auto v = node->getT();
+    if (!includeExternalNodes && !graph->isInternal(v)) {
+      continue;
+    }
+    if (includeValue && !includeValue(v)) {
+      continue;
+    }
+    valueToNode[v] = nodes.size();
+    nodes.push_back(v);
+  }
+
+  /*
+   * Collect the dependences of the kinds requested between indexed values.
+   */
+  std::vector<std::vector<uint32_t>> nodeSuccessors(nodes.size());
+  for (auto i = 0u; i < nodes.size(); i++) {
+    auto node = graph->fetchNode(nodes[i]);
+    for (auto edge : node->getOutgoingEdges()) {
+      if (isa<ControlDependence<Value, Value>>(edge)) {
+        if (!includeControlDependences) {
+          continue;
+        }
+      } else if (isa<MemoryDependence<Value, Value>>(edge)) {
+        if (!includeMemoryDataDependences) {
+          continue;
+        }
+      } else if (isa<VariableDependence<Value, Value>>(edge)) {
+        if (!includeRegisterDataDependences) {
+          continue;
+        }
+      } else {
+        continue;
+      }
+      auto dstIt = valueToNode.find(edge->getDst());
+      if (dstIt == valueToNode.end()) {
+        continue;
+      }
+      if (includeDependence && !includeDependence(nodes[i], dstIt->first)) {
+        continue;
+      }
+      nodeSuccessors[i].push_back(dstIt->second);
+    }
+  }
+
+  /*
+   * Condense the strongly connected components and label the resulting DAG.
+   */
+  this->computeComponents(nodeSuccessors, nodes);
+  this->computeLabels();
+  this->marks.resize(this->components.size(), 0);
+
+  return;
+}
+
+void DependenceReachability::computeComponents(
+    std::vector<std::vector<uint32_t>> const &nodeSuccessors,
+    std::vector<Value *> const &nodes) {
+  auto unvisited = std::numeric_limits<uint32_t>::max();
+
+  /*
+   * Compute the strongly connected components with an iterative version of
+   * Tarjan's algorithm.
+   * Components are completed in reverse topological order, so the ID of a
+   * component is smaller than the IDs of its predecessors.
+   */
+  std::vector<uint32_t> index(nodes.size(), unvisited);
+  std::vector<uint32_t> lowLink(nodes.size(), 0);
+  std::vector<bool> isOnStack(nodes.size(), false);
+  std::vector<uint32_t> nodeToComponent(nodes.size(), 0);
+  std::vector<uint32_t> tarjanStack;
+  std::vector<std::pair<uint32_t, uint32_t>> callStack;
+  uint32_t nextIndex = 0;
+  for (auto root = 0u; root < nodes.size(); root++) {
+    if (index[root] != unvisited) {
+      continue;
+    }
+    index[root] = lowLink[root] = nextIndex++;
+    tarjanStack.push_back(root);
+    isOnStack[root] = true;
+    callStack.push_back({ root, 0 });
+
+    while (!callStack.empty()) {
+      auto n = callStack.back().first;
+      auto nextSuccessor = callStack.back().second;
+
+      /*
+       * Visit the next successor of @n.
+       */
+      if (nextSuccessor < nodeSuccessors[n].size()) {
+        callStack.back().second++;
+        auto s = nodeSuccessors[n][nextSuccessor];
+        if (index[s] == unvisited) {
+          index[s] = lowLink[s] = nextIndex++;
+          tarjanStack.push_back(s);
+          isOnStack[s] = true;
+          callStack.push_back({ s, 0 });
+        } else if (isOnStack[s]) {
+          lowLink[n] = std::min(lowLink[n], index[s]);
+        }
+        continue;
+      }
+
+      /*
+       * All successors of @n have been visited.
+       * Check if @n is the root of a component.
+       */
+      if (lowLink[n] == index[n]) {
+        auto componentID = this->components.size();
+        this->components.push_back({});
+        auto &members = this->components.back();
+        uint32_t m;
+        do {
+          m = tarjanStack.back();
+          tarjanStack.pop_back();
+          isOnStack[m] = false;
+          nodeToComponent[m] = componentID;
+          members.push_back(nodes[m]);
+          this->valueToComponent[nodes[m]] = componentID;
+        } while (m != n);
+      }
+      callStack.pop_back();
+      if (!callStack.empty()) {
+        auto parent = callStack.back().first;
+        lowLink[parent] = std::min(lowLink[parent], lowLink[n]);
+      }
+    }
+  }
+
+  /*
+   * Compute the edges of the condensed DAG without duplicates.
+   */
+  auto numComponents = this->components.size();
+  this->successors.resize(numComponents);
+  this->predecessors.resize(numComponents);
+  this->isCyclic.resize(numComponents, false);
+  std::vector<uint32_t> lastSource(numComponents, unvisited);
+  for (auto n = 0u; n < nodes.size(); n++) {
+    auto c = nodeToComponent[n];
+    if (this->components[c].size() > 1) {
+      this->isCyclic[c] = true;
+    }
+    for (auto s : nodeSuccessors[n]) {
+      auto d = nodeToComponent[s];
+      if (d == c) {
+        this->isCyclic[c] = true;
+        continue;
+      }
+      if (lastSource[d] == c) {
+        continue;
+      }
+      lastSource[d] = c;
+      this->successors[c].push_back(d);
+      this->predecessors[d].push_back(c);
+    }
+  }
+
+  return;
+}
+
+void DependenceReachability::computeLabels(void) {
+  auto numComponents = this->components.size();
+  this->preOrder.resize(numComponents, 0);
+  this->postOrder.resize(numComponents, 0);
+  this->lowestPostOrder.resize(numComponents, 0);
+
+  /*
+   * Number the components with a depth-first traversal of the condensed DAG
+   * that starts from the components without predecessors.
+   */
+  std::vector<bool> visited(numComponents, false);
+  std::vector<std::pair<uint32_t, uint32_t>> callStack;
+  uint32_t nextPreOrder = 0;
+  uint32_t nextPostOrder = 0;
+  for (auto root = 0u; root < numComponents; root++) {
+    if (!this->predecessors[root].empty()) {
+      continue;
+    }
+    visited[root] = true;
+    this->preOrder[root] = nextPreOrder++;
+    callStack.push_back({ root, 0 });
+    while (!callStack.empty()) {
+      auto c = callStack.back().first;
+      auto nextSuccessor = callStack.back().second;
+      if (nextSuccessor < this->successors[c].size()) {
+        callStack.back().second++;
+        auto s = this->successors[c][nextSuccessor];
+        if (!visited[s]) {
+          visited[s] = true;
+          this->preOrder[s] = nextPreOrder++;
+          callStack.push_back({ s, 0 });
+        }
+        continue;
+      }
+      this->postOrder[c] = nextPostOrder++;
+      callStack.pop_back();
+    }
+  }
+
+  /*
+   * Propagate the smallest post-order number from successors to
+   * predecessors. Successors have smaller IDs, so they are processed first.
+   */
+  for (auto c = 0u; c < numComponents; c++) {
+    auto lowest = this->postOrder[c];
+    for (auto s : this->successors[c]) {
+      lowest = std::min(lowest, this->lowestPostOrder[s]);
+    }
+    this->lowestPostOrder[c] = lowest;
+  }
+
+  return;
+}
+
+bool DependenceReachability::isIncluded(Value *v) const {
+  return this->valueToComponent.find(v) != this->valueToComponent.end();
+}
+
+bool DependenceReachability::doesDependOn(Value *toValue,
+                                          Value *fromValue) const {
+  auto toIt = this->valueToComponent.find(toValue);
+  auto fromIt = this->valueToComponent.find(fromValue);
+  if ((toIt == this->valueToComponent.end())
+      || (fromIt == this->valueToComponent.end())) {
+    return false;
+  }
+
+  /*
+   * Values of the same component depend on each other only if the component
+   * is a cycle.
+   */
+  if (toIt->second == fromIt->second) {
+    return this->isCyclic[toIt->second];
+  }
+
+  return this->isReachable(fromIt->second, toIt->second);
+}
+
+bool DependenceReachability::areInTheSameCycle(Value *v1, Value *v2) const {
+  auto it1 = this->valueToComponent.find(v1);
+  auto it2 = this->valueToComponent.find(v2);
+  if ((it1 == this->valueToComponent.end())
+      || (it2 == this->valueToComponent.end())) {
+    return false;
+  }
+  if (it1->second != it2->second) {
+    return false;
+  }
+
+  return this->isCyclic[it1->second];
+}
+
+std::unordered_set<Value *> DependenceReachability::getBackwardSlice(
+    Value *v) const {
+  auto it = this->valueToComponent.find(v);
+  if (it == this->valueToComponent.end()) {
+    return {};
+  }
+
+  return this->collectValues(it->second, this->predecessors);
+}
+
+std::unordered_set<Value *> DependenceReachability::getForwardSlice(
+    Value *v) const {
+  auto it = this->valueToComponent.find(v);
+  if (it == this->valueToComponent.end()) {
+    return {};
+  }
+
+  return this->collectValues(it->second, this->successors);
+}
+
+uint64_t DependenceReachability::getNumberOfComponents(void) const {
+  return this->components.size();
+}
+
+bool DependenceReachability::isReachable(uint32_t fromComponent,
+                                         uint32_t toComponent) const {
+
+  /*
+   * Labels that prove or disprove reachability without traversals:
+   * - successors have smaller IDs than their predecessors,
+   * - a component reaches only components whose post-order interval is
+   *   included in its own,
+   * - a component reaches all its descendants of the depth-first tree.
+   */
+  auto mayReach = [this, toComponent](uint32_t c) -> bool {
+    if (toComponent > c) {
+      return false;
+    }
+    return (this->lowestPostOrder[c] <= this->lowestPostOrder[toComponent])
+           && (this->postOrder[toComponent] <= this->postOrder[c]);
+  };
+  auto mustReach = [this, toComponent](uint32_t c) -> bool {
+    return (this->preOrder[c] <= this->preOrder[toComponent])
+           && (this->postOrder[toComponent] <= this->postOrder[c]);
+  };
+  if (!mayReach(fromComponent)) {
+    return false;
+  }
+  if (mustReach(fromComponent)) {
+    return true;
+  }
+
+  /*
+   * Traverse the condensed DAG skipping components that cannot reach the
+   * destination.
+   */
+  auto mark = this->getNewMark();
+  std::vector<uint32_t> worklist{ fromComponent };
+  this->marks[fromComponent] = mark;
+  while (!worklist.empty()) {
+    auto c = worklist.back();
+    worklist.pop_back();
+    for (auto s : this->successors[c]) {
+      if (s == toComponent) {
+        return true;
+      }
+      if (this->marks[s] == mark) {
+        continue;
+      }
+      this->marks[s] = mark;
+      if (!mayReach(s)) {
+        continue;
+      }
+      if (mustReach(s)) {
+        return true;
+      }
+      worklist.push_back(s);
+    }
+  }
+
+  return false;
+}
+
+std::unordered_set<Value *> DependenceReachability::collectValues(
+    uint32_t component,
+    std::vector<std::vector<uint32_t>> const &edges) const {
+  std::unordered_set<Value *> values;
+
+  /*
+   * The values of the component itself are included only if they form a
+   * cycle.
+   */
+  if (this->isCyclic[component]) {
+    values.insert(this->components[component].begin(),
+                  this->components[component].end());
+  }
+
+  /*
+   * Collect the values of the components reachable through @edges.
+   */
+  auto mark = this->getNewMark();
+  std::vector<uint32_t> worklist{ component };
+  this->marks[component] = mark;
+  while (!worklist.empty()) {
+    auto c = worklist.back();
+    worklist.pop_back();
+    for (auto next : edges[c]) {
+      if (this->marks[next] == mark) {
+        continue;
+      }
+      this->marks[next] = mark;
+      values.insert(this->components[next].begin(),
+                    this->components[next].end());
+      worklist.push_back(next);
+    }
+  }
+
+  return values;
+}
+
+uint32_t DependenceReachability::getNewMark(void) const {
+  this->currentMark++;
+  if (this->currentMark == 0) {
+    std::fill(this->marks.begin(), this->marks.end(), 0);
+    this->currentMark = 1;
+  }
+
+  return this->currentMark;
+}
+
+} // namespace arcana::noelle
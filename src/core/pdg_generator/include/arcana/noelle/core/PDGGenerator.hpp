@@ -95,7 +95,15 @@ private:
   bool disableSVFCallGraph;
   bool disableAllocAA;
   bool disableRA;
+  std::string cacheDirectory;
+  uint64_t cacheHits;
+  uint64_t cacheMisses;
+  std::unordered_set<const Function *> functionsLoadedFromCache;
+  std::unordered_map<const Function *, std::string> functionIRHashes;
+  std::string pointerFlowHash;
   PDGPrinter printer;
+  PDGPrinterOptions dumpOptions;
+  double dumpMinimumHotness;
   noelle::CallGraph *noelleCG;
   std::set<DependenceAnalysis *> ddAnalyses;
   std::set<CallGraphAnalysis *> cgAnalyses;
@@ -161,6 +169,18 @@ private:
   void constructEdgesFromAliasesForFunction(PDG *pdg, Function &F);
   void constructEdgesFromControlForFunction(PDG *pdg, Function &F);
 
+  /*
+   * On-disk cache of the memory and control dependences of functions.
+   */
+  bool isTheCacheEnabled(void) const;
+  std::string getCacheKey(Function &F);
+  std::string getIRHash(const Function &F);
+  std::string getPointerFlowHash(void);
+  bool loadDependencesFromCache(PDG *pdg, Function &F);
+  void storeDependencesInCache(PDG *pdg, Function &F);
+  void storeDependencesInCache(PDG *pdg, Module &M);
+  void printCacheReport(void);
+
   void iterateInstForStore(PDG *,
                            Function &,
                            AAResults &,
@@ -210,6 +230,12 @@ private:
                           Value *instI,
                           Value *instJ);
 
+  /*
+   * Add the alias queries counted by the current thread to the
+   * instrumentation and reset them.
+   */
+  static void flushAliasQueryCounters(void);
+
   bool edgeIsNotLoopCarriedMemoryDependency(DGEdge<Value, Value> *edge);
   bool isBackedgeIntoSameGlobal(DGEdge<Value, Value> *edge);
   bool isMemoryAccessIntoDifferentArrays(DGEdge<Value, Value> *edge);
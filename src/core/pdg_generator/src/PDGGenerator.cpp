@@ -22,7 +22,9 @@
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/TalkDown.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
+#include "arcana/noelle/core/HotProfiler.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
 #include "arcana/noelle/core/Utils.hpp"
 
 namespace arcana::noelle {
@@ -40,7 +42,11 @@ PDGGenerator::PDGGenerator()
     disableSVFCallGraph{ false },
     disableAllocAA{ false },
     disableRA{ false },
+    cacheHits{ 0 },
+    cacheMisses{ 0 },
     printer{},
+    dumpOptions{},
+    dumpMinimumHotness{ 0 },
     noelleCG{ nullptr } {
 
   return;
@@ -90,6 +96,7 @@ PDG *PDGGenerator::getPDG(void) {
   if (this->programDependenceGraph) {
     return this->programDependenceGraph;
   }
+  ScopedTimer timer("PDGGenerator::getPDG");
 
   /*
    * Construct the PDG
@@ -154,6 +161,27 @@ PDG *PDGGenerator::getPDG(void) {
    */
 
   if (this->dumpPDG) {
+
+    /*
+     * Only dump hot loops if requested.
+     */
+    auto options = this->dumpOptions;
+    if (this->dumpMinimumHotness > 0) {
+      auto hot = &getAnalysis<HotProfiler>().getHot();
+      if (hot->isAvailable()) {
+        auto minimumHotness = this->dumpMinimumHotness;
+        options.shouldPrintLoop = [hot, minimumHotness](Loop *loop) -> bool {
+          LoopStructure loopStructure{ loop };
+          auto hotness =
+              hot->getDynamicTotalInstructionCoverage(&loopStructure);
+          return hotness >= minimumHotness;
+        };
+      } else {
+        errs() << "PDGGenerator: WARNING = the profile is not available; all "
+                  "loops will be dumped\n";
+      }
+    }
+
     llvm::CallGraph llvmCG = llvm::CallGraph(*(this->M));
     this->printer.printPDG(
         *(this->M),
@@ -161,7 +189,8 @@ PDG *PDGGenerator::getPDG(void) {
         this->programDependenceGraph,
         [this](llvm::Function *F) -> llvm::LoopInfo & {
           return llvm::Pass::getAnalysis<LoopInfoWrapperPass>(*F).getLoopInfo();
-        });
+        },
+        options);
   }
 
   return this->programDependenceGraph;
@@ -172,13 +201,39 @@ PDG *PDGGenerator::constructPDGFromAnalysis(Module &M) {
     errs() << "PDGGenerator: Construct PDG from Analysis\n";
   }
 
+  ScopedTimer timer("PDGGenerator::constructPDGFromAnalysis");
   auto pdg = new PDG(M);
+  this->functionsLoadedFromCache.clear();
 
-  constructEdgesFromUseDefs(pdg);
-  constructEdgesFromAliases(pdg, M);
-  constructEdgesFromControl(pdg, M);
+  /*
+   * The code may have changed since the last PDG: forget its hashes.
+   */
+  this->functionIRHashes.clear();
+  this->pointerFlowHash.clear();
 
-  trimDGUsingCustomAliasAnalysis(pdg);
+  {
+    ScopedTimer useDefTimer("PDGGenerator::constructEdgesFromUseDefs");
+    constructEdgesFromUseDefs(pdg);
+  }
+  {
+    ScopedTimer aliasTimer("PDGGenerator::constructEdgesFromAliases");
+    constructEdgesFromAliases(pdg, M);
+  }
+  {
+    ScopedTimer controlTimer("PDGGenerator::constructEdgesFromControl");
+    constructEdgesFromControl(pdg, M);
+  }
+  if (this->isTheCacheEnabled()) {
+    this->storeDependencesInCache(pdg, M);
+    this->printCacheReport();
+  }
+
+  {
+    ScopedTimer trimTimer("PDGGenerator::trimDGUsingCustomAliasAnalysis");
+    trimDGUsingCustomAliasAnalysis(pdg);
+  }
+  Instrumentation::count("PDGGenerator: PDG edges", pdg->numEdges());
+  pdg->updateMemoryAccount("PDG");
 
   return pdg;
 }
@@ -255,6 +310,13 @@ void PDGGenerator::constructEdgesFromAliases(PDG *pdg, Module &M) {
     if (F.empty())
       continue;
 
+    /*
+     * Check if the dependences of the function are in the cache.
+     */
+    if (this->loadDependencesFromCache(pdg, F)) {
+      continue;
+    }
+
     /*
      * Add the edges to the PDG.
      */
@@ -266,6 +328,8 @@ void PDGGenerator::constructEdgesFromAliases(PDG *pdg, Module &M) {
 
 void PDGGenerator::constructEdgesFromAliasesForFunction(PDG *pdg, Function &F) {
 
+  ScopedTimer timer("PDGGenerator::constructEdgesFromAliasesForFunction", &F);
+
   /*
    * Fetch the alias analysis.
    */
@@ -318,6 +382,11 @@ void PDGGenerator::constructEdgesFromAliasesForFunction(PDG *pdg, Function &F) {
    * Free the memory.
    */
   delete dfr;
+
+  /*
+   * Record the alias queries done for @F.
+   */
+  PDGGenerator::flushAliasQueryCounters();
 }
 
 void PDGGenerator::removeEdgesNotUsedByParSchemes(PDG *pdg) {
@@ -362,6 +431,8 @@ void PDGGenerator::removeEdgesNotUsedByParSchemes(PDG *pdg) {
   for (auto edge : removeEdges) {
     pdg->removeEdge(edge);
   }
+  Instrumentation::count("PDGGenerator: edges removed by AllocAA",
+                         removeEdges.size());
 
   return;
 }
@@ -0,0 +1,597 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "llvm/IR/ModuleSlotTracker.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/PDGGenerator.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Version of the format of the files of the cache.
+ * It must change every time the format or the dependence analyses change.
+ */
+static const char *cacheVersion = "NOELLE-PDG-CACHE 3";
+
+static std::string digestOf(MD5 &hash) {
+  MD5::MD5Result result;
+  hash.final(result);
+
+  return result.digest().str().str();
+}
+
+/*
+ * Remove the numbers of the metadata (e.g., !12) and attribute groups (e.g.,
+ * #3) from the textual IR. These numbers are assigned at the module level, so
+ * they change when other functions change. The content they refer to is
+ * hashed separately (see hashMetadata and hashAttributes).
+ */
+static std::string removeModuleLevelIDs(const std::string &ir) {
+  std::string stripped;
+  stripped.reserve(ir.size());
+  for (auto i = 0u; i < ir.size(); i++) {
+    stripped.push_back(ir[i]);
+    if ((ir[i] != '!') && (ir[i] != '#')) {
+      continue;
+    }
+    while (((i + 1) < ir.size()) && isdigit(ir[i + 1])) {
+      i++;
+    }
+  }
+
+  return stripped;
+}
+
+/*
+ * Hash the content of a metadata (e.g., TBAA and alias scopes), including
+ * the metadata it refers to.
+ * Nodes are identified by the order in which they are reached, so the hash
+ * does not depend on the numbers the module assigns to them.
+ */
+static void hashMetadata(MD5 &hash,
+                         const Metadata *md,
+                         std::unordered_map<const Metadata *, uint32_t> &ids) {
+  if (md == nullptr) {
+    hash.update("null;");
+    return;
+  }
+  auto it = ids.find(md);
+  if (it != ids.end()) {
+    hash.update("ref " + std::to_string(it->second) + ";");
+    return;
+  }
+  auto id = static_cast<uint32_t>(ids.size());
+  ids[md] = id;
+
+  if (auto str = dyn_cast<MDString>(md)) {
+    hash.update("str ");
+    hash.update(str->getString());
+    hash.update(";");
+    return;
+  }
+  if (auto value = dyn_cast<ValueAsMetadata>(md)) {
+    std::string valueString;
+    raw_string_ostream valueStream(valueString);
+    value->getValue()->printAsOperand(valueStream);
+    hash.update("value ");
+    hash.update(valueStream.str());
+    hash.update(";");
+    return;
+  }
+  if (auto node = dyn_cast<MDNode>(md)) {
+    hash.update(node->isDistinct() ? "distinct " : "node ");
+    hash.update(std::to_string(node->getMetadataID()));
+    hash.update("{");
+    for (auto &op : node->operands()) {
+      hashMetadata(hash, op.get(), ids);
+    }
+    hash.update("};");
+    return;
+  }
+  hash.update("other " + std::to_string(md->getMetadataID()) + ";");
+
+  return;
+}
+
+static void hashMetadataAttachments(
+    MD5 &hash,
+    const SmallVectorImpl<std::pair<unsigned, MDNode *>> &attachments,
+    std::unordered_map<const Metadata *, uint32_t> &ids) {
+  for (auto &attachment : attachments) {
+    hash.update("kind " + std::to_string(attachment.first) + " ");
+    hashMetadata(hash, attachment.second, ids);
+  }
+
+  return;
+}
+
+/*
+ * Hash the attributes of a function or call site, including those of the
+ * return value and of the parameters.
+ */
+static void hashAttributes(MD5 &hash, const AttributeList &attributes) {
+  for (auto i = attributes.index_begin(); i != attributes.index_end(); i++) {
+    hash.update(std::to_string(i) + " ");
+    hash.update(attributes.getAsString(i));
+    hash.update(";");
+  }
+
+  return;
+}
+
+bool PDGGenerator::isTheCacheEnabled(void) const {
+  return !this->cacheDirectory.empty();
+}
+
+std::string PDGGenerator::getIRHash(const Function &F) {
+
+  /*
+   * Check if we have already hashed the function.
+   */
+  auto it = this->functionIRHashes.find(&F);
+  if (it != this->functionIRHashes.end()) {
+    return it->second;
+  }
+
+  /*
+   * Hash the textual IR of the function and its attributes.
+   */
+  std::string ir;
+  raw_string_ostream irStream(ir);
+  F.print(irStream);
+  irStream.flush();
+  MD5 hash;
+  hash.update(removeModuleLevelIDs(ir));
+  hashAttributes(hash, F.getAttributes());
+
+  /*
+   * Hash the metadata and attribute groups the IR refers to.
+   */
+  std::unordered_map<const Metadata *, uint32_t> metadataIDs;
+  SmallVector<std::pair<unsigned, MDNode *>, 4> attachments;
+  F.getAllMetadata(attachments);
+  hashMetadataAttachments(hash, attachments, metadataIDs);
+  for (auto &inst : instructions(F)) {
+    attachments.clear();
+    inst.getAllMetadata(attachments);
+    hashMetadataAttachments(hash, attachments, metadataIDs);
+    if (auto call = dyn_cast<CallBase>(&inst)) {
+      hashAttributes(hash, call->getAttributes());
+    }
+    for (auto &op : inst.operands()) {
+      if (auto mdValue = dyn_cast<MetadataAsValue>(op.get())) {
+        hashMetadata(hash, mdValue->getMetadata(), metadataIDs);
+      }
+    }
+  }
+  auto digest = digestOf(hash);
+  this->functionIRHashes[&F] = digest;
+
+  return digest;
+}
+
+/*
+ * Hash the text of a global variable and its metadata.
+ */
+static void hashGlobal(MD5 &hash,
+                       const GlobalVariable &G,
+                       std::unordered_map<const Metadata *, uint32_t> &ids) {
+  std::string ir;
+  raw_string_ostream irStream(ir);
+  G.print(irStream);
+  hash.update(removeModuleLevelIDs(irStream.str()));
+  SmallVector<std::pair<unsigned, MDNode *>, 4> attachments;
+  G.getAllMetadata(attachments);
+  hashMetadataAttachments(hash, attachments, ids);
+
+  return;
+}
+
+/*
+ * Collect the global variables used by a value, including those used through
+ * constant expressions.
+ */
+static void collectGlobals(const Value *value,
+                           std::set<const GlobalVariable *> &globals,
+                           std::unordered_set<const Value *> &visited) {
+  if (!visited.insert(value).second) {
+    return;
+  }
+  if (auto G = dyn_cast<GlobalVariable>(value)) {
+    globals.insert(G);
+    return;
+  }
+  auto constantExpr = dyn_cast<ConstantExpr>(value);
+  if (constantExpr == nullptr) {
+    return;
+  }
+  for (auto &op : constantExpr->operands()) {
+    collectGlobals(op.get(), globals, visited);
+  }
+
+  return;
+}
+
+/*
+ * Check if an instruction contributes to the flow of pointers (e.g.,
+ * allocations, pointer arithmetic, loads and stores, calls that pass pointers).
+ */
+static bool isPartOfThePointerFlow(const Instruction &inst) {
+  if (inst.getType()->isPointerTy()) {
+    return true;
+  }
+  for (auto &op : inst.operands()) {
+    if (op->getType()->isPointerTy()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::string PDGGenerator::getPointerFlowHash(void) {
+  if (!this->pointerFlowHash.empty()) {
+    return this->pointerFlowHash;
+  }
+
+  /*
+   * Hash the global variables and the aliases.
+   */
+  MD5 hash;
+  std::unordered_map<const Metadata *, uint32_t> metadataIDs;
+  for (auto &G : this->M->globals()) {
+    hashGlobal(hash, G, metadataIDs);
+  }
+  for (auto &alias : this->M->aliases()) {
+    std::string ir;
+    raw_string_ostream irStream(ir);
+    alias.print(irStream);
+    hash.update(removeModuleLevelIDs(irStream.str()));
+  }
+
+  /*
+   * Hash the instructions of the defined functions that can move pointers.
+   * Instructions that only compute non-pointer values (e.g., arithmetic) are
+   * not hashed, so changing them does not invalidate other functions.
+   */
+  ModuleSlotTracker MST(this->M);
+  for (auto &F : *this->M) {
+    hash.update(F.getName());
+    std::string signature;
+    raw_string_ostream signatureStream(signature);
+    F.getFunctionType()->print(signatureStream);
+    hash.update(signatureStream.str());
+    hashAttributes(hash, F.getAttributes());
+    if (F.empty()) {
+      continue;
+    }
+    MST.incorporateFunction(F);
+    for (auto &inst : instructions(F)) {
+      if (!isPartOfThePointerFlow(inst)) {
+        continue;
+      }
+      std::string ir;
+      raw_string_ostream irStream(ir);
+      inst.print(irStream, MST);
+      hash.update(removeModuleLevelIDs(irStream.str()));
+    }
+  }
+  this->pointerFlowHash = digestOf(hash);
+
+  return this->pointerFlowHash;
+}
+
+std::string PDGGenerator::getCacheKey(Function &F) {
+  MD5 hash;
+
+  /*
+   * Hash the configuration of the analyses.
+   */
+  hash.update(cacheVersion);
+  hash.update(this->M->getTargetTriple());
+  hash.update(this->M->getDataLayoutStr());
+  hash.update(this->disableSVF ? "nosvf" : "svf");
+  hash.update(this->disableSVFCallGraph ? "nosvfcg" : "svfcg");
+  hash.update(this->disableRA ? "nora" : "ra");
+  std::set<std::string> analyses;
+  for (auto ddAnalysis : this->ddAnalyses) {
+    analyses.insert(ddAnalysis->getName());
+  }
+  for (auto &name : analyses) {
+    hash.update(name);
+  }
+
+  /*
+   * Hash the function.
+   * This includes the TBAA and alias-scope metadata of its memory accesses up
+   * to their roots (see getIRHash).
+   */
+  hash.update(this->getIRHash(F));
+
+  /*
+   * Fetch the functions @F can transitively call: their summaries (i.e., what
+   * they can access) affect the dependences of the calls of @F.
+   * Indirect calls can reach every function whose address is taken.
+   */
+  std::set<const Function *> reachable;
+  std::vector<const Function *> toVisit{ &F };
+  auto addressTakenFunctionsAdded = false;
+  while (!toVisit.empty()) {
+    auto current = toVisit.back();
+    toVisit.pop_back();
+    if (!reachable.insert(current).second) {
+      continue;
+    }
+    if (current->empty()) {
+      continue;
+    }
+    for (auto &inst : instructions(*current)) {
+      auto call = dyn_cast<CallBase>(&inst);
+      if (call == nullptr) {
+        continue;
+      }
+      if (auto callee = call->getCalledFunction()) {
+        toVisit.push_back(callee);
+        continue;
+      }
+      if (call->isInlineAsm() || addressTakenFunctionsAdded) {
+        continue;
+      }
+      addressTakenFunctionsAdded = true;
+      for (auto &other : *this->M) {
+        if (other.hasAddressTaken()) {
+          toVisit.push_back(&other);
+        }
+      }
+    }
+  }
+
+  /*
+   * Hash the callees and the global variables they and @F refer to.
+   */
+  std::map<std::string, const Function *> sortedCallees;
+  for (auto callee : reachable) {
+    sortedCallees[callee->getName().str()] = callee;
+  }
+  std::set<const GlobalVariable *> globals;
+  std::unordered_set<const Value *> visited;
+  for (auto &pair : sortedCallees) {
+    auto callee = pair.second;
+    hash.update(pair.first);
+    if (callee->empty()) {
+      std::string declaration;
+      raw_string_ostream declarationStream(declaration);
+      callee->getFunctionType()->print(declarationStream);
+      hash.update(declarationStream.str());
+      hashAttributes(hash, callee->getAttributes());
+      continue;
+    }
+    hash.update(this->getIRHash(*callee));
+    for (auto &inst : instructions(*callee)) {
+      for (auto &op : inst.operands()) {
+        collectGlobals(op.get(), globals, visited);
+      }
+    }
+  }
+  std::map<std::string, const GlobalVariable *> sortedGlobals;
+  for (auto G : globals) {
+    sortedGlobals[G->getName().str()] = G;
+  }
+  std::unordered_map<const Metadata *, uint32_t> metadataIDs;
+  for (auto &pair : sortedGlobals) {
+    hashGlobal(hash, *pair.second, metadataIDs);
+  }
+
+  /*
+   * Hash the flow of pointers of the module.
+   * Some analyses are module-wide (e.g., SVF and globals-aa): what a pointer
+   * of @F can point to depends on the pointers the other functions store or
+   * pass around, but not on the rest of their code.
+   */
+  hash.update(this->getPointerFlowHash());
+
+  return digestOf(hash);
+}
+
+bool PDGGenerator::loadDependencesFromCache(PDG *pdg, Function &F) {
+  if (!this->isTheCacheEnabled()) {
+    return false;
+  }
+  ScopedTimer timer("PDGGenerator::loadDependencesFromCache", &F);
+
+  /*
+   * Read the file of the function.
+   */
+  SmallString<128> fileName(this->cacheDirectory);
+  sys::path::append(fileName, this->getCacheKey(F) + ".deps");
+  auto buffer = MemoryBuffer::getFile(fileName);
+  if (!buffer) {
+    this->cacheMisses++;
+    return false;
+  }
+
+  /*
+   * Parse the dependences.
+   * Instructions are identified by their position in the function.
+   */
+  std::vector<Instruction *> insts;
+  for (auto &inst : instructions(F)) {
+    insts.push_back(&inst);
+  }
+  SmallVector<StringRef, 8> lines;
+  (*buffer)->getBuffer().split(lines, '\n', -1, false);
+  if ((lines.size() < 2) || (lines[0] != cacheVersion)
+      || (lines[1] != std::to_string(insts.size()))) {
+    this->cacheMisses++;
+    return false;
+  }
+  struct CachedDependence {
+    bool isControl;
+    uint32_t src;
+    uint32_t dst;
+    uint32_t type;
+    bool isMust;
+  };
+  std::vector<CachedDependence> deps;
+  for (auto i = 2u; i < lines.size(); i++) {
+    SmallVector<StringRef, 5> fields;
+    lines[i].split(fields, ' ');
+    CachedDependence dep{ fields[0] == "C", 0, 0, 0, false };
+    auto expectedFields = dep.isControl ? 3u : 5u;
+    auto malformed = (fields.size() != expectedFields)
+                     || fields[1].getAsInteger(10, dep.src)
+                     || fields[2].getAsInteger(10, dep.dst)
+                     || (dep.src >= insts.size()) || (dep.dst >= insts.size());
+    if (!dep.isControl && !malformed) {
+      malformed = (fields[0] != "M") || fields[3].getAsInteger(10, dep.type)
+                  || (dep.type > DG_DATA_WAW);
+      dep.isMust = (fields.size() == 5) && (fields[4] == "1");
+    }
+    if (malformed) {
+      this->cacheMisses++;
+      return false;
+    }
+    deps.push_back(dep);
+  }
+
+  /*
+   * Add the dependences to the PDG.
+   */
+  for (auto &dep : deps) {
+    if (dep.isControl) {
+      pdg->addControlDependenceEdge(insts[dep.src], insts[dep.dst]);
+    } else {
+      pdg->addMemoryDataDependenceEdge(insts[dep.src],
+                                       insts[dep.dst],
+                                       static_cast<DataDependenceType>(
+                                           dep.type),
+                                       dep.isMust);
+    }
+  }
+  this->functionsLoadedFromCache.insert(&F);
+  this->cacheHits++;
+
+  return true;
+}
+
+void PDGGenerator::storeDependencesInCache(PDG *pdg, Module &M) {
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    if (this->functionsLoadedFromCache.count(&F) > 0) {
+      continue;
+    }
+    this->storeDependencesInCache(pdg, F);
+  }
+
+  return;
+}
+
+void PDGGenerator::storeDependencesInCache(PDG *pdg, Function &F) {
+
+  /*
+   * Serialize the memory and control dependences that start from @F.
+   */
+  std::unordered_map<Value *, uint32_t> instIDs;
+  for (auto &inst : instructions(F)) {
+    auto id = static_cast<uint32_t>(instIDs.size());
+    instIDs[&inst] = id;
+  }
+  std::string content;
+  raw_string_ostream stream(content);
+  stream << cacheVersion << "\n" << instIDs.size() << "\n";
+  for (auto &inst : instructions(F)) {
+    auto node = pdg->fetchNode(&inst);
+    for (auto edge : node->getOutgoingEdges()) {
+      auto isControl = isa<ControlDependence<Value, Value>>(edge);
+      auto memoryDep = dyn_cast<MemoryDependence<Value, Value>>(edge);
+      if ((!isControl) && (memoryDep == nullptr)) {
+        continue;
+      }
+
+      /*
+       * Dependences that leave the function cannot be cached.
+       */
+      auto dstIt = instIDs.find(edge->getDst());
+      if (dstIt == instIDs.end()) {
+        return;
+      }
+
+      if (isControl) {
+        stream << "C " << instIDs[&inst] << " " << dstIt->second << "\n";
+        continue;
+      }
+      stream << "M " << instIDs[&inst] << " " << dstIt->second << " "
+             << memoryDep->getDataDependenceType() << " "
+             << (isa<MustMemoryDependence<Value, Value>>(edge) ? 1 : 0)
+             << "\n";
+    }
+  }
+  stream.flush();
+
+  /*
+   * Write the file atomically: concurrent compilations can share the cache.
+   */
+  if (sys::fs::create_directories(this->cacheDirectory)) {
+    return;
+  }
+  SmallString<128> fileName(this->cacheDirectory);
+  sys::path::append(fileName, this->getCacheKey(F) + ".deps");
+  auto tmpFileName = fileName.str().str() + ".tmp"
+                     + std::to_string(sys::Process::getProcessId());
+  std::error_code EC;
+  raw_fd_ostream file(tmpFileName, EC, sys::fs::F_None);
+  if (EC) {
+    return;
+  }
+  file << content;
+  file.close();
+  if (file.has_error() || sys::fs::rename(tmpFileName, fileName)) {
+    file.clear_error();
+    sys::fs::remove(tmpFileName);
+  }
+
+  return;
+}
+
+void PDGGenerator::printCacheReport(void) {
+  Instrumentation::count("PDGGenerator: cache hits", this->cacheHits);
+  Instrumentation::count("PDGGenerator: cache misses", this->cacheMisses);
+  if (this->verbose != PDGVerbosity::Disabled) {
+    errs() << "PDGGenerator: Cache of " << this->cacheDirectory << ": "
+           << this->cacheHits << " hits, " << this->cacheMisses
+           << " misses\n";
+  }
+  this->cacheHits = 0;
+  this->cacheMisses = 0;
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -23,6 +23,7 @@
 #include "arcana/noelle/core/TalkDown.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
 
 namespace arcana::noelle {
 
@@ -38,6 +39,13 @@ void PDGGenerator::constructEdgesFromControl(PDG *pdg, Module &M) {
       continue;
     }
 
+    /*
+     * Check if the control dependences have been loaded from the cache.
+     */
+    if (this->functionsLoadedFromCache.count(&F) > 0) {
+      continue;
+    }
+
     /*
      * Compute the control dependences of the function based on its
      * post-dominator tree.
@@ -50,6 +58,7 @@ void PDGGenerator::constructEdgesFromControl(PDG *pdg, Module &M) {
 
 void PDGGenerator::constructEdgesFromControlForFunction(PDG *pdg, Function &F) {
   assert(pdg != nullptr);
+  ScopedTimer timer("PDGGenerator::constructEdgesFromControlForFunction", &F);
 
   /*
    * There is a control dependence from a basic block A to a basic block B iff
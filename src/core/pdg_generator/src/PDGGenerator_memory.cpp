@@ -19,15 +19,58 @@
  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include <chrono>
+
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/TalkDown.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
 #include "IntegrationWithSVF.hpp"
 #include "arcana/noelle/core/Utils.hpp"
 
 namespace arcana::noelle {
 
+/*
+ * Alias queries are too frequent to be timed one by one: they are counted
+ * per thread and added to the instrumentation once per function.
+ */
+namespace {
+
+struct AliasQueryCounters {
+  uint64_t llvmQueries = 0;
+  uint64_t llvmNanoseconds = 0;
+  uint64_t svfQueries = 0;
+  uint64_t svfNanoseconds = 0;
+};
+thread_local AliasQueryCounters aliasQueryCounters;
+
+uint64_t nowInNanoseconds(void) {
+  auto t = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+}
+
+} // namespace
+
+void PDGGenerator::flushAliasQueryCounters(void) {
+  auto &c = aliasQueryCounters;
+  if (c.llvmQueries > 0) {
+    Instrumentation::count("PDGGenerator::LLVMAliasQuery queries",
+                           c.llvmQueries);
+    Instrumentation::count("PDGGenerator::LLVMAliasQuery nanoseconds",
+                           c.llvmNanoseconds);
+  }
+  if (c.svfQueries > 0) {
+    Instrumentation::count("PDGGenerator::SVFAliasQuery queries",
+                           c.svfQueries);
+    Instrumentation::count("PDGGenerator::SVFAliasQuery nanoseconds",
+                           c.svfNanoseconds);
+  }
+  c = AliasQueryCounters();
+
+  return;
+}
+
 bool PDGGenerator::canThereBeAMemoryDataDependence(Instruction *fromInst,
                                                    Instruction *toInst,
                                                    Function &F) {
@@ -1312,6 +1355,8 @@ AliasResult PDGGenerator::doTheyAlias(PDG *pdg,
   /*
    * Query the LLVM alias analyses.
    */
+  auto instrumented = Instrumentation::isEnabled();
+  auto start = instrumented ? nowInNanoseconds() : 0;
   AliasResult aaResult;
   if (haveMemoryLocations) {
     auto memI = MemoryLocation::get(instIAsInst);
@@ -1326,6 +1371,10 @@ AliasResult PDGGenerator::doTheyAlias(PDG *pdg,
   } else {
     aaResult = AA.alias(instI, instJ);
   }
+  if (instrumented) {
+    aliasQueryCounters.llvmQueries++;
+    aliasQueryCounters.llvmNanoseconds += nowInNanoseconds() - start;
+  }
   switch (aaResult) {
     case NoAlias:
       return NoAlias;
@@ -1353,6 +1402,7 @@ AliasResult PDGGenerator::doTheyAlias(PDG *pdg,
      * SVF is enabled, so let's use it.
      */
     AliasResult SVFAAResult;
+    auto svfStart = instrumented ? nowInNanoseconds() : 0;
     if (haveMemoryLocations) {
       SVFAAResult =
           NoelleSVFIntegration::alias(MemoryLocation::get(instIAsInst),
@@ -1360,6 +1410,10 @@ AliasResult PDGGenerator::doTheyAlias(PDG *pdg,
     } else {
       SVFAAResult = NoelleSVFIntegration::alias(instI, instJ);
     }
+    if (instrumented) {
+      aliasQueryCounters.svfQueries++;
+      aliasQueryCounters.svfNanoseconds += nowInNanoseconds() - svfStart;
+    }
     switch (SVFAAResult) {
       case NoAlias:
         return NoAlias;
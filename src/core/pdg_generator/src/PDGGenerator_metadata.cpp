@@ -23,6 +23,7 @@
 #include "arcana/noelle/core/TalkDown.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
 
 namespace arcana::noelle {
 
@@ -134,6 +135,7 @@ PDG *PDGGenerator::constructPDGFromMetadata(Module &M) {
   if (verbose >= PDGVerbosity::Maximal) {
     errs() << "PDGGenerator: Construct PDG from Metadata\n";
   }
+  ScopedTimer timer("PDGGenerator::constructPDGFromMetadata");
 
   /*
    * Create the PDG.
@@ -151,6 +153,7 @@ PDG *PDGGenerator::constructPDGFromMetadata(Module &M) {
 
   constructEdgesFromUseDefs(pdg);
   constructEdgesFromControl(pdg, M);
+  pdg->updateMemoryAccount("PDG");
 
   return pdg;
 }
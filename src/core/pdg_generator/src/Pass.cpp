@@ -22,6 +22,8 @@
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
+#include "arcana/noelle/core/HotProfiler.hpp"
+#include "arcana/noelle/core/Architecture.hpp"
 
 namespace arcana::noelle {
 
@@ -50,6 +52,49 @@ static cl::opt<bool> PDGDump("noelle-pdg-dump",
                              cl::Hidden,
                              cl::desc("Dump the PDG"));
 
+static cl::list<std::string> PDGDumpFunctions(
+    "noelle-pdg-dump-functions",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::CommaSeparated,
+    cl::desc("Dump only the graphs of these functions"));
+
+static cl::opt<int> PDGDumpMaximumLoopDepth(
+    "noelle-pdg-dump-max-loop-depth",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Do not dump loops nested deeper than this level"));
+
+static cl::opt<int> PDGDumpMinimumHotness(
+    "noelle-pdg-dump-min-hot",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Minimum hotness (per mille) of the loops to dump"));
+
+static cl::opt<bool> PDGDumpNoSCCs(
+    "noelle-pdg-dump-no-sccdags",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Do not dump the SCCDAGs of loops and their SCCs"));
+
+static cl::opt<int> PDGDumpThreads(
+    "noelle-pdg-dump-threads",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Number of threads that dump graphs (0: all logical cores)"));
+
+static cl::opt<std::string> PDGDumpArchive(
+    "noelle-pdg-dump-archive",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Stream the dumped graphs to this tar archive"));
+
+static cl::opt<bool> PDGDumpCompress(
+    "noelle-pdg-dump-compress",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Compress the dumped graphs with gzip"));
+
 static cl::opt<bool> PDGCheck("noelle-pdg-check",
                               cl::ZeroOrMore,
                               cl::Hidden,
@@ -77,6 +122,12 @@ static cl::opt<bool> PDGRADisable(
     cl::Hidden,
     cl::desc("Disable the use of reaching analysis to compute the PDG"));
 
+static cl::opt<std::string> PDGCacheDirectory(
+    "noelle-pdg-cache",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Directory where the dependences of functions are cached"));
+
 bool PDGGenerator::doInitialization(Module &M) {
   this->verbose = static_cast<PDGVerbosity>(PDGVerbose.getValue());
   this->embedPDG = (PDGEmbed.getNumOccurrences() > 0) ? true : false;
@@ -90,6 +141,30 @@ bool PDGGenerator::doInitialization(Module &M) {
   this->disableAllocAA =
       (PDGAllocAADisable.getNumOccurrences() > 0) ? true : false;
   this->disableRA = (PDGRADisable.getNumOccurrences() > 0) ? true : false;
+  this->cacheDirectory = PDGCacheDirectory.getValue();
+
+  /*
+   * Fetch the options about dumping the PDG.
+   */
+  for (auto &functionName : PDGDumpFunctions) {
+    this->dumpOptions.functionNames.insert(functionName);
+  }
+  if (PDGDumpMaximumLoopDepth.getValue() > 0) {
+    this->dumpOptions.maximumLoopDepth = PDGDumpMaximumLoopDepth.getValue();
+  }
+  this->dumpMinimumHotness =
+      ((double)(PDGDumpMinimumHotness.getValue())) / 1000;
+  this->dumpOptions.printSCCDAGs = (PDGDumpNoSCCs.getNumOccurrences() == 0);
+  if (PDGDumpThreads.getNumOccurrences() > 0) {
+    if (PDGDumpThreads.getValue() <= 0) {
+      this->dumpOptions.numberOfThreads =
+          Architecture::getNumberOfLogicalCores();
+    } else {
+      this->dumpOptions.numberOfThreads = PDGDumpThreads.getValue();
+    }
+  }
+  this->dumpOptions.archiveFileName = PDGDumpArchive.getValue();
+  this->dumpOptions.compress = (PDGDumpCompress.getNumOccurrences() > 0);
 
   return false;
 }
@@ -102,6 +177,9 @@ void PDGGenerator::getAnalysisUsage(AnalysisUsage &AU) const {
   AU.addRequired<ScalarEvolutionWrapperPass>();
   AU.addRequired<AllocAA>();
   AU.addRequired<TalkDown>();
+  if (PDGDumpMinimumHotness.getNumOccurrences() > 0) {
+    AU.addRequired<HotProfiler>();
+  }
   AU.setPreservesAll();
 
   return;
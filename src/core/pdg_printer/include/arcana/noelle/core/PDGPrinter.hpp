@@ -37,6 +37,7 @@
 #include "arcana/noelle/core/DGGraphTraits.hpp"
 #include "arcana/noelle/core/PDG.hpp"
 #include "arcana/noelle/core/PDGTraits.hpp"
+#include "arcana/noelle/core/SCCDAG.hpp"
 
 #include "llvm/ADT/GraphTraits.h"
 #include "llvm/Analysis/DOTGraphTraitsPass.h"
@@ -88,19 +89,101 @@ public:
     return false;
   }
 
+  /*
+   * Return the DOT description of @graph.
+   * Nothing is written to disk, so different graphs can be rendered by
+   * different threads concurrently.
+   */
+  template <class GT, class T>
+  static std::string renderGraph(const std::string &title, GT *graph) {
+    DGGraphWrapper<GT, T> graphWrapper(graph);
+
+    std::string dot;
+    raw_string_ostream stream(dot);
+    WriteGraph(stream, &graphWrapper, false, title);
+    stream.flush();
+
+    return dot;
+  }
+
+  template <class GT, class T>
+  static std::string renderClusteredGraph(const std::string &title,
+                                          GT *graph) {
+    return addClustering(renderGraph<GT, T>(title, graph));
+  }
+
+  /*
+   * Return @dot with its nodes grouped in subgraphs by cluster.
+   */
+  static std::string addClustering(const std::string &dot);
+
 private:
   static void addClusteringToDotFile(std::string inputFileName,
                                      std::string outputFileName);
   static void groupNodesByCluster(
       std::unordered_map<std::string, std::set<std::string>> &clusterNodes,
       uint64_t &numLines,
-      std::ifstream &ifile);
+      std::istream &ifile);
+  static void copyWithClusters(
+      const std::unordered_map<std::string, std::set<std::string>>
+          &clusterNodes,
+      uint64_t numLines,
+      std::istream &ifile,
+      std::ostream &cfile);
   static void writeClusterToFile(
       const std::unordered_map<std::string, std::set<std::string>>
           &clusterNodes,
-      std::ofstream &cfile);
+      std::ostream &cfile);
+};
+
+/*
+ * What PDGPrinter dumps and how it writes it.
+ */
+struct PDGPrinterOptions {
+
+  /*
+   * Names of the functions to dump.
+   * If empty, all functions reachable from "main" are dumped together with the
+   * PDG of the whole program.
+   */
+  std::set<std::string> functionNames;
+
+  /*
+   * Loops nested deeper than this level are not dumped (outermost loops are at
+   * level 1). 0 means no limit.
+   */
+  uint32_t maximumLoopDepth = 0;
+
+  /*
+   * Loops for which this returns false are not dumped (e.g., cold loops).
+   * It is always invoked by the thread that invoked PDGPrinter.
+   */
+  std::function<bool(Loop *loop)> shouldPrintLoop = nullptr;
+
+  /*
+   * Dump the SCCDAG of each loop and each of its SCCs.
+   */
+  bool printSCCDAGs = true;
+
+  /*
+   * Number of threads that build and render graphs concurrently.
+   */
+  uint32_t numberOfThreads = 1;
+
+  /*
+   * If not empty, all graphs are streamed to this tar archive rather than
+   * being written to separate files.
+   */
+  std::string archiveFileName;
+
+  /*
+   * Compress the archive (or each file) with gzip.
+   */
+  bool compress = false;
 };
 
+class DOTFileWriter;
+
 class PDGPrinter {
 public:
   PDGPrinter();
@@ -108,14 +191,43 @@ public:
   void printPDG(Module &module,
                 CallGraph &callGraph,
                 PDG *graph,
-                std::function<LoopInfo &(Function *f)> getLoopInfo);
+                std::function<LoopInfo &(Function *f)> getLoopInfo,
+                const PDGPrinterOptions &options = PDGPrinterOptions());
 
   void printGraphsForFunction(Function &F, PDG *graph, LoopInfo &LI);
 
+  /*
+   * Print the dependence graph of a loop, its SCCDAG, and its SCCs by reusing
+   * the ones already computed (e.g., by LoopContent).
+   * The names of the files start with @prefix.
+   */
+  void printLoopGraphs(const std::string &prefix,
+                       PDG *loopDG,
+                       SCCDAG *loopSCCDAG,
+                       const PDGPrinterOptions &options = PDGPrinterOptions());
+
 private:
+  using PrintJob = std::function<void(DOTFileWriter &writer)>;
+
   void collectAllFunctionsInCallGraph(Module &M,
                                       CallGraph &callGraph,
                                       std::set<Function *> &funcSet);
+
+  void collectJobsForFunction(Function &F,
+                              PDG *graph,
+                              LoopInfo &LI,
+                              const PDGPrinterOptions &options,
+                              std::vector<PrintJob> &jobs);
+
+  /*
+   * Run @jobs and return the number of files written.
+   */
+  uint64_t runJobs(std::vector<PrintJob> &jobs,
+                   const PDGPrinterOptions &options);
+
+  static void printSCCDAG(const std::string &prefix,
+                          SCCDAG *sccdag,
+                          DOTFileWriter &writer);
 };
 
 } // namespace arcana::noelle
@@ -33,14 +33,263 @@
 #include "llvm/Analysis/DomPrinter.h"
 #include "llvm/Support/GraphWriter.h"
 #include "llvm/Support/DOTGraphTraits.h"
+#include "llvm/Support/Compression.h"
 
 #include "arcana/noelle/core/PDGTraits.hpp"
 #include "arcana/noelle/core/SCCDAG.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/SCCDAGGraphTraits.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
+
+#include <atomic>
+#include <ctime>
+#include <mutex>
+#include <sstream>
 
 namespace arcana::noelle {
 
+/*
+ * Destination of the DOT files dumped by PDGPrinter.
+ *
+ * Files are either written to disk one by one or streamed to a single tar
+ * archive.
+ * When compression is requested, every file (or every archive entry) is
+ * compressed as its own gzip member.
+ * Concatenated gzip members form a valid gzip stream, so the archive can be
+ * read with "tar xzf" while it is never kept in memory as a whole.
+ * Files can be written by multiple threads concurrently.
+ */
+class DOTFileWriter {
+public:
+  DOTFileWriter(const PDGPrinterOptions &options);
+
+  void write(const std::string &fileName, const std::string &dot);
+
+  uint64_t getNumberOfFiles(void) const;
+
+  ~DOTFileWriter();
+
+private:
+  bool compress;
+  std::unique_ptr<raw_fd_ostream> archive;
+  std::mutex lock;
+  uint64_t numberOfFiles;
+
+  std::string compressAsGZIPMember(StringRef data) const;
+
+  static std::string createTarEntry(const std::string &fileName,
+                                    const std::string &contents);
+
+  static std::string createTarHeader(const std::string &fileName,
+                                     uint64_t size,
+                                     char type);
+};
+
+DOTFileWriter::DOTFileWriter(const PDGPrinterOptions &options)
+  : compress{ options.compress },
+    archive{ nullptr },
+    numberOfFiles{ 0 } {
+
+  /*
+   * Check if compression is available.
+   */
+  if (this->compress && !zlib::isAvailable()) {
+    errs() << "PDGPrinter: WARNING = zlib is not available; graphs will not "
+              "be compressed\n";
+    this->compress = false;
+  }
+
+  /*
+   * Open the archive.
+   */
+  if (options.archiveFileName == "") {
+    return;
+  }
+  std::error_code EC;
+  this->archive = std::make_unique<raw_fd_ostream>(options.archiveFileName,
+                                                   EC,
+                                                   sys::fs::F_None);
+  if (EC) {
+    errs() << "PDGPrinter: ERROR = cannot open the archive "
+           << options.archiveFileName << "\n";
+    abort();
+  }
+
+  return;
+}
+
+void DOTFileWriter::write(const std::string &fileName, const std::string &dot) {
+
+  /*
+   * Prepare the bytes to write without holding the lock.
+   */
+  std::string bytes;
+  if (this->archive != nullptr) {
+    bytes = DOTFileWriter::createTarEntry(fileName, dot);
+  }
+  if (this->compress) {
+    auto &uncompressed = (this->archive != nullptr) ? bytes : dot;
+    bytes = this->compressAsGZIPMember(uncompressed);
+  }
+
+  /*
+   * Case: the file is an entry of the archive.
+   */
+  if (this->archive != nullptr) {
+    std::lock_guard<std::mutex> guard(this->lock);
+    *this->archive << bytes;
+    this->numberOfFiles++;
+    return;
+  }
+
+  /*
+   * Case: the file is written on its own.
+   */
+  auto outputFileName = this->compress ? (fileName + ".gz") : fileName;
+  std::error_code EC;
+  raw_fd_ostream file(outputFileName,
+                      EC,
+                      this->compress ? sys::fs::F_None : sys::fs::F_Text);
+  if (EC) {
+    errs() << "PDGPrinter: ERROR = cannot open " << outputFileName << "\n";
+    return;
+  }
+  file << (this->compress ? bytes : dot);
+  file.close();
+  {
+    std::lock_guard<std::mutex> guard(this->lock);
+    this->numberOfFiles++;
+  }
+
+  return;
+}
+
+uint64_t DOTFileWriter::getNumberOfFiles(void) const {
+  return this->numberOfFiles;
+}
+
+std::string DOTFileWriter::compressAsGZIPMember(StringRef data) const {
+
+  /*
+   * Compress the data as a zlib stream.
+   */
+  SmallVector<char, 0> zlibStream;
+  if (auto error = zlib::compress(data, zlibStream)) {
+    errs() << "PDGPrinter: ERROR = " << toString(std::move(error)) << "\n";
+    abort();
+  }
+
+  /*
+   * A zlib stream is a 2-byte header, the deflate data, and a 4-byte checksum.
+   * A gzip member is a 10-byte header, the same deflate data, the CRC-32 of
+   * the uncompressed data, and its size (both in little endian).
+   */
+  std::string member{ '\x1f', '\x8b', '\x08', 0, 0, 0, 0, 0, 0, '\xff' };
+  member.append(zlibStream.begin() + 2, zlibStream.end() - 4);
+  auto appendLittleEndian = [&member](uint32_t value) -> void {
+    for (auto i = 0; i < 4; i++) {
+      member.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+  };
+  appendLittleEndian(zlib::crc32(data));
+  appendLittleEndian(static_cast<uint32_t>(data.size()));
+
+  return member;
+}
+
+std::string DOTFileWriter::createTarEntry(const std::string &fileName,
+                                          const std::string &contents) {
+  std::string entry;
+  auto pad = [&entry](void) -> void {
+    entry.append((512 - (entry.size() % 512)) % 512, '\0');
+  };
+
+  /*
+   * Names that do not fit the header are stored in a PAX extended header.
+   * The length of a PAX record includes the digits of the length itself.
+   */
+  if (fileName.size() >= 100) {
+    auto body = " path=" + fileName + "\n";
+    auto length = body.size() + 1;
+    while (std::to_string(length).size() + body.size() != length) {
+      length = std::to_string(length).size() + body.size();
+    }
+    auto record = std::to_string(length) + body;
+    entry += DOTFileWriter::createTarHeader("PaxHeader", record.size(), 'x');
+    entry += record;
+    pad();
+  }
+
+  /*
+   * Append the file.
+   */
+  entry += DOTFileWriter::createTarHeader(fileName.substr(0, 99),
+                                          contents.size(),
+                                          '0');
+  entry += contents;
+  pad();
+
+  return entry;
+}
+
+std::string DOTFileWriter::createTarHeader(const std::string &fileName,
+                                           uint64_t size,
+                                           char type) {
+  std::string header(512, '\0');
+  auto setField = [&header](uint32_t offset, const std::string &value) -> void {
+    header.replace(offset, value.size(), value);
+  };
+  auto toOctal = [](uint64_t value, uint32_t digits) -> std::string {
+    std::string octal(digits, '0');
+    for (auto i = digits; i > 0; i--) {
+      octal[i - 1] = static_cast<char>('0' + (value & 7));
+      value >>= 3;
+    }
+    return octal;
+  };
+
+  /*
+   * Fill the ustar header.
+   */
+  setField(0, fileName);
+  setField(100, "0000644");
+  setField(108, "0000000");
+  setField(116, "0000000");
+  setField(124, toOctal(size, 11));
+  setField(136, toOctal(static_cast<uint64_t>(std::time(nullptr)), 11));
+  header[156] = type;
+  setField(257, "ustar");
+  setField(263, "00");
+
+  /*
+   * The checksum is computed with its own field set to spaces.
+   */
+  setField(148, "        ");
+  uint64_t checksum = 0;
+  for (auto c : header) {
+    checksum += static_cast<unsigned char>(c);
+  }
+  setField(148, toOctal(checksum, 6));
+  header[154] = '\0';
+
+  return header;
+}
+
+DOTFileWriter::~DOTFileWriter() {
+  if (this->archive == nullptr) {
+    return;
+  }
+
+  /*
+   * A tar archive ends with two empty blocks.
+   */
+  std::string end(1024, '\0');
+  *this->archive << (this->compress ? this->compressAsGZIPMember(end) : end);
+  this->archive->close();
+
+  return;
+}
+
 PDGPrinter::PDGPrinter() {
   return;
 }
@@ -48,7 +297,9 @@ PDGPrinter::PDGPrinter() {
 void PDGPrinter::printPDG(Module &module,
                           llvm::CallGraph &callGraph,
                           PDG *graph,
-                          std::function<LoopInfo &(Function *f)> getLoopInfo) {
+                          std::function<LoopInfo &(Function *f)> getLoopInfo,
+                          const PDGPrinterOptions &options) {
+  ScopedTimer timer("PDGPrinter::printPDG");
 
   /*
    * Collect functions through call graph starting at function "main"
@@ -57,13 +308,68 @@ void PDGPrinter::printPDG(Module &module,
   collectAllFunctionsInCallGraph(module, callGraph, funcToGraph);
 
   /*
-   * Print the PDG
+   * Collect the graphs to print.
+   *
+   * The loop information of a function can be invalidated when the one of
+   * another function is requested.
+   * Hence, everything needed from it is collected here, sequentially, and the
+   * graphs are built and printed later.
    */
-  DGPrinter::writeClusteredGraph<PDG, Value>("pdg-full.dot", graph);
+  std::vector<PrintJob> jobs;
+  if (options.functionNames.empty()) {
+    jobs.push_back([graph](DOTFileWriter &writer) -> void {
+      writer.write("pdg-full.dot",
+                   DGPrinter::renderClusteredGraph<PDG, Value>("pdg-full.dot",
+                                                               graph));
+    });
+  }
   for (auto F : funcToGraph) {
+    if (!options.functionNames.empty()
+        && (options.functionNames.count(F->getName().str()) == 0)) {
+      continue;
+    }
     auto &LI = getLoopInfo(F);
-    printGraphsForFunction(*F, graph, LI);
+    this->collectJobsForFunction(*F, graph, LI, options, jobs);
+  }
+
+  /*
+   * Print the PDG
+   */
+  auto filesWritten = this->runJobs(jobs, options);
+  errs() << "PDGPrinter: " << filesWritten << " graphs written";
+  if (options.archiveFileName != "") {
+    errs() << " to " << options.archiveFileName;
+  }
+  errs() << "\n";
+
+  return;
+}
+
+void PDGPrinter::printGraphsForFunction(Function &F, PDG *graph, LoopInfo &LI) {
+  PDGPrinterOptions options;
+  std::vector<PrintJob> jobs;
+  this->collectJobsForFunction(F, graph, LI, options, jobs);
+  this->runJobs(jobs, options);
+
+  return;
+}
+
+void PDGPrinter::printLoopGraphs(const std::string &prefix,
+                                 PDG *loopDG,
+                                 SCCDAG *loopSCCDAG,
+                                 const PDGPrinterOptions &options) {
+  std::vector<PrintJob> jobs;
+  jobs.push_back([prefix, loopDG](DOTFileWriter &writer) -> void {
+    auto fileName = prefix + ".dot";
+    writer.write(fileName,
+                 DGPrinter::renderClusteredGraph<PDG, Value>(fileName, loopDG));
+  });
+  if (options.printSCCDAGs && (loopSCCDAG != nullptr)) {
+    jobs.push_back([prefix, loopSCCDAG](DOTFileWriter &writer) -> void {
+      PDGPrinter::printSCCDAG(prefix, loopSCCDAG, writer);
+    });
   }
+  this->runJobs(jobs, options);
 
   return;
 }
@@ -95,17 +401,24 @@ void PDGPrinter::collectAllFunctionsInCallGraph(Module &M,
   }
 }
 
-void PDGPrinter::printGraphsForFunction(Function &F, PDG *graph, LoopInfo &LI) {
+void PDGPrinter::collectJobsForFunction(Function &F,
+                                        PDG *graph,
+                                        LoopInfo &LI,
+                                        const PDGPrinterOptions &options,
+                                        std::vector<PrintJob> &jobs) {
 
   /*
    * Print the DG of the function.
    */
-  std::string filename;
-  raw_string_ostream ros(filename);
-  ros << "pdg-function-" << F.getName() << ".dot";
-  auto subgraph = graph->createFunctionSubgraph(F);
-  DGPrinter::writeClusteredGraph<PDG, Value>(ros.str(), subgraph);
-  delete subgraph;
+  auto functionPrefix = "pdg-function-" + F.getName().str();
+  jobs.push_back([functionPrefix, graph, &F](DOTFileWriter &writer) -> void {
+    auto fileName = functionPrefix + ".dot";
+    auto subgraph = graph->createFunctionSubgraph(F);
+    writer.write(fileName,
+                 DGPrinter::renderClusteredGraph<PDG, Value>(fileName,
+                                                             subgraph));
+    delete subgraph;
+  });
 
   /*
    * Check if the function has loops.
@@ -115,54 +428,128 @@ void PDGPrinter::printGraphsForFunction(Function &F, PDG *graph, LoopInfo &LI) {
 
   /*
    * Print the DG of each loop.
+   *
+   * Loops are numbered as if none were filtered out, so the name of a file
+   * does not depend on the filters.
    */
   auto loopCount = 0;
   for (auto currentLoop : LI.getLoopsInPreorder()) {
+    auto loopPrefix = functionPrefix + "-loop" + std::to_string(loopCount);
+    loopCount++;
 
     /*
-     * Print the loop DG.
-     */
-    filename.clear();
-    ros << "pdg-function-" << F.getName() << "-loop" << loopCount << ".dot";
-    subgraph = graph->createLoopsSubgraph(currentLoop);
-    DGPrinter::writeClusteredGraph<PDG, Value>(ros.str(), subgraph);
-
-    /*
-     * Print the SCCDAG of the loop.
+     * Check if the loop should be printed.
      */
-    filename.clear();
-    ros << "pdg-function-" << F.getName() << "-loop" << loopCount
-        << "-SCCDAG.dot";
-    auto sccSubgraph = new SCCDAG(subgraph);
-    DGPrinter::writeClusteredGraph<SCCDAG, SCC>(ros.str(), sccSubgraph);
+    if ((options.maximumLoopDepth > 0)
+        && (currentLoop->getLoopDepth() > options.maximumLoopDepth)) {
+      continue;
+    }
+    if (options.shouldPrintLoop && !options.shouldPrintLoop(currentLoop)) {
+      continue;
+    }
 
     /*
-     * Print each SCC within the loop SCCDAG.
+     * Collect the instructions of the loop.
      */
-    auto sccCount = 0;
-    for (auto scc : sccSubgraph->getSCCs()) {
-      filename.clear();
-      ros << "pdg-function-" << F.getName() << "-loop" << loopCount
-          << "-SCCDAG-SCC" << sccCount << ".dot";
-      DGPrinter::writeClusteredGraph<SCC, Value>(ros.str(), scc);
-      sccCount++;
+    std::vector<Value *> loopValues;
+    for (auto bb : currentLoop->blocks()) {
+      for (auto &I : *bb) {
+        loopValues.push_back(&I);
+      }
     }
 
     /*
-     * Free the memory
+     * Print the loop DG, its SCCDAG, and each SCC within the loop SCCDAG.
      */
-    delete sccSubgraph;
-    delete subgraph;
+    auto printSCCDAGs = options.printSCCDAGs;
+    jobs.push_back([loopPrefix, loopValues, graph, printSCCDAGs](
+                       DOTFileWriter &writer) mutable -> void {
+      auto fileName = loopPrefix + ".dot";
+      auto subgraph = graph->createSubgraphFromValues(loopValues, true);
+      writer.write(fileName,
+                   DGPrinter::renderClusteredGraph<PDG, Value>(fileName,
+                                                               subgraph));
+      if (printSCCDAGs) {
+        auto sccSubgraph = new SCCDAG(subgraph);
+        PDGPrinter::printSCCDAG(loopPrefix, sccSubgraph, writer);
+        delete sccSubgraph;
+      }
+      delete subgraph;
+    });
+  }
 
-    /*
-     * Increase the loop count ID
-     */
-    loopCount++;
+  return;
+}
+
+void PDGPrinter::printSCCDAG(const std::string &prefix,
+                             SCCDAG *sccdag,
+                             DOTFileWriter &writer) {
+
+  /*
+   * Print the SCCDAG.
+   */
+  auto fileName = prefix + "-SCCDAG.dot";
+  writer.write(fileName,
+               DGPrinter::renderClusteredGraph<SCCDAG, SCC>(fileName, sccdag));
+
+  /*
+   * Print each SCC.
+   */
+  auto sccCount = 0;
+  for (auto scc : sccdag->getSCCs()) {
+    fileName = prefix + "-SCCDAG-SCC" + std::to_string(sccCount) + ".dot";
+    writer.write(fileName,
+                 DGPrinter::renderClusteredGraph<SCC, Value>(fileName, scc));
+    sccCount++;
   }
 
   return;
 }
 
+uint64_t PDGPrinter::runJobs(std::vector<PrintJob> &jobs,
+                             const PDGPrinterOptions &options) {
+  DOTFileWriter writer(options);
+
+  /*
+   * Run the jobs.
+   *
+   * Jobs only read the PDG and the IR, so they can run concurrently.
+   * Threads pick the next job from a shared counter because the size of the
+   * graphs varies a lot.
+   */
+  auto workers = std::min<uint64_t>(options.numberOfThreads, jobs.size());
+  if (workers <= 1) {
+    for (auto &job : jobs) {
+      job(writer);
+    }
+
+  } else {
+    std::atomic<uint64_t> nextJob{ 0 };
+    auto worker = [&nextJob, &jobs, &writer](void) -> void {
+      while (true) {
+        auto jobIndex = nextJob.fetch_add(1);
+        if (jobIndex >= jobs.size()) {
+          break;
+        }
+        jobs[jobIndex](writer);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (uint64_t i = 1; i < workers; i++) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  Instrumentation::count("PDGPrinter: graphs written",
+                         writer.getNumberOfFiles());
+
+  return writer.getNumberOfFiles();
+}
+
 void DGPrinter::addClusteringToDotFile(std::string inputFileName,
                                        std::string outputFileName) {
   std::ifstream ifile(inputFileName);
@@ -194,6 +581,36 @@ void DGPrinter::addClusteringToDotFile(std::string inputFileName,
     return;
   }
 
+  copyWithClusters(clusterNodes, numLines, ifile, cfile);
+
+  cfile.close();
+  ifile.close();
+}
+
+std::string DGPrinter::addClustering(const std::string &dot) {
+  std::istringstream input(dot);
+  std::unordered_map<std::string, std::set<std::string>> clusterNodes;
+
+  uint64_t numLines = 0;
+  groupNodesByCluster(clusterNodes, numLines, input);
+  if (clusterNodes.size() == 0) {
+    return dot;
+  }
+
+  input.clear();
+  input.seekg(0, std::ios::beg);
+
+  std::ostringstream output;
+  copyWithClusters(clusterNodes, numLines, input, output);
+
+  return output.str();
+}
+
+void DGPrinter::copyWithClusters(
+    const std::unordered_map<std::string, std::set<std::string>> &clusterNodes,
+    uint64_t numLines,
+    std::istream &ifile,
+    std::ostream &cfile) {
   std::string line;
   for (uint64_t i = 0; i < (numLines - 1); ++i) {
     getline(ifile, line);
@@ -204,13 +621,11 @@ void DGPrinter::addClusteringToDotFile(std::string inputFileName,
 
   getline(ifile, line);
   cfile << line;
-  cfile.close();
-  ifile.close();
 }
 
 void DGPrinter::writeClusterToFile(
     const std::unordered_map<std::string, std::set<std::string>> &clusterNodes,
-    std::ofstream &cfile) {
+    std::ostream &cfile) {
   for (auto clusterNodesPair : clusterNodes) {
     std::string indent = "    ";
     cfile << "\n";
@@ -227,7 +642,7 @@ void DGPrinter::writeClusterToFile(
 void DGPrinter::groupNodesByCluster(
     std::unordered_map<std::string, std::set<std::string>> &clusterNodes,
     uint64_t &numLines,
-    std::ifstream &ifile) {
+    std::istream &ifile) {
   std::string CLUSTER_KEY = "cluster=";
   std::string NODE_NAME = "Node";
   std::string line;
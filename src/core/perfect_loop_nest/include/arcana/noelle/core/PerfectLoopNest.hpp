@@ -0,0 +1,119 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_PERFECT_LOOP_NEST_PERFECTLOOPNEST_H_
+#define NOELLE_SRC_CORE_PERFECT_LOOP_NEST_PERFECTLOOPNEST_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/LoopContent.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Perfect nest of counted loops in while form (see LoopWhilifier) rooted at
+ * the loop of a LoopContent.
+ *
+ * Every loop of the nest but the innermost one has a single sub-loop, and its
+ * code outside that sub-loop has no side effects.
+ * Every loop has the following shape, where @start and @exitValue do not
+ * change while the nest runs (i.e., the iteration space is rectangular):
+ *
+ *   header:
+ *     iv = phi [start, preheader], [iv + step, latch]
+ *     if (iv continuePredicate exitValue) goto body; else goto exit;
+ */
+class PerfectLoopNest {
+public:
+  struct CountedLoop {
+    LoopStructure *loop;
+    PHINode *inductionVariable;
+    Value *startValue;
+    Value *exitValue;
+    uint64_t step;
+
+    /*
+     * The compare of the header and the predicate that keeps the loop
+     * running when @inductionVariable is its first operand.
+     * The predicate is either ICMP_SLT or ICMP_ULT.
+     */
+    CmpInst *compare;
+    CmpInst::Predicate continuePredicate;
+  };
+
+  PerfectLoopNest(LoopContent &LDI, ScalarEvolution &SE);
+
+  PerfectLoopNest() = delete;
+
+  /*
+   * Return true if the loop of the LoopContent is the root of a perfect nest
+   * of counted loops that only accesses memory through loads and stores.
+   */
+  bool isValid(void) const;
+
+  /*
+   * Return the loops of the nest from the outermost.
+   */
+  const std::vector<CountedLoop> &getLoops(void) const;
+
+  uint32_t getDepth(void) const;
+
+  /*
+   * Return the loads and stores of the nest.
+   */
+  const std::vector<Instruction *> &getMemoryAccesses(void) const;
+
+  /*
+   * Return true if the memory dependences of the nest have no negative
+   * component in their direction vectors, so the loops can be reordered (or
+   * tiled) arbitrarily.
+   */
+  bool isFullyPermutable(void) const;
+
+  /*
+   * Return true if running the loops of the nest in the order @permutation
+   * (permutation[i] is the depth, from 0, of the loop that becomes the i-th
+   * one) preserves all memory dependences.
+   */
+  bool isPermutationLegal(const std::vector<uint32_t> &permutation) const;
+
+private:
+  LoopContent &LDI;
+  bool valid;
+  std::vector<CountedLoop> loops;
+  std::vector<Instruction *> memoryAccesses;
+  std::vector<std::pair<Instruction *, Instruction *>> memoryDependences;
+
+  bool collectLoops(ScalarEvolution &SE);
+
+  bool describeCountedLoop(LoopStructure *loop,
+                           LoopStructure *topLoop,
+                           ScalarEvolution &SE,
+                           CountedLoop &countedLoop);
+
+  bool collectMemoryAccessesAndDependences(void);
+
+  bool mayHaveDependenceWithDirections(
+      const std::vector<uint8_t> &directions) const;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_PERFECT_LOOP_NEST_PERFECTLOOPNEST_H_
@@ -0,0 +1,373 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/PerfectLoopNest.hpp"
+
+namespace arcana::noelle {
+
+PerfectLoopNest::PerfectLoopNest(LoopContent &LDI, ScalarEvolution &SE)
+  : LDI{ LDI },
+    valid{ false } {
+
+  /*
+   * Describe the loops of the nest.
+   */
+  if (!this->collectLoops(SE)) {
+    return;
+  }
+
+  /*
+   * Collect the memory accesses and the memory dependences between them.
+   */
+  if (!this->collectMemoryAccessesAndDependences()) {
+    return;
+  }
+  this->valid = true;
+
+  return;
+}
+
+bool PerfectLoopNest::isValid(void) const {
+  return this->valid;
+}
+
+const std::vector<PerfectLoopNest::CountedLoop> &PerfectLoopNest::getLoops(
+    void) const {
+  return this->loops;
+}
+
+uint32_t PerfectLoopNest::getDepth(void) const {
+  return this->loops.size();
+}
+
+const std::vector<Instruction *> &PerfectLoopNest::getMemoryAccesses(
+    void) const {
+  return this->memoryAccesses;
+}
+
+bool PerfectLoopNest::collectLoops(ScalarEvolution &SE) {
+  auto node = this->LDI.getLoopHierarchyStructures();
+  auto topLoop = node->getLoop();
+  while (true) {
+
+    /*
+     * Describe the current loop.
+     */
+    auto loop = node->getLoop();
+    CountedLoop countedLoop;
+    if (!this->describeCountedLoop(loop, topLoop, SE, countedLoop)) {
+      return false;
+    }
+    this->loops.push_back(countedLoop);
+
+    /*
+     * Check whether the current loop is the innermost one.
+     */
+    auto children = node->getChildren();
+    if (children.size() == 0) {
+      break;
+    }
+    if (children.size() > 1) {
+      return false;
+    }
+    auto child = *children.begin();
+
+    /*
+     * The code of the current loop that is outside its sub-loop must not have
+     * side effects nor read memory, as it can run a different number of times
+     * once the nest is transformed.
+     */
+    auto subLoop = child->getLoop();
+    for (auto bb : loop->getBasicBlocks()) {
+      if (subLoop->isIncluded(bb)) {
+        continue;
+      }
+      for (auto &inst : *bb) {
+        if (inst.mayHaveSideEffects() || inst.mayReadFromMemory()) {
+          return false;
+        }
+      }
+    }
+
+    node = child;
+  }
+
+  return true;
+}
+
+bool PerfectLoopNest::describeCountedLoop(LoopStructure *loop,
+                                          LoopStructure *topLoop,
+                                          ScalarEvolution &SE,
+                                          CountedLoop &countedLoop) {
+  countedLoop.loop = loop;
+
+  /*
+   * Values the loop depends on must not change while the nest runs.
+   */
+  auto isNestInvariant = [topLoop](Value *v) -> bool {
+    auto inst = dyn_cast<Instruction>(v);
+    return (inst == nullptr) || !topLoop->isIncluded(inst);
+  };
+
+  /*
+   * Fetch the loop-governing induction variable.
+   * Its step must be a positive constant.
+   */
+  auto ivManager = this->LDI.getInductionVariableManager();
+  auto GIV = ivManager->getLoopGoverningInductionVariable(*loop);
+  if (GIV == nullptr) {
+    return false;
+  }
+  auto IV = GIV->getInductionVariable();
+  auto step = dyn_cast_or_null<ConstantInt>(IV->getSingleComputedStepValue());
+  if ((step == nullptr) || !step->getValue().isStrictlyPositive()
+      || (step->getValue().getActiveBits() > 63)) {
+    return false;
+  }
+  countedLoop.step = step->getZExtValue();
+  countedLoop.inductionVariable = IV->getLoopEntryPHI();
+
+  /*
+   * The induction variable must be the only value carried across iterations
+   * by the header, and the loop must be entered from its preheader only.
+   */
+  auto header = loop->getHeader();
+  auto preheader = loop->getPreHeader();
+  auto phis = header->phis();
+  if ((preheader == nullptr)
+      || (std::distance(phis.begin(), phis.end()) != 1)
+      || (countedLoop.inductionVariable->getNumIncomingValues() != 2)
+      || (countedLoop.inductionVariable->getBasicBlockIndex(preheader) < 0)) {
+    return false;
+  }
+  countedLoop.startValue =
+      countedLoop.inductionVariable->getIncomingValueForBlock(preheader);
+  if (!isNestInvariant(countedLoop.startValue)) {
+    return false;
+  }
+
+  /*
+   * The loop must exit only from its header, by comparing the induction
+   * variable against a value that does not change while the nest runs.
+   */
+  auto exitBlocks = loop->getLoopExitBasicBlocks();
+  if ((exitBlocks.size() != 1)
+      || (exitBlocks[0] != GIV->getExitBlockFromHeader())) {
+    return false;
+  }
+  auto compare = dyn_cast_or_null<ICmpInst>(
+      GIV->getHeaderCompareInstructionToComputeExitCondition());
+  if ((compare == nullptr)
+      || (GIV->getValueToCompareAgainstExitConditionValue()
+          != countedLoop.inductionVariable)
+      || (GIV->getConditionValueDerivation().size() > 0)) {
+    return false;
+  }
+  countedLoop.compare = compare;
+  countedLoop.exitValue = GIV->getExitConditionValue();
+  if (!isNestInvariant(countedLoop.exitValue)) {
+    return false;
+  }
+
+  /*
+   * Compute the predicate that keeps the loop running when the induction
+   * variable is the first operand of the compare.
+   */
+  auto predicate = compare->getPredicate();
+  if (compare->getOperand(1) == countedLoop.inductionVariable) {
+    predicate = CmpInst::getSwappedPredicate(predicate);
+  }
+  if (!GIV->valueOfExitConditionToJumpToTheLoopBody()) {
+    predicate = CmpInst::getInversePredicate(predicate);
+  }
+
+  /*
+   * An induction variable that steps by one from a start value that does not
+   * exceed the exit value runs while it is different from the exit value, or
+   * equivalently, while it is lower than the exit value.
+   */
+  if ((predicate == CmpInst::Predicate::ICMP_NE) && (countedLoop.step == 1)
+      && SE.isSCEVable(countedLoop.startValue->getType())
+      && SE.isKnownPredicate(CmpInst::Predicate::ICMP_ULE,
+                             SE.getSCEV(countedLoop.startValue),
+                             SE.getSCEV(countedLoop.exitValue))) {
+    predicate = CmpInst::Predicate::ICMP_ULT;
+  }
+  if ((predicate != CmpInst::Predicate::ICMP_SLT)
+      && (predicate != CmpInst::Predicate::ICMP_ULT)) {
+    return false;
+  }
+  countedLoop.continuePredicate = predicate;
+
+  return true;
+}
+
+bool PerfectLoopNest::collectMemoryAccessesAndDependences(void) {
+
+  /*
+   * The nest must access memory only through simple loads and stores, and the
+   * values it computes must not be used outside of it.
+   */
+  auto topLoop = this->loops.front().loop;
+  for (auto bb : topLoop->getBasicBlocks()) {
+    for (auto &inst : *bb) {
+      if (auto load = dyn_cast<LoadInst>(&inst)) {
+        if (!load->isSimple()) {
+          return false;
+        }
+        this->memoryAccesses.push_back(load);
+
+      } else if (auto store = dyn_cast<StoreInst>(&inst)) {
+        if (!store->isSimple()) {
+          return false;
+        }
+        this->memoryAccesses.push_back(store);
+
+      } else if (inst.mayReadOrWriteMemory() || inst.mayHaveSideEffects()) {
+        return false;
+      }
+
+      for (auto user : inst.users()) {
+        auto userInst = dyn_cast<Instruction>(user);
+        if ((userInst == nullptr) || !topLoop->isIncluded(userInst)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  /*
+   * Collect the memory dependences of the nest.
+   */
+  auto loopDG = this->LDI.getLoopDG();
+  for (auto edge : loopDG->getEdges()) {
+    if (!isa<MemoryDependence<Value, Value>>(edge)) {
+      continue;
+    }
+    auto from = dyn_cast<Instruction>(edge->getSrc());
+    auto to = dyn_cast<Instruction>(edge->getDst());
+    if ((from == nullptr) || (to == nullptr) || !topLoop->isIncluded(from)
+        || !topLoop->isIncluded(to)) {
+      continue;
+    }
+    this->memoryDependences.push_back(std::make_pair(from, to));
+  }
+
+  return true;
+}
+
+bool PerfectLoopNest::mayHaveDependenceWithDirections(
+    const std::vector<uint8_t> &directions) const {
+  auto iterationSpace = this->LDI.getLoopIterationSpaceAnalysis();
+  if (iterationSpace == nullptr) {
+    return this->memoryDependences.size() > 0;
+  }
+  for (auto &dependence : this->memoryDependences) {
+    if (iterationSpace->mayDependWithDirections(dependence.first,
+                                                dependence.second,
+                                                directions)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool PerfectLoopNest::isFullyPermutable(void) const {
+  assert(this->valid);
+
+  /*
+   * A dependence prevents reordering the loops if it goes forward at the loop
+   * at depth @p (the iterations of the outer loops being the same) and
+   * backward at a deeper loop @q.
+   */
+  auto depth = this->getDepth();
+  for (auto p = 0u; p < depth; p++) {
+    for (auto q = p + 1; q < depth; q++) {
+      std::vector<uint8_t> directions(
+          depth,
+          LoopIterationSpaceAnalysis::DIRECTION_ANY);
+      for (auto outer = 0u; outer < p; outer++) {
+        directions[outer] = LoopIterationSpaceAnalysis::DIRECTION_SAME;
+      }
+      directions[p] = LoopIterationSpaceAnalysis::DIRECTION_BEFORE;
+      directions[q] = LoopIterationSpaceAnalysis::DIRECTION_AFTER;
+      if (this->mayHaveDependenceWithDirections(directions)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool PerfectLoopNest::isPermutationLegal(
+    const std::vector<uint32_t> &permutation) const {
+  assert(this->valid);
+  auto depth = this->getDepth();
+  assert(permutation.size() == depth);
+
+  /*
+   * A dependence that goes forward first at the loop at depth @p (the
+   * iterations of the outer loops being the same) is reversed by the
+   * permutation if, in the new order, the first loop whose iterations differ
+   * is a loop @q where the dependence goes backward.
+   */
+  for (auto p = 0u; p < depth; p++) {
+    for (auto t = 0u; t < depth; t++) {
+      auto q = permutation[t];
+      if (q <= p) {
+        continue;
+      }
+      std::vector<uint8_t> directions(
+          depth,
+          LoopIterationSpaceAnalysis::DIRECTION_ANY);
+      for (auto outer = 0u; outer < p; outer++) {
+        directions[outer] = LoopIterationSpaceAnalysis::DIRECTION_SAME;
+      }
+      directions[p] = LoopIterationSpaceAnalysis::DIRECTION_BEFORE;
+
+      /*
+       * The loops before @q in the new order run the same iterations.
+       */
+      auto isConsistent = true;
+      for (auto s = 0u; s < t; s++) {
+        auto l = permutation[s];
+        if (l == p) {
+          isConsistent = false;
+          break;
+        }
+        directions[l] = LoopIterationSpaceAnalysis::DIRECTION_SAME;
+      }
+      if (!isConsistent) {
+        continue;
+      }
+      directions[q] = LoopIterationSpaceAnalysis::DIRECTION_AFTER;
+      if (this->mayHaveDependenceWithDirections(directions)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+} // namespace arcana::noelle
@@ -83,6 +83,12 @@ public:
    */
   int64_t numberOfInstructions(void) const;
 
+  /*
+   * Return the identifier of the SCC.
+   * Identifiers are never reused, even after the SCC is deallocated.
+   */
+  uint64_t getID(void) const;
+
   /*
    * Print
    */
@@ -101,6 +107,8 @@ public:
   ~SCC();
 
 private:
+  uint64_t ID;
+
   void copyNodesAndEdges(std::set<DGNode<Value> *> internalNodes,
                          std::set<DGNode<Value> *> externalNodes);
 };
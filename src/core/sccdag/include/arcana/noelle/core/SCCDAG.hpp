@@ -115,6 +115,11 @@ public:
    */
   uint32_t getSCCIndex(const SCC *scc) const;
 
+  /*
+   * Memory used by the SCCDAG, including its SCCs.
+   */
+  MemoryFootprint getMemoryFootprint(void) const;
+
   /*
    * Deconstructor.
    */
@@ -19,12 +19,19 @@
  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include <atomic>
+
 #include "llvm/Support/raw_ostream.h"
 #include "arcana/noelle/core/SCC.hpp"
 
 namespace arcana::noelle {
 
-SCC::SCC(std::set<DGNode<Value> *> internalNodes) {
+/*
+ * Identifier of the next SCC.
+ */
+static std::atomic<uint64_t> nextSCCID{ 0 };
+
+SCC::SCC(std::set<DGNode<Value> *> internalNodes) : ID{ nextSCCID++ } {
 
   /*
    * Collect all internal values
@@ -57,7 +64,8 @@ SCC::SCC(std::set<DGNode<Value> *> internalNodes) {
 }
 
 SCC::SCC(std::set<DGNode<Value> *> internalNodes,
-         std::set<DGNode<Value> *> externalNodes) {
+         std::set<DGNode<Value> *> externalNodes)
+  : ID{ nextSCCID++ } {
   copyNodesAndEdges(internalNodes, externalNodes);
 }
 
@@ -294,6 +302,10 @@ bool SCC::iterateOverAllValues(std::function<bool(Value *)> funcToInvoke) {
   return false;
 }
 
+uint64_t SCC::getID(void) const {
+  return this->ID;
+}
+
 SCC::~SCC() {
   return;
 }
@@ -23,11 +23,13 @@
 #include "arcana/noelle/core/DGGraphTraits.hpp"
 #include "arcana/noelle/core/PDGTraits.hpp"
 #include "arcana/noelle/core/SCCDAG.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
 #include "llvm/InitializePasses.h"
 
 namespace arcana::noelle {
 
 SCCDAG::SCCDAG(PDG *pdg) {
+  ScopedTimer timer("SCCDAG");
 
   /*
    * Create nodes of the SCCDAG.
@@ -95,10 +97,41 @@ SCCDAG::SCCDAG(PDG *pdg) {
    */
   orderedDirty = true;
   this->computeReachabilityAmongSCCs();
+  Instrumentation::count("SCCDAG: SCCs", this->numNodes());
+  if (Instrumentation::isEnabled()) {
+    this->memoryAccount.update("SCCDAG", this->getMemoryFootprint());
+  }
 
   return;
 }
 
+MemoryFootprint SCCDAG::getMemoryFootprint(void) const {
+  auto pointerBytes = sizeof(void *);
+
+  /*
+   * Account the graph among SCCs.
+   */
+  auto footprint = DG<SCC>::getMemoryFootprint();
+
+  /*
+   * Account the SCCs.
+   */
+  for (auto node : this->allNodes) {
+    footprint += node->getT()->getMemoryFootprint();
+  }
+
+  /*
+   * Account the maps and the reachability matrix.
+   */
+  footprint.bytes += MemoryFootprint::hashEntriesBytes(
+      this->valueToSCCNode.size() + this->sccIndexes.size(),
+      2 * pointerBytes);
+  auto sccs = this->allNodes.size();
+  footprint.bytes += (sccs * sccs) / 8;
+
+  return footprint;
+}
+
 bool SCCDAG::doesItContain(Instruction *inst) const {
 
   /*
@@ -25,6 +25,7 @@
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/LoopContent.hpp"
 #include "arcana/noelle/core/Dominators.hpp"
+#include "arcana/noelle/core/DependenceReachability.hpp"
 
 namespace arcana::noelle {
 
@@ -35,6 +36,8 @@ enum ScheduleDirection {
 
 };
 
+enum class SchedulerVerbosity { Disabled, Minimal, Maximal };
+
 /*
  * Forward declarations
  */
@@ -42,6 +45,12 @@ class LoopScheduler;
 
 /*
  * Scheduler abstraction
+ *
+ * The dependences between the instructions of the same basic block are
+ * indexed (see DependenceReachability) the first time a PDG is queried, and
+ * the index is reused by the next queries on that PDG. Hence, the queries
+ * describe the code when the PDG has been queried first, and the const
+ * methods of a scheduler are not thread-safe.
  */
 class Scheduler {
 
@@ -49,7 +58,7 @@ public:
   /*
    * Constructors
    */
-  Scheduler();
+  Scheduler(SchedulerVerbosity verbose = SchedulerVerbosity::Disabled);
 
   /*
    * Scheduler builder methods --- FIX
@@ -88,6 +97,18 @@ public:
   std::set<Instruction *> getOutgoingDependencesInParentBasicBlock(
       Instruction *const I,
       PDG *const ThePDG) const;
+
+protected:
+  SchedulerVerbosity verbose;
+
+private:
+  /*
+   * Indexes of the dependences within basic blocks of the PDGs queried.
+   */
+  mutable std::unordered_map<PDG *, std::shared_ptr<DependenceReachability>>
+      intraBlockReachabilities;
+
+  DependenceReachability &getIntraBlockReachability(PDG *const ThePDG) const;
 };
 
 /*
@@ -105,7 +126,8 @@ public:
    */
   LoopScheduler(LoopStructure *const LS,
                 DominatorSummary *const DS,
-                PDG *const ThePDG);
+                PDG *const ThePDG,
+                SchedulerVerbosity verbose = SchedulerVerbosity::Disabled);
 
   /*
    * Getter methods
@@ -132,6 +154,11 @@ public:
    */
 
   /*
+   * Move instructions out of all the blocks of the loop prologue
+   * in a single invocation (bottom-up). The dependences within a
+   * block are computed once per block, and the moves and clones
+   * of a block are performed and remapped together.
+   *
    * FIX --- This method performs the mechanism, but does
    * not give the user an option to decide whether or not
    * the prologue should be shrunk --- want to separate
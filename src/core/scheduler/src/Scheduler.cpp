@@ -35,7 +35,7 @@ namespace arcana::noelle {
  * ------------------------------------------------------------------
  */
 
-Scheduler::Scheduler() {
+Scheduler::Scheduler(SchedulerVerbosity verbose) : verbose{ verbose } {
   return;
 }
 
@@ -43,7 +43,7 @@ LoopScheduler Scheduler::getNewLoopScheduler(LoopStructure *const LS,
                                              DominatorSummary *const DS,
                                              PDG *const ThePDG) const {
 
-  return LoopScheduler(LS, DS, ThePDG);
+  return LoopScheduler(LS, DS, ThePDG, this->verbose);
 }
 
 /*
@@ -79,8 +79,10 @@ bool Scheduler::canMoveAnyInstOutOfBasicBlock(BasicBlock *const Block) const {
    *    - TODO : Relax this constraint
    */
 
-  errs() << "Scheduler: canMoveAnyInstOutOfBasicBlock --- @Block: " << *Block
-         << "\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "Scheduler: canMoveAnyInstOutOfBasicBlock --- @Block: " << *Block
+           << "\n";
+  }
 
   /*
    * <Constraint 1.>
@@ -89,7 +91,9 @@ bool Scheduler::canMoveAnyInstOutOfBasicBlock(BasicBlock *const Block) const {
 
   if (!(isa<BranchInst>(BlockTerminator))) {
 
-    errs() << "Scheduler:     No! @Block terminator is not a branch\n";
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs() << "Scheduler:     No! @Block terminator is not a branch\n";
+    }
     return false;
   }
 
@@ -102,14 +106,18 @@ bool Scheduler::canMoveAnyInstOutOfBasicBlock(BasicBlock *const Block) const {
 
     if (!SinglePred) {
 
-      errs()
-          << "Scheduler:     No! A successor does not have a single predecessor == @Block\n";
+      if (this->verbose >= SchedulerVerbosity::Maximal) {
+        errs()
+            << "Scheduler:     No! A successor does not have a single predecessor == @Block\n";
+      }
       return false;
     }
   }
 
-  errs() << "Scheduler:     Yes!\n"
-         << "Scheduler:     Success for canMoveAnyInstOutOfBasicBlock...\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "Scheduler:     Yes!\n"
+           << "Scheduler:     Success for canMoveAnyInstOutOfBasicBlock...\n";
+  }
 
   return true;
 }
@@ -119,9 +127,10 @@ std::set<Instruction *> Scheduler::getAllInstsMoveableOutOfBasicBlock(
     PDG *const ThePDG,
     ScheduleDirection Direction) const {
 
-  errs()
-      << "Scheduler: getAllInstsMoveableOutOfBasicBlock --- @Block: " << *Block
-      << "\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "Scheduler: getAllInstsMoveableOutOfBasicBlock --- @Block: "
+           << *Block << "\n";
+  }
 
   auto Moves = std::set<Instruction *>();
 
@@ -130,131 +139,72 @@ std::set<Instruction *> Scheduler::getAllInstsMoveableOutOfBasicBlock(
    */
   if (Direction != ScheduleDirection::Down) {
 
-    errs()
-        << "Scheduler:     No instructions --- Direction to move is not down!\n"
-        << *Block << "\n";
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs()
+          << "Scheduler:     No instructions --- Direction to move is not down!\n"
+          << *Block << "\n";
+    }
     return Moves;
   }
 
   /*
    * <Constraint 2. --- Context = ENTIRE CFG>
    */
-  errs() << "Scheduler:     Checking the block ...\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "Scheduler:     Checking the block ...\n";
+  }
 
   if (!(this->canMoveAnyInstOutOfBasicBlock(Block))) {
 
-    errs() << "Scheduler:     No instructions --- Block can't be scheduled!\n"
-           << *Block << "\n";
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs() << "Scheduler:     No instructions --- Block can't be scheduled!\n"
+             << *Block << "\n";
+    }
     return Moves;
   }
 
   /*
    * Perform the following algorithm:
    *
-   * for I in all instructions of @Block (starting at the terminator):
-   *    a. If I cannot be moved, add to Keeps set
-   *    b. Iterate over outgoing dependences of I. If any
-   *       dependence is a member of the Keeps set or not part
-   *       of @Block add I to Keeps and continue. Otherwise,
-   *       add I to Moves set and continue.
+   * 1. Fetch the memory and register dependences between the
+   *    instructions of @Block (indexed once per PDG)
+   * 2. Keep every instruction that cannot be moved (PHIs and the
+   *    terminator) and every instruction that transitively reaches
+   *    one of them through the dependences of step 1
+   * 3. Move the rest
    *
-   * NOTE --- this algorithm ignores possible cycles that arise
-   * from alias analysis --- because this is in the context of a
-   * single basic block, cyclic dependencies can be ignored
+   * Cycles of dependences within @Block are handled by step 2 as
+   * well: an instruction of a cycle that reaches a kept instruction
+   * makes the whole cycle kept
    */
+  auto &Reachability = this->getIntraBlockReachability(ThePDG);
 
-  /*
-   * Set up worklist --- reverse instruction iteration
-   */
-  std::queue<Instruction *> WorkList;
   std::set<Instruction *> Keeps;
-
-  for (auto IIT = Block->rbegin(); IIT != Block->rend(); ++IIT) {
-
-    Instruction &I = *IIT;
-    WorkList.push(&I);
-  }
-
-  /*
-   * Iterate through the worklist, get outgoing dependences
-   * of each instruction in the worklist and determine whether
-   * the instructions should be kept or moved
-   *
-   * Context = @Block
-   */
-  errs() << "Scheduler:     Now the worklist...\n";
-
-  while (!WorkList.empty()) {
-
-    /*
-     * Set up the next instruction
-     */
-    Instruction *Next = WorkList.front();
-    WorkList.pop();
-
-    errs() << "Scheduler:       Next: " << *Next << "\n";
-
-    /*
-     * Check if the instruction can be moved, if not
-     * add to the Keeps set and continue
-     */
-    if (!(this->canMoveInstOutOfBasicBlock(Next))) {
-
-      errs() << "Scheduler:         Keep --- Can't move Next!\n";
-
-      Keeps.insert(Next);
+  for (auto &I : *Block) {
+    if (this->canMoveInstOutOfBasicBlock(&I)) {
       continue;
     }
-
-    /*
-     * Get the outgoing dependence instructions that reside in @Block
-     */
-    errs() << "Scheduler:       Now the dependences...\n";
-
-    auto Outgoing =
-        this->getOutgoingDependencesInParentBasicBlock(Next, ThePDG);
-
-    /*
-     * Filter the dependences, determine status for Next
-     */
-    bool ShouldKeep = false;
-    for (auto D : Outgoing) {
-
-      errs() << "         D: " << *D << "\n";
-
-      /*
-       * Check if the dependence can be moved or belongs
-       * to the Keeps set --- Next must be kept in this
-       * case
-       */
-      if (false || !(this->canMoveInstOutOfBasicBlock(D))
-          || Keeps.find(D) != Keeps.end()) {
-
-        ShouldKeep |= true;
-        break;
-      }
+    Keeps.insert(&I);
+    for (auto V : Reachability.getBackwardSlice(&I)) {
+      Keeps.insert(cast<Instruction>(V));
     }
+  }
 
-    if (ShouldKeep) {
-
-      errs() << "Scheduler:       Keep --- Dependence(s) can't be moved!\n";
-      Keeps.insert(Next);
-
-    } else {
-
-      errs() << "Scheduler:       Move!\n";
-      Moves.insert(Next);
+  for (auto &I : *Block) {
+    if (Keeps.find(&I) == Keeps.end()) {
+      Moves.insert(&I);
     }
   }
 
   /*
    * Debugging
    */
-  errs() << "Scheduler: getAllInstsMoveableOutOfBasicBlock --- All moves ("
-         << Moves.size() << "): \n";
-
-  for (auto Move : Moves) {
-    errs() << "Scheduler:   " << *Move << "\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "Scheduler: getAllInstsMoveableOutOfBasicBlock --- All moves ("
+           << Moves.size() << "): \n";
+    for (auto Move : Moves) {
+      errs() << "Scheduler:   " << *Move << "\n";
+    }
   }
 
   return Moves;
@@ -271,19 +221,25 @@ bool Scheduler::canMoveInstOutOfBasicBlock(Instruction *const I) const {
    * @I can only be moved if it is NOT a PHINode or a terminator
    */
 
-  errs() << "Scheduler: canMoveInstOutOfBasicBlock --- @I: " << *I << "\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "Scheduler: canMoveInstOutOfBasicBlock --- @I: " << *I << "\n";
+  }
 
   /*
    * <Constraint>
    */
   if (false || (isa<PHINode>(I)) || (I->isTerminator())) {
 
-    errs() << "Scheduler:     No! @I is a PHI or terminator\n";
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs() << "Scheduler:     No! @I is a PHI or terminator\n";
+    }
     return false;
   }
 
-  errs() << "Scheduler:     Yes!\n"
-         << "Scheduler:     Success for canMoveInstOutOfBasicBlock...\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "Scheduler:     Yes!\n"
+           << "Scheduler:     Success for canMoveInstOutOfBasicBlock...\n";
+  }
 
   return true;
 }
@@ -317,16 +273,20 @@ std::set<Instruction *> Scheduler::getAllInstsToMoveForSpecifiedInst(
 
   auto Requirements = std::set<Instruction *>();
 
-  errs()
-      << "Scheduler: getAllInstsToMoveForSpecifiedInst --- @I: " << *I << "\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "Scheduler: getAllInstsToMoveForSpecifiedInst --- @I: " << *I
+           << "\n";
+  }
 
   /*
    * <Constraint 1.>
    */
   if (Direction != ScheduleDirection::Down) {
 
-    errs()
-        << "Scheduler:     Can't get requirements --- Direction to move is not down!\n";
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs()
+          << "Scheduler:     Can't get requirements --- Direction to move is not down!\n";
+    }
     return Requirements;
   }
 
@@ -335,61 +295,53 @@ std::set<Instruction *> Scheduler::getAllInstsToMoveForSpecifiedInst(
    */
   if (!(this->canMoveInstOutOfBasicBlock(I))) {
 
-    errs() << "Scheduler:     Can't get requirements --- @I can't be moved!\n";
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs()
+          << "Scheduler:     Can't get requirements --- @I can't be moved!\n";
+    }
     return Requirements;
   }
 
   /*
-   * Execute the following:
-   *   1. Iterate through dependences of the next instruction in
-   *      the worklist, adding to the Requirements set when necessary,
-   *   2. Add outgoing dependences to the worklist according to
-   *      Scheduler::getOutgoingDependencesInParentBasicBlock
+   * Fetch the memory and register dependences between the instructions of
+   * @I's parent basic block (the same ones considered by
+   * Scheduler::getOutgoingDependencesInParentBasicBlock)
    */
-  std::queue<Instruction *> WorkList;
-  WorkList.push(I);
-  Requirements.insert(I);
+  auto &Reachability = this->getIntraBlockReachability(ThePDG);
 
-  errs() << "Scheduler:     Now the dependences...\n";
-
-  while (!WorkList.empty()) {
+  /*
+   * Every instruction of the block that transitively depends on @I must be
+   * moved as well
+   */
+  Requirements.insert(I);
 
-    /*
-     * Get the next instruction
-     */
-    Instruction *Next = WorkList.front();
-    WorkList.pop();
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "Scheduler:     Now the dependences...\n";
+  }
 
-    errs() << "Scheduler:     Next: " << *Next << "\n";
+  for (auto V : Reachability.getForwardSlice(I)) {
+    auto D = cast<Instruction>(V);
+    if (D == I) {
+      continue;
+    }
 
-    /*
-     * Get the outgoing dependence instructions
-     */
-    auto Outgoing =
-        this->getOutgoingDependencesInParentBasicBlock(Next, ThePDG);
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs() << "Scheduler:       D: " << *D << "\n";
+    }
 
     /*
-     * Filter the dependences
+     * If the instruction can't be moved abort the computation
      */
-    for (auto D : Outgoing) {
-
-      errs() << "Scheduler:       D: " << *D << "\n";
-
-      /*
-       * If the instruction can't be moved abort the computation
-       */
-      if (!(this->canMoveInstOutOfBasicBlock(D))) {
+    if (!(this->canMoveInstOutOfBasicBlock(D))) {
 
+      if (this->verbose >= SchedulerVerbosity::Maximal) {
         errs()
             << "Scheduler:         Can't get requirements --- A dependence can't be moved!\n";
-        return std::set<Instruction *>();
       }
-
-      /*
-       * Add back worklist
-       */
-      WorkList.push(D);
+      return std::set<Instruction *>();
     }
+
+    Requirements.insert(D);
   }
 
   return Requirements;
@@ -425,12 +377,14 @@ bool Scheduler::isControlEquivalent(BasicBlock *const First,
   /*
    * Debugging
    */
-  errs()
-      << "Scheduler: First --- \n"
-      << *First << "\n"
-      << "Scheduler: Second --- \n"
-      << *Second << "\n"
-      << "Scheduler: IsControlEquivalent --- " << IsControlEquivalent << "\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs()
+        << "Scheduler: First --- \n"
+        << *First << "\n"
+        << "Scheduler: Second --- \n"
+        << *Second << "\n"
+        << "Scheduler: IsControlEquivalent --- " << IsControlEquivalent << "\n";
+  }
 
   return IsControlEquivalent;
 }
@@ -529,6 +483,44 @@ std::set<Instruction *> Scheduler::getOutgoingDependencesInParentBasicBlock(
   return OutgoingDependences;
 }
 
+/*
+ * ------------------------------------------------------------------
+ * PRIVATE --- Analysis Methods
+ * ------------------------------------------------------------------
+ */
+DependenceReachability &Scheduler::getIntraBlockReachability(
+    PDG *const ThePDG) const {
+
+  /*
+   * Check if the dependences of @ThePDG have been indexed already
+   */
+  auto &Reachability = this->intraBlockReachabilities[ThePDG];
+  if (Reachability != nullptr) {
+    return *Reachability;
+  }
+
+  /*
+   * Index the memory and register dependences between instructions of the
+   * same basic block, for all basic blocks at once: paths never leave a
+   * block, so the index of a block is not affected by the other ones
+   */
+  auto IsInstruction = [](Value *V) -> bool { return isa<Instruction>(V); };
+  auto AreInTheSameBlock = [](Value *From, Value *To) -> bool {
+    return cast<Instruction>(From)->getParent()
+           == cast<Instruction>(To)->getParent();
+  };
+  Reachability = std::make_shared<DependenceReachability>(
+      ThePDG,
+      false, /* Control dependences */
+      true,  /* Memory dependences */
+      true,  /* Register dependences */
+      true,  /* External nodes */
+      IsInstruction,
+      AreInTheSameBlock);
+
+  return *Reachability;
+}
+
 /*
  * ------------------------------------------------------------------
  * *** LOOP SCHEDULER ***
@@ -542,7 +534,9 @@ std::set<Instruction *> Scheduler::getOutgoingDependencesInParentBasicBlock(
  */
 LoopScheduler::LoopScheduler(LoopStructure *const LS,
                              DominatorSummary *const DS,
-                             PDG *const ThePDG) {
+                             PDG *const ThePDG,
+                             SchedulerVerbosity verbose)
+  : Scheduler(verbose) {
 
   /*
    * Save passed analysis state
@@ -582,18 +576,24 @@ bool LoopScheduler::canMoveAnyInstOutOfLoop(void) const {
    * 2. Nothing else yet
    */
 
-  errs() << "LoopScheduler:   canMoveAnyInstOutOfLoop\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "LoopScheduler:   canMoveAnyInstOutOfLoop\n";
+  }
 
   /*
    * <Constraint 1.>
    */
   if (!(this->Body.size())) {
 
-    errs() << "LoopScheduler:     No! Loop body is empty\n";
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs() << "LoopScheduler:     No! Loop body is empty\n";
+    }
     return false;
   }
 
-  errs() << "LoopScheduler:     Yes! Loop can be scheduled\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "LoopScheduler:     Yes! Loop can be scheduled\n";
+  }
   return true;
 }
 
@@ -609,11 +609,15 @@ bool LoopScheduler::canQuicklyHandleLoop(void) const {
 
   if (this->Prologue.size() > this->MaxPrologueSizeToHandle) {
 
-    errs() << "LoopScheduler:     No! Too many blocks in the loop prologue\n";
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs() << "LoopScheduler:     No! Too many blocks in the loop prologue\n";
+    }
     return false;
   }
 
-  errs() << "LoopScheduler:     Yes! Loop can be quickly handled\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "LoopScheduler:     Yes! Loop can be quickly handled\n";
+  }
   return true;
 }
 
@@ -631,13 +635,17 @@ bool LoopScheduler::shrinkLoopPrologue(void) {
    */
   if (!(this->canMoveAnyInstOutOfLoop())) {
 
-    errs() << "LoopScheduler:     Abort! Can't schedule the loop\n";
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs() << "LoopScheduler:     Abort! Can't schedule the loop\n";
+    }
     return Modified;
   }
 
   if (!(this->canQuicklyHandleLoop())) {
 
-    errs() << "LoopScheduler:     Can't seem to quickly handle this loop\n";
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs() << "LoopScheduler:     Can't seem to quickly handle this loop\n";
+    }
 
     /*
      * Attempt to merge prologue blocks to handle the issue, return
@@ -651,16 +659,20 @@ bool LoopScheduler::shrinkLoopPrologue(void) {
   }
 
   /*
-   * Set up a worklist --- try shrinking the prologue --- if
-   * there is any modification to any block, return immediately
-   * (let noelle-enable start a new invocation to avoid the
-   * headaches of invalidated noelle analysis info) --- INEFFICIENT
+   * Set up a worklist --- shrink all the blocks of the prologue
+   * in a single invocation
    *
-   * Iteration is bottom-up --- FIX (modified inorder traversal
-   * is more efficient but unwise given the current setup)
+   * Iteration is bottom-up, so a block is shrunk only after its
+   * successors in the prologue. Moving instructions down neither
+   * changes the CFG nor the dependences between the instructions
+   * that are still in the blocks to process, so the prologue, the
+   * dominator summary, and the PDG stay valid across blocks.
+   * Instructions moved into an already processed block are left
+   * there until the next invocation.
    */
   std::queue<BasicBlock *> WorkList;
   std::set<BasicBlock *> ProcessedBlocks, CannotProcessBlocks;
+  uint32_t ShrunkBlocks = 0;
 
   /*
    * Set up
@@ -695,7 +707,9 @@ bool LoopScheduler::shrinkLoopPrologue(void) {
     BasicBlock *Next = WorkList.front();
     WorkList.pop();
 
-    errs() << "LoopScheduler:       Next: " << *Next << "\n";
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs() << "LoopScheduler:       Next: " << *Next << "\n";
+    }
 
     /*
      * <Constraint 1.>
@@ -746,18 +760,24 @@ bool LoopScheduler::shrinkLoopPrologue(void) {
     }
 
     /*
-     * If there was a move, return immediately --- otherwise
-     * add Next to the ProcessedBlocks set and continue
+     * Shrink Next and continue with its predecessors
      */
-    Modified |= this->shrinkPrologueBasicBlock(Next);
-
-    if (Modified) {
-      return Modified;
+    if (this->shrinkPrologueBasicBlock(Next)) {
+      Modified = true;
+      ShrunkBlocks++;
     }
 
     ProcessedBlocks.insert(Next);
   }
 
+  if (Modified && (this->verbose >= SchedulerVerbosity::Minimal)) {
+    errs() << "LoopScheduler: Shrunk " << ShrunkBlocks << " of "
+           << this->Prologue.size() << " prologue blocks\n";
+  }
+  if (Modified && (this->verbose >= SchedulerVerbosity::Maximal)) {
+    this->Dump();
+  }
+
   return Modified;
 }
 
@@ -924,7 +944,9 @@ bool LoopScheduler::mergePrologueBasicBlocks(void) {
 
   bool Modified = false;
 
-  errs() << "LoopScheduler:       Attempting to merge prologue blocks\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "LoopScheduler:       Attempting to merge prologue blocks\n";
+  }
 
   for (auto Block : Prologue) {
     Modified |= llvm::MergeBlockIntoPredecessor(Block);
@@ -937,7 +959,8 @@ bool LoopScheduler::shrinkPrologueBasicBlock(BasicBlock *Block) {
   auto Modified = false;
 
   /*
-   * Find all instructions to move from @Block --- FIX --- VERY INEFFIEICNT
+   * Find all instructions to move from @Block (dependences within @Block
+   * are computed once)
    */
   auto InstructionsToMove =
       this->getAllInstsMoveableOutOfBasicBlock(Block, this->ThePDG);
@@ -950,7 +973,8 @@ bool LoopScheduler::shrinkPrologueBasicBlock(BasicBlock *Block) {
   }
 
   /*
-   * Get correct order for all possible instructions to move --- Horrible
+   * Order the instructions to move bottom-up, so moving each one before the
+   * first non-PHI of the successor preserves their original order
    */
   std::vector<Instruction *> OrderedInstructionsToMove;
 
@@ -964,14 +988,17 @@ bool LoopScheduler::shrinkPrologueBasicBlock(BasicBlock *Block) {
   }
 
   /*
-   * Perform the move or clone --- Terrible
+   * Perform the moves and clones of the whole block
    */
   ValueToValueMapTy OriginalToClones;
   std::set<Instruction *> Clones;
 
   for (auto Move : OrderedInstructionsToMove) {
 
-    errs() << "LoopScheduler:       Next instruction to move: " << Move << "\n";
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs() << "LoopScheduler:       Next instruction to move: " << *Move
+             << "\n";
+    }
 
     this->moveInstOutOfPrologueBasicBlock(Move, OriginalToClones, Clones);
 
@@ -979,15 +1006,10 @@ bool LoopScheduler::shrinkPrologueBasicBlock(BasicBlock *Block) {
   }
 
   /*
-   * Remap all cloned instructions if necessary --- Attrocious
+   * Remap the operands of all clones of the block at once
    */
   this->remapClonedInstructions(OriginalToClones, Clones);
 
-  if (Modified) {
-    this->Dump();
-    errs() << *(this->TheLoop->getFunction()) << "\n";
-  }
-
   return Modified;
 }
 
@@ -1044,16 +1066,20 @@ bool LoopScheduler::moveInstOutOfPrologueBasicBlock(
 
   BasicBlock *Parent = I->getParent();
 
-  errs() << "LoopScheduler:   moveInstOutOfPrologueBasicBlock --- @I: " << *I
-         << "\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "LoopScheduler:   moveInstOutOfPrologueBasicBlock --- @I: " << *I
+           << "\n";
+  }
 
   /*
    * CASE 1
    */
   if (Direction != ScheduleDirection::Down) {
 
-    errs()
-        << "LoopScheduler:     No instructions --- Direction to move is not down!\n";
+    if (this->verbose >= SchedulerVerbosity::Maximal) {
+      errs()
+          << "LoopScheduler:     No instructions --- Direction to move is not down!\n";
+    }
     return false;
   }
 
@@ -1130,7 +1156,9 @@ bool LoopScheduler::moveInstIntoSuccessor(Instruction *I,
   /*
    * Return success
    */
-  errs() << "LoopScheduler:     Success! Moved @I to successor\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "LoopScheduler:     Success! Moved @I to successor\n";
+  }
   return true;
 }
 
@@ -1162,7 +1190,9 @@ bool LoopScheduler::cloneInstIntoSuccessor(Instruction *I,
   /*
    * Return success
    */
-  errs() << "LoopScheduler:     Success! Cloned @I to successor\n";
+  if (this->verbose >= SchedulerVerbosity::Maximal) {
+    errs() << "LoopScheduler:     Success! Cloned @I to successor\n";
+  }
   return true;
 }
 
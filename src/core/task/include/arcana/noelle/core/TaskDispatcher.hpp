@@ -0,0 +1,104 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_TASK_TASKDISPATCHER_H_
+#define NOELLE_SRC_CORE_TASK_TASKDISPATCHER_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/Task.hpp"
+#include "arcana/noelle/core/LoopTransformationsOptions.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Emit calls to the task runtime of NOELLE (library NoelleTasks).
+ *
+ * Tasks dispatched with dispatchTasks must have the signature
+ *   void (i8 *environment, i64 instanceID, i64 numberOfInstances, i64 chunk)
+ * Bodies of iteration ranges dispatched with dispatchRange must have the
+ * signature
+ *   void (i8 *environment, i64 begin, i64 end, i64 workerID)
+ */
+class TaskDispatcher {
+public:
+  enum Schedule { STATIC = 0, DYNAMIC = 1 };
+
+  TaskDispatcher(Module &M);
+
+  FunctionType *getTaskSignature(void) const;
+
+  FunctionType *getRangeBodySignature(void) const;
+
+  /*
+   * Run @numberOfInstances instances of @task and wait for them.
+   * The call returns the number of instances executed.
+   */
+  CallInst *dispatchTasks(IRBuilder<> &builder,
+                          Task *task,
+                          Value *environment,
+                          Value *numberOfInstances,
+                          Value *chunkSize);
+
+  /*
+   * Run as many instances of @task as the cores allowed for the loop, using
+   * the chunk size of the loop.
+   */
+  CallInst *dispatchTasks(IRBuilder<> &builder,
+                          Task *task,
+                          Value *environment,
+                          LoopTransformationsManager &loopOptions);
+
+  /*
+   * Run the iterations [@begin, @end) split in chunks of @chunkSize
+   * iterations and wait for them.
+   * The call returns the number of sub-ranges executed.
+   */
+  CallInst *dispatchRange(IRBuilder<> &builder,
+                          Function *body,
+                          Value *environment,
+                          Value *begin,
+                          Value *end,
+                          Value *chunkSize,
+                          Schedule schedule);
+
+  /*
+   * The call returns the number of threads of the runtime.
+   */
+  CallInst *getNumberOfWorkers(IRBuilder<> &builder);
+
+private:
+  Module &M;
+  FunctionType *taskSignature;
+  FunctionType *rangeBodySignature;
+  Function *dispatchTasksFunction;
+  Function *dispatchRangeFunction;
+  Function *getNumberOfWorkersFunction;
+
+  Function *getRuntimeFunction(const std::string &name, FunctionType *type);
+
+  Value *castToInt64(IRBuilder<> &builder, Value *v);
+
+  Value *castToVoidPointer(IRBuilder<> &builder, Value *v);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_TASK_TASKDISPATCHER_H_
@@ -0,0 +1,210 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/TaskDispatcher.hpp"
+
+namespace arcana::noelle {
+
+TaskDispatcher::TaskDispatcher(Module &M) : M{ M } {
+
+  /*
+   * Fetch the types.
+   */
+  auto &cxt = M.getContext();
+  auto int64Type = IntegerType::get(cxt, 64);
+  auto voidPointerType = PointerType::getUnqual(IntegerType::get(cxt, 8));
+  auto voidType = Type::getVoidTy(cxt);
+
+  /*
+   * Signatures of the functions invoked by the runtime.
+   */
+  this->taskSignature = FunctionType::get(
+      voidType,
+      ArrayRef<Type *>({ voidPointerType, int64Type, int64Type, int64Type }),
+      false);
+  this->rangeBodySignature = this->taskSignature;
+
+  /*
+   * Declare the APIs of the runtime.
+   */
+  auto dispatchTasksType = FunctionType::get(int64Type,
+                                             ArrayRef<Type *>({
+                                                 this->taskSignature
+                                                     ->getPointerTo(),
+                                                 voidPointerType,
+                                                 int64Type,
+                                                 int64Type,
+                                             }),
+                                             false);
+  this->dispatchTasksFunction =
+      this->getRuntimeFunction("NOELLE_dispatchTasks", dispatchTasksType);
+
+  auto dispatchRangeType = FunctionType::get(int64Type,
+                                             ArrayRef<Type *>({
+                                                 this->rangeBodySignature
+                                                     ->getPointerTo(),
+                                                 voidPointerType,
+                                                 int64Type,
+                                                 int64Type,
+                                                 int64Type,
+                                                 int64Type,
+                                             }),
+                                             false);
+  this->dispatchRangeFunction =
+      this->getRuntimeFunction("NOELLE_dispatchRange", dispatchRangeType);
+
+  auto getNumberOfWorkersType = FunctionType::get(int64Type, false);
+  this->getNumberOfWorkersFunction =
+      this->getRuntimeFunction("NOELLE_getNumberOfWorkers",
+                               getNumberOfWorkersType);
+
+  return;
+}
+
+FunctionType *TaskDispatcher::getTaskSignature(void) const {
+  return this->taskSignature;
+}
+
+FunctionType *TaskDispatcher::getRangeBodySignature(void) const {
+  return this->rangeBodySignature;
+}
+
+CallInst *TaskDispatcher::dispatchTasks(IRBuilder<> &builder,
+                                        Task *task,
+                                        Value *environment,
+                                        Value *numberOfInstances,
+                                        Value *chunkSize) {
+  assert(task != nullptr);
+
+  /*
+   * Check the signature of the task.
+   */
+  auto taskBody = task->getTaskBody();
+  if (taskBody->getFunctionType() != this->taskSignature) {
+    errs() << "TaskDispatcher: ERROR = task " << taskBody->getName()
+           << " does not have the signature expected by the runtime\n";
+    abort();
+  }
+
+  /*
+   * Emit the call.
+   */
+  auto call = builder.CreateCall(this->dispatchTasksFunction,
+                                 ArrayRef<Value *>({
+                                     taskBody,
+                                     this->castToVoidPointer(builder,
+                                                             environment),
+                                     this->castToInt64(builder,
+                                                       numberOfInstances),
+                                     this->castToInt64(builder, chunkSize),
+                                 }));
+
+  return call;
+}
+
+CallInst *TaskDispatcher::dispatchTasks(
+    IRBuilder<> &builder,
+    Task *task,
+    Value *environment,
+    LoopTransformationsManager &loopOptions) {
+
+  /*
+   * Fetch the parallelization options of the loop.
+   */
+  auto int64Type = IntegerType::get(this->M.getContext(), 64);
+  auto numberOfInstances =
+      ConstantInt::get(int64Type, loopOptions.getMaximumNumberOfCores());
+  auto chunkSize = ConstantInt::get(int64Type, loopOptions.getChunkSize());
+
+  return this->dispatchTasks(builder,
+                             task,
+                             environment,
+                             numberOfInstances,
+                             chunkSize);
+}
+
+CallInst *TaskDispatcher::dispatchRange(IRBuilder<> &builder,
+                                        Function *body,
+                                        Value *environment,
+                                        Value *begin,
+                                        Value *end,
+                                        Value *chunkSize,
+                                        Schedule schedule) {
+  assert(body != nullptr);
+
+  /*
+   * Check the signature of the body.
+   */
+  if (body->getFunctionType() != this->rangeBodySignature) {
+    errs() << "TaskDispatcher: ERROR = function " << body->getName()
+           << " does not have the signature expected by the runtime\n";
+    abort();
+  }
+
+  /*
+   * Emit the call.
+   */
+  auto int64Type = IntegerType::get(this->M.getContext(), 64);
+  auto call = builder.CreateCall(
+      this->dispatchRangeFunction,
+      ArrayRef<Value *>({
+          body,
+          this->castToVoidPointer(builder, environment),
+          this->castToInt64(builder, begin),
+          this->castToInt64(builder, end),
+          this->castToInt64(builder, chunkSize),
+          ConstantInt::get(int64Type, schedule),
+      }));
+
+  return call;
+}
+
+CallInst *TaskDispatcher::getNumberOfWorkers(IRBuilder<> &builder) {
+  return builder.CreateCall(this->getNumberOfWorkersFunction);
+}
+
+Function *TaskDispatcher::getRuntimeFunction(const std::string &name,
+                                             FunctionType *type) {
+  auto functionCallee = this->M.getOrInsertFunction(name, type);
+  auto f = dyn_cast<Function>(functionCallee.getCallee());
+  if (f == nullptr) {
+    errs() << "TaskDispatcher: ERROR = " << name
+           << " is already declared with a different signature\n";
+    abort();
+  }
+
+  return f;
+}
+
+Value *TaskDispatcher::castToInt64(IRBuilder<> &builder, Value *v) {
+  auto int64Type = IntegerType::get(this->M.getContext(), 64);
+
+  return builder.CreateSExtOrTrunc(v, int64Type);
+}
+
+Value *TaskDispatcher::castToVoidPointer(IRBuilder<> &builder, Value *v) {
+  auto voidPointerType =
+      PointerType::getUnqual(IntegerType::get(this->M.getContext(), 8));
+
+  return builder.CreateBitCast(v, voidPointerType);
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,264 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*
+ * Runtime of the NOELLE loop profiler.
+ *
+ * The calls to the APIs below are injected by the LoopProfiler pass (see
+ * noelle-prof-loops).
+ * The profile is written when the program exits to the file specified by the
+ * environment variable NOELLE_LOOP_PROFILE_FILE (noelle_loops.prof by
+ * default) and it is embedded in the IR by noelle-meta-loop-prof-embed.
+ *
+ * The profiler assumes loops are executed by a single thread, like the
+ * counters injected by -pgo-instr-gen.
+ *
+ * Every call passes the address of a stack slot of the function that runs the
+ * loop, which identifies its frame. An invocation can stay active after its
+ * frame is gone (e.g., an exception unwound the frame without taking an exit
+ * of the loop). Because the stack grows down, the invocations of a loop that
+ * belong to frames below the current one are stale: they are discarded
+ * rather than being attributed to the current invocation.
+ */
+
+namespace {
+
+constexpr uint32_t numberOfBuckets = 65;
+
+struct ActiveInvocation {
+  uint64_t iterations;
+  uint64_t startCycles;
+  uintptr_t frame;
+};
+
+struct LoopStats {
+  bool executed = false;
+  uint64_t invocations = 0;
+  uint64_t iterations = 0;
+  uint64_t minIterations = UINT64_MAX;
+  uint64_t maxIterations = 0;
+  double iterationsSquaredSum = 0;
+  uint64_t cycles = 0;
+  double cyclesSquaredSum = 0;
+  uint64_t buckets[numberOfBuckets] = {};
+
+  /*
+   * Invocations that have not ended yet.
+   * There can be more than one because of recursion.
+   */
+  std::vector<ActiveInvocation> active;
+};
+
+std::vector<LoopStats> *loops = nullptr;
+
+uint64_t readCycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+#endif
+}
+
+uint32_t getBucketOfTripCount(uint64_t tripCount) {
+  uint32_t b = 0;
+  while (tripCount > 0) {
+    tripCount >>= 1;
+    b++;
+  }
+
+  return b;
+}
+
+void dumpProfile(void) {
+
+  /*
+   * Open the output file.
+   */
+  auto fileName = std::getenv("NOELLE_LOOP_PROFILE_FILE");
+  if (fileName == nullptr) {
+    fileName = (char *)"noelle_loops.prof";
+  }
+  auto f = std::fopen(fileName, "w");
+  if (f == nullptr) {
+    std::fprintf(stderr,
+                 "NOELLE loop profiler: cannot open \"%s\"\n",
+                 fileName);
+    return;
+  }
+
+  /*
+   * Dump the loops that have been executed.
+   */
+  std::fprintf(f,
+               "# ID INVOCATIONS ITERATIONS MIN_ITERATIONS MAX_ITERATIONS "
+               "ITERATIONS_SQUARED_SUM CYCLES CYCLES_SQUARED_SUM BUCKETS "
+               "[BUCKET:INVOCATIONS]*\n");
+  for (uint64_t loopID = 0; loopID < loops->size(); loopID++) {
+    auto &l = (*loops)[loopID];
+    if (!l.executed) {
+      continue;
+    }
+    uint32_t usedBuckets = 0;
+    for (auto b = 0u; b < numberOfBuckets; b++) {
+      if (l.buckets[b] > 0) {
+        usedBuckets++;
+      }
+    }
+    std::fprintf(f,
+                 "%lu %lu %lu %lu %lu %.17g %lu %.17g %u",
+                 (unsigned long)loopID,
+                 (unsigned long)l.invocations,
+                 (unsigned long)l.iterations,
+                 (unsigned long)(l.invocations > 0 ? l.minIterations : 0),
+                 (unsigned long)l.maxIterations,
+                 l.iterationsSquaredSum,
+                 (unsigned long)l.cycles,
+                 l.cyclesSquaredSum,
+                 usedBuckets);
+    for (auto b = 0u; b < numberOfBuckets; b++) {
+      if (l.buckets[b] > 0) {
+        std::fprintf(f, " %u:%lu", b, (unsigned long)l.buckets[b]);
+      }
+    }
+    std::fprintf(f, "\n");
+  }
+  std::fclose(f);
+
+  return;
+}
+
+/*
+ * Discard the invocations of frames that are not alive anymore.
+ * If @includeFrame is true, the invocation of the current frame is discarded
+ * as well, because the frame is starting a new invocation of the loop.
+ */
+void discardStaleInvocations(LoopStats &l, uintptr_t frame, bool includeFrame) {
+  while (!l.active.empty()) {
+    auto activeFrame = l.active.back().frame;
+    if ((activeFrame > frame) || ((activeFrame == frame) && !includeFrame)) {
+      break;
+    }
+    l.active.pop_back();
+  }
+
+  return;
+}
+
+LoopStats &getLoop(uint64_t loopID) {
+
+  /*
+   * Allocate the table the first time a loop is executed.
+   * The table is never freed because loops can run after it has been dumped
+   * (e.g., within the destructors of global objects).
+   */
+  if (loops == nullptr) {
+    loops = new std::vector<LoopStats>();
+    std::atexit(dumpProfile);
+  }
+
+  /*
+   * Loop IDs are dense, so the table grows up to the largest ID.
+   */
+  if (loopID >= loops->size()) {
+    loops->resize(loopID + 1);
+  }
+  auto &l = (*loops)[loopID];
+  l.executed = true;
+
+  return l;
+}
+
+} // namespace
+
+extern "C" {
+
+void NOELLE_loopInvocationBegin(uint64_t loopID, void *frame) {
+  auto &l = getLoop(loopID);
+  auto f = reinterpret_cast<uintptr_t>(frame);
+  discardStaleInvocations(l, f, true);
+  l.active.push_back(ActiveInvocation{ 0, readCycles(), f });
+
+  return;
+}
+
+void NOELLE_loopIterationBegin(uint64_t loopID, void *frame) {
+  auto &l = getLoop(loopID);
+  auto f = reinterpret_cast<uintptr_t>(frame);
+  discardStaleInvocations(l, f, false);
+  if (l.active.empty() || (l.active.back().frame != f)) {
+    return;
+  }
+  l.active.back().iterations++;
+
+  return;
+}
+
+void NOELLE_loopInvocationEnd(uint64_t loopID, void *frame) {
+  auto endCycles = readCycles();
+  auto &l = getLoop(loopID);
+  auto f = reinterpret_cast<uintptr_t>(frame);
+
+  /*
+   * The end of an invocation can be reached without starting one (e.g., a
+   * landing pad reached from outside the loop).
+   */
+  discardStaleInvocations(l, f, false);
+  if (l.active.empty() || (l.active.back().frame != f)) {
+    return;
+  }
+
+  /*
+   * Fetch the invocation that just ended.
+   */
+  auto invocation = l.active.back();
+  l.active.pop_back();
+  auto iterations = invocation.iterations;
+  auto cycles = endCycles - invocation.startCycles;
+
+  /*
+   * Update the statistics.
+   */
+  l.invocations++;
+  l.iterations += iterations;
+  if (iterations < l.minIterations) {
+    l.minIterations = iterations;
+  }
+  if (iterations > l.maxIterations) {
+    l.maxIterations = iterations;
+  }
+  l.iterationsSquaredSum += ((double)iterations) * ((double)iterations);
+  l.cycles += cycles;
+  l.cyclesSquaredSum += ((double)cycles) * ((double)cycles);
+  l.buckets[getBucketOfTripCount(iterations)]++;
+
+  return;
+}
+}
@@ -0,0 +1,457 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*
+ * Queues of the NOELLE runtime.
+ *
+ * There are two kinds of bounded, lock-free queues:
+ * - single-producer/single-consumer (SPSC) ring buffers of elements of any
+ *   size, with batched variants of push and pop;
+ * - multiple-producers/multiple-consumers (MPMC) queues of elements up to 8
+ *   bytes.
+ *
+ * Pushes wait while the queue is full and pops wait while the queue is empty.
+ * The indices written by producers and by consumers live in different cache
+ * lines, and each side caches the index of the other side to avoid touching
+ * the other cache line on every operation.
+ *
+ * Noelle::declareQueueRuntime declares these APIs in the IR and registers them
+ * in Noelle::queues.
+ */
+
+namespace {
+
+constexpr uint64_t cacheLineBytes = 64;
+
+void pause(uint64_t &spins) {
+  spins++;
+  if (spins < 1024) {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+    return;
+  }
+  std::this_thread::yield();
+
+  return;
+}
+
+uint64_t roundUpToPowerOfTwo(uint64_t value) {
+  uint64_t p = 2;
+  while (p < value) {
+    p <<= 1;
+  }
+
+  return p;
+}
+
+struct SPSCQueue {
+
+  /*
+   * Written by the producer.
+   */
+  alignas(cacheLineBytes) std::atomic<uint64_t> tail;
+  uint64_t cachedHead;
+
+  /*
+   * Written by the consumer.
+   */
+  alignas(cacheLineBytes) std::atomic<uint64_t> head;
+  uint64_t cachedTail;
+
+  /*
+   * Read-only after creation.
+   */
+  alignas(cacheLineBytes) uint8_t *buffer;
+  uint64_t capacity;
+  uint64_t mask;
+  uint64_t elementBytes;
+};
+
+struct MPMCCell {
+  std::atomic<uint64_t> sequence;
+  uint64_t data;
+};
+
+struct MPMCQueue {
+  alignas(cacheLineBytes) std::atomic<uint64_t> enqueuePosition;
+  alignas(cacheLineBytes) std::atomic<uint64_t> dequeuePosition;
+  alignas(cacheLineBytes) MPMCCell *cells;
+  uint64_t mask;
+  uint64_t elementBytes;
+};
+
+/*
+ * Wait until there are at least @n free slots (or the queue has room for
+ * less than @n elements and it is not full).
+ * Return the number of free slots.
+ */
+uint64_t waitForFreeSlots(SPSCQueue *q, uint64_t tail, uint64_t n) {
+  auto freeSlots = q->capacity - (tail - q->cachedHead);
+  uint64_t spins = 0;
+  while (freeSlots < n) {
+    q->cachedHead = q->head.load(std::memory_order_acquire);
+    freeSlots = q->capacity - (tail - q->cachedHead);
+    if ((freeSlots >= n) || (freeSlots > 0 && n > 1)) {
+      break;
+    }
+    pause(spins);
+  }
+
+  return freeSlots;
+}
+
+/*
+ * Wait until there are at least @n elements (or there are less than @n
+ * elements and the queue is not empty).
+ * Return the number of elements available.
+ */
+uint64_t waitForElements(SPSCQueue *q, uint64_t head, uint64_t n) {
+  auto elements = q->cachedTail - head;
+  uint64_t spins = 0;
+  while (elements < n) {
+    q->cachedTail = q->tail.load(std::memory_order_acquire);
+    elements = q->cachedTail - head;
+    if ((elements >= n) || (elements > 0 && n > 1)) {
+      break;
+    }
+    pause(spins);
+  }
+
+  return elements;
+}
+
+template <typename T>
+void push(SPSCQueue *q, const T *value) {
+  auto tail = q->tail.load(std::memory_order_relaxed);
+  waitForFreeSlots(q, tail, 1);
+  auto slot = reinterpret_cast<T *>(q->buffer) + (tail & q->mask);
+  *slot = *value;
+  q->tail.store(tail + 1, std::memory_order_release);
+
+  return;
+}
+
+template <typename T>
+void pop(SPSCQueue *q, T *value) {
+  auto head = q->head.load(std::memory_order_relaxed);
+  waitForElements(q, head, 1);
+  auto slot = reinterpret_cast<T *>(q->buffer) + (head & q->mask);
+  *value = *slot;
+  q->head.store(head + 1, std::memory_order_release);
+
+  return;
+}
+
+/*
+ * Copy @n elements between the ring buffer (starting from the position
+ * @index) and @values.
+ */
+void copyElements(SPSCQueue *q,
+                  uint64_t index,
+                  uint8_t *values,
+                  uint64_t n,
+                  bool toBuffer) {
+  auto first = index & q->mask;
+  auto firstPart = std::min(n, q->capacity - first);
+  auto eb = q->elementBytes;
+  auto slot = q->buffer + (first * eb);
+  if (toBuffer) {
+    std::memcpy(slot, values, firstPart * eb);
+    std::memcpy(q->buffer, values + (firstPart * eb), (n - firstPart) * eb);
+  } else {
+    std::memcpy(values, slot, firstPart * eb);
+    std::memcpy(values + (firstPart * eb), q->buffer, (n - firstPart) * eb);
+  }
+
+  return;
+}
+
+template <typename T>
+void mpmcPush(MPMCQueue *q, const T *value) {
+  auto position = q->enqueuePosition.load(std::memory_order_relaxed);
+  MPMCCell *cell;
+  uint64_t spins = 0;
+  while (true) {
+    cell = &q->cells[position & q->mask];
+    auto sequence = cell->sequence.load(std::memory_order_acquire);
+    auto difference = (int64_t)sequence - (int64_t)position;
+    if (difference == 0) {
+      if (q->enqueuePosition.compare_exchange_weak(position,
+                                                   position + 1,
+                                                   std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+
+      /*
+       * The queue is full.
+       */
+      pause(spins);
+      position = q->enqueuePosition.load(std::memory_order_relaxed);
+    } else {
+      position = q->enqueuePosition.load(std::memory_order_relaxed);
+    }
+  }
+  std::memcpy(&cell->data, value, sizeof(T));
+  cell->sequence.store(position + 1, std::memory_order_release);
+
+  return;
+}
+
+template <typename T>
+void mpmcPop(MPMCQueue *q, T *value) {
+  auto position = q->dequeuePosition.load(std::memory_order_relaxed);
+  MPMCCell *cell;
+  uint64_t spins = 0;
+  while (true) {
+    cell = &q->cells[position & q->mask];
+    auto sequence = cell->sequence.load(std::memory_order_acquire);
+    auto difference = (int64_t)sequence - (int64_t)(position + 1);
+    if (difference == 0) {
+      if (q->dequeuePosition.compare_exchange_weak(position,
+                                                   position + 1,
+                                                   std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+
+      /*
+       * The queue is empty.
+       */
+      pause(spins);
+      position = q->dequeuePosition.load(std::memory_order_relaxed);
+    } else {
+      position = q->dequeuePosition.load(std::memory_order_relaxed);
+    }
+  }
+  std::memcpy(value, &cell->data, sizeof(T));
+  cell->sequence.store(position + q->mask + 1, std::memory_order_release);
+
+  return;
+}
+
+} // namespace
+
+extern "C" {
+
+/*
+ * ============================ SPSC queues ===================================
+ */
+
+void *NOELLE_queueCreate(uint64_t elementBytes, uint64_t capacity) {
+  auto q = new SPSCQueue();
+  q->capacity = roundUpToPowerOfTwo(capacity);
+  q->mask = q->capacity - 1;
+  q->elementBytes = elementBytes;
+  q->buffer = new (std::align_val_t(cacheLineBytes))
+      uint8_t[q->capacity * elementBytes];
+  q->tail.store(0);
+  q->cachedHead = 0;
+  q->head.store(0);
+  q->cachedTail = 0;
+
+  return q;
+}
+
+void NOELLE_queueDestroy(void *queue) {
+  auto q = static_cast<SPSCQueue *>(queue);
+  operator delete[](q->buffer, std::align_val_t(cacheLineBytes));
+  delete q;
+
+  return;
+}
+
+void NOELLE_queuePush8(void *queue, int8_t *value) {
+  push(static_cast<SPSCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_queuePush16(void *queue, int16_t *value) {
+  push(static_cast<SPSCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_queuePush32(void *queue, int32_t *value) {
+  push(static_cast<SPSCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_queuePush64(void *queue, int64_t *value) {
+  push(static_cast<SPSCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_queuePop8(void *queue, int8_t *value) {
+  pop(static_cast<SPSCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_queuePop16(void *queue, int16_t *value) {
+  pop(static_cast<SPSCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_queuePop32(void *queue, int32_t *value) {
+  pop(static_cast<SPSCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_queuePop64(void *queue, int64_t *value) {
+  pop(static_cast<SPSCQueue *>(queue), value);
+
+  return;
+}
+
+/*
+ * Push the @n elements stored in @values.
+ * Elements are published as soon as there is room for some of them.
+ */
+void NOELLE_queuePushBatch(void *queue, void *values, uint64_t n) {
+  auto q = static_cast<SPSCQueue *>(queue);
+  auto v = static_cast<uint8_t *>(values);
+  while (n > 0) {
+    auto tail = q->tail.load(std::memory_order_relaxed);
+    auto freeSlots = waitForFreeSlots(q, tail, n);
+    auto toPush = std::min(freeSlots, n);
+    copyElements(q, tail, v, toPush, true);
+    q->tail.store(tail + toPush, std::memory_order_release);
+    v += toPush * q->elementBytes;
+    n -= toPush;
+  }
+
+  return;
+}
+
+/*
+ * Pop @n elements and store them in @values.
+ */
+void NOELLE_queuePopBatch(void *queue, void *values, uint64_t n) {
+  auto q = static_cast<SPSCQueue *>(queue);
+  auto v = static_cast<uint8_t *>(values);
+  while (n > 0) {
+    auto head = q->head.load(std::memory_order_relaxed);
+    auto elements = waitForElements(q, head, n);
+    auto toPop = std::min(elements, n);
+    copyElements(q, head, v, toPop, false);
+    q->head.store(head + toPop, std::memory_order_release);
+    v += toPop * q->elementBytes;
+    n -= toPop;
+  }
+
+  return;
+}
+
+/*
+ * ============================ MPMC queues ===================================
+ */
+
+void *NOELLE_mpmcQueueCreate(uint64_t elementBytes, uint64_t capacity) {
+  if (elementBytes > sizeof(uint64_t)) {
+    return nullptr;
+  }
+  auto q = new MPMCQueue();
+  auto cells = roundUpToPowerOfTwo(capacity);
+  q->mask = cells - 1;
+  q->elementBytes = elementBytes;
+  q->cells = new (std::align_val_t(cacheLineBytes)) MPMCCell[cells];
+  for (uint64_t i = 0; i < cells; i++) {
+    q->cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  q->enqueuePosition.store(0);
+  q->dequeuePosition.store(0);
+
+  return q;
+}
+
+void NOELLE_mpmcQueueDestroy(void *queue) {
+  auto q = static_cast<MPMCQueue *>(queue);
+  operator delete[](q->cells, std::align_val_t(cacheLineBytes));
+  delete q;
+
+  return;
+}
+
+void NOELLE_mpmcQueuePush8(void *queue, int8_t *value) {
+  mpmcPush(static_cast<MPMCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_mpmcQueuePush16(void *queue, int16_t *value) {
+  mpmcPush(static_cast<MPMCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_mpmcQueuePush32(void *queue, int32_t *value) {
+  mpmcPush(static_cast<MPMCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_mpmcQueuePush64(void *queue, int64_t *value) {
+  mpmcPush(static_cast<MPMCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_mpmcQueuePop8(void *queue, int8_t *value) {
+  mpmcPop(static_cast<MPMCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_mpmcQueuePop16(void *queue, int16_t *value) {
+  mpmcPop(static_cast<MPMCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_mpmcQueuePop32(void *queue, int32_t *value) {
+  mpmcPop(static_cast<MPMCQueue *>(queue), value);
+
+  return;
+}
+
+void NOELLE_mpmcQueuePop64(void *queue, int64_t *value) {
+  mpmcPop(static_cast<MPMCQueue *>(queue), value);
+
+  return;
+}
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <pthread.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/*
+ * Microbenchmark: latency of dispatching empty tasks through the NOELLE task
+ * runtime compared to creating (and joining) one pthread per task instance at
+ * every invocation.
+ *
+ * Usage: NoelleTasksBenchmark [INVOCATIONS] [INSTANCES]
+ */
+
+extern "C" {
+int64_t NOELLE_getNumberOfWorkers(void);
+int64_t NOELLE_dispatchTasks(void (*task)(void *, int64_t, int64_t, int64_t),
+                             void *environment,
+                             int64_t numberOfInstances,
+                             int64_t chunkSize);
+}
+
+namespace {
+
+std::atomic<int64_t> executedInstances{ 0 };
+
+void emptyTask(void *environment,
+               int64_t instanceID,
+               int64_t numberOfInstances,
+               int64_t chunkSize) {
+  executedInstances.fetch_add(1, std::memory_order_relaxed);
+
+  return;
+}
+
+void *emptyThread(void *arguments) {
+  emptyTask(arguments, 0, 0, 0);
+
+  return nullptr;
+}
+
+double nanosecondsPerInvocation(std::chrono::steady_clock::time_point start,
+                                int64_t invocations) {
+  auto end = std::chrono::steady_clock::now();
+  auto elapsed =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+
+  return (double)elapsed.count() / invocations;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  int64_t invocations = argc > 1 ? std::atoll(argv[1]) : 10000;
+  int64_t instances =
+      argc > 2 ? std::atoll(argv[2]) : NOELLE_getNumberOfWorkers();
+  if ((invocations <= 0) || (instances <= 0)) {
+    fprintf(stderr, "Usage: %s [INVOCATIONS] [INSTANCES]\n", argv[0]);
+    return 1;
+  }
+
+  /*
+   * Warm up the thread pool.
+   */
+  NOELLE_dispatchTasks(emptyTask, nullptr, instances, 1);
+
+  /*
+   * Runtime.
+   */
+  executedInstances = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (auto i = 0; i < invocations; i++) {
+    NOELLE_dispatchTasks(emptyTask, nullptr, instances, 1);
+  }
+  auto runtimeLatency = nanosecondsPerInvocation(start, invocations);
+  auto runtimeInstances = executedInstances.load();
+
+  /*
+   * pthread_create per invocation.
+   */
+  executedInstances = 0;
+  std::vector<pthread_t> threads(instances);
+  start = std::chrono::steady_clock::now();
+  for (auto i = 0; i < invocations; i++) {
+    for (auto &t : threads) {
+      pthread_create(&t, nullptr, emptyThread, nullptr);
+    }
+    for (auto &t : threads) {
+      pthread_join(t, nullptr);
+    }
+  }
+  auto pthreadLatency = nanosecondsPerInvocation(start, invocations);
+  auto pthreadInstances = executedInstances.load();
+
+  /*
+   * Report.
+   */
+  if ((runtimeInstances != pthreadInstances)
+      || (runtimeInstances != (invocations * instances))) {
+    fprintf(stderr, "ERROR: not all task instances have been executed\n");
+    return 1;
+  }
+  printf("Workers: %ld\n", (long)NOELLE_getNumberOfWorkers());
+  printf("Task instances per invocation: %ld\n", (long)instances);
+  printf("NOELLE runtime: %.0f ns per invocation\n", runtimeLatency);
+  printf("pthread_create: %.0f ns per invocation\n", pthreadLatency);
+  printf("Speedup: %.2fx\n", pthreadLatency / runtimeLatency);
+
+  return 0;
+}
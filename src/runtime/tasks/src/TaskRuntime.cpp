@@ -0,0 +1,402 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Task runtime of NOELLE.
+ *
+ * Tasks are executed by a persistent pool of threads created the first time a
+ * task is dispatched. The number of threads (including the one that
+ * dispatches the tasks) is specified by the environment variable
+ * NOELLE_WORKERS (the number of logical cores by default).
+ *
+ * Every worker has its own deque of work items. A worker executes the items of
+ * its deque starting from the most recent one, and it steals the oldest items
+ * from the deques of the other workers when its deque is empty. The thread
+ * that dispatches the tasks helps executing them until all of them are done.
+ *
+ * Task instances and chunks of the same dispatch can run one after the other
+ * on the same worker. Hence, they must not wait for each other (e.g., the
+ * tasks generated by DOALL).
+ *
+ * Dispatching from a task runs the new work sequentially within the caller.
+ *
+ * TaskDispatcher (src/core/task) emits the calls to these APIs.
+ */
+
+namespace {
+
+constexpr uint64_t cacheLineBytes = 64;
+
+typedef void (*TaskFunction)(void *environment,
+                             int64_t instanceID,
+                             int64_t numberOfInstances,
+                             int64_t chunkSize);
+
+typedef void (*RangeFunction)(void *environment,
+                              int64_t begin,
+                              int64_t end,
+                              int64_t workerID);
+
+enum Schedule : int64_t { STATIC = 0, DYNAMIC = 1 };
+
+struct Job {
+  TaskFunction task;
+  RangeFunction body;
+  void *environment;
+  int64_t numberOfInstances;
+  int64_t chunkSize;
+  alignas(cacheLineBytes) std::atomic<int64_t> remainingItems;
+};
+
+struct WorkItem {
+  Job *job;
+  int64_t begin;
+  int64_t end;
+  bool stealable;
+};
+
+struct alignas(cacheLineBytes) WorkerDeque {
+  std::mutex lock;
+  std::deque<WorkItem> items;
+};
+
+thread_local bool isWorker = false;
+
+class ThreadPool {
+public:
+  ThreadPool() {
+    auto workers = std::thread::hardware_concurrency();
+    if (auto workersString = std::getenv("NOELLE_WORKERS")) {
+      workers = std::atoi(workersString);
+    }
+    if (workers == 0) {
+      workers = 1;
+    }
+    for (auto i = 0u; i < workers; i++) {
+      this->deques.push_back(std::make_unique<WorkerDeque>());
+    }
+
+    /*
+     * Worker 0 is the thread that dispatches the tasks.
+     */
+    for (auto i = 1u; i < workers; i++) {
+      this->threads.emplace_back([this, i]() { this->workerLoop(i); });
+    }
+
+    return;
+  }
+
+  uint32_t getNumberOfWorkers(void) const {
+    return this->deques.size();
+  }
+
+  void push(uint32_t workerID, const WorkItem &item) {
+    auto &d = *this->deques[workerID % this->deques.size()];
+    std::lock_guard<std::mutex> guard(d.lock);
+    d.items.push_back(item);
+
+    return;
+  }
+
+  void run(Job &job) {
+
+    /*
+     * Wake up the workers.
+     */
+    {
+      std::lock_guard<std::mutex> guard(this->lock);
+      this->epoch++;
+    }
+    this->wakeUp.notify_all();
+
+    /*
+     * Help until all items have been executed.
+     */
+    isWorker = true;
+    while (job.remainingItems.load(std::memory_order_acquire) > 0) {
+      if (!this->executeOneItem(0)) {
+        std::this_thread::yield();
+      }
+    }
+    isWorker = false;
+
+    return;
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> guard(this->lock);
+      this->stop = true;
+    }
+    this->wakeUp.notify_all();
+    for (auto &t : this->threads) {
+      t.join();
+    }
+
+    return;
+  }
+
+private:
+  std::vector<std::unique_ptr<WorkerDeque>> deques;
+  std::vector<std::thread> threads;
+  std::mutex lock;
+  std::condition_variable wakeUp;
+  uint64_t epoch = 0;
+  bool stop = false;
+
+  bool popLocal(uint32_t workerID, WorkItem &item) {
+    auto &d = *this->deques[workerID];
+    std::lock_guard<std::mutex> guard(d.lock);
+    if (d.items.empty()) {
+      return false;
+    }
+    item = d.items.back();
+    d.items.pop_back();
+
+    return true;
+  }
+
+  bool steal(uint32_t thiefID, WorkItem &item) {
+    auto workers = this->deques.size();
+    for (auto i = 1u; i < workers; i++) {
+      auto &d = *this->deques[(thiefID + i) % workers];
+      std::lock_guard<std::mutex> guard(d.lock);
+      if (d.items.empty() || !d.items.front().stealable) {
+        continue;
+      }
+      item = d.items.front();
+      d.items.pop_front();
+      return true;
+    }
+
+    return false;
+  }
+
+  bool executeOneItem(uint32_t workerID) {
+    WorkItem item;
+    if (!this->popLocal(workerID, item) && !this->steal(workerID, item)) {
+      return false;
+    }
+
+    /*
+     * Execute the item.
+     */
+    auto job = item.job;
+    if (job->task != nullptr) {
+      for (auto i = item.begin; i < item.end; i++) {
+        job->task(job->environment, i, job->numberOfInstances, job->chunkSize);
+      }
+    } else {
+      job->body(job->environment, item.begin, item.end, workerID);
+    }
+
+    /*
+     * The job can be destroyed by its dispatcher right after the last item is
+     * marked as executed.
+     */
+    job->remainingItems.fetch_sub(1, std::memory_order_acq_rel);
+
+    return true;
+  }
+
+  void workerLoop(uint32_t workerID) {
+    isWorker = true;
+    uint64_t lastEpoch = 0;
+    while (true) {
+
+      /*
+       * Wait for new work.
+       */
+      {
+        std::unique_lock<std::mutex> guard(this->lock);
+        this->wakeUp.wait(guard, [this, lastEpoch]() {
+          return this->stop || (this->epoch != lastEpoch);
+        });
+        if (this->stop) {
+          return;
+        }
+        lastEpoch = this->epoch;
+      }
+
+      /*
+       * Execute items until there is nothing left to execute or steal.
+       */
+      while (this->executeOneItem(workerID)) {
+      }
+    }
+
+    return;
+  }
+};
+
+ThreadPool &getThreadPool(void) {
+  static ThreadPool pool;
+
+  return pool;
+}
+
+} // namespace
+
+extern "C" {
+
+/*
+ * Return the number of threads that execute tasks.
+ */
+int64_t NOELLE_getNumberOfWorkers(void) {
+  return getThreadPool().getNumberOfWorkers();
+}
+
+/*
+ * Run @numberOfInstances instances of @task and wait for them to complete.
+ * Each instance receives its ID, @numberOfInstances, and @chunkSize, so it
+ * can select the iterations to execute (e.g., DOALL tasks).
+ * Return the number of instances executed.
+ */
+int64_t NOELLE_dispatchTasks(TaskFunction task,
+                             void *environment,
+                             int64_t numberOfInstances,
+                             int64_t chunkSize) {
+  if (numberOfInstances <= 0) {
+    return 0;
+  }
+
+  /*
+   * Run the instances sequentially if we are already within a task.
+   */
+  if (isWorker) {
+    for (int64_t i = 0; i < numberOfInstances; i++) {
+      task(environment, i, numberOfInstances, chunkSize);
+    }
+    return numberOfInstances;
+  }
+
+  /*
+   * Distribute the instances among the workers.
+   */
+  auto &pool = getThreadPool();
+  Job job;
+  job.task = task;
+  job.body = nullptr;
+  job.environment = environment;
+  job.numberOfInstances = numberOfInstances;
+  job.chunkSize = chunkSize;
+  job.remainingItems.store(numberOfInstances, std::memory_order_relaxed);
+  for (int64_t i = 0; i < numberOfInstances; i++) {
+    pool.push(i, WorkItem{ &job, i, i + 1, true });
+  }
+
+  /*
+   * Run the instances.
+   */
+  pool.run(job);
+
+  return numberOfInstances;
+}
+
+/*
+ * Execute the iterations [@begin, @end) by invoking @body on sub-ranges, and
+ * wait for them to complete.
+ *
+ * With the static schedule, every worker executes a contiguous block of
+ * iterations (a multiple of @chunkSize long), and blocks are not stolen.
+ * With the dynamic schedule, the iterations are split in chunks of
+ * @chunkSize iterations, which are distributed round-robin among workers and
+ * balanced by work stealing.
+ *
+ * Return the number of sub-ranges executed.
+ */
+int64_t NOELLE_dispatchRange(RangeFunction body,
+                             void *environment,
+                             int64_t begin,
+                             int64_t end,
+                             int64_t chunkSize,
+                             int64_t schedule) {
+  if (begin >= end) {
+    return 0;
+  }
+  if (chunkSize <= 0) {
+    chunkSize = 1;
+  }
+
+  /*
+   * Run the iterations sequentially if we are already within a task.
+   */
+  if (isWorker) {
+    body(environment, begin, end, 0);
+    return 1;
+  }
+
+  /*
+   * Split the iterations.
+   */
+  auto &pool = getThreadPool();
+  auto workers = (int64_t)pool.getNumberOfWorkers();
+  auto iterations = end - begin;
+  std::vector<WorkItem> items;
+  Job job;
+  job.task = nullptr;
+  job.body = body;
+  job.environment = environment;
+  job.numberOfInstances = 0;
+  job.chunkSize = chunkSize;
+  if (schedule == STATIC) {
+    auto chunks = (iterations + chunkSize - 1) / chunkSize;
+    auto chunksPerWorker = (chunks + workers - 1) / workers;
+    auto blockSize = chunksPerWorker * chunkSize;
+    for (auto b = begin; b < end; b += blockSize) {
+      auto e = (end - b) > blockSize ? b + blockSize : end;
+      items.push_back(WorkItem{ &job, b, e, false });
+    }
+  } else {
+    for (auto b = begin; b < end; b += chunkSize) {
+      auto e = (end - b) > chunkSize ? b + chunkSize : end;
+      items.push_back(WorkItem{ &job, b, e, true });
+    }
+  }
+  job.remainingItems.store(items.size(), std::memory_order_relaxed);
+
+  /*
+   * Distribute the items round-robin.
+   * The items of a worker are pushed in reverse order so that the worker
+   * executes them in order, while thieves steal the last ones.
+   */
+  for (auto i = (int64_t)items.size() - 1; i >= 0; i--) {
+    pool.push(i % workers, items[i]);
+  }
+
+  /*
+   * Run the items.
+   */
+  pool.run(job);
+
+  return items.size();
+}
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_TOOLS_FIXED_POINT_FIXEDPOINT_H_
+#define NOELLE_SRC_TOOLS_FIXED_POINT_FIXEDPOINT_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+using namespace llvm;
+
+namespace arcana::noelle {
+
+/*
+ * Run passes (e.g., enablers) until they no longer change the program.
+ *
+ * Every iteration runs, in a single pass manager, the normalization passes,
+ * the analyses NOELLE relies on, and the passes given by
+ * -noelle-fixedpoint-passes. A fingerprint of the IR is computed after the
+ * normalization and after the passes: the fixed point is reached when they
+ * are the same.
+ * Analyses are shared by the passes of the same iteration, but they are
+ * recomputed at every iteration. Only the dependences of the functions that
+ * did not change can be reused across iterations, through the PDG cache
+ * (-noelle-pdg-cache), which is disabled by default.
+ */
+class FixedPoint : public ModulePass {
+public:
+  static char ID;
+
+  FixedPoint();
+
+  bool doInitialization(Module &M) override;
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+  bool runOnModule(Module &M) override;
+
+  /*
+   * Fingerprint of the IR of @M.
+   */
+  static std::string computeFingerprint(Module &M);
+
+private:
+  std::vector<std::string> passes;
+  std::vector<std::string> normalizationPasses;
+  std::vector<std::string> analyses;
+  uint32_t maximumIterations;
+
+  void addPasses(legacy::PassManager &pm,
+                 const std::vector<std::string> &names,
+                 bool skipUnregistered);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_TOOLS_FIXED_POINT_FIXEDPOINT_H_
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "llvm/Support/MD5.h"
+#include "arcana/noelle/tools/FixedPoint.hpp"
+
+namespace arcana::noelle {
+
+namespace {
+
+/*
+ * Record the fingerprint of the IR at a given point of a pass manager.
+ */
+class FingerprintRecorder : public ModulePass {
+public:
+  static char ID;
+
+  FingerprintRecorder(std::string &fingerprint)
+    : ModulePass{ ID },
+      fingerprint{ fingerprint } {
+    return;
+  }
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override {
+    AU.setPreservesAll();
+    return;
+  }
+
+  bool runOnModule(Module &M) override {
+    this->fingerprint = FixedPoint::computeFingerprint(M);
+    return false;
+  }
+
+private:
+  std::string &fingerprint;
+};
+
+char FingerprintRecorder::ID = 0;
+
+} // namespace
+
+FixedPoint::FixedPoint() : ModulePass{ ID }, maximumIterations{ 0 } {
+  return;
+}
+
+bool FixedPoint::runOnModule(Module &M) {
+  errs() << "NOELLE: FixedPoint: Start\n";
+  errs() << "NOELLE: FixedPoint:   Passes:";
+  for (auto &name : this->passes) {
+    errs() << " " << name;
+  }
+  errs() << "\n";
+  if (this->passes.empty()) {
+    errs() << "FixedPoint: ERROR = no pass specified (use "
+              "-noelle-fixedpoint-passes)\n";
+    abort();
+  }
+
+  /*
+   * Run until a fixed point is reached.
+   */
+  uint32_t iterations = 0;
+  while (true) {
+    errs() << "NOELLE: FixedPoint:     Invocation " << iterations << "\n";
+
+    /*
+     * Normalize the code, fetch the analyses, and run the passes.
+     */
+    std::string before;
+    std::string after;
+    legacy::PassManager pm;
+    this->addPasses(pm, this->normalizationPasses, true);
+    pm.add(new FingerprintRecorder(before));
+    this->addPasses(pm, this->analyses, true);
+    this->addPasses(pm, this->passes, false);
+    pm.add(new FingerprintRecorder(after));
+    pm.run(M);
+
+    /*
+     * Check if the passes modified the code.
+     */
+    if (before == after) {
+      break;
+    }
+    iterations++;
+    errs() << "NOELLE: FixedPoint:       The code has changed\n";
+
+    /*
+     * Check if we have reached the maximum number of iterations.
+     */
+    if ((this->maximumIterations > 0)
+        && (iterations >= this->maximumIterations)) {
+      errs() << "NOELLE: FixedPoint:   WARNING: the maximum number of "
+                "iterations has been reached before the fixed point\n";
+      break;
+    }
+  }
+
+  errs() << "NOELLE: FixedPoint:   Iteration count = " << iterations << "\n";
+  errs() << "NOELLE: FixedPoint: Exit\n";
+
+  /*
+   * The normalization might have modified the code even if the passes did
+   * not.
+   */
+  return true;
+}
+
+void FixedPoint::addPasses(legacy::PassManager &pm,
+                           const std::vector<std::string> &names,
+                           bool skipUnregistered) {
+  auto registry = PassRegistry::getPassRegistry();
+  for (auto &name : names) {
+
+    /*
+     * Fetch the pass.
+     */
+    auto passInfo = registry->getPassInfo(name);
+    if (passInfo == nullptr) {
+      if (skipUnregistered) {
+        continue;
+      }
+      errs() << "FixedPoint: ERROR = the pass " << name
+             << " is not registered (is its library loaded?)\n";
+      abort();
+    }
+
+    /*
+     * Add the pass.
+     */
+    auto pass = passInfo->createPass();
+    if (pass == nullptr) {
+      errs() << "FixedPoint: ERROR = the pass " << name
+             << " cannot be created\n";
+      abort();
+    }
+    pm.add(pass);
+  }
+
+  return;
+}
+
+std::string FixedPoint::computeFingerprint(Module &M) {
+  std::string ir;
+  raw_string_ostream irStream(ir);
+  M.print(irStream, nullptr);
+  irStream.flush();
+
+  MD5 hash;
+  hash.update(ir);
+  MD5::MD5Result result;
+  hash.final(result);
+
+  return result.digest().str().str();
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/tools/FixedPoint.hpp"
+
+namespace arcana::noelle {
+
+static cl::list<std::string> Passes(
+    "noelle-fixedpoint-passes",
+    cl::CommaSeparated,
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Passes to run until they do not change the code anymore"));
+
+static cl::list<std::string> NormalizationPasses(
+    "noelle-fixedpoint-normalization",
+    cl::CommaSeparated,
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Passes that normalize the code before every iteration"));
+
+static cl::list<std::string> Analyses(
+    "noelle-fixedpoint-analyses",
+    cl::CommaSeparated,
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Analyses to schedule before the passes of every iteration"));
+
+static cl::opt<bool> EmbedLoopIDs(
+    "noelle-fixedpoint-embed-loop-ids",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Embed the loop IDs (LoopMetadata) after the normalization"));
+
+static cl::opt<uint32_t> MaximumIterations(
+    "noelle-fixedpoint-max-iterations",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::init(0),
+    cl::desc("Maximum number of iterations (0 means no limit)"));
+
+bool FixedPoint::doInitialization(Module &M) {
+  this->passes.assign(Passes.begin(), Passes.end());
+  this->maximumIterations = MaximumIterations.getValue();
+
+  /*
+   * The default normalization is made of the opt passes of noelle-norm.
+   * Loop IDs are embedded only if requested.
+   */
+  if (NormalizationPasses.getNumOccurrences() > 0) {
+    this->normalizationPasses.assign(NormalizationPasses.begin(),
+                                     NormalizationPasses.end());
+  } else {
+    this->normalizationPasses = { "basicaa",          "mem2reg",
+                                  "break-constgeps",  "merge-rets",
+                                  "lowerswitch",      "mergereturn",
+                                  "break-crit-edges", "loop-simplify",
+                                  "lcssa",            "indvars",
+                                  "functionattrs",    "rpo-functionattrs" };
+  }
+  if (EmbedLoopIDs.getValue()) {
+    this->normalizationPasses.push_back("LoopMetadata");
+  }
+
+  /*
+   * The default analyses are the ones of noelle-load.
+   * SVF and SCAF analyses are skipped when their libraries are not loaded.
+   */
+  if (Analyses.getNumOccurrences() > 0) {
+    this->analyses.assign(Analyses.begin(), Analyses.end());
+  } else {
+    this->analyses = { "globals-aa",
+                       "cfl-steens-aa",
+                       "tbaa",
+                       "scev-aa",
+                       "cfl-anders-aa",
+                       "objc-arc-aa",
+                       "scalar-evolution",
+                       "loops",
+                       "domtree",
+                       "postdomtree",
+                       "basic-loop-aa",
+                       "scev-loop-aa",
+                       "auto-restrict-aa",
+                       "intrinsic-aa",
+                       "global-malloc-aa",
+                       "pure-fun-aa",
+                       "semi-local-fun-aa",
+                       "phi-maze-aa",
+                       "no-capture-global-aa",
+                       "no-capture-src-aa",
+                       "type-aa",
+                       "no-escape-fields-aa",
+                       "acyclic-aa",
+                       "disjoint-fields-aa",
+                       "field-malloc-aa",
+                       "loop-variant-allocation-aa",
+                       "std-in-out-err-aa",
+                       "array-of-structures-aa",
+                       "kill-flow-aa",
+                       "callsite-depth-combinator-aa",
+                       "unique-access-paths-aa",
+                       "llvm-aa-results",
+                       "noelle-scaf",
+                       "noelle-svf" };
+  }
+
+  return false;
+}
+
+void FixedPoint::getAnalysisUsage(AnalysisUsage &AU) const {
+  return;
+}
+
+// Next there is code to register your pass to "opt"
+char FixedPoint::ID = 0;
+static RegisterPass<FixedPoint> X("FixedPoint",
+                                  "Run passes until a fixed point is reached",
+                                  false,
+                                  false);
+
+// Next there is code to register your pass to "clang"
+static FixedPoint *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new FixedPoint());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new FixedPoint());
+      }
+    }); // ** for -O0
+
+} // namespace arcana::noelle
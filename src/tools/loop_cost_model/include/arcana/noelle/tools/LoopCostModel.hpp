@@ -0,0 +1,107 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_TOOLS_LOOP_COST_MODEL_LOOPCOSTMODEL_H_
+#define NOELLE_SRC_TOOLS_LOOP_COST_MODEL_LOOPCOSTMODEL_H_
+
+#include "arcana/noelle/core/Noelle.hpp"
+
+using namespace llvm;
+
+namespace arcana::noelle {
+
+/*
+ * Analytical model of the speedup of parallelizing each loop.
+ *
+ * For every loop, parallelization technique, and number of cores, the model
+ * predicts the speedup of the loop and the fraction of the parallel loop
+ * time spent on parallelization overhead. The predictions are printed one
+ * per line as
+ *   LOOP_ID TECHNIQUE CORES COVERAGE LOOP_SPEEDUP OVERHEAD
+ * where TECHNIQUE is 0 for DOALL, 1 for HELIX, and 2 for DSWP (the technique
+ * indexes of the autotuner), and COVERAGE is the fraction of the dynamic
+ * instructions of the program executed by the loop.
+ * Techniques that cannot be applied to a loop are not printed.
+ */
+class LoopCostModel : public ModulePass {
+public:
+  static char ID;
+
+  LoopCostModel();
+
+  bool doInitialization(Module &M) override;
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+  bool runOnModule(Module &M) override;
+
+private:
+  enum Technique { DOALL = 0, HELIX = 1, DSWP = 2 };
+
+  /*
+   * Dynamic characteristics of a loop used by the model.
+   * Work is measured in dynamic instructions.
+   */
+  struct LoopSummary {
+    uint64_t ID = 0;
+    double coverage = 0;
+    double work = 0;
+    double invocations = 0;
+    double iterations = 0;
+    double sequentialWork = 0;
+    double largestSCCWork = 0;
+    uint64_t sequentialSCCs = 0;
+    uint64_t SCCs = 0;
+    uint64_t edgesBetweenSCCs = 0;
+  };
+
+  /*
+   * Costs of the parallelization (in dynamic instructions).
+   * The command line options of the tool override the default ones, while
+   * the cost of a queue is the one used by NOELLE (see
+   * CompilationOptionsManager::getQueueCost).
+   */
+  double dispatchCost = 5000;
+  double dispatchCostPerCore = 1000;
+  double sequentialSegmentSignalCost = 150;
+  double queueCost = 60;
+
+  std::string outputFileName;
+
+  bool summarizeLoop(Hot *profiles, LoopContent *loop, LoopSummary &summary);
+
+  bool canBeParallelizedWith(const LoopSummary &loop,
+                             Technique technique) const;
+
+  double getParallelOverhead(const LoopSummary &loop,
+                             Technique technique,
+                             uint32_t cores) const;
+
+  double getParallelTime(const LoopSummary &loop,
+                         Technique technique,
+                         uint32_t cores) const;
+
+  void printModel(raw_ostream &stream,
+                  const LoopSummary &loop,
+                  uint32_t maximumNumberOfCores) const;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_TOOLS_LOOP_COST_MODEL_LOOPCOSTMODEL_H_
@@ -0,0 +1,237 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/tools/LoopCostModel.hpp"
+#include "arcana/noelle/core/LoopCarriedUnknownSCC.hpp"
+
+namespace arcana::noelle {
+
+LoopCostModel::LoopCostModel() : ModulePass{ ID } {}
+
+bool LoopCostModel::runOnModule(Module &M) {
+
+  /*
+   * Fetch NOELLE
+   */
+  auto &noelle = getAnalysis<Noelle>();
+
+  /*
+   * Fetch the profiles.
+   */
+  auto profiles = noelle.getProfiles();
+  if (!profiles->isAvailable()) {
+    errs() << "LoopCostModel: WARNING: the profiles are not available, so "
+              "no prediction can be made\n";
+    return false;
+  }
+
+  /*
+   * Summarize the loops.
+   */
+  std::map<uint64_t, LoopSummary> summaries;
+  auto loops = noelle.getLoopContents();
+  for (auto loop : *loops) {
+    LoopSummary summary;
+    if (!this->summarizeLoop(profiles, loop, summary)) {
+      continue;
+    }
+    summaries[summary.ID] = summary;
+  }
+
+  /*
+   * Print the predictions.
+   */
+  auto optionsManager = noelle.getCompilationOptionsManager();
+  auto maxCores = optionsManager->getMaximumNumberOfCores();
+  this->queueCost = optionsManager->getQueueCost();
+  if (this->outputFileName.empty()) {
+    for (auto &pair : summaries) {
+      this->printModel(outs(), pair.second, maxCores);
+    }
+
+  } else {
+    std::error_code EC;
+    raw_fd_ostream stream(this->outputFileName, EC);
+    if (EC) {
+      errs() << "LoopCostModel: ERROR = cannot open " << this->outputFileName
+             << ": " << EC.message() << "\n";
+      abort();
+    }
+    for (auto &pair : summaries) {
+      this->printModel(stream, pair.second, maxCores);
+    }
+  }
+
+  return false;
+}
+
+bool LoopCostModel::summarizeLoop(Hot *profiles,
+                                  LoopContent *loop,
+                                  LoopSummary &summary) {
+
+  /*
+   * Fetch the loop.
+   */
+  auto ls = loop->getLoopStructure();
+  auto loopIDOpt = ls->getID();
+  if (!loopIDOpt) {
+    return false;
+  }
+  summary.ID = loopIDOpt.value();
+
+  /*
+   * Fetch the dynamic characteristics of the loop.
+   * Loops that have not been executed cannot be modeled.
+   */
+  summary.work = profiles->getTotalInstructions(ls);
+  if (summary.work == 0) {
+    return false;
+  }
+  summary.coverage = profiles->getDynamicTotalInstructionCoverage(ls);
+  summary.invocations = std::max<uint64_t>(profiles->getInvocations(ls), 1);
+  summary.iterations = profiles->getIterations(ls);
+
+  /*
+   * Characterize the SCCs of the loop.
+   * Only SCCs with loop-carried dependences that cannot be removed must run
+   * sequentially.
+   */
+  auto sccManager = loop->getSCCManager();
+  auto sccdag = sccManager->getSCCDAG();
+  for (auto node : sccdag->getNodes()) {
+    auto scc = node->getT();
+    auto sccWork = (double)profiles->getTotalInstructions(scc);
+    summary.SCCs++;
+    summary.largestSCCWork = std::max(summary.largestSCCWork, sccWork);
+
+    auto sccInfo = sccManager->getSCCAttrs(scc);
+    if (isa<LoopCarriedUnknownSCC>(sccInfo)) {
+      summary.sequentialSCCs++;
+      summary.sequentialWork += sccWork;
+    }
+  }
+  summary.edgesBetweenSCCs = sccdag->numEdges();
+
+  return true;
+}
+
+bool LoopCostModel::canBeParallelizedWith(const LoopSummary &loop,
+                                          Technique technique) const {
+  switch (technique) {
+    case DOALL:
+      return loop.sequentialSCCs == 0;
+    case HELIX:
+      return true;
+    case DSWP:
+      return loop.SCCs > 1;
+  }
+
+  return false;
+}
+
+double LoopCostModel::getParallelOverhead(const LoopSummary &loop,
+                                          Technique technique,
+                                          uint32_t cores) const {
+
+  /*
+   * Every invocation of the loop dispatches its tasks to the cores.
+   */
+  auto overhead =
+      loop.invocations * (dispatchCost + (dispatchCostPerCore * cores));
+
+  /*
+   * Add the overhead specific to the technique.
+   */
+  switch (technique) {
+    case DOALL:
+      break;
+
+    case HELIX:
+      overhead += loop.iterations * loop.sequentialSCCs
+                  * sequentialSegmentSignalCost;
+      break;
+
+    case DSWP: {
+      auto stages = std::min<uint64_t>(cores, loop.SCCs);
+      overhead +=
+          (loop.iterations * loop.edgesBetweenSCCs * queueCost) / stages;
+      break;
+    }
+  }
+
+  return overhead;
+}
+
+double LoopCostModel::getParallelTime(const LoopSummary &loop,
+                                      Technique technique,
+                                      uint32_t cores) const {
+  auto overhead = this->getParallelOverhead(loop, technique, cores);
+  auto dispatchOverhead =
+      loop.invocations * (dispatchCost + (dispatchCostPerCore * cores));
+
+  switch (technique) {
+    case DOALL:
+      return (loop.work / cores) + overhead;
+
+    case HELIX: {
+
+      /*
+       * Sequential segments and the signals between them form the critical
+       * path of the parallel loop.
+       */
+      auto criticalPath =
+          loop.sequentialWork + (overhead - dispatchOverhead);
+      return std::max(loop.work / cores, criticalPath) + dispatchOverhead;
+    }
+
+    case DSWP: {
+
+      /*
+       * The slowest stage bounds the throughput of the pipeline.
+       */
+      auto stages = std::min<uint64_t>(cores, loop.SCCs);
+      return std::max(loop.largestSCCWork, loop.work / stages) + overhead;
+    }
+  }
+
+  return loop.work;
+}
+
+void LoopCostModel::printModel(raw_ostream &stream,
+                               const LoopSummary &loop,
+                               uint32_t maximumNumberOfCores) const {
+  for (auto technique : { DOALL, HELIX, DSWP }) {
+    if (!this->canBeParallelizedWith(loop, technique)) {
+      continue;
+    }
+    for (auto cores = 2u; cores <= maximumNumberOfCores; cores++) {
+      auto parallelTime = this->getParallelTime(loop, technique, cores);
+      auto overhead = this->getParallelOverhead(loop, technique, cores);
+      stream << loop.ID << " " << technique << " " << cores << " "
+             << loop.coverage << " " << (loop.work / parallelTime) << " "
+             << (overhead / parallelTime) << "\n";
+    }
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/tools/LoopCostModel.hpp"
+
+namespace arcana::noelle {
+
+static cl::opt<std::string> OutputFileName(
+    "noelle-loop-cost-model-output",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("File where the predictions of the loop cost model are written"));
+static cl::opt<unsigned> DispatchCost(
+    "noelle-loop-cost-model-dispatch-cost",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Dynamic instructions spent to dispatch the tasks of a loop"));
+static cl::opt<unsigned> DispatchCostPerCore(
+    "noelle-loop-cost-model-dispatch-cost-per-core",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Dynamic instructions spent to dispatch a task to a core"));
+static cl::opt<unsigned> SignalCost(
+    "noelle-loop-cost-model-signal-cost",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Dynamic instructions spent to signal a sequential segment"));
+
+bool LoopCostModel::doInitialization(Module &M) {
+  this->outputFileName = OutputFileName.getValue();
+  if (DispatchCost.getNumOccurrences() > 0) {
+    this->dispatchCost = DispatchCost.getValue();
+  }
+  if (DispatchCostPerCore.getNumOccurrences() > 0) {
+    this->dispatchCostPerCore = DispatchCostPerCore.getValue();
+  }
+  if (SignalCost.getNumOccurrences() > 0) {
+    this->sequentialSegmentSignalCost = SignalCost.getValue();
+  }
+  return false;
+}
+
+void LoopCostModel::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<Noelle>();
+  AU.setPreservesAll();
+  return;
+}
+
+// Next there is code to register your pass to "opt"
+char LoopCostModel::ID = 0;
+static RegisterPass<LoopCostModel> X(
+    "LoopCostModel",
+    "Predict the speedup of parallelizing loops",
+    false,
+    false);
+
+// Next there is code to register your pass to "clang"
+static LoopCostModel *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new LoopCostModel());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new LoopCostModel());
+      }
+    }); // ** for -O0
+
+} // namespace arcana::noelle
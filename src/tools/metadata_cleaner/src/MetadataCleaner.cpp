@@ -102,10 +102,20 @@ void MetadataCleaner::cleanProfMetadata(Module &M) {
         if (I.getMetadata("prof")) {
           I.setMetadata("prof", nullptr);
         }
+        if (I.getMetadata("noelle.loop.prof")) {
+          I.setMetadata("noelle.loop.prof", nullptr);
+        }
+        if (I.getMetadata("noelle.prof.input.counters")) {
+          I.setMetadata("noelle.prof.input.counters", nullptr);
+        }
       }
     }
   }
 
+  if (auto n = M.getNamedMetadata("noelle.prof.inputs")) {
+    M.eraseNamedMetadata(n);
+  }
+
   return;
 }
 
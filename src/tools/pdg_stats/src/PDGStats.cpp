@@ -21,6 +21,7 @@
  */
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/Instrumentation.hpp"
 #include "PDGStats.hpp"
 
 namespace arcana::noelle {
@@ -71,6 +72,7 @@ bool PDGStats::runOnModule(Module &M) {
    * Compute the memory edges in the PDG.
    */
   auto PDG = noelle.getProgramDependenceGraph();
+  this->pdgMemory = PDG->getMemoryFootprint();
   for (auto edge : PDG->getEdges()) {
 
     /*
@@ -202,15 +204,21 @@ void PDGStats::printRefinedLoopGraphsForFunction(
         assert(currentLoopContent != nullptr);
 
         /*
-         * Fetch the loop dependence graph.
+         * Fetch the loop dependence graph and its SCCDAG.
          */
         auto loopDG = currentLoopContent->getLoopDG();
+        auto loopSCCDAG = currentLoopContent->getSCCManager()->getSCCDAG();
 
-        std::string filename;
-        raw_string_ostream ros(filename);
+        /*
+         * Print them by reusing the SCCDAG of the loop content rather than
+         * computing it again.
+         */
+        std::string prefix;
+        raw_string_ostream ros(prefix);
         ros << "pdg-function-" << F.getName() << "-loop" << loopCount
-            << "-refined.dot";
-        DGPrinter::writeClusteredGraph<PDG, Value>(ros.str(), loopDG);
+            << "-refined";
+        PDGPrinter printer;
+        printer.printLoopGraphs(ros.str(), loopDG, loopSCCDAG);
 
         loopCount++;
 
@@ -255,6 +263,11 @@ void PDGStats::collectStatsForLoopEdges(
           this->analyzeDependence(edge);
         }
 
+        /*
+         * Account the memory of the loop.
+         */
+        this->loopsMemory += currentLoopContent->getMemoryFootprint();
+
         return false;
       };
       loopTree->visitPreOrder(visitor);
@@ -297,6 +310,26 @@ void PDGStats::printStats() {
   errs() << "     Number of potential memory dependences: "
          << this->numberOfPotentialMemoryDependences << "\n";
 
+  /*
+   * Print the memory used.
+   */
+  this->printMemory("PDG", this->pdgMemory);
+  this->printMemory("Loop DGs and SCCDAGs", this->loopsMemory);
+  if (Instrumentation::isEnabled()) {
+    Instrumentation::printMemoryReport(errs());
+  }
+
+  return;
+}
+
+void PDGStats::printMemory(const std::string &name,
+                           const MemoryFootprint &footprint) {
+  errs() << "Memory of " << name << ": "
+         << format("%.1f", footprint.bytes / 1024.0) << " KB\n";
+  errs() << " Number of nodes: " << footprint.nodes << "\n";
+  errs() << " Number of edges: " << footprint.edges << "\n";
+  errs() << " Number of sub-edges: " << footprint.subEdges << "\n";
+
   return;
 }
 
@@ -53,6 +53,8 @@ private:
   int64_t numberOfMemoryMustDependence = 0;
   int64_t numberOfPotentialMemoryDependences = 0;
   int64_t numberOfControlDependence = 0;
+  MemoryFootprint pdgMemory;
+  MemoryFootprint loopsMemory;
 
   void collectStatsForNodes(Function &F);
   void collectStatsForPotentialEdges(
@@ -75,6 +77,7 @@ private:
 
   bool edgeIsDependenceOf(MDNode *edgeM, EDGE_ATTRIBUTE edgeAttribute);
   void printStats();
+  void printMemory(const std::string &name, const MemoryFootprint &footprint);
   uint64_t computePotentialEdges(uint64_t totLoads,
                                  uint64_t totStores,
                                  uint64_t totCalls);
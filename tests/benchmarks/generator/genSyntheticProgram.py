@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+
+"""
+Generate a synthetic C program whose size is controlled by parameters.
+
+Every function contains a loop nest; the innermost loop has a large basic
+block of arithmetic and memory operations through pointers that may alias.
+Statements are straight-line code so the innermost body stays a single
+basic block; the linked list is circular so its traversal needs no test.
+The main function invokes all of them.
+"""
+
+import sys
+import random
+import argparse
+
+
+def genStatement(rand, pointers, depth):
+  indexes = ["i" + str(d) for d in range(0, depth)]
+  index = " + ".join(indexes) if (len(indexes) > 0) else "0"
+  dst = rand.randrange(0, pointers)
+  src1 = rand.randrange(0, pointers)
+  src2 = rand.randrange(0, pointers)
+  op = rand.choice(["+", "-", "*"])
+  kind = rand.randrange(0, 4)
+  if (kind == 0):
+    return "p" + str(dst) + "[(" + index + ") % n] = p" + str(src1) + "[(" + index + ") % n] " + op + " p" + str(src2) + "[(" + index + " + 1) % n];"
+  if (kind == 1):
+    return "acc = acc " + op + " p" + str(src1) + "[(" + index + ") % n];"
+  if (kind == 2):
+    return "p" + str(dst) + " = p" + str(src1) + ";"
+  return "node = node->next; node->value " + op + "= acc;"
+
+
+def genFunction(rand, functionID, depth, blockSize, pointers):
+  lines = []
+  lines.append("double f" + str(functionID) + "(double **arrays, long n, struct node *list) {")
+  lines.append("  double acc = 0;")
+  lines.append("  struct node *node = list;")
+  for p in range(0, pointers):
+    lines.append("  double *p" + str(p) + " = arrays[" + str(p) + " % NUMBER_OF_ARRAYS];")
+
+  # Loop nest
+  indent = "  "
+  for d in range(0, depth):
+    lines.append(indent + "for (long i" + str(d) + " = 0; i" + str(d) + " < n; i" + str(d) + "++) {")
+    indent += "  "
+
+  # Large basic block
+  for s in range(0, blockSize):
+    lines.append(indent + genStatement(rand, pointers, depth))
+
+  for d in range(0, depth):
+    indent = indent[:-2]
+    lines.append(indent + "}")
+
+  lines.append("  return acc;")
+  lines.append("}")
+  lines.append("")
+
+  return lines
+
+
+def genProgram(functions, depth, blockSize, pointers, seed):
+  rand = random.Random(seed)
+  lines = []
+  lines.append("#include <stdio.h>")
+  lines.append("#include <stdlib.h>")
+  lines.append("")
+  lines.append("#define NUMBER_OF_ARRAYS 4")
+  lines.append("")
+  lines.append("struct node {")
+  lines.append("  double value;")
+  lines.append("  struct node *next;")
+  lines.append("};")
+  lines.append("")
+  for functionID in range(0, functions):
+    lines += genFunction(rand, functionID, depth, blockSize, pointers)
+
+  lines.append("int main(int argc, char *argv[]) {")
+  lines.append("  long n = (argc > 1) ? atol(argv[1]) : 10;")
+  lines.append("  if (n < 1) n = 1;")
+  lines.append("  double *arrays[NUMBER_OF_ARRAYS];")
+  lines.append("  for (int i = 0; i < NUMBER_OF_ARRAYS; i++) {")
+  lines.append("    arrays[i] = (double *)calloc(n, sizeof(double));")
+  lines.append("  }")
+  lines.append("  struct node *list = NULL;")
+  lines.append("  struct node *tail = NULL;")
+  lines.append("  for (long i = 0; i < n; i++) {")
+  lines.append("    struct node *node = (struct node *)malloc(sizeof(struct node));")
+  lines.append("    node->value = i;")
+  lines.append("    node->next = list;")
+  lines.append("    list = node;")
+  lines.append("    if (tail == NULL) tail = node;")
+  lines.append("  }")
+  lines.append("  tail->next = list;")
+  lines.append("  double result = 0;")
+  for functionID in range(0, functions):
+    lines.append("  result += f" + str(functionID) + "(arrays, n, list);")
+  lines.append("  printf(\"%f\\n\", result);")
+  lines.append("  return 0;")
+  lines.append("}")
+
+  return "\n".join(lines) + "\n"
+
+
+if __name__ == '__main__':
+  parser = argparse.ArgumentParser(description = "Generate a synthetic C program")
+  parser.add_argument("--functions", type = int, default = 10, help = "number of functions")
+  parser.add_argument("--depth", type = int, default = 2, help = "depth of the loop nest of every function")
+  parser.add_argument("--block-size", type = int, default = 20, help = "statements in the body of the innermost loops")
+  parser.add_argument("--pointers", type = int, default = 4, help = "pointers that may alias within every function")
+  parser.add_argument("--seed", type = int, default = 0, help = "seed of the generator")
+  args = parser.parse_args()
+  if ((args.functions < 0) or (args.depth < 0) or (args.block_size < 0) or (args.pointers < 1)):
+    parser.error("invalid parameters")
+
+  sys.stdout.write(genProgram(args.functions, args.depth, args.block_size, args.pointers, args.seed))
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "llvm/Pass.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "arcana/noelle/core/Noelle.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace llvm {
+
+/*
+ * Measure the time and the memory taken by the core analyses of NOELLE on
+ * the program given as input, and write them as JSON.
+ */
+class ScalabilityBenchmark : public ModulePass {
+public:
+  ScalabilityBenchmark() : ModulePass{ ID } {}
+
+  /*
+   * Class fields
+   */
+  static char ID;
+
+  bool doInitialization(Module &M) override;
+  bool runOnModule(Module &M) override;
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  struct Measurement {
+    std::string phase;
+    double seconds;
+    int64_t residentKBytesDelta;
+    int64_t peakResidentKBytesDelta;
+    uint64_t items;
+  };
+
+  std::string benchmarkName;
+  std::string outputFileName;
+  std::vector<Measurement> measurements;
+
+  /*
+   * Run @phase, which returns the number of items it produced, and record
+   * its cost.
+   */
+  void measure(const std::string &phaseName, std::function<uint64_t()> phase);
+
+  int64_t getResidentKBytes(void) const;
+
+  int64_t getPeakResidentKBytes(void) const;
+
+  void printJSON(Module &M, raw_ostream &stream) const;
+};
+
+} // namespace llvm
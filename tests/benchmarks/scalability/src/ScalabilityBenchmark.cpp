@@ -0,0 +1,257 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <sys/resource.h>
+#include <unistd.h>
+#include <chrono>
+#include <fstream>
+#include <memory>
+
+#include "arcana/noelle/core/SCCDAG.hpp"
+#include "arcana/noelle/core/DataFlowAnalysis.hpp"
+#include "arcana/noelle/core/MayPointsToAnalysis.hpp"
+
+#include "ScalabilityBenchmark.hpp"
+
+using namespace llvm;
+using namespace arcana::noelle;
+
+static cl::opt<std::string> BenchmarkName(
+    "noelle-benchmark-name",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Name of the benchmark to report"));
+static cl::opt<std::string> BenchmarkOutput(
+    "noelle-benchmark-output",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("JSON file where the measurements are written"));
+
+// Register pass to "opt"
+char ScalabilityBenchmark::ID = 0;
+static RegisterPass<ScalabilityBenchmark> X(
+    "ScalabilityBenchmark",
+    "Measure the scalability of the core analyses of NOELLE");
+
+bool ScalabilityBenchmark::doInitialization(Module &M) {
+  this->benchmarkName = BenchmarkName.getNumOccurrences() > 0
+                            ? BenchmarkName.getValue()
+                            : M.getName().str();
+  this->outputFileName = BenchmarkOutput.getNumOccurrences() > 0
+                             ? BenchmarkOutput.getValue()
+                             : "benchmark.json";
+  return false;
+}
+
+void ScalabilityBenchmark::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<Noelle>();
+  AU.setPreservesAll();
+}
+
+bool ScalabilityBenchmark::runOnModule(Module &M) {
+  errs() << "ScalabilityBenchmark: Start\n";
+  auto &noelle = getAnalysis<Noelle>();
+
+  /*
+   * Fetch the functions to analyze.
+   */
+  std::vector<Function *> functions;
+  for (auto &F : M) {
+    if (!F.empty()) {
+      functions.push_back(&F);
+    }
+  }
+
+  /*
+   * PDG.
+   */
+  PDG *pdg = nullptr;
+  this->measure("PDGGenerator::getPDG", [&]() -> uint64_t {
+    pdg = noelle.getProgramDependenceGraph();
+    return pdg->numEdges();
+  });
+
+  /*
+   * SCCDAGs of the functions.
+   * The dependence graphs of the functions are not part of the measurement.
+   */
+  std::vector<PDG *> functionDGs;
+  for (auto F : functions) {
+    functionDGs.push_back(pdg->createFunctionSubgraph(*F));
+  }
+  std::vector<std::unique_ptr<SCCDAG>> sccdags;
+  this->measure("SCCDAG", [&]() -> uint64_t {
+    uint64_t sccs = 0;
+    for (auto fdg : functionDGs) {
+      sccdags.push_back(std::make_unique<SCCDAG>(fdg));
+      sccs += sccdags.back()->numNodes();
+    }
+    return sccs;
+  });
+  sccdags.clear();
+  for (auto fdg : functionDGs) {
+    delete fdg;
+  }
+
+  /*
+   * Reachability analysis of the functions.
+   */
+  auto dfa = noelle.getDataFlowAnalyses();
+  std::vector<std::unique_ptr<DataFlowResult>> dfrs;
+  this->measure("DataFlowAnalysis::runReachableAnalysis", [&]() -> uint64_t {
+    uint64_t instructions = 0;
+    for (auto F : functions) {
+      dfrs.emplace_back(dfa.runReachableAnalysis(F));
+      instructions += F->getInstructionCount();
+    }
+    return instructions;
+  });
+  dfrs.clear();
+
+  /*
+   * Loops.
+   */
+  this->measure("Noelle::getLoopContents", [&]() -> uint64_t {
+    auto loops = noelle.getLoopContents();
+    auto numberOfLoops = loops->size();
+    delete loops;
+    return numberOfLoops;
+  });
+
+  /*
+   * May points-to summaries of the functions.
+   */
+  std::vector<std::unique_ptr<MpaSummary>> summaries;
+  this->measure("MpaSummary::doMayPointsToAnalysis", [&]() -> uint64_t {
+    for (auto F : functions) {
+      summaries.push_back(std::make_unique<MpaSummary>(F));
+      summaries.back()->doMayPointsToAnalysis();
+    }
+    return summaries.size();
+  });
+  summaries.clear();
+
+  /*
+   * Write the measurements.
+   */
+  std::error_code EC;
+  raw_fd_ostream stream(this->outputFileName, EC);
+  if (EC) {
+    errs() << "ScalabilityBenchmark: ERROR = cannot open "
+           << this->outputFileName << ": " << EC.message() << "\n";
+    abort();
+  }
+  this->printJSON(M, stream);
+  errs() << "ScalabilityBenchmark: Measurements written to "
+         << this->outputFileName << "\n";
+
+  return false;
+}
+
+void ScalabilityBenchmark::measure(const std::string &phaseName,
+                                   std::function<uint64_t()> phase) {
+  auto residentBefore = this->getResidentKBytes();
+  auto peakBefore = this->getPeakResidentKBytes();
+  auto start = std::chrono::steady_clock::now();
+
+  auto items = phase();
+
+  auto end = std::chrono::steady_clock::now();
+  auto residentAfter = this->getResidentKBytes();
+
+  Measurement m;
+  m.phase = phaseName;
+  m.seconds = std::chrono::duration<double>(end - start).count();
+  m.residentKBytesDelta = residentAfter - residentBefore;
+  m.peakResidentKBytesDelta = this->getPeakResidentKBytes() - peakBefore;
+  m.items = items;
+  this->measurements.push_back(m);
+
+  errs() << "ScalabilityBenchmark:   " << phaseName << ": " << m.seconds
+         << " s, " << m.residentKBytesDelta << " KB\n";
+
+  return;
+}
+
+int64_t ScalabilityBenchmark::getResidentKBytes(void) const {
+  std::ifstream statm("/proc/self/statm");
+  int64_t totalPages = 0;
+  int64_t residentPages = 0;
+  if (!(statm >> totalPages >> residentPages)) {
+    return 0;
+  }
+
+  return (residentPages * sysconf(_SC_PAGESIZE)) / 1024;
+}
+
+int64_t ScalabilityBenchmark::getPeakResidentKBytes(void) const {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+
+  return usage.ru_maxrss;
+}
+
+void ScalabilityBenchmark::printJSON(Module &M, raw_ostream &stream) const {
+
+  /*
+   * Size of the program.
+   */
+  uint64_t functions = 0;
+  uint64_t basicBlocks = 0;
+  uint64_t instructions = 0;
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    functions++;
+    basicBlocks += F.size();
+    instructions += F.getInstructionCount();
+  }
+
+  /*
+   * Measurements.
+   * The peak resident memory is a high-water mark of the whole process, so
+   * it is reported once per run; phases report how much they raised it.
+   */
+  stream << "{\n";
+  stream << "  \"benchmark\": \"" << this->benchmarkName << "\",\n";
+  stream << "  \"functions\": " << functions << ",\n";
+  stream << "  \"basicBlocks\": " << basicBlocks << ",\n";
+  stream << "  \"instructions\": " << instructions << ",\n";
+  stream << "  \"peakResidentKBytes\": " << this->getPeakResidentKBytes()
+         << ",\n";
+  stream << "  \"phases\": [\n";
+  for (auto i = 0u; i < this->measurements.size(); i++) {
+    auto &m = this->measurements[i];
+    stream << "    { \"phase\": \"" << m.phase << "\", \"seconds\": "
+           << m.seconds << ", \"residentKBytesDelta\": "
+           << m.residentKBytesDelta << ", \"peakResidentKBytesDelta\": "
+           << m.peakResidentKBytesDelta << ", \"items\": " << m.items
+           << " }";
+    stream << ((i + 1) < this->measurements.size() ? ",\n" : "\n");
+  }
+  stream << "  ]\n";
+  stream << "}\n";
+
+  return;
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <cstdint>
+#include <cstdio>
+
+/*
+ * Exercise the runtime of the loop profiler the way the code injected by
+ * noelle-prof-loops does: every function passes the address of one of its
+ * stack slots as its frame.
+ * The profile written at exit is compared against expected.txt.
+ */
+
+extern "C" {
+void NOELLE_loopInvocationBegin(uint64_t loopID, void *frame);
+void NOELLE_loopIterationBegin(uint64_t loopID, void *frame);
+void NOELLE_loopInvocationEnd(uint64_t loopID, void *frame);
+}
+
+/*
+ * Loop 0 runs @iterations iterations, but an exception unwinds its frame
+ * when the iteration @throwAt starts.
+ */
+__attribute__((noinline)) static void loopThatThrows(int iterations,
+                                                     int throwAt) {
+  char frame;
+  NOELLE_loopInvocationBegin(0, &frame);
+  for (auto i = 0; i < iterations; i++) {
+    NOELLE_loopIterationBegin(0, &frame);
+    if (i == throwAt) {
+      throw i;
+    }
+  }
+  NOELLE_loopInvocationEnd(0, &frame);
+
+  return;
+}
+
+/*
+ * Loop 1 runs two iterations per invocation, and every iteration invokes
+ * the loop again until @depth reaches 0.
+ */
+__attribute__((noinline)) static void recursiveLoop(int depth) {
+  char frame;
+  NOELLE_loopInvocationBegin(1, &frame);
+  for (auto i = 0; i < 2; i++) {
+    NOELLE_loopIterationBegin(1, &frame);
+    if (depth > 0) {
+      recursiveLoop(depth - 1);
+    }
+  }
+  NOELLE_loopInvocationEnd(1, &frame);
+
+  return;
+}
+
+/*
+ * Loop 2 invokes itself once; the inner invocation throws, and the outer one
+ * catches the exception within its loop and keeps iterating.
+ */
+__attribute__((noinline)) static void loopThatCatches(bool isInner) {
+  char frame;
+  NOELLE_loopInvocationBegin(2, &frame);
+  for (auto i = 0; i < 3; i++) {
+    NOELLE_loopIterationBegin(2, &frame);
+    if (isInner) {
+      throw i;
+    }
+    if (i == 0) {
+      try {
+        loopThatCatches(true);
+      } catch (int) {
+      }
+    }
+  }
+  NOELLE_loopInvocationEnd(2, &frame);
+
+  return;
+}
+
+/*
+ * Loop 3 ends in a landing pad, which can also be reached from outside the
+ * loop.
+ */
+__attribute__((noinline)) static void loopThatEndsInALandingPad(
+    bool throwFromTheLoop) {
+  char frame;
+  try {
+    if (!throwFromTheLoop) {
+      throw 0;
+    }
+    NOELLE_loopInvocationBegin(3, &frame);
+    for (auto i = 0; i < 3; i++) {
+      NOELLE_loopIterationBegin(3, &frame);
+    }
+    throw 1;
+  } catch (int) {
+    NOELLE_loopInvocationEnd(3, &frame);
+  }
+
+  return;
+}
+
+int main(int argc, char *argv[]) {
+
+  /*
+   * The invocation unwound by the exception is discarded when the loop is
+   * invoked again.
+   */
+  try {
+    loopThatThrows(5, 2);
+  } catch (int) {
+  }
+  loopThatThrows(4, -1);
+
+  /*
+   * Recursive invocations are kept apart.
+   */
+  recursiveLoop(2);
+
+  /*
+   * Iterations after an exception are attributed to the invocation that
+   * caught it.
+   */
+  loopThatCatches(false);
+
+  /*
+   * Landing pads end only the invocations of their frame.
+   */
+  loopThatEndsInALandingPad(false);
+  loopThatEndsInALandingPad(true);
+
+  printf("Done\n");
+
+  return 0;
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/*
+ * Exercise the queues of the NOELLE runtime with concurrent producers and
+ * consumers.
+ * Queues are small, so producers and consumers keep waiting for each other
+ * and the indices wrap around the ring buffers many times.
+ * The printed summary is compared against expected.txt.
+ */
+
+extern "C" {
+void *NOELLE_queueCreate(uint64_t elementBytes, uint64_t capacity);
+void NOELLE_queueDestroy(void *queue);
+void NOELLE_queuePush8(void *queue, int8_t *value);
+void NOELLE_queuePush64(void *queue, int64_t *value);
+void NOELLE_queuePop8(void *queue, int8_t *value);
+void NOELLE_queuePop64(void *queue, int64_t *value);
+void NOELLE_queuePushBatch(void *queue, void *values, uint64_t n);
+void NOELLE_queuePopBatch(void *queue, void *values, uint64_t n);
+void *NOELLE_mpmcQueueCreate(uint64_t elementBytes, uint64_t capacity);
+void NOELLE_mpmcQueueDestroy(void *queue);
+void NOELLE_mpmcQueuePush64(void *queue, int64_t *value);
+void NOELLE_mpmcQueuePop64(void *queue, int64_t *value);
+}
+
+static const int64_t elements = 100000;
+
+/*
+ * Elements of the batched queue: larger than any fixed-size push.
+ */
+struct Triple {
+  int64_t a;
+  int64_t b;
+  int64_t c;
+};
+
+/*
+ * One producer pushes 0, 1, ... through an SPSC queue of 64-bit values, and
+ * one consumer checks it pops them in the same order.
+ */
+static void testSPSC64(void) {
+  auto queue = NOELLE_queueCreate(sizeof(int64_t), 16);
+  std::thread producer([queue]() {
+    for (int64_t i = 0; i < elements; i++) {
+      NOELLE_queuePush64(queue, &i);
+    }
+  });
+  int64_t sum = 0;
+  auto inOrder = true;
+  for (int64_t i = 0; i < elements; i++) {
+    int64_t value;
+    NOELLE_queuePop64(queue, &value);
+    if (value != i) {
+      inOrder = false;
+    }
+    sum += value;
+  }
+  producer.join();
+  NOELLE_queueDestroy(queue);
+
+  printf("spsc64 %ld %s\n", sum, inOrder ? "ordered" : "unordered");
+
+  return;
+}
+
+/*
+ * Same as testSPSC64 with 8-bit values.
+ */
+static void testSPSC8(void) {
+  auto queue = NOELLE_queueCreate(sizeof(int8_t), 16);
+  std::thread producer([queue]() {
+    for (int64_t i = 0; i < elements; i++) {
+      auto value = (int8_t)i;
+      NOELLE_queuePush8(queue, &value);
+    }
+  });
+  auto inOrder = true;
+  for (int64_t i = 0; i < elements; i++) {
+    int8_t value;
+    NOELLE_queuePop8(queue, &value);
+    if (value != (int8_t)i) {
+      inOrder = false;
+    }
+  }
+  producer.join();
+  NOELLE_queueDestroy(queue);
+
+  printf("spsc8 %s\n", inOrder ? "ordered" : "unordered");
+
+  return;
+}
+
+/*
+ * The producer pushes batches of 5 elements and the consumer pops batches of
+ * 8, so batches are split across the end of the ring buffer and across the
+ * waits for the other side.
+ */
+static void testSPSCBatch(void) {
+  auto queue = NOELLE_queueCreate(sizeof(Triple), 16);
+  std::thread producer([queue]() {
+    Triple batch[5];
+    for (int64_t i = 0; i < elements; i += 5) {
+      for (auto j = 0; j < 5; j++) {
+        batch[j] = { i + j, 2 * (i + j), 3 * (i + j) };
+      }
+      NOELLE_queuePushBatch(queue, batch, 5);
+    }
+  });
+  int64_t sum = 0;
+  auto inOrder = true;
+  Triple batch[8];
+  for (int64_t i = 0; i < elements; i += 8) {
+    NOELLE_queuePopBatch(queue, batch, 8);
+    for (auto j = 0; j < 8; j++) {
+      auto &t = batch[j];
+      if ((t.a != i + j) || (t.b != 2 * t.a) || (t.c != 3 * t.a)) {
+        inOrder = false;
+      }
+      sum += t.a;
+    }
+  }
+  producer.join();
+  NOELLE_queueDestroy(queue);
+
+  printf("spsc-batch %ld %s\n", sum, inOrder ? "ordered" : "unordered");
+
+  return;
+}
+
+/*
+ * Four producers push their own sequence of values through an MPMC queue and
+ * four consumers pop them.
+ * Every value must be popped exactly once, and every consumer must see the
+ * values of each producer in the order they have been pushed.
+ */
+static void testMPMC(void) {
+  const int64_t threads = 4;
+  auto queue = NOELLE_mpmcQueueCreate(sizeof(int64_t), 16);
+  std::vector<std::thread> producers;
+  for (int64_t p = 0; p < threads; p++) {
+    producers.emplace_back([queue, p]() {
+      for (int64_t i = 0; i < elements; i++) {
+        auto value = (p * elements) + i;
+        NOELLE_mpmcQueuePush64(queue, &value);
+      }
+    });
+  }
+  std::vector<std::vector<int64_t>> popped(threads);
+  std::vector<std::thread> consumers;
+  for (int64_t c = 0; c < threads; c++) {
+    consumers.emplace_back([queue, c, &popped]() {
+      for (int64_t i = 0; i < elements; i++) {
+        int64_t value;
+        NOELLE_mpmcQueuePop64(queue, &value);
+        popped[c].push_back(value);
+      }
+    });
+  }
+  for (auto &t : producers) {
+    t.join();
+  }
+  for (auto &t : consumers) {
+    t.join();
+  }
+  NOELLE_mpmcQueueDestroy(queue);
+
+  std::vector<uint8_t> timesPopped(threads * elements, 0);
+  int64_t total = 0;
+  auto inOrder = true;
+  for (auto &values : popped) {
+    std::vector<int64_t> lastOfProducer(threads, -1);
+    for (auto value : values) {
+      timesPopped[value]++;
+      total++;
+      auto p = value / elements;
+      if (value <= lastOfProducer[p]) {
+        inOrder = false;
+      }
+      lastOfProducer[p] = value;
+    }
+  }
+  auto exactlyOnce = true;
+  for (auto times : timesPopped) {
+    if (times != 1) {
+      exactlyOnce = false;
+    }
+  }
+
+  printf("mpmc %ldx%ld %ld %s %s\n",
+         threads,
+         threads,
+         total,
+         exactlyOnce ? "exactly-once" : "lost-or-duplicated",
+         inOrder ? "ordered" : "unordered");
+
+  return;
+}
+
+int main(int argc, char *argv[]) {
+  testSPSC64();
+  testSPSC8();
+  testSPSCBatch();
+  testMPMC();
+
+  return 0;
+}
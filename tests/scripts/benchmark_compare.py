@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+
+"""
+Compare two results of benchmark_run.sh and report the phases that became
+slower, or the benchmarks that used more memory, than the tolerance allows.
+Every metric is the median of the runs of a benchmark, so a single noisy run
+does not cause a regression.
+Exit with 1 if there is any regression.
+"""
+
+import sys
+import json
+import statistics
+
+
+def readResults(pathToFile):
+  samples = {}
+  with open(pathToFile) as f:
+    results = json.load(f)
+  for benchmark in results["benchmarks"]:
+    name = benchmark["benchmark"]
+    for run in benchmark["runs"]:
+      samples.setdefault((name, "whole run", "peakResidentKBytes"), []).append(run["peakResidentKBytes"])
+      for phase in run["phases"]:
+        samples.setdefault((name, phase["phase"], "seconds"), []).append(phase["seconds"])
+
+  medians = {}
+  for key in samples:
+    medians[key] = statistics.median(samples[key])
+
+  return results.get("commit", "unknown"), medians
+
+
+if __name__ == '__main__':
+  if (len(sys.argv) < 3):
+    sys.stderr.write("USAGE: " + sys.argv[0] + " BASELINE_JSON NEW_JSON [TOLERANCE]\n")
+    sys.exit(1)
+  tolerance = float(sys.argv[3]) if (len(sys.argv) > 3) else 1.2
+  baselineCommit, baseline = readResults(sys.argv[1])
+  newCommit, new = readResults(sys.argv[2])
+  print("Comparing " + newCommit + " against " + baselineCommit)
+
+  regressions = 0
+  for key in sorted(new):
+    if (key not in baseline):
+      continue
+    old = baseline[key]
+    current = new[key]
+    ratio = (current / old) if (old > 0) else 1.0
+    status = "ok"
+    if (ratio > tolerance):
+      status = "REGRESSION"
+      regressions += 1
+    print("%-20s %-42s %-20s %12.3f -> %12.3f (%.2fx) %s" % (key[0], key[1], key[2], old, current, ratio, status))
+
+  sys.exit(1 if (regressions > 0) else 0)
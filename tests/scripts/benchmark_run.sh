@@ -0,0 +1,57 @@
+#!/bin/bash -e
+
+if test $# -lt 2 ; then
+  echo "USAGE: `basename $0` CONFIGURATIONS_FILE OUTPUT_JSON [RUNS]" ;
+  exit 1 ;
+fi
+configurations=`realpath $1` ;
+output=`realpath -m $2` ;
+runs=5 ;
+if test $# -gt 2 ; then
+  runs=$3 ;
+fi
+
+# Set the installation directory
+installDir="`git rev-parse --show-toplevel`/install"  ;
+TEST_LIB_DIR=$installDir/test/lib
+TRANSFORMATIONS_BEFORE_PARALLELIZATION="-basicaa -mem2reg -scalar-evolution -loops -loop-simplify -lcssa -domtree -postdomtree"
+GENERATOR="`dirname $(realpath $0)`/../benchmarks/generator/genSyntheticProgram.py"
+
+# Run every configuration
+tmpDir=`mktemp -d` ;
+results="" ;
+while read name functions depth blockSize pointers ; do
+  if test -z "$name" || [[ "$name" == \#* ]] ; then
+    continue ;
+  fi
+  echo "Benchmark: $name" ;
+
+  # Generate the program
+  ${GENERATOR} --functions $functions --depth $depth --block-size $blockSize --pointers $pointers > $tmpDir/$name.c ;
+  clang -emit-llvm -O0 -Xclang -disable-O0-optnone -c $tmpDir/$name.c -o $tmpDir/${name}_pre.bc ;
+  opt ${TRANSFORMATIONS_BEFORE_PARALLELIZATION} $tmpDir/${name}_pre.bc -o $tmpDir/$name.bc ;
+
+  # Measure
+  for run in `seq 1 $runs` ; do
+    noelle-load -load $TEST_LIB_DIR/ScalabilityBenchmark.so -ScalabilityBenchmark -disable-output -noelle-min-hot=0 \
+      -noelle-benchmark-name=$name -noelle-benchmark-output=$tmpDir/${name}_${run}.json $tmpDir/$name.bc ;
+    results="$results $tmpDir/${name}_${run}.json" ;
+  done
+done < $configurations
+
+# Merge the measurements, keeping every run of a benchmark
+python3 - $output `git rev-parse HEAD` $results <<'PYTHON'
+import sys, json
+benchmarks = []
+for fileName in sys.argv[3:]:
+  with open(fileName) as f:
+    run = json.load(f)
+  if ((len(benchmarks) == 0) or (benchmarks[-1]["benchmark"] != run["benchmark"])):
+    benchmarks.append({"benchmark": run["benchmark"], "runs": []})
+  benchmarks[-1]["runs"].append(run)
+with open(sys.argv[1], 'w') as f:
+  json.dump({"commit": sys.argv[2], "benchmarks": benchmarks}, f, indent = 2)
+PYTHON
+
+rm -rf $tmpDir ;
+echo "Results written to $output" ;
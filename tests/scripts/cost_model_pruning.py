@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+
+"""
+Check that pruning the design space of the autotuner with the predictions of
+noelle-loop-cost-model keeps the best configuration of every loop, and that
+this configuration is not skipped as dominated.
+The best configuration of a loop is the one the model predicts to be the
+fastest; every configuration of the full space is checked against it.
+Exit with 1 if the best configuration of any loop is lost.
+"""
+
+import os
+import sys
+import tempfile
+import itertools
+
+thisPath = os.path.dirname(os.path.abspath(__file__))
+sys.path.append(thisPath + "/../../src/autotuner/utils")
+import utils
+
+# Dimensions of a loop: enable, unroll, peel, technique, cores, DOALL chunk,
+# HELIX fix segments, HELIX segments, DSWP queue packing
+SPACE = """\
+1 2 1 1 3 17 1 1 1 1
+2 2 1 1 3 17 1 1 1 1
+3 2 1 1 3 17 1 1 1 1
+4 2 1 1 3 17 1 1 1 1
+"""
+
+# LOOP_ID TECHNIQUE CORES COVERAGE LOOP_SPEEDUP OVERHEAD
+def predictions():
+  lines = []
+  for cores in range(2, 17):
+
+    # Loop 1: DOALL scales up to 8 cores and then the dispatch dominates
+    lines.append((1, 0, cores, 0.5, min(cores, 8) * 0.95 - max(cores - 8, 0) * 0.1, 0.05))
+    lines.append((1, 1, cores, 0.5, min(cores, 3) * 0.9, 0.2))
+
+    # Loop 2: only HELIX speeds it up, up to 4 cores
+    lines.append((2, 1, cores, 0.3, 1.0 + min(cores, 4) * 0.3, 0.3))
+    lines.append((2, 2, cores, 0.3, 0.8, 0.5))
+
+    # Loop 3: nothing speeds it up
+    lines.append((3, 1, cores, 0.1, 0.6, 0.7))
+
+    # Loop 4: a pipeline of 3 stages
+    lines.append((4, 1, cores, 0.1, 1.1, 0.4))
+    lines.append((4, 2, cores, 0.1, 1.0 + min(cores, 3) * 0.4, 0.2))
+
+  return "".join([" ".join([str(e) for e in line]) + "\n" for line in lines])
+
+# Best configuration of each loop: (enabled, technique, cores)
+KNOWN_BEST = {
+  1: (1, 0, 8),
+  2: (1, 1, 4),
+  3: (0, 0, 0),
+  4: (1, 2, 3),
+}
+
+
+def writeFile(directory, name, content):
+  pathToFile = os.path.join(directory, name)
+  with open(pathToFile, 'w') as f:
+    f.write(content)
+
+  return pathToFile
+
+
+def valuesOfDimension(elem):
+  # Values of a dimension of the space: either a cardinality or "cardinality_value"
+  if (elem.isdigit()):
+    return list(range(0, max(int(elem), 1)))
+  _, value = elem.split("_")
+
+  return [int(value)]
+
+
+def loopConfs(loopRanges):
+  # Configurations of the dimensions (enable, technique, cores) of a loop
+  confs = []
+  for enabled, technique, cores in itertools.product(valuesOfDimension(loopRanges[0]), valuesOfDimension(loopRanges[3]), valuesOfDimension(loopRanges[4])):
+    if (enabled == 0):
+      confs.append((0, 0, 0))
+    else:
+      confs.append((enabled, technique, cores))
+
+  return sorted(set(confs))
+
+
+def predictedSpeedup(model, loopID, conf):
+  enabled, technique, cores = conf
+  if ((enabled == 0) or (cores < 2)):
+    return 1.0
+  predictionsOfTechnique = model[loopID].get(technique, {})
+  if (cores not in predictionsOfTechnique):
+    return 0.0
+
+  return predictionsOfTechnique[cores][1]
+
+
+def main():
+  with tempfile.TemporaryDirectory() as directory:
+    ranges, loopIDs = utils.readSpaceFile(writeFile(directory, "space.txt", SPACE))
+    model = utils.readCostModelFile(writeFile(directory, "model.txt", predictions()))
+  fullRanges = {loopID: list(ranges[loopID]) for loopID in loopIDs}
+
+  for message in utils.pruneSpaceWithCostModel(ranges, loopIDs, model, 1.0):
+    print("Pruning: " + message)
+
+  failed = False
+  for loopID in loopIDs:
+    fullConfs = loopConfs(fullRanges[loopID])
+    prunedConfs = loopConfs(ranges[loopID])
+    bestConf = max(fullConfs, key = lambda conf: predictedSpeedup(model, loopID, conf))
+    print("Loop " + str(loopID) + ": " + str(len(prunedConfs)) + " of " + str(len(fullConfs)) + " configurations kept, best " + str(bestConf))
+
+    # The best configuration is the known one
+    if (bestConf != KNOWN_BEST[loopID]):
+      print("  ERROR: the best configuration should be " + str(KNOWN_BEST[loopID]))
+      failed = True
+
+    # The pruned space includes it
+    if (bestConf not in prunedConfs):
+      print("  ERROR: the best configuration has been pruned")
+      failed = True
+
+    # It is not skipped as dominated
+    enabled, technique, cores = bestConf
+    conf = {loopID: [enabled, 0, 0, technique, cores, 0, 0, 0, 0]}
+    if (utils.isConfDominatedByCostModel(conf, model, 1.0)):
+      print("  ERROR: the best configuration is considered dominated")
+      failed = True
+
+    # The space shrinks
+    if (len(prunedConfs) >= len(fullConfs)):
+      print("  ERROR: the space of the loop has not been pruned")
+      failed = True
+
+  if (failed):
+    sys.exit(1)
+  print("PASS")
+
+  return
+
+
+if __name__ == '__main__':
+  main()
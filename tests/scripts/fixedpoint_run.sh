@@ -0,0 +1,67 @@
+#!/bin/bash -e
+
+# Check the in-process fixed-point driver (noelle-fixedpoint and its
+# -noelle-fixedpoint-passes option): passes run until they do not change the
+# code anymore, and unknown passes are rejected.
+
+# Set the installation directory
+installDir="`git rev-parse --show-toplevel`/install"  ;
+export NOELLE_INSTALL_DIR="$installDir" ;
+
+tmpDir=`mktemp -d` ;
+failures=0 ;
+
+# Check that the command $2 succeeds
+function check {
+  local name=$1
+  if eval "$2" ; then
+    echo "PASS: $name" ;
+  else
+    echo "FAIL: $name" ;
+    failures=$((failures + 1)) ;
+  fi
+}
+
+# Generate a program with a chain of functions that cannot be invoked
+cat > $tmpDir/test.c <<'PROGRAM'
+int dead3(int x) {
+  return x * 3;
+}
+
+int dead2(int x) {
+  return dead3(x) + 2;
+}
+
+int dead1(int x) {
+  return dead2(x) + 1;
+}
+
+int main(int argc, char *argv[]) {
+  return argc;
+}
+PROGRAM
+clang -emit-llvm -O0 -Xclang -disable-O0-optnone -c $tmpDir/test.c -o $tmpDir/test.bc ;
+
+# Run the passes through the script
+if noelle-fixedpoint $tmpDir/test.bc $tmpDir/out.bc DeadFunctionEliminator,DeadFunctionEliminator -load $installDir/lib/DeadFunctionEliminator.so &> $tmpDir/log.txt ; then
+  check "noelle-fixedpoint succeeds" true ;
+else
+  check "noelle-fixedpoint succeeds" false ;
+fi
+llvm-dis $tmpDir/out.bc -o $tmpDir/out.ll || true ;
+check "both passes of the comma-separated list are scheduled" "grep -q 'Passes: DeadFunctionEliminator DeadFunctionEliminator' $tmpDir/log.txt" ;
+check "the fixed point is reached" "grep -q 'Iteration count = [1-9]' $tmpDir/log.txt" ;
+check "dead functions are removed" "! grep -q 'define .*@dead' $tmpDir/out.ll" ;
+check "main is kept" "grep -q 'define .*@main' $tmpDir/out.ll" ;
+
+# Run the driver directly with a pass that is not registered
+if noelle-load -load $installDir/lib/FixedPoint.so -FixedPoint -noelle-fixedpoint-passes=NotAPass $tmpDir/test.bc -o $tmpDir/out_unknown.bc &> $tmpDir/log_unknown.txt ; then
+  check "unknown passes are rejected" false ;
+else
+  check "unknown passes are rejected" "grep -q 'NotAPass is not registered' $tmpDir/log_unknown.txt" ;
+fi
+
+rm -rf $tmpDir ;
+if test $failures != 0 ; then
+  exit 1 ;
+fi
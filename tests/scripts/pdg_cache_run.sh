@@ -0,0 +1,113 @@
+#!/bin/bash -e
+
+# Check that the PDG cache (-noelle-pdg-cache) is invalidated when state the
+# alias analyses depend on changes (global variables and TBAA tags), and that
+# unchanged functions still hit it when another function changes.
+
+# Set the installation directory
+installDir="`git rev-parse --show-toplevel`/install"  ;
+export NOELLE_INSTALL_DIR="$installDir" ;
+TRANSFORMATIONS_BEFORE_PARALLELIZATION="-basicaa -mem2reg -scalar-evolution -loops -loop-simplify -lcssa -domtree -postdomtree"
+
+tmpDir=`mktemp -d` ;
+cacheDir=$tmpDir/cache ;
+failures=0 ;
+
+# Print the cache report of a PDG computation of the IR file $1
+function cacheReport {
+  ( cd $tmpDir ; noelle-pdg -noelle-pdg-cache=$cacheDir $1 2>&1 ) | grep "PDGGenerator: Cache of" | tail -n 1 ;
+}
+
+# Print the number of cache misses of a PDG computation of the IR file $1
+function cacheMisses {
+  cacheReport $1 | sed 's/.* \([0-9]*\) misses/\1/' ;
+}
+
+# Check that the number of misses $2 is greater than $3
+function checkMoreMisses {
+  local name=$1
+  local misses=$2
+  local baseline=$3
+  if test "$misses" -gt "$baseline" ; then
+    echo "PASS: $name" ;
+  else
+    echo "FAIL: $name: $misses cache misses, expected more than $baseline" ;
+    failures=$((failures + 1)) ;
+  fi
+}
+
+# Check that the number of hits $2 is greater than 0
+function checkHits {
+  local name=$1
+  local hits=$2
+  if test "$hits" -gt 0 ; then
+    echo "PASS: $name" ;
+  else
+    echo "FAIL: $name: no cache hits" ;
+    failures=$((failures + 1)) ;
+  fi
+}
+
+# Generate a program that uses a global variable and accesses memory through
+# TBAA-tagged loads and stores
+cat > $tmpDir/test.c <<'PROGRAM'
+int g = 1;
+
+void update(int *a, long *b, int n) {
+  for (int i = 0; i < n; i++) {
+    a[i] = a[i] + g;
+    b[i] = b[i] * 2;
+  }
+}
+
+long scale(long *b, int n) {
+  long s = 0;
+  for (int i = 0; i < n; i++) {
+    s += b[i] * 3;
+  }
+  return s;
+}
+
+int main(int argc, char *argv[]) {
+  int a[100];
+  long b[100];
+  for (int i = 0; i < 100; i++) {
+    a[i] = i;
+    b[i] = argc;
+  }
+  update(a, b, 100);
+  return a[argc] + (int)b[argc] + (int)scale(b, 100);
+}
+PROGRAM
+clang -emit-llvm -O1 -Xclang -disable-llvm-passes -c $tmpDir/test.c -o $tmpDir/test_pre.bc ;
+opt ${TRANSFORMATIONS_BEFORE_PARALLELIZATION} $tmpDir/test_pre.bc -o $tmpDir/test.bc ;
+llvm-dis $tmpDir/test.bc -o $tmpDir/test.ll ;
+
+# Fill the cache and check that an unchanged module hits it
+firstMisses=`cacheMisses $tmpDir/test.ll` ;
+baseline=`cacheMisses $tmpDir/test.ll` ;
+checkMoreMisses "unchanged module hits the cache" $firstMisses $baseline ;
+
+# Change a global variable
+sed 's/^@g = \(.*\)global i32 1/@g = \1constant i32 1/' $tmpDir/test.ll > $tmpDir/test_global.ll ;
+checkMoreMisses "changed global variable" `cacheMisses $tmpDir/test_global.ll` $baseline ;
+
+# Change a TBAA tag: "long" accesses become "int" ones, so they may alias
+sed 's/!"long"/!"int"/' $tmpDir/test.ll > $tmpDir/test_tbaa.ll ;
+checkMoreMisses "changed TBAA tag" `cacheMisses $tmpDir/test_tbaa.ll` $baseline ;
+
+# Change the arithmetic of one function: its dependences and those of its
+# callers are recomputed, while the other functions still hit the cache
+sed 's/^\(  %[0-9a-z.]* = mul nsw i64 %[0-9a-z.]*\), 3$/\1, 5/' $tmpDir/test.ll > $tmpDir/test_scale.ll ;
+if cmp -s $tmpDir/test.ll $tmpDir/test_scale.ll ; then
+  echo "FAIL: changed function: the edit did not apply" ;
+  failures=$((failures + 1)) ;
+fi
+report=`cacheReport $tmpDir/test_scale.ll` ;
+checkMoreMisses "changed function" `echo "$report" | sed 's/.* \([0-9]*\) misses/\1/'` $baseline ;
+checkHits "unchanged functions" `echo "$report" | sed 's/.* \([0-9]*\) hits,.*/\1/'` ;
+
+rm -rf $tmpDir ;
+if test $failures != 0 ; then
+  exit 1 ;
+fi
@@ -69,6 +69,7 @@ public:
 private:
   static Values verifyDisjointAccessBetweenIterations(ModulePass &pass,
                                                       TestSuite &suite);
+  static Values verifyDependenceVectors(ModulePass &pass, TestSuite &suite);
   static Values verifyDisjointAccessBetweenIterationsAfterSCEVSimplification(
       ModulePass &pass,
       TestSuite &suite);
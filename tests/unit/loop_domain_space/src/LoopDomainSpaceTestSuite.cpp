@@ -50,11 +50,13 @@ static RegisterStandardPasses _RegPass2(
 
 const char *LoopDomainSpaceTestSuite::tests[] = {
   "verifyDisjointAccessBetweenIterations",
+  "verifyDependenceVectors",
   "verifyDisjointAccessBetweenIterationsAfterSCEVSimplification"
 };
 
 TestFunction LoopDomainSpaceTestSuite::testFns[] = {
   LoopDomainSpaceTestSuite::verifyDisjointAccessBetweenIterations,
+  LoopDomainSpaceTestSuite::verifyDependenceVectors,
   LoopDomainSpaceTestSuite::
       verifyDisjointAccessBetweenIterationsAfterSCEVSimplification
 };
@@ -118,6 +120,99 @@ Values LoopDomainSpaceTestSuite::
   return attrPass.collectDisjointAccessesBetweenIterations(pass, suite);
 }
 
+Values LoopDomainSpaceTestSuite::verifyDependenceVectors(ModulePass &pass,
+                                                        TestSuite &suite) {
+  LoopDomainSpaceTestSuite &attrPass =
+      static_cast<LoopDomainSpaceTestSuite &>(pass);
+  attrPass.computeAnalysisWithoutSCEVSimplification();
+
+  /*
+   * Name the loads and stores of the loop nest by their position in the code
+   * (e.g., "store 2"), as the names of the instructions are not stable.
+   */
+  auto loop = attrPass.loopNode->getLoop();
+  std::vector<std::pair<Instruction *, std::string>> memoryAccesses;
+  for (auto &B : *loop->getFunction()) {
+    if (!loop->isIncluded(&B)) {
+      continue;
+    }
+    for (auto &I : B) {
+      if (!isa<StoreInst>(&I) && !isa<LoadInst>(&I)) {
+        continue;
+      }
+      auto name = std::string(isa<StoreInst>(&I) ? "store " : "load ")
+                  + std::to_string(memoryAccesses.size());
+      memoryAccesses.push_back(std::make_pair(&I, name));
+    }
+  }
+
+  /*
+   * Describe the dependence from every access to every store, and from every
+   * store to every access: its classification and its directions per loop,
+   * from the outermost.
+   */
+  Values dependences;
+  for (auto &from : memoryAccesses) {
+    for (auto &to : memoryAccesses) {
+      if (!isa<StoreInst>(from.first) && !isa<StoreInst>(to.first)) {
+        continue;
+      }
+      auto vector =
+          attrPass.domainSpaceAnalysis->computeDependenceVector(from.first,
+                                                                to.first);
+      if (!vector) {
+        continue;
+      }
+      std::string classification;
+      switch (attrPass.domainSpaceAnalysis->classifyDependence(from.first,
+                                                               to.first)) {
+        case LoopIterationSpaceAnalysis::DEPENDENCE_DISPROVED:
+          classification = "disproved";
+          break;
+        case LoopIterationSpaceAnalysis::DEPENDENCE_WITHIN_ITERATIONS:
+          classification = "within iterations";
+          break;
+        default:
+          classification = "loop-carried";
+          break;
+      }
+      std::string directions = "(";
+      for (auto l = 0u; l < vector->directions.size(); l++) {
+        if (l > 0) {
+          directions += ",";
+        }
+        auto direction = vector->directions[l];
+        if (direction == LoopIterationSpaceAnalysis::DIRECTION_ANY) {
+          directions += "*";
+          continue;
+        }
+        if (direction == LoopIterationSpaceAnalysis::DIRECTION_NONE) {
+          directions += "none";
+          continue;
+        }
+        if (direction & LoopIterationSpaceAnalysis::DIRECTION_BEFORE) {
+          directions += "<";
+        }
+        if (direction & LoopIterationSpaceAnalysis::DIRECTION_SAME) {
+          directions += "=";
+        }
+        if (direction & LoopIterationSpaceAnalysis::DIRECTION_AFTER) {
+          directions += ">";
+        }
+      }
+      directions += ")";
+
+      dependences.insert(suite.combineOrderedValues(
+          std::vector<std::string>{ from.second,
+                                    to.second,
+                                    classification,
+                                    directions }));
+    }
+  }
+
+  return dependences;
+}
+
 Values LoopDomainSpaceTestSuite::collectDisjointAccessesBetweenIterations(
     ModulePass &pass,
     TestSuite &suite) {
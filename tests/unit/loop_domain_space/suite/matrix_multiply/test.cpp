@@ -0,0 +1,27 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+int64_t A[100][100];
+int64_t B[100][100];
+int64_t C[100][100];
+
+int main (int argc, char *argv[]){
+  A[0][0] = argc;
+  B[0][0] = argc * 2;
+
+  /*
+   * The accumulation into C is carried by the inner loops only
+   */
+  for (int64_t i = 0; i < 100; i++) {
+    for (int64_t j = 0; j < 100; j++) {
+      for (int64_t k = 0; k < 100; k++) {
+        C[i][j] += A[i][k] * B[k][j];
+      }
+    }
+  }
+
+  printf("%ld, %ld\n", C[0][0], C[99][99]);
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+int64_t A[100];
+
+int main (int argc, char *argv[]){
+  A[99] = argc;
+
+  /*
+   * Every iteration reads the element that the next iteration writes:
+   * the dependence from the store to the load has a negative distance
+   */
+  for (int64_t i = 0; i < 99; i++) {
+    A[i] = A[i + 1] + 1;
+  }
+
+  printf("%ld, %ld\n", A[0], A[98]);
+
+  return 0;
+}
@@ -0,0 +1,23 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+int64_t A[100];
+
+int main (int argc, char *argv[]){
+  A[0] = argc;
+  A[99] = argc * 2;
+
+  /*
+   * The read of the previous element depends on the write of the previous
+   * iteration, while the read of the next element must happen before the
+   * write of the next iteration
+   */
+  for (int64_t i = 1; i < 99; i++) {
+    A[i] = (A[i - 1] + A[i + 1]) / 2;
+  }
+
+  printf("%ld, %ld\n", A[1], A[98]);
+
+  return 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "llvm/Pass.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+
+#include "arcana/noelle/core/Noelle.hpp"
+#include "arcana/noelle/core/LoopEnvironmentBuilder.hpp"
+
+#include "TestSuite.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace parallelizertests;
+
+namespace arcana::noelle {
+
+class LoopEnvironmentTestSuite : public ModulePass {
+public:
+  LoopEnvironmentTestSuite() : ModulePass{ ID } {}
+
+  /*
+   * Class fields
+   */
+  static char ID;
+  static const char *tests[];
+  static parallelizertests::TestFunction testFns[];
+
+  bool doInitialization(Module &M) override;
+  bool runOnModule(Module &M) override;
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  static Values verifyLayout(ModulePass &pass, TestSuite &suite);
+  static Values verifyCompactLayout(ModulePass &pass, TestSuite &suite);
+
+  /*
+   * Build the environment of the loop with -noelle-compact-environment set
+   * to @compact, and print its layout.
+   */
+  std::unique_ptr<LoopEnvironmentBuilder> buildEnvironment(bool compact);
+
+  TestSuite *suite;
+  Module *M;
+  LoopEnvironment *environment;
+  std::vector<uint32_t> liveInIDs;
+  std::vector<uint32_t> liveOutIDs;
+};
+
+} // namespace arcana::noelle
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "LoopEnvironmentTestSuite.hpp"
+#include "arcana/noelle/core/Architecture.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char LoopEnvironmentTestSuite::ID = 0;
+static RegisterPass<LoopEnvironmentTestSuite> X("UnitTester",
+                                                "Loop Environment Unit Tester");
+
+// Register pass to "clang"
+static LoopEnvironmentTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new LoopEnvironmentTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new LoopEnvironmentTestSuite());
+      }
+    }); // ** for -O0
+
+const char *LoopEnvironmentTestSuite::tests[] = { "verifyLayout",
+                                                  "verifyCompactLayout" };
+TestFunction LoopEnvironmentTestSuite::testFns[] = {
+  LoopEnvironmentTestSuite::verifyLayout,
+  LoopEnvironmentTestSuite::verifyCompactLayout
+};
+
+bool LoopEnvironmentTestSuite::doInitialization(Module &M) {
+  errs() << "LoopEnvironmentTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("LoopEnvironmentTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void LoopEnvironmentTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<Noelle>();
+}
+
+bool LoopEnvironmentTestSuite::runOnModule(Module &M) {
+  errs() << "LoopEnvironmentTestSuite: Start\n";
+  auto &noelle = getAnalysis<Noelle>();
+
+  /*
+   * Fetch the environment of the outermost loop of main.
+   */
+  auto mainFunction = M.getFunction("main");
+  auto loops = noelle.getLoopStructures(mainFunction, 0);
+  LoopStructure *outermostLoop = nullptr;
+  for (auto loop : *loops) {
+    if (loop->getNestingLevel() == 1) {
+      outermostLoop = loop;
+      break;
+    }
+  }
+  assert(outermostLoop != nullptr);
+  auto loopContent = noelle.getLoopContent(outermostLoop);
+  this->environment = loopContent->getEnvironment();
+  for (auto id : this->environment->getEnvIDsOfLiveInVars()) {
+    this->liveInIDs.push_back(id);
+  }
+  for (auto id : this->environment->getEnvIDsOfLiveOutVars()) {
+    this->liveOutIDs.push_back(id);
+  }
+
+  suite->runTests((ModulePass &)*this);
+
+  delete loopContent;
+  delete loops;
+
+  return false;
+}
+
+std::unique_ptr<LoopEnvironmentBuilder> LoopEnvironmentTestSuite::
+    buildEnvironment(bool compact) {
+
+  /*
+   * Set -noelle-compact-environment for the builder.
+   */
+  auto &options = cl::getRegisteredOptions();
+  auto option = options.find("noelle-compact-environment");
+  assert(option != options.end());
+  auto compactOption = static_cast<cl::opt<bool> *>(option->second);
+  auto wasCompact = compactOption->getValue();
+  compactOption->setValue(compact);
+
+  auto builder = std::make_unique<LoopEnvironmentBuilder>(
+      this->M->getContext(),
+      this->environment,
+      1);
+
+  compactOption->setValue(wasCompact);
+
+  builder->printLayout(errs(), "LoopEnvironmentTestSuite: ");
+
+  return builder;
+}
+
+Values LoopEnvironmentTestSuite::verifyLayout(ModulePass &pass,
+                                              TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  auto builder = envPass.buildEnvironment(false);
+  auto lineBytes = Architecture::getCacheLineBytes();
+  auto slotsInLine = lineBytes / sizeof(int64_t);
+
+  /*
+   * Every variable has its own cache line, in the order of their IDs.
+   */
+  std::set<uint32_t> ids;
+  ids.insert(envPass.liveInIDs.begin(), envPass.liveInIDs.end());
+  ids.insert(envPass.liveOutIDs.begin(), envPass.liveOutIDs.end());
+  auto inOrderOfIDs = true;
+  uint64_t index = 0;
+  for (auto id : ids) {
+    if (builder->getOffsetOfEnvironmentVariable(id) != index * slotsInLine) {
+      inOrderOfIDs = false;
+    }
+    index++;
+  }
+
+  Values values;
+  values.insert(suite.combineOrderedValues(
+      { "variables", std::to_string(ids.size()) }));
+  values.insert(suite.combineOrderedValues(
+      { "cache lines",
+        std::to_string(builder->getEnvironmentBytes() / lineBytes) }));
+  values.insert(suite.combineOrderedValues(
+      { "offsets follow the IDs", inOrderOfIDs ? "true" : "false" }));
+
+  return values;
+}
+
+Values LoopEnvironmentTestSuite::verifyCompactLayout(ModulePass &pass,
+                                                     TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  auto builder = envPass.buildEnvironment(true);
+  auto lineBytes = Architecture::getCacheLineBytes();
+
+  /*
+   * Live-outs are written by the tasks, so they come before the live-ins
+   * that are only read.
+   */
+  auto writtenFirst = true;
+  for (auto liveOutID : envPass.liveOutIDs) {
+    auto liveOutOffset = builder->getOffsetOfEnvironmentVariable(liveOutID);
+    for (auto liveInID : envPass.liveInIDs) {
+      if (builder->getOffsetOfEnvironmentVariable(liveInID) < liveOutOffset) {
+        writtenFirst = false;
+      }
+    }
+  }
+
+  Values values;
+  values.insert(suite.combineOrderedValues(
+      { "variables",
+        std::to_string(envPass.liveInIDs.size()
+                       + envPass.liveOutIDs.size()) }));
+  values.insert(suite.combineOrderedValues(
+      { "cache lines",
+        std::to_string(builder->getEnvironmentBytes() / lineBytes) }));
+  values.insert(suite.combineOrderedValues(
+      { "variables written by the tasks first",
+        writtenFirst ? "true" : "false" }));
+
+  return values;
+}
+
+} // namespace arcana::noelle
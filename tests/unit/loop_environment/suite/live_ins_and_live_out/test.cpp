@@ -0,0 +1,23 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+int main (int argc, char *argv[]){
+  int64_t iterations = argc * 10;
+  int64_t factor = argc + 3;
+  int64_t *array = (int64_t *)calloc(iterations, sizeof(int64_t));
+
+  /*
+   * The loop reads three live-ins (iterations, factor, array) and produces
+   * one live-out (sum)
+   */
+  int64_t sum = 0;
+  for (int64_t i = 0; i < iterations; i++) {
+    array[i] = i * factor;
+    sum += array[i];
+  }
+
+  printf("%ld\n", sum);
+
+  return 0;
+}
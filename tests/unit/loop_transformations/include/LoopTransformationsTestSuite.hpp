@@ -0,0 +1,86 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "llvm/Pass.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Verifier.h"
+
+#include "arcana/noelle/core/Noelle.hpp"
+#include "arcana/noelle/core/LoopInterchange.hpp"
+#include "arcana/noelle/core/LoopTiling.hpp"
+#include "arcana/noelle/core/LoopFusion.hpp"
+
+#include "TestSuite.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace parallelizertests;
+
+namespace arcana::noelle {
+
+class LoopTransformationsTestSuite : public ModulePass {
+public:
+  LoopTransformationsTestSuite() : ModulePass{ ID } {}
+
+  /*
+   * Class fields
+   */
+  static char ID;
+  static const char *tests[];
+  static parallelizertests::TestFunction testFns[];
+
+  bool doInitialization(Module &M) override;
+  bool runOnModule(Module &M) override;
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  static Values verifyInterchange(ModulePass &pass, TestSuite &suite);
+  static Values verifyTiling(ModulePass &pass, TestSuite &suite);
+  static Values verifyFusion(ModulePass &pass, TestSuite &suite);
+
+  /*
+   * Return the step, in bytes, of the address of the first store of the
+   * innermost loop of main across the iterations of that loop (0 if it is not
+   * a constant).
+   */
+  int64_t computeStrideOfInnermostStore(void);
+
+  /*
+   * Return the number of loops of main computed from its current code.
+   */
+  uint32_t countLoopsOfMain(void);
+
+  TestSuite *suite;
+  Module *M;
+  Noelle *noelle;
+  Function *mainF;
+  std::vector<LoopContent *> outermostLoops;
+  LoopInfo *LI;
+  ScalarEvolution *SE;
+};
+
+} // namespace arcana::noelle
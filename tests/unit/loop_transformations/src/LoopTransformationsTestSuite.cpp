@@ -0,0 +1,273 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "LoopTransformationsTestSuite.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char LoopTransformationsTestSuite::ID = 0;
+static RegisterPass<LoopTransformationsTestSuite> X(
+    "UnitTester",
+    "Loop Transformations Unit Tester");
+
+// Register pass to "clang"
+static LoopTransformationsTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new LoopTransformationsTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new LoopTransformationsTestSuite());
+      }
+    }); // ** for -O0
+
+const char *LoopTransformationsTestSuite::tests[] = { "verifyInterchange",
+                                                      "verifyTiling",
+                                                      "verifyFusion" };
+TestFunction LoopTransformationsTestSuite::testFns[] = {
+  LoopTransformationsTestSuite::verifyInterchange,
+  LoopTransformationsTestSuite::verifyTiling,
+  LoopTransformationsTestSuite::verifyFusion
+};
+
+bool LoopTransformationsTestSuite::doInitialization(Module &M) {
+  errs() << "LoopTransformationsTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("LoopTransformationsTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void LoopTransformationsTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<Noelle>();
+  AU.addRequired<LoopInfoWrapperPass>();
+  AU.addRequired<ScalarEvolutionWrapperPass>();
+}
+
+bool LoopTransformationsTestSuite::runOnModule(Module &M) {
+  errs() << "LoopTransformationsTestSuite: Start\n";
+  auto &noelle = getAnalysis<Noelle>();
+
+  /*
+   * Fetch the outermost loops of main in program order.
+   * Each test transforms the code, so each program only lists one test.
+   */
+  this->noelle = &noelle;
+  this->mainF = M.getFunction("main");
+  auto loops = noelle.getLoopStructures(this->mainF, 0);
+  for (auto &bb : *this->mainF) {
+    for (auto loop : *loops) {
+      if ((loop->getNestingLevel() == 1) && (loop->getHeader() == &bb)) {
+        this->outermostLoops.push_back(noelle.getLoopContent(loop));
+      }
+    }
+  }
+  assert(!this->outermostLoops.empty());
+
+  /*
+   * Fetch the LLVM analyses the transformations keep up to date.
+   */
+  this->LI = &getAnalysis<LoopInfoWrapperPass>(*this->mainF).getLoopInfo();
+  this->SE = &getAnalysis<ScalarEvolutionWrapperPass>(*this->mainF).getSE();
+
+  suite->runTests((ModulePass &)*this);
+
+  for (auto ldi : this->outermostLoops) {
+    delete ldi;
+  }
+  delete loops;
+  delete this->suite;
+
+  return false;
+}
+
+int64_t LoopTransformationsTestSuite::computeStrideOfInnermostStore(void) {
+
+  /*
+   * Fetch the innermost loop.
+   */
+  Loop *innermostLoop = nullptr;
+  for (auto loop : this->LI->getLoopsInPreorder()) {
+    if (loop->getSubLoops().empty()) {
+      innermostLoop = loop;
+      break;
+    }
+  }
+  if (innermostLoop == nullptr) {
+    return 0;
+  }
+
+  /*
+   * Fetch the step of the address of its first store.
+   */
+  for (auto bb : innermostLoop->getBlocks()) {
+    for (auto &inst : *bb) {
+      auto store = dyn_cast<StoreInst>(&inst);
+      if (store == nullptr) {
+        continue;
+      }
+      auto address = this->SE->getSCEV(store->getPointerOperand());
+      auto addRec = dyn_cast<SCEVAddRecExpr>(address);
+      if ((addRec == nullptr) || (addRec->getLoop() != innermostLoop)) {
+        return 0;
+      }
+      auto step = dyn_cast<SCEVConstant>(addRec->getStepRecurrence(*this->SE));
+      if (step == nullptr) {
+        return 0;
+      }
+      return step->getAPInt().getSExtValue();
+    }
+  }
+
+  return 0;
+}
+
+uint32_t LoopTransformationsTestSuite::countLoopsOfMain(void) {
+  DominatorTree DT(*this->mainF);
+  LoopInfo LI(DT);
+
+  return LI.getLoopsInPreorder().size();
+}
+
+Values LoopTransformationsTestSuite::verifyInterchange(ModulePass &pass,
+                                                       TestSuite &suite) {
+  auto &transformationsPass = static_cast<LoopTransformationsTestSuite &>(pass);
+  auto &LI = *transformationsPass.LI;
+  auto &SE = *transformationsPass.SE;
+  auto &ldi = *transformationsPass.outermostLoops.front();
+  LoopInterchange interchange;
+
+  /*
+   * A permutation that does not place every loop of the nest is rejected.
+   */
+  auto invalid = interchange.interchangeLoops(ldi, { 0, 0 }, LI, SE);
+
+  /*
+   * Swap the two loops of the nest.
+   * The stride before the swap is computed first so the SCEVs of the nest are
+   * cached, and the stride after it shows whether they have been forgotten.
+   */
+  auto strideBefore = transformationsPass.computeStrideOfInnermostStore();
+  auto swapped = interchange.interchangeLoops(ldi, { 1, 0 }, LI, SE);
+  auto strideAfter = transformationsPass.computeStrideOfInnermostStore();
+
+  Values values;
+  values.insert(suite.combineOrderedValues(
+      { "invalid permutation", invalid ? "interchanged" : "rejected" }));
+  values.insert(suite.combineOrderedValues(
+      { "swapped loops", swapped ? "interchanged" : "rejected" }));
+  values.insert(suite.combineOrderedValues(
+      { "innermost stride before", std::to_string(strideBefore) }));
+  values.insert(suite.combineOrderedValues(
+      { "innermost stride after", std::to_string(strideAfter) }));
+
+  return values;
+}
+
+Values LoopTransformationsTestSuite::verifyTiling(ModulePass &pass,
+                                                  TestSuite &suite) {
+  auto &transformationsPass = static_cast<LoopTransformationsTestSuite &>(pass);
+  auto &ldi = *transformationsPass.outermostLoops.front();
+  LoopTiling tiling;
+
+  /*
+   * Tile every loop of the nest with 16 iterations per tile.
+   */
+  auto loopsBefore = transformationsPass.countLoopsOfMain();
+  std::vector<uint32_t> tileSizes(loopsBefore, 16);
+  auto tiled = tiling.tileLoopNest(ldi,
+                                   tileSizes,
+                                   *transformationsPass.LI,
+                                   *transformationsPass.SE);
+  auto loopsAfter = transformationsPass.countLoopsOfMain();
+
+  /*
+   * The loop forest of the nest must include the new tile loops.
+   */
+  auto tree = ldi.getLoopHierarchyStructures();
+  while (tree->getParent() != nullptr) {
+    tree = tree->getParent();
+  }
+  auto loopsInTheForest = tree->getNumberOfSubLoops() + 1;
+
+  Values values;
+  values.insert(suite.combineOrderedValues(
+      { "nest", tiled ? "tiled" : "rejected" }));
+  values.insert(suite.combineOrderedValues(
+      { "loops before", std::to_string(loopsBefore) }));
+  values.insert(suite.combineOrderedValues(
+      { "loops after", std::to_string(loopsAfter) }));
+  values.insert(suite.combineOrderedValues(
+      { "loops in the forest", std::to_string(loopsInTheForest) }));
+  values.insert(suite.combineOrderedValues(
+      { "valid code",
+        verifyFunction(*transformationsPass.mainF) ? "false" : "true" }));
+
+  return values;
+}
+
+Values LoopTransformationsTestSuite::verifyFusion(ModulePass &pass,
+                                                  TestSuite &suite) {
+  auto &transformationsPass = static_cast<LoopTransformationsTestSuite &>(pass);
+  auto &loops = transformationsPass.outermostLoops;
+  auto mainF = transformationsPass.mainF;
+  assert(loops.size() == 2);
+
+  /*
+   * Fuse the second loop of main into the first one.
+   */
+  auto &noelle = *transformationsPass.noelle;
+  auto FDG = noelle.getProgramDependenceGraph()->createFunctionSubgraph(*mainF);
+  auto DS = noelle.getDominators(mainF);
+  LoopFusion fusion;
+  auto fused = fusion.fuseLoops(*loops[0],
+                                *loops[1],
+                                FDG,
+                                DS,
+                                *transformationsPass.LI,
+                                *transformationsPass.SE);
+  delete DS;
+  delete FDG;
+
+  Values values;
+  values.insert(suite.combineOrderedValues(
+      { "loops", fused ? "fused" : "rejected" }));
+  values.insert(suite.combineOrderedValues(
+      { "loops after",
+        std::to_string(transformationsPass.countLoopsOfMain()) }));
+  values.insert(suite.combineOrderedValues(
+      { "valid code", verifyFunction(*mainF) ? "false" : "true" }));
+
+  return values;
+}
+
+} // namespace arcana::noelle
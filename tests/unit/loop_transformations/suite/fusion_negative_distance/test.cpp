@@ -0,0 +1,24 @@
+#include <stdio.h>
+#include <stdint.h>
+
+int64_t A[101];
+int64_t B[100];
+
+int main (int argc, char *argv[]){
+
+  /*
+   * The iteration i of the second loop reads A[i + 1], which the first loop
+   * writes at the later iteration i + 1 (delta + stride < bytes), so fusing
+   * the loops would read it before it is written
+   */
+  for (int64_t i = 0; i < 100; i++) {
+    A[i] = i * argc;
+  }
+  for (int64_t i = 0; i < 100; i++) {
+    B[i] = A[i + 1] + 1;
+  }
+
+  printf("%ld\n", B[argc]);
+
+  return 0;
+}
@@ -0,0 +1,23 @@
+#include <stdio.h>
+#include <stdint.h>
+
+int64_t A[101];
+int64_t B[100];
+
+int main (int argc, char *argv[]){
+
+  /*
+   * The second loop reads A[i] after the first loop writes it at the same
+   * iteration, so the loops can be fused
+   */
+  for (int64_t i = 0; i < 100; i++) {
+    A[i] = i * argc;
+  }
+  for (int64_t i = 0; i < 100; i++) {
+    B[i] = A[i] + 1;
+  }
+
+  printf("%ld\n", B[argc]);
+
+  return 0;
+}
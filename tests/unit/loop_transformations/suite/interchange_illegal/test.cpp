@@ -0,0 +1,21 @@
+#include <stdio.h>
+#include <stdint.h>
+
+int64_t A[100][100];
+
+int main (int argc, char *argv[]){
+
+  /*
+   * A[i][j] is read at the iteration (i + 1, j - 1), so the dependence has the
+   * direction vector (<, >) and swapping the loops would reverse it
+   */
+  for (int64_t i = 1; i < 100; i++) {
+    for (int64_t j = 0; j < 99; j++) {
+      A[i][j] = A[i - 1][j + 1] + argc;
+    }
+  }
+
+  printf("%ld\n", A[argc][argc]);
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+#include <stdio.h>
+#include <stdint.h>
+
+int64_t A[100][100];
+
+int main (int argc, char *argv[]){
+
+  /*
+   * The inner loop walks a column of A, so swapping the loops (which carry no
+   * dependence) makes it walk a row
+   */
+  for (int64_t i = 0; i < 100; i++) {
+    for (int64_t j = 0; j < 100; j++) {
+      A[j][i] = A[j][i] + argc;
+    }
+  }
+
+  printf("%ld\n", A[argc][argc]);
+
+  return 0;
+}
@@ -0,0 +1,25 @@
+#include <stdio.h>
+#include <stdint.h>
+
+int64_t A[64][64];
+int64_t B[64][64];
+int64_t C[64][64];
+
+int main (int argc, char *argv[]){
+
+  /*
+   * The only dependence is the accumulation on C[i][j], which has the
+   * direction vector (=, =, <), so every loop of the nest can be tiled
+   */
+  for (int64_t i = 0; i < 64; i++) {
+    for (int64_t j = 0; j < 64; j++) {
+      for (int64_t k = 0; k < 64; k++) {
+        C[i][j] = C[i][j] + A[i][k] * B[k][j];
+      }
+    }
+  }
+
+  printf("%ld\n", C[argc][argc]);
+
+  return 0;
+}
@@ -79,6 +79,9 @@ private:
 
   static Values loopCarriedDependencies(ModulePass &pass, TestSuite &suite);
 
+  static Values concurrentTagsMatchSequentialOnes(ModulePass &pass,
+                                                  TestSuite &suite);
+
   static Values printSCCs(ModulePass &pass,
                           TestSuite &suite,
                           std::set<SCC *> sccs);
@@ -91,6 +94,7 @@ private:
   SCCDAG *sccdag;
   SCCDAGAttrs *attrs;
   LoopContent *ldi;
+  DominatorSummary *DS;
   Noelle *noelle;
 };
 } // namespace arcana::noelle
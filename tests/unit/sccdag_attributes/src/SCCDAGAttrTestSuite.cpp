@@ -56,7 +56,8 @@ const char *SCCDAGAttrTestSuite::tests[] = {
   "reducible SCC",
   "clonable SCC",
   "clonable SCC into local memory",
-  "loop carried dependencies (top loop)"
+  "loop carried dependencies (top loop)",
+  "concurrent SCC tags"
 };
 TestFunction SCCDAGAttrTestSuite::testFns[] = {
   SCCDAGAttrTestSuite::sccdagHasCorrectSCCs,
@@ -64,7 +65,8 @@ TestFunction SCCDAGAttrTestSuite::testFns[] = {
   SCCDAGAttrTestSuite::reducibleSCCsAreFound,
   SCCDAGAttrTestSuite::clonableSCCsAreFound,
   SCCDAGAttrTestSuite::clonableSCCsIntoLocalMemoryAreFound,
-  SCCDAGAttrTestSuite::loopCarriedDependencies
+  SCCDAGAttrTestSuite::loopCarriedDependencies,
+  SCCDAGAttrTestSuite::concurrentTagsMatchSequentialOnes
 };
 
 bool SCCDAGAttrTestSuite::doInitialization(Module &M) {
@@ -105,6 +107,7 @@ bool SCCDAGAttrTestSuite::runOnModule(Module &M) {
    * Fetch the dominators
    */
   auto DS = this->noelle->getDominators(mainFunction);
+  this->DS = DS;
 
   /*
    * Fetch the forest node of the loop
@@ -359,4 +362,66 @@ Values SCCDAGAttrTestSuite::loopCarriedDependencies(ModulePass &pass,
   return valueNames;
 }
 
+Values SCCDAGAttrTestSuite::concurrentTagsMatchSequentialOnes(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &attrPass = static_cast<SCCDAGAttrTestSuite &>(pass);
+
+  /*
+   * Tag the SCCs of the loop sequentially and with at least two threads
+   * (more if -noelle-analysis-threads asks for them).
+   */
+  auto options = attrPass.noelle->getCompilationOptionsManager();
+  auto threads = std::max<uint32_t>(2, options->getNumberOfAnalysisThreads());
+  auto loopDG = attrPass.ldi->getLoopDG();
+  auto loopNode = attrPass.ldi->getLoopHierarchyStructures();
+  auto IV = attrPass.ldi->getInductionVariableManager();
+  auto floatsAsReals = options->canFloatsBeConsideredRealNumbers();
+  auto sequentialAttrs = new SCCDAGAttrs(floatsAsReals,
+                                         loopDG,
+                                         attrPass.sccdag,
+                                         loopNode,
+                                         *IV,
+                                         *attrPass.DS,
+                                         1);
+  auto concurrentAttrs = new SCCDAGAttrs(floatsAsReals,
+                                         loopDG,
+                                         attrPass.sccdag,
+                                         loopNode,
+                                         *IV,
+                                         *attrPass.DS,
+                                         threads);
+
+  /*
+   * Collect the SCCs tagged differently.
+   */
+  std::set<SCC *> mismatches;
+  for (auto node : attrPass.sccdag->getNodes()) {
+    auto scc = node->getT();
+    auto sequentialSCC = sequentialAttrs->getSCCAttrs(scc);
+    auto concurrentSCC = concurrentAttrs->getSCCAttrs(scc);
+    if (sequentialSCC->getKind() != concurrentSCC->getKind()) {
+      mismatches.insert(scc);
+      continue;
+    }
+    auto sequentialLCSCC = dyn_cast<LoopCarriedSCC>(sequentialSCC);
+    if (sequentialLCSCC == nullptr) {
+      continue;
+    }
+    auto concurrentLCSCC = cast<LoopCarriedSCC>(concurrentSCC);
+    if (sequentialLCSCC->getLoopCarriedDependences()
+        != concurrentLCSCC->getLoopCarriedDependences()) {
+      mismatches.insert(scc);
+    }
+  }
+
+  delete concurrentAttrs;
+  delete sequentialAttrs;
+
+  if (mismatches.empty()) {
+    return Values{ "identical" };
+  }
+  return SCCDAGAttrTestSuite::printSCCs(pass, suite, mismatches);
+}
+
 } // namespace arcana::noelle